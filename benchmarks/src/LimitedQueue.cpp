@@ -90,6 +90,24 @@ void BM_LimitedQueue_Snapshot_ExpensiveCopy(benchmark::State &state)
     }
 }
 
+void BM_LimitedQueue_PushBack_WithSnapshot(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+    auto item = std::make_shared<int>(0);
+
+    // every push has to copy the store since a snapshot refers to it
+    for (auto _ : state)
+    {
+        auto snapshot = queue.getSnapshot();
+        queue.pushBack(item);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
 void BM_LimitedQueue_Find(benchmark::State &state)
 {
     LimitedQueue<int> queue(1000);
@@ -113,4 +131,5 @@ BENCHMARK(BM_LimitedQueue_PushFront_Many);
 BENCHMARK(BM_LimitedQueue_Replace);
 BENCHMARK(BM_LimitedQueue_Snapshot);
 BENCHMARK(BM_LimitedQueue_Snapshot_ExpensiveCopy);
+BENCHMARK(BM_LimitedQueue_PushBack_WithSnapshot);
 BENCHMARK(BM_LimitedQueue_Find);
@@ -0,0 +1,79 @@
+#include "providers/twitch/pubsubmessages/Base.hpp"
+#include "providers/twitch/pubsubmessages/ChatModeratorAction.hpp"
+#include "providers/twitch/pubsubmessages/Message.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <string>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// A burst of timeouts like the ones sent for a mass-timeout in a big channel
+std::vector<std::string> makeTimeouts(size_t count)
+{
+    // The inner message is a JSON encoded string
+    const std::string prefix =
+        R"({"type":"MESSAGE","data":{"topic":"chat_moderator_actions.1.2",)"
+        R"("message":"{\"type\":\"moderation_action\",\"data\":{)"
+        R"(\"type\":\"chat_login_moderation\",)"
+        R"(\"moderation_action\":\"timeout\",)"
+        R"(\"created_by\":\"pajlada\",)"
+        R"(\"created_by_user_id\":\"11148817\",)"
+        R"(\"target_user_login\":\"\",\"args\":[\"user)";
+    const std::string suffix = R"(\",\"600\",\"spam\"]}}"}})";
+
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        messages.push_back(prefix + std::to_string(i) + suffix);
+    }
+    return messages;
+}
+
+void BM_ModerationBurst(benchmark::State &state)
+{
+    auto messages = makeTimeouts(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (const auto &blob : messages)
+        {
+            auto message = parsePubSubBaseMessage(blob);
+            auto action = message->toInner<PubSubMessageMessage>()
+                              ->toInner<PubSubChatModeratorActionMessage>();
+            benchmark::DoNotOptimize(action->data.arg(0));
+        }
+    }
+}
+
+/// Decodes the same burst, but builds a Qt JSON tree for the inner message
+/// like the handlers used to read it from
+void BM_ModerationBurstQtJson(benchmark::State &state)
+{
+    auto messages = makeTimeouts(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (const auto &blob : messages)
+        {
+            auto message = parsePubSubBaseMessage(blob);
+            auto root =
+                QJsonDocument::fromJson(message->messagePayload).object();
+            auto data = root.value("data").toObject();
+            benchmark::DoNotOptimize(
+                data.value("args").toArray().at(0).toString());
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ModerationBurst)->Arg(100)->Arg(1000);
+BENCHMARK(BM_ModerationBurstQtJson)->Arg(100)->Arg(1000);
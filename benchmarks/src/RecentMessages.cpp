@@ -21,6 +21,7 @@
 #include "singletons/Resources.hpp"
 
 #include <benchmark/benchmark.h>
+#include <QEventLoop>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -256,6 +257,35 @@ public:
     }
 };
 
+class BuildRecentMessagesConcurrently : public RecentMessages
+{
+public:
+    explicit BuildRecentMessagesConcurrently(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+        // The channel is owned by this benchmark
+        std::shared_ptr<Channel> channel(&this->chan, [](auto * /*chan*/) {});
+        auto jsonMessages = this->messages.object()["messages"_L1].toArray();
+
+        for (auto _ : state)
+        {
+            QEventLoop loop;
+            std::vector<MessagePtr> built;
+            recentmessages::detail::buildRecentMessagesConcurrently(
+                jsonMessages, channel, [&](auto &&messages) {
+                    built = std::move(messages);
+                    loop.quit();
+                });
+            loop.exec();
+            benchmark::DoNotOptimize(built);
+        }
+    }
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
@@ -268,7 +298,16 @@ void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
     bench.run(state);
 }
 
+void BM_BuildRecentMessagesConcurrently(benchmark::State &state,
+                                        const QString &name)
+{
+    BuildRecentMessagesConcurrently bench(name);
+    bench.run(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_BuildRecentMessagesConcurrently, nymn, u"nymn"_s)
+    ->UseRealTime();
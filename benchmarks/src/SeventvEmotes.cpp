@@ -0,0 +1,118 @@
+#include "common/Literals.hpp"
+#include "messages/Emote.hpp"
+#include "providers/seventv/eventapi/Dispatch.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <rapidjson/document.h>
+
+using namespace chatterino;
+using namespace chatterino::seventv::eventapi;
+using namespace literals;
+
+namespace {
+
+QJsonArray readEmotes()
+{
+    QFile file(":/bench/seventvemotes-nymn.json");
+    if (!file.open(QFile::ReadOnly))
+    {
+        return {};
+    }
+    auto json = QJsonDocument::fromJson(file.readAll()).object();
+    return json["emote_set"_L1].toObject()["emotes"_L1].toArray();
+}
+
+/// Applies `nChanges` changes (alternating removals and re-additions of
+/// emotes) to the emote set of NymN.
+class ApplyEmoteSetChanges
+{
+public:
+    ApplyEmoteSetChanges(size_t nChanges)
+    {
+        auto emotes = readEmotes();
+        this->initial_ = std::make_shared<const EmoteMap>(
+            seventv::detail::parseEmotes(emotes, SeventvEmoteSetKind::Channel));
+
+        rapidjson::Document document;
+        document.Parse(R"({"type":"emote_set.update","body":{"id":"nymn",)"
+                       R"("actor":{"display_name":"nymn"}}})");
+        Dispatch dispatch(document);
+
+        this->changes_.emoteSetID = "nymn";
+        for (size_t i = 0; i < nChanges; i++)
+        {
+            auto emote =
+                emotes.at(static_cast<qsizetype>(i / 2) % emotes.size())
+                    .toObject();
+            if (i % 2 == 0)
+            {
+                this->changes_.changes.emplace_back(
+                    EmoteRemoveDispatch(dispatch, emote));
+            }
+            else
+            {
+                this->changes_.changes.emplace_back(
+                    EmoteAddDispatch(dispatch, emote));
+            }
+        }
+    }
+
+    void runBatched(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            Atomic<std::shared_ptr<const EmoteMap>> map(
+                std::shared_ptr<const EmoteMap>(this->initial_));
+            auto applied =
+                SeventvEmotes::applyEmoteSetChanges(map, this->changes_);
+            benchmark::DoNotOptimize(applied);
+        }
+    }
+
+    void runOneByOne(benchmark::State &state)
+    {
+        std::vector<EmoteSetChanges> single;
+        for (const auto &change : this->changes_.changes)
+        {
+            single.push_back({this->changes_.emoteSetID, {change}});
+        }
+
+        for (auto _ : state)
+        {
+            Atomic<std::shared_ptr<const EmoteMap>> map(
+                std::shared_ptr<const EmoteMap>(this->initial_));
+            for (const auto &changes : single)
+            {
+                auto applied =
+                    SeventvEmotes::applyEmoteSetChanges(map, changes);
+                benchmark::DoNotOptimize(applied);
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<const EmoteMap> initial_;
+    EmoteSetChanges changes_;
+};
+
+void BM_ApplyEmoteSetChangesBatched(benchmark::State &state)
+{
+    ApplyEmoteSetChanges bench(static_cast<size_t>(state.range(0)));
+    bench.runBatched(state);
+}
+
+void BM_ApplyEmoteSetChangesOneByOne(benchmark::State &state)
+{
+    ApplyEmoteSetChanges bench(static_cast<size_t>(state.range(0)));
+    bench.runOneByOne(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ApplyEmoteSetChangesBatched)->Arg(1)->Arg(8)->Arg(64)->Arg(500);
+BENCHMARK(BM_ApplyEmoteSetChangesOneByOne)->Arg(1)->Arg(8)->Arg(64)->Arg(500);
@@ -101,6 +101,59 @@ declare module c2 {
     static create(method: HTTPMethod, url: string): HTTPRequest;
   }
 
+  enum MessageFlag {
+    None,
+    System,
+    Timeout,
+    Highlighted,
+    DoNotTriggerNotification,
+    Centered,
+    Disabled,
+    DisableCompactEmotes,
+    Collapsed,
+    ConnectedMessage,
+    DisconnectedMessage,
+    Untimeout,
+    PubSub,
+    Subscription,
+    DoNotLog,
+    AutoMod,
+    RecentMessage,
+    Whisper,
+    HighlightedWhisper,
+    Debug,
+    Similar,
+    RedeemedHighlight,
+    RedeemedChannelPointReward,
+    ShowInMentions,
+    FirstMessage,
+    ReplyMessage,
+    ElevatedMessage,
+    SubscribedThread,
+    CheerMessage,
+    LiveUpdatesAdd,
+    LiveUpdatesRemove,
+    LiveUpdatesUpdate,
+    AutoModOffendingMessageHeader,
+    AutoModOffendingMessage,
+    LowTrustUsers,
+    RestrictedMessage,
+    MonitoredMessage,
+    Action,
+    SharedMessage,
+    Archived,
+  }
+
+  class Message implements ISharedResource {
+    get_id(): string;
+    get_text(): string;
+    get_login_name(): string;
+    get_display_name(): string;
+    get_channel_name(): string;
+    get_time(): number;
+    has_flag(flag: MessageFlag): boolean;
+  }
+
   function log(level: LogLevel, ...data: any[]): void;
   function register_command(
     name: String,
@@ -119,15 +172,33 @@ declare module c2 {
     hide_others: boolean;
   }
 
+  class MessagesAddedEvent {
+    messages: Message[];
+  }
+
+  class MessageFilter {
+    channels?: string[];
+    authors?: string[];
+    flags?: MessageFlag[];
+  }
+
   enum EventType {
     CompletionRequested = "CompletionRequested",
+    MessagesAdded = "MessagesAdded",
   }
 
   type CbFuncCompletionsRequested = (ev: CompletionEvent) => CompletionList;
+  type CbFuncMessagesAdded = (ev: MessagesAddedEvent) => void;
   type CbFunc<T> = T extends EventType.CompletionRequested
     ? CbFuncCompletionsRequested
+    : T extends EventType.MessagesAdded
+    ? CbFuncMessagesAdded
     : never;
 
-  function register_callback<T>(type: T, func: CbFunc<T>): void;
+  function register_callback<T>(
+    type: T,
+    func: CbFunc<T>,
+    filter?: T extends EventType.MessagesAdded ? MessageFilter : never
+  ): void;
   function later(callback: () => void, msec: number): void;
 }
@@ -16,8 +16,9 @@ c2.LogLevel = {}
 -- Begin src/controllers/plugins/api/EventType.hpp
 
 ---@alias c2.EventType.CompletionRequested "c2.EventType.CompletionRequested"
----@alias c2.EventType c2.EventType.CompletionRequested
----@type { CompletionRequested: c2.EventType.CompletionRequested }
+---@alias c2.EventType.MessagesAdded "c2.EventType.MessagesAdded"
+---@alias c2.EventType c2.EventType.CompletionRequested|c2.EventType.MessagesAdded
+---@type { CompletionRequested: c2.EventType.CompletionRequested, MessagesAdded: c2.EventType.MessagesAdded }
 c2.EventType = {}
 
 -- End src/controllers/plugins/api/EventType.hpp
@@ -36,6 +37,9 @@ c2.EventType = {}
 ---@field cursor_position integer Position of the cursor in the text input in unicode codepoints (not bytes)
 ---@field is_first_word boolean True if this is the first word in the input
 
+---@class MessagesAddedEvent
+---@field messages c2.Message[] The messages added since the last event, oldest first
+
 -- Begin src/common/Channel.hpp
 
 ---@alias c2.ChannelType.None "c2.ChannelType.None"
@@ -100,12 +104,14 @@ function c2.Channel:get_display_name() end
 
 --- Sends a message to the target channel.
 --- Note that this does not execute client-commands.
+--- Plugins running on a worker thread send the message asynchronously.
 ---
 ---@param message string
 ---@param execute_commands? boolean Should commands be run on the text?
 function c2.Channel:send_message(message, execute_commands) end
 
---- Adds a system message client-side
+--- Adds a system message client-side.
+--- Plugins running on a worker thread add the message asynchronously.
 ---
 ---@param message string
 function c2.Channel:add_system_message(message) end
@@ -261,6 +267,106 @@ HTTPMethod = {}
 
 -- End src/common/network/NetworkCommon.hpp
 
+-- Begin src/controllers/plugins/api/MessageView.hpp
+
+-- Begin src/messages/MessageFlag.hpp
+
+---@alias c2.MessageFlag.None "c2.MessageFlag.None"
+---@alias c2.MessageFlag.System "c2.MessageFlag.System"
+---@alias c2.MessageFlag.Timeout "c2.MessageFlag.Timeout"
+---@alias c2.MessageFlag.Highlighted "c2.MessageFlag.Highlighted"
+---@alias c2.MessageFlag.DoNotTriggerNotification "c2.MessageFlag.DoNotTriggerNotification"
+---@alias c2.MessageFlag.Centered "c2.MessageFlag.Centered"
+---@alias c2.MessageFlag.Disabled "c2.MessageFlag.Disabled"
+---@alias c2.MessageFlag.DisableCompactEmotes "c2.MessageFlag.DisableCompactEmotes"
+---@alias c2.MessageFlag.Collapsed "c2.MessageFlag.Collapsed"
+---@alias c2.MessageFlag.ConnectedMessage "c2.MessageFlag.ConnectedMessage"
+---@alias c2.MessageFlag.DisconnectedMessage "c2.MessageFlag.DisconnectedMessage"
+---@alias c2.MessageFlag.Untimeout "c2.MessageFlag.Untimeout"
+---@alias c2.MessageFlag.PubSub "c2.MessageFlag.PubSub"
+---@alias c2.MessageFlag.Subscription "c2.MessageFlag.Subscription"
+---@alias c2.MessageFlag.DoNotLog "c2.MessageFlag.DoNotLog"
+---@alias c2.MessageFlag.AutoMod "c2.MessageFlag.AutoMod"
+---@alias c2.MessageFlag.RecentMessage "c2.MessageFlag.RecentMessage"
+---@alias c2.MessageFlag.Whisper "c2.MessageFlag.Whisper"
+---@alias c2.MessageFlag.HighlightedWhisper "c2.MessageFlag.HighlightedWhisper"
+---@alias c2.MessageFlag.Debug "c2.MessageFlag.Debug"
+---@alias c2.MessageFlag.Similar "c2.MessageFlag.Similar"
+---@alias c2.MessageFlag.RedeemedHighlight "c2.MessageFlag.RedeemedHighlight"
+---@alias c2.MessageFlag.RedeemedChannelPointReward "c2.MessageFlag.RedeemedChannelPointReward"
+---@alias c2.MessageFlag.ShowInMentions "c2.MessageFlag.ShowInMentions"
+---@alias c2.MessageFlag.FirstMessage "c2.MessageFlag.FirstMessage"
+---@alias c2.MessageFlag.ReplyMessage "c2.MessageFlag.ReplyMessage"
+---@alias c2.MessageFlag.ElevatedMessage "c2.MessageFlag.ElevatedMessage"
+---@alias c2.MessageFlag.SubscribedThread "c2.MessageFlag.SubscribedThread"
+---@alias c2.MessageFlag.CheerMessage "c2.MessageFlag.CheerMessage"
+---@alias c2.MessageFlag.LiveUpdatesAdd "c2.MessageFlag.LiveUpdatesAdd"
+---@alias c2.MessageFlag.LiveUpdatesRemove "c2.MessageFlag.LiveUpdatesRemove"
+---@alias c2.MessageFlag.LiveUpdatesUpdate "c2.MessageFlag.LiveUpdatesUpdate"
+---@alias c2.MessageFlag.AutoModOffendingMessageHeader "c2.MessageFlag.AutoModOffendingMessageHeader"
+---@alias c2.MessageFlag.AutoModOffendingMessage "c2.MessageFlag.AutoModOffendingMessage"
+---@alias c2.MessageFlag.LowTrustUsers "c2.MessageFlag.LowTrustUsers"
+---@alias c2.MessageFlag.RestrictedMessage "c2.MessageFlag.RestrictedMessage"
+---@alias c2.MessageFlag.MonitoredMessage "c2.MessageFlag.MonitoredMessage"
+---@alias c2.MessageFlag.Action "c2.MessageFlag.Action"
+---@alias c2.MessageFlag.SharedMessage "c2.MessageFlag.SharedMessage"
+---@alias c2.MessageFlag.Archived "c2.MessageFlag.Archived"
+---@alias c2.MessageFlag c2.MessageFlag.None|c2.MessageFlag.System|c2.MessageFlag.Timeout|c2.MessageFlag.Highlighted|c2.MessageFlag.DoNotTriggerNotification|c2.MessageFlag.Centered|c2.MessageFlag.Disabled|c2.MessageFlag.DisableCompactEmotes|c2.MessageFlag.Collapsed|c2.MessageFlag.ConnectedMessage|c2.MessageFlag.DisconnectedMessage|c2.MessageFlag.Untimeout|c2.MessageFlag.PubSub|c2.MessageFlag.Subscription|c2.MessageFlag.DoNotLog|c2.MessageFlag.AutoMod|c2.MessageFlag.RecentMessage|c2.MessageFlag.Whisper|c2.MessageFlag.HighlightedWhisper|c2.MessageFlag.Debug|c2.MessageFlag.Similar|c2.MessageFlag.RedeemedHighlight|c2.MessageFlag.RedeemedChannelPointReward|c2.MessageFlag.ShowInMentions|c2.MessageFlag.FirstMessage|c2.MessageFlag.ReplyMessage|c2.MessageFlag.ElevatedMessage|c2.MessageFlag.SubscribedThread|c2.MessageFlag.CheerMessage|c2.MessageFlag.LiveUpdatesAdd|c2.MessageFlag.LiveUpdatesRemove|c2.MessageFlag.LiveUpdatesUpdate|c2.MessageFlag.AutoModOffendingMessageHeader|c2.MessageFlag.AutoModOffendingMessage|c2.MessageFlag.LowTrustUsers|c2.MessageFlag.RestrictedMessage|c2.MessageFlag.MonitoredMessage|c2.MessageFlag.Action|c2.MessageFlag.SharedMessage|c2.MessageFlag.Archived
+---@type { None: c2.MessageFlag.None, System: c2.MessageFlag.System, Timeout: c2.MessageFlag.Timeout, Highlighted: c2.MessageFlag.Highlighted, DoNotTriggerNotification: c2.MessageFlag.DoNotTriggerNotification, Centered: c2.MessageFlag.Centered, Disabled: c2.MessageFlag.Disabled, DisableCompactEmotes: c2.MessageFlag.DisableCompactEmotes, Collapsed: c2.MessageFlag.Collapsed, ConnectedMessage: c2.MessageFlag.ConnectedMessage, DisconnectedMessage: c2.MessageFlag.DisconnectedMessage, Untimeout: c2.MessageFlag.Untimeout, PubSub: c2.MessageFlag.PubSub, Subscription: c2.MessageFlag.Subscription, DoNotLog: c2.MessageFlag.DoNotLog, AutoMod: c2.MessageFlag.AutoMod, RecentMessage: c2.MessageFlag.RecentMessage, Whisper: c2.MessageFlag.Whisper, HighlightedWhisper: c2.MessageFlag.HighlightedWhisper, Debug: c2.MessageFlag.Debug, Similar: c2.MessageFlag.Similar, RedeemedHighlight: c2.MessageFlag.RedeemedHighlight, RedeemedChannelPointReward: c2.MessageFlag.RedeemedChannelPointReward, ShowInMentions: c2.MessageFlag.ShowInMentions, FirstMessage: c2.MessageFlag.FirstMessage, ReplyMessage: c2.MessageFlag.ReplyMessage, ElevatedMessage: c2.MessageFlag.ElevatedMessage, SubscribedThread: c2.MessageFlag.SubscribedThread, CheerMessage: c2.MessageFlag.CheerMessage, LiveUpdatesAdd: c2.MessageFlag.LiveUpdatesAdd, LiveUpdatesRemove: c2.MessageFlag.LiveUpdatesRemove, LiveUpdatesUpdate: c2.MessageFlag.LiveUpdatesUpdate, AutoModOffendingMessageHeader: c2.MessageFlag.AutoModOffendingMessageHeader, AutoModOffendingMessage: c2.MessageFlag.AutoModOffendingMessage, LowTrustUsers: c2.MessageFlag.LowTrustUsers, RestrictedMessage: c2.MessageFlag.RestrictedMessage, MonitoredMessage: c2.MessageFlag.MonitoredMessage, Action: c2.MessageFlag.Action, SharedMessage: c2.MessageFlag.SharedMessage, Archived: c2.MessageFlag.Archived }
+c2.MessageFlag = {}
+
+-- End src/messages/MessageFlag.hpp
+
+---@class MessageFilter
+---@field channels? string[] Only deliver messages from these channels (login names)
+---@field authors? string[] Only deliver messages sent by these users (login names)
+---@field flags? c2.MessageFlag[] Only deliver messages with at least one of these flags
+
+--- A read-only view of a message in a channel
+---@class c2.Message
+c2.Message = {}
+
+--- Returns the ID of the message. This is empty for messages that weren't sent by Twitch (e.g. system messages).
+---
+---@return string
+function c2.Message:get_id() end
+
+--- Returns the text of the message
+---
+---@return string
+function c2.Message:get_text() end
+
+--- Returns the login name of the sender. This is empty for system messages.
+---
+---@return string
+function c2.Message:get_login_name() end
+
+--- Returns the display name of the sender
+---
+---@return string
+function c2.Message:get_display_name() end
+
+--- Returns the name of the channel the message was added to
+---
+---@return string
+function c2.Message:get_channel_name() end
+
+--- Returns the time the message was received in milliseconds since the Unix epoch
+---
+---@return integer
+function c2.Message:get_time() end
+
+--- Returns true if the message has the flag
+---
+---@param flag c2.MessageFlag
+---@return boolean
+function c2.Message:has_flag(flag) end
+
+---@return string
+function c2.Message:__tostring() end
+
+-- End src/controllers/plugins/api/MessageView.hpp
+
 --- Registers a new command called `name` which when executed will call `handler`.
 ---
 ---@param name string The name of the command.
@@ -268,11 +374,14 @@ HTTPMethod = {}
 ---@return boolean ok  Returns `true` if everything went ok, `false` if a command with this name exists.
 function c2.register_command(name, handler) end
 
---- Registers a callback to be invoked when completions for a term are requested.
+--- Registers a callback to be invoked when an event happens.
+--- `CompletionRequested` callbacks are invoked when completions for a term are requested.
+--- `MessagesAdded` callbacks are invoked at most once per event loop iteration with the messages added to channels since the last invocation. Only messages matching `filter` are delivered.
 ---
----@param type c2.EventType.CompletionRequested
----@param func fun(event: CompletionEvent): CompletionList The callback to be invoked.
-function c2.register_callback(type, func) end
+---@param type c2.EventType
+---@param func (fun(event: CompletionEvent): CompletionList)|fun(event: MessagesAddedEvent) The callback to be invoked.
+---@param filter? MessageFilter Filter for `MessagesAdded`. It's evaluated before any Lua code runs.
+function c2.register_callback(type, func, filter) end
 
 --- Writes a message to the Chatterino log.
 ---
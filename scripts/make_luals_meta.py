@@ -174,7 +174,8 @@ class Reader:
             if line.startswith("enum class"):
                 continue
 
-            items.append(line.rstrip(","))
+            # variants may have a value and a trailing comment
+            items.append(line.split("//", 1)[0].split("=", 1)[0].strip().rstrip(","))
 
         return items
 
@@ -16,6 +16,8 @@
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/links/LinkResolver.hpp"
 #include "providers/pronouns/Pronouns.hpp"
+#include "providers/ProviderSnapshot.hpp"
+#include "providers/recentmessages/MessageCache.hpp"
 #include "providers/seventv/SeventvAPI.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
@@ -29,6 +31,7 @@
 #include "controllers/twitch/LiveController.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "debug/StartupTimeline.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/BttvLiveUpdates.hpp"
@@ -59,6 +62,7 @@
 #include "singletons/Toasts.hpp"
 #include "singletons/Updates.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/CombinePath.hpp"
 #include "util/Helpers.hpp"
 #include "util/PostToThread.hpp"
 #include "widgets/Notebook.hpp"
@@ -69,6 +73,8 @@
 #include <QApplication>
 #include <QDesktopServices>
 
+#include <algorithm>
+
 namespace {
 
 using namespace chatterino;
@@ -260,8 +266,18 @@ void Application::initialize(Settings &settings, const Paths &paths)
     }
 
     this->accounts->load();
+    startup::mark("accounts loaded");
 
     this->windows->initialize();
+    startup::mark("windows created");
+
+    // Global emotes and badges are restored from the snapshot of the
+    // previous run while they're revalidated
+    if (!this->args_.dontSaveSettings)
+    {
+        ProviderSnapshot::instance().initialize(
+            combinePath(paths.miscDirectory, "provider-snapshot.bin"));
+    }
 
     this->ffzBadges->load();
 
@@ -278,9 +294,11 @@ void Application::initialize(Settings &settings, const Paths &paths)
     // XXX: Loading Twitch badges after Helix has been initialized, which only happens after
     // the AccountController initialize has been called
     this->twitchBadges->loadTwitchBadges();
+    startup::mark("Twitch initialized");
 
 #ifdef CHATTERINO_HAVE_PLUGINS
     this->plugins->initialize(settings);
+    startup::mark("plugins loaded");
 #endif
 
     // Show crash message.
@@ -320,6 +338,7 @@ void Application::initialize(Settings &settings, const Paths &paths)
     this->streamerMode->start();
 
     this->initialized = true;
+    startup::mark("live updates initialized");
 }
 
 int Application::run()
@@ -332,6 +351,7 @@ int Application::run()
     {
         this->windows->getMainWindow().show();
     }
+    startup::mark("main window shown");
 
     getSettings()->enableBTTVChannelEmotes.connect(
         [this] {
@@ -636,6 +656,8 @@ void Application::save()
     this->commands->save();
     this->hotkeys->save();
     this->windows->save();
+    recentmessages::MessageCache::instance().save();
+    ProviderSnapshot::instance().save();
 }
 
 void Application::initNm(const Paths &paths)
@@ -708,54 +730,54 @@ void Application::initSeventvEventAPI()
 
     // We can safely ignore these signal connections since the twitch object will always
     // be destroyed before the Application
-    std::ignore = this->seventvEventAPI->signals_.emoteAdded.connect(
-        [&](const auto &data) {
-            if (this->seventvPersonalEmotes->hasEmoteSet(data.emoteSetID))
-            {
-                this->seventvPersonalEmotes->updateEmoteSet(data.emoteSetID,
-                                                            data);
-            }
-            else
-            {
-                postToThread([this, data] {
-                    this->twitch->forEachSeventvEmoteSet(
-                        data.emoteSetID, [data](TwitchChannel &chan) {
-                            chan.addSeventvEmote(data);
-                        });
-                });
-            }
-        });
-    std::ignore = this->seventvEventAPI->signals_.emoteUpdated.connect(
-        [&](const auto &data) {
-            if (this->seventvPersonalEmotes->hasEmoteSet(data.emoteSetID))
-            {
-                this->seventvPersonalEmotes->updateEmoteSet(data.emoteSetID,
-                                                            data);
-            }
-            else
+    std::ignore = this->seventvEventAPI->signals_.emoteSetChanged.connect(
+        [&](const auto &changes) {
+            if (this->seventvPersonalEmotes->hasEmoteSet(changes.emoteSetID))
             {
-                postToThread([this, data] {
-                    this->twitch->forEachSeventvEmoteSet(
-                        data.emoteSetID, [data](TwitchChannel &chan) {
-                            chan.updateSeventvEmote(data);
-                        });
-                });
+                this->seventvPersonalEmotes->updateEmoteSet(changes);
+                return;
             }
-        });
-    std::ignore = this->seventvEventAPI->signals_.emoteRemoved.connect(
-        [&](const auto &data) {
-            if (this->seventvPersonalEmotes->hasEmoteSet(data.emoteSetID))
+
+            // Changes arriving before the GUI thread gets to them are merged,
+            // so each channel's emote map is replaced once per emote set
+            bool scheduleApply = false;
             {
-                this->seventvPersonalEmotes->updateEmoteSet(data.emoteSetID,
-                                                            data);
+                std::lock_guard lock(this->seventvEmoteSetChangesMutex);
+                scheduleApply = this->pendingSeventvEmoteSetChanges.empty();
+                auto it = std::find_if(
+                    this->pendingSeventvEmoteSetChanges.begin(),
+                    this->pendingSeventvEmoteSetChanges.end(),
+                    [&](const auto &pending) {
+                        return pending.emoteSetID == changes.emoteSetID;
+                    });
+                if (it != this->pendingSeventvEmoteSetChanges.end())
+                {
+                    it->append(seventv::eventapi::EmoteSetChanges(changes));
+                }
+                else
+                {
+                    this->pendingSeventvEmoteSetChanges.push_back(changes);
+                }
             }
-            else
+
+            if (scheduleApply)
             {
-                postToThread([this, data] {
-                    this->twitch->forEachSeventvEmoteSet(
-                        data.emoteSetID, [data](TwitchChannel &chan) {
-                            chan.removeSeventvEmote(data);
-                        });
+                this->seventvEventBatch.post([this] {
+                    std::vector<seventv::eventapi::EmoteSetChanges> pending;
+                    {
+                        std::lock_guard lock(
+                            this->seventvEmoteSetChangesMutex);
+                        pending.swap(this->pendingSeventvEmoteSetChanges);
+                    }
+
+                    for (const auto &changes : pending)
+                    {
+                        this->twitch->forEachSeventvEmoteSet(
+                            changes.emoteSetID,
+                            [&changes](TwitchChannel &chan) {
+                                chan.applySeventvEmoteSetChanges(changes);
+                            });
+                    }
                 });
             }
         });
@@ -768,7 +790,7 @@ void Application::initSeventvEventAPI()
         });
     std::ignore = seventvEventAPI->signals_.personalEmoteSetAdded.connect(
         [&](const auto &data) {
-            postToThread([this, data]() {
+            this->seventvEventBatch.post([this, data]() {
                 this->twitch->forEachChannelAndSpecialChannels([=](auto chan) {
                     if (auto *twitchChannel =
                             dynamic_cast<TwitchChannel *>(chan.get()))
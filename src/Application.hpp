@@ -1,9 +1,12 @@
 #pragma once
 
 #include "singletons/NativeMessaging.hpp"
+#include "util/GuiThreadBatch.hpp"
 
 #include <cassert>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace chatterino {
 
@@ -59,6 +62,9 @@ class ITwitchUsers;
 namespace pronouns {
     class Pronouns;
 }  // namespace pronouns
+namespace seventv::eventapi {
+    struct EmoteSetChanges;
+}  // namespace seventv::eventapi
 
 class IApplication
 {
@@ -244,6 +250,12 @@ private:
     NativeMessagingServer nmServer;
     Updates &updates;
 
+    // Emote set changes from the 7TV EventAPI are applied in batches
+    GuiThreadBatch seventvEventBatch;
+    std::mutex seventvEmoteSetChangesMutex;
+    std::vector<seventv::eventapi::EmoteSetChanges>
+        pendingSeventvEmoteSetChanges;
+
     bool initialized{false};
 };
 
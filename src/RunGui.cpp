@@ -5,6 +5,8 @@
 #include "common/Modes.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/CrashHandler.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Resources.hpp"
@@ -230,6 +232,11 @@ namespace {
 void runGui(QApplication &a, const Paths &paths, Settings &settings,
             const Args &args, Updates &updates)
 {
+    if (args.traceFile)
+    {
+        trace::setEnabled(true);
+    }
+
     initQt();
     initResources();
     initSignalHandler();
@@ -260,12 +267,19 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
 
     chatterino::NetworkManager::init();
     updates.checkForUpdates();
+    startup::mark("Qt initialized");
 
     Application app(settings, paths, args, updates);
+    startup::mark("singletons created");
     app.initialize(settings, paths);
     app.run();
     app.save();
 
+    if (args.traceFile)
+    {
+        trace::exportChromeTrace(*args.traceFile);
+    }
+
     settings.requestSave();
 
     chatterino::NetworkManager::deinit();
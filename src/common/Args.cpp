@@ -117,6 +117,18 @@ Args::Args(const QApplication &app, const Paths &paths)
         "safe-mode", "Starts Chatterino without loading Plugins and always "
                      "show the settings button.");
 
+    QCommandLineOption traceOption(
+        "trace",
+        "Records performance traces (IRC, message building, layout, paint, "
+        "images and network) and writes them to the supplied file on exit. "
+        "The file can be opened in https://ui.perfetto.dev.",
+        "file");
+
+    QCommandLineOption startupTimelineOption(
+        "startup-timeline",
+        "Logs how long each startup stage took, from starting Chatterino to "
+        "the first painted message.");
+
     QCommandLineOption loginOption(
         "login",
         "Starts Chatterino logged in as the account matching the supplied "
@@ -149,6 +161,8 @@ Args::Args(const QApplication &app, const Paths &paths)
         parentWindowIdOption,
         verboseOption,
         safeModeOption,
+        traceOption,
+        startupTimelineOption,
         loginOption,
         channelLayout,
         activateOption,
@@ -205,6 +219,16 @@ Args::Args(const QApplication &app, const Paths &paths)
         this->safeMode = true;
     }
 
+    if (parser.isSet(traceOption))
+    {
+        this->traceFile = parser.value(traceOption);
+    }
+
+    if (parser.isSet(startupTimelineOption))
+    {
+        this->startupTimeline = true;
+    }
+
     if (parser.isSet(loginOption))
     {
         this->initialLogin = parser.value(loginOption);
@@ -219,6 +243,7 @@ Args::Args(const QApplication &app, const Paths &paths)
     this->currentArguments_ = extractCommandLine(parser, {
                                                              verboseOption,
                                                              safeModeOption,
+                                                             traceOption,
                                                              loginOption,
                                                              channelLayout,
                                                              activateOption,
@@ -29,6 +29,8 @@ class Paths;
 /// -c, --channels=t:channel1;t:channel2;...
 /// -a, --activate=t:channel
 ///     --safe-mode
+///     --trace=file
+///     --startup-timeline
 ///
 /// See documentation on `QGuiApplication` for documentation on Qt arguments like -platform.
 class Args
@@ -63,6 +65,12 @@ public:
     std::optional<QString> initialLogin;
     bool verbose{};
     bool safeMode{};
+    /// If set, performance spans are recorded and written to this file (in
+    /// the Chrome trace event format) when Chatterino exits.
+    std::optional<QString> traceFile;
+    /// If set, the duration of each startup stage is logged once the first
+    /// message is painted.
+    bool startupTimeline{};
 
     QStringList currentArguments() const;
 
@@ -1,7 +1,11 @@
 #include "common/Channel.hpp"
 
 #include "Application.hpp"
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "controllers/plugins/PluginController.hpp"
+#endif
 #include "messages/Message.hpp"
+#include "messages/MessageArchive.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "singletons/Emotes.hpp"
@@ -34,6 +38,10 @@ Channel::Channel(const QString &name, Type type)
     {
         this->platform_ = "twitch";
     }
+
+    this->messages_.setIndexKeys([](const MessagePtr &message) {
+        return message->userKeys();
+    });
 }
 
 Channel::~Channel()
@@ -81,6 +89,11 @@ bool Channel::hasMessages() const
     return !this->messages_.empty();
 }
 
+MessageArchive *Channel::getArchive() const
+{
+    return this->archive_.get();
+}
+
 LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
 {
     return this->messages_.getSnapshot();
@@ -109,10 +122,21 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
 
     if (this->messages_.pushBack(message, deleted))
     {
+        if (this->archive_)
+        {
+            this->archive_->add(*deleted);
+        }
         this->messageRemovedFromStart(deleted);
     }
 
     this->messageAppended.invoke(message, overridingFlags);
+
+#ifdef CHATTERINO_HAVE_PLUGINS
+    if (context == MessageContext::Original && getSettings()->pluginsEnabled)
+    {
+        getApp()->getPlugins()->observeMessage(this->name_, message);
+    }
+#endif
 }
 
 void Channel::addSystemMessage(const QString &contents)
@@ -123,6 +147,20 @@ void Channel::addSystemMessage(const QString &contents)
 
 void Channel::addOrReplaceTimeout(MessagePtr message)
 {
+    // disable the messages from the user
+    for (const auto &s : this->findMessagesByUser(message->timeoutUser))
+    {
+        if (s->loginName == message->timeoutUser &&
+            s->flags.hasNone({MessageFlag::Timeout, MessageFlag::Untimeout,
+                              MessageFlag::Whisper}))
+        {
+            // FOURTF: disabled for now
+            // PAJLADA: Shitty solution described in Message.hpp
+            s->flags.set(MessageFlag::Disabled);
+            s->invalidateLayouts();
+        }
+    }
+
     addOrReplaceChannelTimeout(
         this->getMessageSnapshot(), std::move(message), QTime::currentTime(),
         [this](auto /*idx*/, auto msg, auto replacement) {
@@ -130,8 +168,7 @@ void Channel::addOrReplaceTimeout(MessagePtr message)
         },
         [this](auto msg) {
             this->addMessage(msg, MessageContext::Original);
-        },
-        true);
+        });
 
     // XXX: Might need the following line
     // WindowManager::instance().repaintVisibleChatWidgets(this);
@@ -152,6 +189,7 @@ void Channel::disableAllMessages()
 
         // FOURTF: disabled for now
         const_cast<Message *>(message.get())->flags.set(MessageFlag::Disabled);
+        message->invalidateLayouts();
     }
 }
 
@@ -277,15 +315,26 @@ void Channel::deleteMessage(QString messageID)
     if (msg != nullptr)
     {
         msg->flags.set(MessageFlag::Disabled);
+        msg->invalidateLayouts();
     }
 }
 
 void Channel::clearMessages()
 {
     this->messages_.clear();
+    if (this->archive_)
+    {
+        this->archive_->clear();
+    }
     this->messagesCleared.invoke();
 }
 
+std::vector<MessagePtr> Channel::findMessagesByUser(
+    const QString &userName) const
+{
+    return this->messages_.findByKey(userName.toLower());
+}
+
 MessagePtr Channel::findMessage(QString messageID)
 {
     MessagePtr res;
@@ -17,6 +17,7 @@ namespace chatterino {
 
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
+class MessageArchive;
 
 enum class TimeoutStackStyle : int {
     StackHard = 0,
@@ -105,8 +106,17 @@ public:
 
     MessagePtr findMessage(QString messageID);
 
+    /// Returns the messages from or about the user in the order they appear
+    /// in the channel, see Message::userKeys.
+    /// This uses an index and doesn't go through all messages.
+    std::vector<MessagePtr> findMessagesByUser(const QString &userName) const;
+
     bool hasMessages() const;
 
+    /// The messages this channel evicted from its scrollback, if it keeps
+    /// them (see MessageArchive). This is nullptr for most channels.
+    MessageArchive *getArchive() const;
+
     // CHANNEL INFO
     virtual bool canSendMessage() const;
     virtual bool isWritable() const;  // whether split input will be usable
@@ -131,6 +141,8 @@ protected:
     virtual void onConnected();
     virtual void messageRemovedFromStart(const MessagePtr &msg);
     QString platform_{"other"};
+    /// Messages removed from the start are added to this if it's set
+    std::unique_ptr<MessageArchive> archive_;
 
 private:
     const QString name_;
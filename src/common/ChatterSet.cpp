@@ -2,6 +2,9 @@
 
 #include "debug/Benchmark.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace chatterino {
 
 ChatterSet::ChatterSet()
@@ -11,7 +14,60 @@ ChatterSet::ChatterSet()
 
 void ChatterSet::addRecentChatter(const QString &userName)
 {
-    this->items.put(userName.toLower(), userName);
+    auto lowerName = userName.toLower();
+
+    // put() silently drops the least recent chatter if the cache is full
+    if (!this->items.exists(lowerName) &&
+        this->items.size() >= ChatterSet::CHATTER_LIMIT)
+    {
+        auto evicted = this->indexIds_.find(std::prev(this->items.end())->first);
+        if (evicted != this->indexIds_.end())
+        {
+            this->index_.remove(evicted->second);
+            this->indexIds_.erase(evicted);
+        }
+    }
+
+    this->items.put(lowerName, userName);
+    this->indexChatter(lowerName, userName);
+}
+
+void ChatterSet::indexChatter(const QString &lowerName,
+                              const QString &userName)
+{
+    NgramIndex::Id id{};
+    auto it = this->indexIds_.find(lowerName);
+    if (it == this->indexIds_.end())
+    {
+        id = this->index_.insert(userName);
+        this->indexIds_.emplace(lowerName, id);
+    }
+    else
+    {
+        id = it->second;
+        this->index_.setText(id, userName);
+    }
+
+    if (this->lastSeen_.size() <= id)
+    {
+        this->lastSeen_.resize(id + 1);
+    }
+    this->lastSeen_[id] = ++this->seenCounter_;
+}
+
+void ChatterSet::rebuildIndex()
+{
+    this->index_.clear();
+    this->indexIds_.clear();
+    this->lastSeen_.clear();
+
+    // The most recent chatter is at the front, so it's indexed last
+    std::vector<std::pair<QString, QString>> chatters(this->items.begin(),
+                                                      this->items.end());
+    for (auto it = chatters.rbegin(); it != chatters.rend(); ++it)
+    {
+        this->indexChatter(it->first, it->second);
+    }
 }
 
 void ChatterSet::updateOnlineChatters(
@@ -37,6 +93,7 @@ void ChatterSet::updateOnlineChatters(
     }
 
     this->items = std::move(tmp);
+    this->rebuildIndex();
 }
 
 bool ChatterSet::contains(const QString &userName) const
@@ -46,20 +103,50 @@ bool ChatterSet::contains(const QString &userName) const
 
 std::vector<QString> ChatterSet::filterByPrefix(const QString &prefix) const
 {
-    QString lowerPrefix = prefix.toLower();
+    auto ids = this->index_.findPrefix(prefix);
+    std::sort(ids.begin(), ids.end(), [this](auto a, auto b) {
+        return this->lastSeen_[a] > this->lastSeen_[b];
+    });
+
     std::vector<QString> result;
+    result.reserve(ids.size());
+    for (auto id : ids)
+    {
+        result.push_back(this->index_.text(id));
+    }
+
+    return result;
+}
+
+std::vector<std::pair<QString, QString>> ChatterSet::filterBySubstring(
+    QStringView query) const
+{
+    auto ids = this->index_.findSubstring(query);
+    std::sort(ids.begin(), ids.end(), [this](auto a, auto b) {
+        return this->lastSeen_[a] > this->lastSeen_[b];
+    });
 
-    for (auto &&item : this->items)
+    std::vector<std::pair<QString, QString>> result;
+    result.reserve(ids.size());
+    for (auto id : ids)
     {
-        if (item.first.startsWith(lowerPrefix))
-        {
-            result.push_back(item.second);
-        }
+        result.emplace_back(this->index_.key(id), this->index_.text(id));
     }
 
     return result;
 }
 
+std::vector<QString> ChatterSet::topMatches(QStringView query,
+                                            size_t limit) const
+{
+    std::vector<QString> result;
+    for (auto id : this->index_.topK(query, limit))
+    {
+        result.push_back(this->index_.text(id));
+    }
+    return result;
+}
+
 std::vector<std::pair<QString, QString>> ChatterSet::all() const
 {
     return {this->items.begin(), this->items.end()};
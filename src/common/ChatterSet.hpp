@@ -1,10 +1,12 @@
 #pragma once
 
+#include "util/NgramIndex.hpp"
 #include "util/QStringHash.hpp"
 
 #include <lrucache/lrucache.hpp>
 #include <QString>
 
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -36,13 +38,37 @@ public:
     /// are in mixed case if available.
     std::vector<QString> filterByPrefix(const QString &prefix) const;
 
+    /// Get chatters whose name contains `query` (case-insensitive), most
+    /// recent chatters first. The first pair element contains the username in
+    /// lowercase, while the second pair element is the original case.
+    std::vector<std::pair<QString, QString>> filterBySubstring(
+        QStringView query) const;
+
+    /// Get the `limit` best matches for `query` (exact matches, then prefix
+    /// matches, then substring matches). Contained items are in mixed case if
+    /// available.
+    std::vector<QString> topMatches(QStringView query, size_t limit) const;
+
     /// Get all recent chatters. The first pair element contains the username
     /// in lowercase, while the second pair element is the original case.
     std::vector<std::pair<QString, QString>> all() const;
 
 private:
+    void indexChatter(const QString &lowerName, const QString &userName);
+    void rebuildIndex();
+
     // user name in lower case -> user name in normal case
     cache::lru_cache<QString, QString> items;
+
+    // Kept in sync with `items` so completions don't have to scan or copy all
+    // chatters
+    NgramIndex index_;
+    // user name in lower case -> id in index_
+    std::unordered_map<QString, NgramIndex::Id> indexIds_;
+    // id in index_ -> value of seenCounter_ when the chatter was last added.
+    // Used to order results like the LRU cache.
+    std::vector<uint64_t> lastSeen_;
+    uint64_t seenCounter_ = 0;
 };
 
 using ChatterSet = ChatterSet;
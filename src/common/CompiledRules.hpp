@@ -0,0 +1,55 @@
+#pragma once
+
+#include "common/Atomic.hpp"
+#include "common/SignalVector.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+/// Rules compiled from the items of a SignalVector.
+///
+/// The rules are compiled when they're first requested after the items
+/// changed and are immutable afterwards, so they can be shared between
+/// threads. Compiled rules are swapped in atomically. Readers keep using the
+/// rules they got while new ones are compiled.
+///
+/// `Rules` must be constructible from a `const std::vector<T> &`.
+template <typename T, typename Rules>
+class CompiledRules
+{
+public:
+    std::shared_ptr<const Rules> get(SignalVector<T> &items)
+    {
+        auto source = items.readOnly();
+        auto compiled = this->compiled_.get();
+        if (!compiled || compiled->source != source)
+        {
+            // If two threads get here at once, both compile the rules.
+            // That's wasteful but correct.
+            compiled = std::make_shared<const Compiled>(source);
+            this->compiled_.set(compiled);
+        }
+
+        return {compiled, &compiled->rules};
+    }
+
+private:
+    struct Compiled {
+        explicit Compiled(std::shared_ptr<const std::vector<T>> source_)
+            : source(std::move(source_))
+            , rules(*this->source)
+        {
+        }
+
+        /// The items the rules were compiled from. This keeps them alive, so
+        /// a new vector can't have the same address.
+        std::shared_ptr<const std::vector<T>> source;
+        Rules rules;
+    };
+
+    Atomic<std::shared_ptr<const Compiled>> compiled_;
+};
+
+}  // namespace chatterino
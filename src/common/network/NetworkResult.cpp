@@ -10,8 +10,9 @@
 namespace chatterino {
 
 NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                             QByteArray data)
+                             QByteArray data, QByteArray etag)
     : data_(std::move(data))
+    , etag_(std::move(etag))
     , error_(error)
 {
     if (httpStatusCode.isValid())
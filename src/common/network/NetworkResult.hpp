@@ -15,7 +15,7 @@ public:
     using NetworkError = QNetworkReply::NetworkError;
 
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                  QByteArray data);
+                  QByteArray data, QByteArray etag = {});
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -40,12 +40,19 @@ public:
         return this->status_;
     }
 
+    /// The `ETag` header of the response. Empty if there was none.
+    const QByteArray &etag() const
+    {
+        return this->etag_;
+    }
+
     /// Formats the error.
     /// If a reply is received, returns the HTTP status otherwise, the network error.
     QString formatError() const;
 
 private:
     QByteArray data_;
+    QByteArray etag_;
 
     NetworkError error_;
     std::optional<int> status_;
@@ -5,6 +5,7 @@
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
@@ -30,6 +31,8 @@ NetworkTask::~NetworkTask()
 
 void NetworkTask::run()
 {
+    this->traceStartNs_ = trace::now();
+
     const auto &timeout = this->data_->timeout;
     if (timeout.has_value())
     {
@@ -137,6 +140,9 @@ void NetworkTask::timeout()
                         &NetworkTask::finished);
     this->reply_->abort();
 
+    trace::recordSpan(trace::category::NETWORK, "timeout", this->traceStartNs_,
+                      trace::now());
+
     qCDebug(chatterinoHTTP).noquote()
         << this->data_->typeString() << "[timed out]"
         << this->data_->request.url().toString();
@@ -157,6 +163,13 @@ void NetworkTask::finished()
     auto *reply = this->reply_;
     auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
 
+    if (trace::isEnabled())
+    {
+        trace::recordSpan(trace::category::NETWORK,
+                          this->data_->request.url().host(),
+                          this->traceStartNs_, trace::now());
+    }
+
     if (reply->error() == QNetworkReply::OperationCanceledError)
     {
         // Operation cancelled, most likely timed out
@@ -184,7 +197,8 @@ void NetworkTask::finished()
 
     DebugCount::increase("http request success");
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
+    this->data_->emitSuccess(
+        {reply->error(), status, bytes, reply->rawHeader("ETag")});
     this->data_->emitFinally();
 }
 
@@ -41,6 +41,7 @@ private:
     std::shared_ptr<NetworkData> data_;
     QNetworkReply *reply_{};  // parent: default (accessManager)
     QTimer *timer_{};         // parent: this
+    int64_t traceStartNs_{};
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private slots:
@@ -3,6 +3,7 @@
 #include "Application.hpp"
 #include "common/Channel.hpp"
 #include "controllers/completion/sources/CommandSource.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "controllers/completion/sources/EmoteSource.hpp"
 #include "controllers/completion/sources/UnifiedSource.hpp"
 #include "controllers/completion/sources/UserSource.hpp"
@@ -20,9 +21,17 @@ namespace chatterino {
 TabCompletionModel::TabCompletionModel(Channel &channel, QObject *parent)
     : QStringListModel(parent)
     , channel_(channel)
+    , emoteIndex_(std::make_unique<completion::EmoteIndex>())
 {
 }
 
+TabCompletionModel::~TabCompletionModel() = default;
+
+completion::EmoteIndex &TabCompletionModel::emoteIndex()
+{
+    return *this->emoteIndex_;
+}
+
 void TabCompletionModel::updateResults(const QString &query,
                                        const QString &fullTextContent,
                                        int cursorPosition, bool isFirstWord)
@@ -6,12 +6,17 @@
 #include <QString>
 #include <QStringListModel>
 
+#include <memory>
 #include <optional>
 
 namespace chatterino {
 
 class Channel;
 
+namespace completion {
+    class EmoteIndex;
+}  // namespace completion
+
 /// @brief TabCompletionModel is a QStringListModel intended to provide tab
 /// completion to a ResizingTextInput. The model automatically selects a completion
 /// source based on the current query before updating the results.
@@ -23,6 +28,12 @@ public:
     /// @param channel Channel reference
     /// @param parent Model parent
     explicit TabCompletionModel(Channel &channel, QObject *parent);
+    ~TabCompletionModel() override;
+
+    TabCompletionModel(const TabCompletionModel &) = delete;
+    TabCompletionModel(TabCompletionModel &&) = delete;
+    TabCompletionModel &operator=(const TabCompletionModel &) = delete;
+    TabCompletionModel &operator=(TabCompletionModel &&) = delete;
 
     /// @brief Updates the model based on the completion query
     /// @param query Completion query
@@ -33,6 +44,11 @@ public:
     void updateResults(const QString &query, const QString &fullTextContent,
                        int cursorPosition, bool isFirstWord = false);
 
+    /// @brief The emotes that can be completed in the bound channel.
+    /// The index is kept between completions and only updated for emote sets
+    /// that changed (see completion::EmoteSource).
+    completion::EmoteIndex &emoteIndex();
+
 private:
     enum class SourceKind {
         // Known to be an emote, i.e. started with :
@@ -68,6 +84,7 @@ private:
 
     Channel &channel_;
     std::unique_ptr<completion::Source> source_{};
+    std::unique_ptr<completion::EmoteIndex> emoteIndex_;
 };
 
 }  // namespace chatterino
@@ -0,0 +1,144 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "messages/Emote.hpp"
+#include "providers/emoji/Emojis.hpp"
+
+#include <algorithm>
+
+namespace chatterino::completion {
+
+void EmoteIndex::update(const std::vector<Segment> &segments,
+                        const std::vector<EmojiPtr> &emojis)
+{
+    std::vector<IndexedSegment> updated;
+    updated.reserve(segments.size());
+
+    for (const auto &segment : segments)
+    {
+        if (!segment.emotes)
+        {
+            continue;
+        }
+
+        // Reuse the ids if this exact map was indexed before
+        auto old = std::find_if(
+            this->segments_.begin(), this->segments_.end(),
+            [&](const IndexedSegment &indexed) {
+                return indexed.emotes == segment.emotes &&
+                       indexed.providerName == segment.providerName;
+            });
+        if (old != this->segments_.end())
+        {
+            updated.emplace_back(std::move(*old));
+            this->segments_.erase(old);
+            continue;
+        }
+
+        IndexedSegment indexed{
+            .providerName = segment.providerName,
+            .emotes = segment.emotes,
+            .ids = {},
+        };
+        indexed.ids.reserve(segment.emotes->size());
+        for (const auto &[name, emote] : *segment.emotes)
+        {
+            indexed.ids.push_back(this->add({
+                .emote = emote,
+                .searchName = name.string,
+                .tabCompletionName = name.string,
+                .displayName = emote->name.string,
+                .providerName = segment.providerName,
+                .isEmoji = false,
+            }));
+        }
+        updated.emplace_back(std::move(indexed));
+    }
+
+    // Everything that's left was replaced or removed
+    for (const auto &segment : this->segments_)
+    {
+        this->removeAll(segment.ids);
+    }
+    this->segments_ = std::move(updated);
+
+    // The emojis are loaded once on startup
+    if (this->emojiSource_ != emojis.data() ||
+        this->emojiCount_ != emojis.size())
+    {
+        this->removeAll(this->emojiIds_);
+        this->emojiIds_.clear();
+        for (const auto &emoji : emojis)
+        {
+            for (const auto &shortCode : emoji->shortCodes)
+            {
+                this->emojiIds_.push_back(this->add({
+                    .emote = emoji->emote,
+                    .searchName = shortCode,
+                    .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
+                    .displayName = shortCode,
+                    .providerName = "Emoji",
+                    .isEmoji = true,
+                }));
+            }
+        }
+        this->emojiSource_ = emojis.data();
+        this->emojiCount_ = emojis.size();
+    }
+
+    // Keep the results in the order of the segments
+    uint64_t order = 0;
+    for (const auto &segment : this->segments_)
+    {
+        for (auto id : segment.ids)
+        {
+            this->items_[id].order = order++;
+        }
+    }
+    for (auto id : this->emojiIds_)
+    {
+        this->items_[id].order = order++;
+    }
+}
+
+std::vector<EmoteItem> EmoteIndex::findContaining(QStringView query) const
+{
+    auto ids = this->index_.findSubstring(query);
+    std::sort(ids.begin(), ids.end(), [this](auto a, auto b) {
+        return this->items_[a].order < this->items_[b].order;
+    });
+
+    std::vector<EmoteItem> result;
+    result.reserve(ids.size());
+    for (auto id : ids)
+    {
+        result.push_back(this->items_[id].item);
+    }
+    return result;
+}
+
+size_t EmoteIndex::size() const
+{
+    return this->index_.size();
+}
+
+NgramIndex::Id EmoteIndex::add(EmoteItem item)
+{
+    auto id = this->index_.insert(item.searchName);
+    if (this->items_.size() <= id)
+    {
+        this->items_.resize(id + 1);
+    }
+    this->items_[id].item = std::move(item);
+    return id;
+}
+
+void EmoteIndex::removeAll(const std::vector<NgramIndex::Id> &ids)
+{
+    for (auto id : ids)
+    {
+        this->index_.remove(id);
+        this->items_[id] = {};
+    }
+}
+
+}  // namespace chatterino::completion
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "controllers/completion/sources/EmoteSource.hpp"
+#include "util/NgramIndex.hpp"
+
+#include <QString>
+#include <QStringView>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class EmoteMap;
+struct EmojiData;
+using EmojiPtr = std::shared_ptr<EmojiData>;
+
+}  // namespace chatterino
+
+namespace chatterino::completion {
+
+/// An index of all emotes that can be completed in a channel.
+///
+/// The index is kept between completions (see TabCompletionModel). Emote maps
+/// are replaced as a whole when they change, so they're indexed per map and
+/// only maps that were replaced since the last update are re-indexed.
+class EmoteIndex
+{
+public:
+    struct Segment {
+        QString providerName;
+        std::shared_ptr<const EmoteMap> emotes;
+    };
+
+    /// Makes the index contain the emotes of `segments` (in that order)
+    /// followed by `emojis`.
+    void update(const std::vector<Segment> &segments,
+                const std::vector<EmojiPtr> &emojis);
+
+    /// Items whose search name contains `query` (case-insensitive) in the
+    /// order of the segments.
+    std::vector<EmoteItem> findContaining(QStringView query) const;
+
+    /// Number of indexed items
+    size_t size() const;
+
+private:
+    struct IndexedSegment {
+        QString providerName;
+        std::shared_ptr<const EmoteMap> emotes;
+        std::vector<NgramIndex::Id> ids;
+    };
+
+    struct IndexedItem {
+        EmoteItem item;
+        /// Position of the item in the results (segment order)
+        uint64_t order = 0;
+    };
+
+    NgramIndex::Id add(EmoteItem item);
+    void removeAll(const std::vector<NgramIndex::Id> &ids);
+
+    NgramIndex index_;
+    // id in index_ -> item
+    std::vector<IndexedItem> items_;
+
+    std::vector<IndexedSegment> segments_;
+
+    const EmojiPtr *emojiSource_ = nullptr;
+    size_t emojiCount_ = 0;
+    std::vector<NgramIndex::Id> emojiIds_;
+};
+
+}  // namespace chatterino::completion
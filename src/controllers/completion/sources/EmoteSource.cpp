@@ -2,7 +2,9 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "controllers/completion/sources/Helpers.hpp"
+#include "controllers/completion/TabCompletionModel.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/emoji/Emojis.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
@@ -15,42 +17,6 @@
 
 namespace chatterino::completion {
 
-namespace {
-
-    void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
-                   const QString &providerName)
-    {
-        for (auto &&emote : map)
-        {
-            out.push_back({.emote = emote.second,
-                           .searchName = emote.first.string,
-                           .tabCompletionName = emote.first.string,
-                           .displayName = emote.second->name.string,
-                           .providerName = providerName,
-                           .isEmoji = false});
-        }
-    }
-
-    void addEmojis(std::vector<EmoteItem> &out,
-                   const std::vector<EmojiPtr> &map)
-    {
-        for (const auto &emoji : map)
-        {
-            for (auto &&shortCode : emoji->shortCodes)
-            {
-                out.push_back(
-                    {.emote = emoji->emote,
-                     .searchName = shortCode,
-                     .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
-                     .displayName = shortCode,
-                     .providerName = "Emoji",
-                     .isEmoji = true});
-            }
-        };
-    }
-
-}  // namespace
-
 EmoteSource::EmoteSource(const Channel *channel,
                          std::unique_ptr<EmoteStrategy> strategy,
                          ActionCallback callback)
@@ -63,9 +29,17 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
-    if (this->strategy_)
+    if (this->strategy_ && this->index_)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        // All strategies only output emotes that contain the query (without
+        // the leading colon), so only those are passed to the strategy.
+        QStringView normalizedQuery = query;
+        if (normalizedQuery.startsWith(':'))
+        {
+            normalizedQuery = normalizedQuery.mid(1);
+        }
+        this->strategy_->apply(this->index_->findContaining(normalizedQuery),
+                               this->output_, query);
     }
 }
 
@@ -91,60 +65,44 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getApp();
 
-    std::vector<EmoteItem> emotes;
+    std::vector<EmoteIndex::Segment> segments;
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
     {
         if (tc)
         {
-            if (auto twitch = tc->localTwitchEmotes())
-            {
-                addEmotes(emotes, *twitch, "Local Twitch Emotes");
-            }
+            segments.push_back(
+                {"Local Twitch Emotes", tc->localTwitchEmotes()});
 
             auto user = getApp()->getAccounts()->twitch.getCurrent();
-            addEmotes(emotes, **user->accessEmotes(), "Twitch Emote");
+            segments.push_back({"Twitch Emote", *user->accessEmotes()});
 
             for (const auto &map :
                  app->getSeventvPersonalEmotes()->getEmoteSetsForUser(
                      app->getAccounts()->twitch.getCurrent()->getUserId()))
             {
-                addEmotes(emotes, *map, "Personal 7TV");
+                segments.push_back({"Personal 7TV", map});
             }
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
-            if (auto bttv = tc->bttvEmotes())
-            {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
-            }
-            if (auto ffz = tc->ffzEmotes())
-            {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
-            }
-            if (auto seventv = tc->seventvEmotes())
-            {
-                addEmotes(emotes, *seventv, "Channel 7TV");
-            }
+            segments.push_back({"Channel BetterTTV", tc->bttvEmotes()});
+            segments.push_back({"Channel FrankerFaceZ", tc->ffzEmotes()});
+            segments.push_back({"Channel 7TV", tc->seventvEmotes()});
         }
 
-        if (auto bttvG = app->getBttvEmotes()->emotes())
-        {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
-        }
-        if (auto ffzG = app->getFfzEmotes()->emotes())
-        {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
-        }
-        if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
-        {
-            addEmotes(emotes, *seventvG, "Global 7TV");
-        }
+        segments.push_back({"Global BetterTTV", app->getBttvEmotes()->emotes()});
+        segments.push_back(
+            {"Global FrankerFaceZ", app->getFfzEmotes()->emotes()});
+        segments.push_back(
+            {"Global 7TV", app->getSeventvEmotes()->globalEmotes()});
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
-
-    this->items_ = std::move(emotes);
+    // The index is shared by all completions in this channel. Only emote maps
+    // that changed since the last completion are indexed again.
+    this->index_ = &channel->completionModel->emoteIndex();
+    this->index_->update(segments,
+                         app->getEmotes()->getEmojis()->getEmojis());
 }
 
 const std::vector<EmoteItem> &EmoteSource::output() const
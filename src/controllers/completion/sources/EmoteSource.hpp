@@ -13,6 +13,8 @@
 
 namespace chatterino::completion {
 
+class EmoteIndex;
+
 struct EmoteItem {
     /// Emote image to show in input popup
     EmotePtr emote{};
@@ -56,7 +58,7 @@ private:
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
-    std::vector<EmoteItem> items_{};
+    EmoteIndex *index_{};
     std::vector<EmoteItem> output_{};
 };
 
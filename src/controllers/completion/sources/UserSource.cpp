@@ -14,7 +14,10 @@ UserSource::UserSource(const Channel *channel,
     , callback_(std::move(callback))
     , prependAt_(prependAt)
 {
-    this->initializeFromChannel(channel);
+    if (channel != nullptr)
+    {
+        this->channel_ = channel->weak_from_this();
+    }
 }
 
 void UserSource::update(const QString &query)
@@ -22,10 +25,47 @@ void UserSource::update(const QString &query)
     this->output_.clear();
     if (this->strategy_)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        this->strategy_->apply(this->candidatesFor(query), this->output_,
+                               query);
     }
 }
 
+std::vector<UserItem> UserSource::candidatesFor(const QString &query) const
+{
+    auto channel = this->channel_.lock();
+    const auto *tc = dynamic_cast<const TwitchChannel *>(channel.get());
+    if (!tc)
+    {
+        return {};
+    }
+
+    // The user strategies only output users whose name contains the query
+    // (without the leading @), so the chatters are filtered through their
+    // index instead of copying all of them.
+    QStringView normalizedQuery = query;
+    if (normalizedQuery.startsWith('@'))
+    {
+        normalizedQuery = normalizedQuery.mid(1);
+    }
+    auto items = tc->accessChatters()->filterBySubstring(normalizedQuery);
+
+    if (getSettings()->alwaysIncludeBroadcasterInUserCompletions &&
+        tc->getName().contains(normalizedQuery, Qt::CaseInsensitive))
+    {
+        auto it = std::find_if(items.begin(), items.end(),
+                               [tc](const UserItem &user) {
+                                   return user.first == tc->getName();
+                               });
+
+        if (it == items.end())
+        {
+            items.emplace_back(tc->getName(), tc->getDisplayName());
+        }
+    }
+
+    return items;
+}
+
 void UserSource::addToListModel(GenericListModel &model, size_t maxCount) const
 {
     addVecToListModel(this->output_, model, maxCount,
@@ -50,30 +90,6 @@ void UserSource::addToStringList(QStringList &list, size_t maxCount,
                        });
 }
 
-void UserSource::initializeFromChannel(const Channel *channel)
-{
-    const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
-    if (!tc)
-    {
-        return;
-    }
-
-    this->items_ = tc->accessChatters()->all();
-
-    if (getSettings()->alwaysIncludeBroadcasterInUserCompletions)
-    {
-        auto it = std::find_if(this->items_.begin(), this->items_.end(),
-                               [tc](const UserItem &user) {
-                                   return user.first == tc->getName();
-                               });
-
-        if (it == this->items_.end())
-        {
-            this->items_.emplace_back(tc->getName(), tc->getDisplayName());
-        }
-    }
-}
-
 const std::vector<UserItem> &UserSource::output() const
 {
     return this->output_;
@@ -40,13 +40,14 @@ public:
     const std::vector<UserItem> &output() const;
 
 private:
-    void initializeFromChannel(const Channel *channel);
+    /// Chatters of the channel that can match `query`
+    std::vector<UserItem> candidatesFor(const QString &query) const;
 
+    std::weak_ptr<const Channel> channel_;
     std::unique_ptr<UserStrategy> strategy_;
     ActionCallback callback_;
     bool prependAt_;
 
-    std::vector<UserItem> items_{};
     std::vector<UserItem> output_{};
 };
 
@@ -17,6 +17,10 @@ public:
 
     /// @brief Applies the strategy, taking the input items and storing the
     /// appropriate output items in the desired order.
+    ///
+    /// Sources use indices to only pass items whose search name contains the
+    /// query (ignoring a leading ':' or '@'). Strategies must not output other
+    /// items.
     /// @param items Input items to consider
     /// @param output Output vector for items
     /// @param query Completion query
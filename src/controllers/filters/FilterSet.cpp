@@ -1,6 +1,7 @@
 #include "controllers/filters/FilterSet.hpp"
 
 #include "controllers/filters/FilterRecord.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/Settings.hpp"
 
 namespace chatterino {
@@ -42,6 +43,8 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
+    trace::Span span(trace::category::FILTER, "FilterSet::filter");
+
     filters::ContextMap context = filters::buildContextMap(m, channel.get());
     for (const auto &f : this->filters_.values())
     {
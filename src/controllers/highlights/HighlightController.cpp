@@ -5,6 +5,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightBadge.hpp"
 #include "controllers/highlights/HighlightPhrase.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/colors/ColorProvider.hpp"
@@ -546,6 +547,8 @@ std::pair<bool, HighlightResult> HighlightController::check(
     const QString &senderName, const QString &originalMessage,
     const MessageFlags &messageFlags) const
 {
+    trace::Span span(trace::category::HIGHLIGHT, "HighlightController::check");
+
     bool highlighted = false;
     auto result = HighlightResult::emptyResult();
 
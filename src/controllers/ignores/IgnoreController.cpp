@@ -5,6 +5,7 @@
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnoreRules.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "singletons/Settings.hpp"
@@ -135,17 +136,13 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
 {
     if (!params.message.isEmpty())
     {
-        // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getSettings()->ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        auto rules = getSettings()->ignoreRules();
+        if (const auto *phrase = rules->findBlock(params.message))
         {
-            if (phrase.isBlock() && phrase.isMatch(params.message))
-            {
-                qCDebug(chatterinoMessage)
-                    << "Blocking message because it contains ignored phrase"
-                    << phrase.getPattern();
-                return true;
-            }
+            qCDebug(chatterinoMessage)
+                << "Blocking message because it contains ignored phrase"
+                << phrase->getPattern();
+            return true;
         }
     }
 
@@ -0,0 +1,90 @@
+#include "controllers/ignores/IgnoreRules.hpp"
+
+namespace chatterino {
+
+IgnoreRules::IgnoreRules(const std::vector<IgnorePhrase> &phrases)
+{
+    std::vector<QString> caseSensitive;
+    std::vector<QString> caseInsensitive;
+
+    for (const auto &phrase : phrases)
+    {
+        if (phrase.getPattern().isEmpty() ||
+            (phrase.isRegex() && !phrase.isRegexValid()))
+        {
+            continue;
+        }
+
+        if (phrase.isRegex())
+        {
+            phrase.getRegex().optimize();
+        }
+
+        if (!phrase.isBlock())
+        {
+            this->replacePhrases_.push_back(phrase);
+            continue;
+        }
+
+        if (phrase.isRegex())
+        {
+            this->regexBlocks_.push_back(phrase);
+            continue;
+        }
+
+        auto index = this->literalBlocks_.size();
+        this->literalBlocks_.push_back(phrase);
+        if (phrase.isCaseSensitive())
+        {
+            caseSensitive.push_back(phrase.getPattern());
+            this->caseSensitiveIndices_.push_back(index);
+        }
+        else
+        {
+            caseInsensitive.push_back(phrase.getPattern().toCaseFolded());
+            this->caseInsensitiveIndices_.push_back(index);
+        }
+    }
+
+    this->caseSensitive_ = AhoCorasick(caseSensitive);
+    this->caseInsensitive_ = AhoCorasick(caseInsensitive);
+}
+
+const IgnorePhrase *IgnoreRules::findBlock(const QString &message) const
+{
+    if (message.isEmpty())
+    {
+        return nullptr;
+    }
+
+    if (auto found = this->caseSensitive_.findAny(message))
+    {
+        return &this->literalBlocks_[this->caseSensitiveIndices_[*found]];
+    }
+
+    if (!this->caseInsensitive_.empty())
+    {
+        if (auto found =
+                this->caseInsensitive_.findAny(message.toCaseFolded()))
+        {
+            return &this->literalBlocks_[this->caseInsensitiveIndices_[*found]];
+        }
+    }
+
+    for (const auto &phrase : this->regexBlocks_)
+    {
+        if (phrase.getRegex().match(message).hasMatch())
+        {
+            return &phrase;
+        }
+    }
+
+    return nullptr;
+}
+
+const std::vector<IgnorePhrase> &IgnoreRules::replacePhrases() const
+{
+    return this->replacePhrases_;
+}
+
+}  // namespace chatterino
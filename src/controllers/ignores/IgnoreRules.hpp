@@ -0,0 +1,46 @@
+#pragma once
+
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "util/AhoCorasick.hpp"
+
+#include <QString>
+
+#include <vector>
+
+namespace chatterino {
+
+/// The ignore phrases compiled for matching many messages.
+///
+/// Literal block phrases are combined into one automaton per case
+/// sensitivity, so checking a message doesn't get slower with the number of
+/// phrases. Regular expressions are optimized when the rules are built.
+/// Phrases with an empty pattern or an invalid regular expression are left
+/// out.
+class IgnoreRules
+{
+public:
+    IgnoreRules() = default;
+    explicit IgnoreRules(const std::vector<IgnorePhrase> &phrases);
+
+    /// Returns a block phrase matching `message` or nullptr if the message
+    /// isn't blocked
+    const IgnorePhrase *findBlock(const QString &message) const;
+
+    /// The replace phrases in the order they're applied
+    /// (see processIgnorePhrases)
+    const std::vector<IgnorePhrase> &replacePhrases() const;
+
+private:
+    std::vector<IgnorePhrase> literalBlocks_;
+    /// Indices into literalBlocks_
+    std::vector<size_t> caseSensitiveIndices_;
+    std::vector<size_t> caseInsensitiveIndices_;
+    AhoCorasick caseSensitive_;
+    /// Matches case folded messages
+    AhoCorasick caseInsensitive_;
+
+    std::vector<IgnorePhrase> regexBlocks_;
+    std::vector<IgnorePhrase> replacePhrases_;
+};
+
+}  // namespace chatterino
@@ -59,6 +59,12 @@ public:
         return this->isCaseSensitive_;
     }
 
+    /// The compiled name if this is a regex nickname
+    [[nodiscard]] const QRegularExpression &regex() const
+    {
+        return this->regex_;
+    }
+
     [[nodiscard]] std::optional<QString> match(
         const QString &usernameText) const
     {
@@ -0,0 +1,77 @@
+#include "controllers/nicknames/NicknameRules.hpp"
+
+namespace chatterino {
+
+NicknameRules::NicknameRules(const std::vector<Nickname> &nicknames)
+{
+    for (size_t i = 0; i < nicknames.size(); i++)
+    {
+        const auto &nickname = nicknames[i];
+        if (nickname.isRegex())
+        {
+            if (nickname.name().isEmpty() || !nickname.regex().isValid())
+            {
+                continue;
+            }
+            nickname.regex().optimize();
+            this->regexes_.push_back({.index = i, .nickname = nickname});
+            continue;
+        }
+
+        // Earlier nicknames win, so existing entries are kept
+        if (nickname.isCaseSensitive())
+        {
+            this->caseSensitive_.try_emplace(
+                nickname.name(),
+                Exact{.index = i, .replace = nickname.replace()});
+        }
+        else
+        {
+            this->caseInsensitive_.try_emplace(
+                nickname.name().toCaseFolded(),
+                Exact{.index = i, .replace = nickname.replace()});
+        }
+    }
+}
+
+std::optional<QString> NicknameRules::match(const QString &username) const
+{
+    const Exact *exact = nullptr;
+
+    auto sensitive = this->caseSensitive_.find(username);
+    if (sensitive != this->caseSensitive_.end())
+    {
+        exact = &sensitive->second;
+    }
+
+    if (!this->caseInsensitive_.empty())
+    {
+        auto insensitive =
+            this->caseInsensitive_.find(username.toCaseFolded());
+        if (insensitive != this->caseInsensitive_.end() &&
+            (!exact || insensitive->second.index < exact->index))
+        {
+            exact = &insensitive->second;
+        }
+    }
+
+    for (const auto &regex : this->regexes_)
+    {
+        if (exact && regex.index > exact->index)
+        {
+            break;
+        }
+        if (auto replaced = regex.nickname.match(username))
+        {
+            return replaced;
+        }
+    }
+
+    if (exact)
+    {
+        return exact->replace;
+    }
+    return std::nullopt;
+}
+
+}  // namespace chatterino
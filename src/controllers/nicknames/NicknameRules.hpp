@@ -0,0 +1,47 @@
+#pragma once
+
+#include "controllers/nicknames/Nickname.hpp"
+
+#include <QString>
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+/// The nicknames compiled for matching many user names.
+///
+/// Exact names are looked up in hash maps. Only the regex nicknames that come
+/// before a matching exact name are tried, so the first matching nickname in
+/// the list wins like in a linear scan. Regular expressions are optimized
+/// when the rules are built.
+class NicknameRules
+{
+public:
+    NicknameRules() = default;
+    explicit NicknameRules(const std::vector<Nickname> &nicknames);
+
+    /// Returns the replacement of the first nickname matching `username`
+    std::optional<QString> match(const QString &username) const;
+
+private:
+    struct Exact {
+        /// Index of the nickname in the list
+        size_t index = 0;
+        QString replace;
+    };
+
+    std::unordered_map<QString, Exact> caseSensitive_;
+    /// Keyed by the case folded name
+    std::unordered_map<QString, Exact> caseInsensitive_;
+
+    struct Regex {
+        size_t index = 0;
+        Nickname nickname;
+    };
+    /// Sorted by their index
+    std::vector<Regex> regexes_;
+};
+
+}  // namespace chatterino
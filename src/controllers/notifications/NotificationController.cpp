@@ -166,6 +166,7 @@ void NotificationController::notifyTwitchChannelOffline(const QString &id) const
         if (s->id == id)
         {
             s->flags.set(MessageFlag::Disabled);
+            s->invalidateLayouts();
             break;
         }
     }
@@ -4,6 +4,7 @@
 #    include "Application.hpp"
 #    include "common/QLogging.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
+#    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/SolTypes.hpp"  // for lua operations on QString{,List} for CompletionList
 
@@ -91,9 +92,18 @@ sol::table toTable(lua_State *L, const CompletionEvent &ev)
 }
 
 void c2_register_callback(ThisPluginState L, EventType evtType,
-                          sol::protected_function callback)
+                          sol::protected_function callback,
+                          sol::optional<sol::table> filter)
 {
-    L.plugin()->callbacks[evtType] = std::move(callback);
+    if (filter && evtType != EventType::MessagesAdded)
+    {
+        throw std::runtime_error(
+            "c2.register_callback only accepts a filter for "
+            "c2.EventType.MessagesAdded");
+    }
+    L.plugin()->registerCallback(
+        evtType, std::move(callback),
+        filter ? MessageFilter(*filter) : MessageFilter());
 }
 
 void c2_log(ThisPluginState L, LogLevel lvl, sol::variadic_args args)
@@ -131,6 +141,13 @@ void c2_later(ThisPluginState L, sol::protected_function callback, int time)
         [pl = L.plugin(), name, timer, cb, thread, main]() {
             timer->deleteLater();
             pl->removeTimeout(timer);
+            if (!pl->isRunnable())
+            {
+                main.registry()[name.toStdString()] = sol::nil;
+                return;
+            }
+
+            Plugin::CallGuard call(pl);
             sol::protected_function_result res = cb();
 
             if (res.return_count() != 0)
@@ -2,6 +2,7 @@
 
 #ifdef CHATTERINO_HAVE_PLUGINS
 #    include "controllers/plugins/api/ChannelRef.hpp"
+#    include "controllers/plugins/api/MessageView.hpp"
 #    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/SolTypes.hpp"
 
@@ -80,12 +81,18 @@ struct CompletionEvent {
 
 sol::table toTable(lua_State *L, const CompletionEvent &ev);
 
+/**
+ * @lua@class MessagesAddedEvent
+ * @lua@field messages c2.Message[] The messages added since the last event, oldest first
+ */
+
 /**
  * @includefile common/Channel.hpp
  * @includefile controllers/plugins/api/ChannelRef.hpp
  * @includefile controllers/plugins/api/HTTPResponse.hpp
  * @includefile controllers/plugins/api/HTTPRequest.hpp
  * @includefile common/network/NetworkCommon.hpp
+ * @includefile controllers/plugins/api/MessageView.hpp
  */
 
 /**
@@ -98,14 +105,18 @@ sol::table toTable(lua_State *L, const CompletionEvent &ev);
  */
 
 /**
- * Registers a callback to be invoked when completions for a term are requested.
+ * Registers a callback to be invoked when an event happens.
+ * `CompletionRequested` callbacks are invoked when completions for a term are requested.
+ * `MessagesAdded` callbacks are invoked at most once per event loop iteration with the messages added to channels since the last invocation. Only messages matching `filter` are delivered.
  *
- * @lua@param type c2.EventType.CompletionRequested
- * @lua@param func fun(event: CompletionEvent): CompletionList The callback to be invoked.
+ * @lua@param type c2.EventType
+ * @lua@param func (fun(event: CompletionEvent): CompletionList)|fun(event: MessagesAddedEvent) The callback to be invoked.
+ * @lua@param filter? MessageFilter Filter for `MessagesAdded`. It's evaluated before any Lua code runs.
  * @exposed c2.register_callback
  */
 void c2_register_callback(ThisPluginState L, EventType evtType,
-                          sol::protected_function callback);
+                          sol::protected_function callback,
+                          sol::optional<sol::table> filter);
 
 /**
  * Writes a message to the Chatterino log.
@@ -4,21 +4,34 @@
 #    include "common/network/NetworkCommon.hpp"
 #    include "common/QLogging.hpp"
 #    include "controllers/commands/CommandController.hpp"
+#    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/PluginPermission.hpp"
+#    include "util/PostToThread.hpp"
 #    include "util/QMagicEnum.hpp"
 
+#    include <lauxlib.h>
 #    include <lua.h>
 #    include <magic_enum/magic_enum.hpp>
 #    include <QJsonArray>
 #    include <QJsonObject>
 #    include <QLoggingCategory>
+#    include <QThread>
 #    include <QUrl>
 #    include <sol/sol.hpp>
 
 #    include <algorithm>
+#    include <cassert>
+#    include <memory>
 #    include <unordered_map>
 #    include <unordered_set>
 
+namespace {
+
+/// The watchdog hook runs every this many instructions
+constexpr int INSTRUCTION_STEP = 1000;
+
+}  // namespace
+
 namespace chatterino {
 
 PluginMeta::PluginMeta(const QJsonObject &obj)
@@ -160,6 +173,19 @@ PluginMeta::PluginMeta(const QJsonObject &obj)
         }
     }
 
+    auto workerObj = obj.value("worker");
+    if (workerObj.isBool())
+    {
+        this->worker = workerObj.toBool();
+    }
+    else if (!workerObj.isUndefined())
+    {
+        auto type = qmagicenum::enumName(workerObj.type());
+        this->errors.emplace_back(
+            QString("worker is defined but is not a boolean (its type is %1)")
+                .arg(type));
+    }
+
     auto tagsObj = obj.value("tags");
     if (!tagsObj.isUndefined())
     {
@@ -192,22 +218,69 @@ PluginMeta::PluginMeta(const QJsonObject &obj)
 bool Plugin::registerCommand(const QString &name,
                              sol::protected_function function)
 {
-    if (this->ownedCommands.find(name) != this->ownedCommands.end())
+    if (this->hasCommand(name))
     {
         return false;
     }
 
+    if (this->isWorker())
+    {
+        // Commands are registered on the GUI thread. Waiting for it here
+        // could dead-lock with the GUI thread stopping the worker, so the
+        // command is assumed to be free.
+        {
+            std::lock_guard lock(this->mutex_);
+            this->ownedCommands.emplace(name, std::move(function));
+        }
+        postToThread([self = this, id = this->id, name] {
+            const auto &plugins = getApp()->getPlugins()->plugins();
+            auto it = plugins.find(id);
+            if (it == plugins.end() || it->second.get() != self)
+            {
+                // the plugin was unloaded in the meantime
+                return;
+            }
+            if (getApp()->getCommands()->registerPluginCommand(name))
+            {
+                return;
+            }
+            qCWarning(chatterinoLua)
+                << "Plugin" << id << "can't register the command" << name
+                << "because the name is already taken";
+
+            // The name belongs to someone else. It must not be owned by this
+            // plugin, or reloading it would unregister the other command.
+            std::shared_ptr<sol::protected_function> function;
+            {
+                std::lock_guard lock(self->mutex_);
+                auto node = self->ownedCommands.extract(name);
+                if (!node.empty())
+                {
+                    function = std::make_shared<sol::protected_function>(
+                        std::move(node.mapped()));
+                }
+            }
+            // The function has to be released on the plugin's thread
+            self->invoke([function = std::move(function)]() mutable {
+                function.reset();
+            });
+        });
+        return true;
+    }
+
     auto ok = getApp()->getCommands()->registerPluginCommand(name);
     if (!ok)
     {
         return false;
     }
+    std::lock_guard lock(this->mutex_);
     this->ownedCommands.emplace(name, std::move(function));
     return true;
 }
 
-std::unordered_set<QString> Plugin::listRegisteredCommands()
+std::unordered_set<QString> Plugin::listRegisteredCommands() const
 {
+    std::lock_guard lock(this->mutex_);
     std::unordered_set<QString> out;
     for (const auto &[name, _] : this->ownedCommands)
     {
@@ -216,12 +289,122 @@ std::unordered_set<QString> Plugin::listRegisteredCommands()
     return out;
 }
 
+bool Plugin::hasCommand(const QString &name) const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->ownedCommands.contains(name);
+}
+
+std::optional<sol::protected_function> Plugin::getCommand(const QString &name)
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->ownedCommands.find(name);
+    if (it == this->ownedCommands.end())
+    {
+        return {};
+    }
+    return it->second;
+}
+
+void Plugin::registerCallback(lua::api::EventType type,
+                              sol::protected_function function,
+                              lua::api::MessageFilter filter)
+{
+    std::lock_guard lock(this->mutex_);
+    if (type == lua::api::EventType::MessagesAdded)
+    {
+        this->messageFilter = std::move(filter);
+    }
+    this->callbacks[type] = std::move(function);
+}
+
+std::optional<sol::protected_function> Plugin::getCallback(
+    lua::api::EventType type)
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->callbacks.find(type);
+    if (it == this->callbacks.end())
+    {
+        return {};
+    }
+    return it->second;
+}
+
+bool Plugin::observes(const QString &channelName, const Message &message) const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->state_ != nullptr && this->error_.isNull() &&
+           this->callbacks.contains(lua::api::EventType::MessagesAdded) &&
+           this->messageFilter.matches(channelName, message);
+}
+
+void Plugin::invoke(std::function<void()> fn)
+{
+    if (!this->isWorker())
+    {
+        fn();
+        return;
+    }
+    QMetaObject::invokeMethod(this->workerContext_.get(), std::move(fn),
+                              Qt::QueuedConnection);
+}
+
+void Plugin::startWorker()
+{
+    assert(!this->workerThread_);
+    this->workerThread_ = std::make_unique<QThread>();
+    this->workerThread_->setObjectName("Plugin " + this->id);
+    this->workerContext_ = std::make_unique<QObject>();
+    this->workerContext_->moveToThread(this->workerThread_.get());
+    this->workerThread_->start();
+}
+
+QString Plugin::error() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->error_;
+}
+
+void Plugin::setError(QString error)
+{
+    std::lock_guard lock(this->mutex_);
+    this->error_ = std::move(error);
+}
+
+bool Plugin::isRunnable() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->state_ != nullptr && this->error_.isNull();
+}
+
+Plugin::Usage Plugin::usage() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->usage_;
+}
+
 Plugin::~Plugin()
 {
+    if (this->workerThread_)
+    {
+        // Lua code that's running is stopped by the watchdog at the latest
+        this->workerThread_->quit();
+        this->workerThread_->wait();
+        this->workerContext_.reset();
+    }
+
     for (auto *timer : this->activeTimeouts)
     {
         QObject::disconnect(timer, nullptr, nullptr, nullptr);
-        timer->deleteLater();
+        if (this->workerThread_)
+        {
+            // the thread of the timer doesn't process events anymore
+            delete timer;
+        }
+        else
+        {
+            timer->deleteLater();
+        }
     }
     this->httpRequests.clear();
     qCDebug(chatterinoLua) << "Destroyed" << this->activeTimeouts.size()
@@ -261,6 +444,92 @@ void Plugin::removeTimeout(QTimer *timer)
     }
 }
 
+Plugin::CallGuard::CallGuard(Plugin *plugin)
+    : plugin_(plugin)
+{
+    if (this->plugin_->callDepth_++ == 0)
+    {
+        this->plugin_->instructionsUsed_ = 0;
+        this->plugin_->exceededBudget_ = false;
+        this->plugin_->callStart_ = std::chrono::steady_clock::now();
+    }
+}
+
+Plugin::CallGuard::~CallGuard()
+{
+    auto *pl = this->plugin_;
+    if (--pl->callDepth_ != 0)
+    {
+        return;
+    }
+
+    std::lock_guard lock(pl->mutex_);
+    pl->usage_.time += std::chrono::steady_clock::now() - pl->callStart_;
+    pl->usage_.calls++;
+    if (!pl->exceededBudget_)
+    {
+        return;
+    }
+
+    pl->usage_.overBudget++;
+    qCWarning(chatterinoLua).nospace()
+        << "Plugin " << pl->id << " (" << pl->meta.name
+        << ") exceeded its instruction budget ("
+        << pl->usage_.overBudget << "/" << MAX_BUDGET_VIOLATIONS << ")";
+    if (pl->usage_.overBudget >= MAX_BUDGET_VIOLATIONS && pl->error_.isNull())
+    {
+        pl->error_ = QString("Disabled because it exceeded its instruction "
+                             "budget %1 times. Reload it to enable it again.")
+                         .arg(pl->usage_.overBudget);
+    }
+}
+
+void Plugin::installWatchdog()
+{
+    // Threads created from this state copy its extra space and hook
+    *static_cast<Plugin **>(lua_getextraspace(this->state_)) = this;
+    lua_sethook(this->state_, &Plugin::watchdogHook, LUA_MASKCOUNT,
+                INSTRUCTION_STEP);
+}
+
+void Plugin::watchdogHook(lua_State *L, lua_Debug * /*ar*/)
+{
+    auto *pl = *static_cast<Plugin **>(lua_getextraspace(L));
+    auto count = lua_gethookcount(L);
+
+    if (pl == nullptr || pl->callDepth_ == 0)
+    {
+        // Code run outside of an invocation (e.g. finalizers) isn't limited
+        if (count != INSTRUCTION_STEP)
+        {
+            lua_sethook(L, &Plugin::watchdogHook, LUA_MASKCOUNT,
+                        INSTRUCTION_STEP);
+        }
+        return;
+    }
+
+    pl->instructionsUsed_ += static_cast<size_t>(count);
+    if (pl->instructionsUsed_ <= INSTRUCTION_BUDGET)
+    {
+        if (count != INSTRUCTION_STEP)
+        {
+            lua_sethook(L, &Plugin::watchdogHook, LUA_MASKCOUNT,
+                        INSTRUCTION_STEP);
+        }
+        return;
+    }
+
+    pl->exceededBudget_ = true;
+    // Fail on every instruction from now on, so the error can't be caught
+    // with pcall to keep going
+    if (count != 1)
+    {
+        lua_sethook(L, &Plugin::watchdogHook, LUA_MASKCOUNT, 1);
+    }
+    luaL_error(L, "instruction budget of %d exceeded",
+               static_cast<int>(INSTRUCTION_BUDGET));
+}
+
 bool Plugin::hasFSPermissionFor(bool write, const QString &path)
 {
     auto canon = QUrl(this->dataDirectory().absolutePath() + "/");
@@ -4,6 +4,7 @@
 #    include "Application.hpp"
 #    include "controllers/plugins/api/EventType.hpp"
 #    include "controllers/plugins/api/HTTPRequest.hpp"
+#    include "controllers/plugins/api/MessageView.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
 #    include "controllers/plugins/PluginPermission.hpp"
 
@@ -13,17 +14,26 @@
 #    include <semver/semver.hpp>
 #    include <sol/forward.hpp>
 
+#    include <chrono>
+#    include <cstddef>
+#    include <functional>
 #    include <memory>
+#    include <mutex>
 #    include <optional>
 #    include <unordered_map>
 #    include <unordered_set>
 #    include <vector>
 
 struct lua_State;
+struct lua_Debug;
+class QObject;
+class QThread;
 class QTimer;
 
 namespace chatterino {
 
+struct Message;
+
 struct PluginMeta {
     // for more info on these fields see docs/plugin-info.schema.json
 
@@ -50,6 +60,9 @@ struct PluginMeta {
 
     std::vector<PluginPermission> permissions;
 
+    // run the plugin in its own thread instead of the GUI thread
+    bool worker = false;
+
     // errors that occurred while parsing info.json
     std::vector<QString> errors;
 
@@ -66,6 +79,42 @@ struct PluginMeta {
 class Plugin
 {
 public:
+    /// Number of Lua instructions a single invocation of a plugin (loading it,
+    /// running a command, a callback or a timer) may execute
+    static constexpr size_t INSTRUCTION_BUDGET = 10'000'000;
+
+    /// Number of invocations that can run out of instructions before the
+    /// plugin is disabled
+    static constexpr size_t MAX_BUDGET_VIOLATIONS = 3;
+
+    struct Usage {
+        /// Time spent running Lua code of this plugin
+        std::chrono::steady_clock::duration time{};
+        /// Number of invocations
+        size_t calls = 0;
+        /// Number of invocations that ran out of instructions
+        size_t overBudget = 0;
+    };
+
+    /// Accounts for the Lua code run while this guard is alive.
+    ///
+    /// Every place that calls into a plugin must hold a guard. Guards can be
+    /// nested, the budget applies to the outermost one.
+    class CallGuard
+    {
+    public:
+        explicit CallGuard(Plugin *plugin);
+        ~CallGuard();
+
+        CallGuard(const CallGuard &) = delete;
+        CallGuard(CallGuard &&) = delete;
+        CallGuard &operator=(const CallGuard &) = delete;
+        CallGuard &operator=(CallGuard &&) = delete;
+
+    private:
+        Plugin *plugin_;
+    };
+
     QString id;
     PluginMeta meta;
 
@@ -96,7 +145,41 @@ public:
     /**
      * @brief Get names of all commands belonging to this plugin
      */
-    std::unordered_set<QString> listRegisteredCommands();
+    std::unordered_set<QString> listRegisteredCommands() const;
+
+    bool hasCommand(const QString &name) const;
+
+    /// Must be called on the plugin's thread (see invoke)
+    std::optional<sol::protected_function> getCommand(const QString &name);
+
+    /// Sets the callback for `type`. `filter` is only used for MessagesAdded.
+    /// Must be called on the plugin's thread (see invoke).
+    void registerCallback(lua::api::EventType type,
+                          sol::protected_function function,
+                          lua::api::MessageFilter filter = {});
+
+    /// Must be called on the plugin's thread (see invoke)
+    std::optional<sol::protected_function> getCallback(
+        lua::api::EventType type);
+
+    /// Returns true if the plugin wants `message` in its MessagesAdded
+    /// callback. This can be called from any thread.
+    bool observes(const QString &channelName, const Message &message) const;
+
+    /**
+     * Runs `fn` on the thread that owns the Lua state of this plugin.
+     *
+     * For plugins on the GUI thread, `fn` is called right away. For worker
+     * plugins, `fn` is queued on the worker thread and dropped if the plugin
+     * is destroyed before it runs.
+     */
+    void invoke(std::function<void()> fn);
+
+    /// Whether the plugin runs on its own thread (see PluginMeta::worker)
+    bool isWorker() const
+    {
+        return this->workerThread_ != nullptr;
+    }
 
     const QDir &loadDirectory() const
     {
@@ -108,28 +191,29 @@ public:
         return this->loadDirectory_.absoluteFilePath("data");
     }
 
+    /// Completions are requested synchronously, so worker plugins can't
+    /// provide them
     std::optional<sol::protected_function> getCompletionCallback()
     {
-        if (this->state_ == nullptr || !this->error_.isNull())
-        {
-            return {};
-        }
-        auto it =
-            this->callbacks.find(lua::api::EventType::CompletionRequested);
-        if (it == this->callbacks.end())
+        if (this->isWorker() || !this->isRunnable())
         {
             return {};
         }
-        return it->second;
+        return this->getCallback(lua::api::EventType::CompletionRequested);
     }
 
     /**
      * If the plugin crashes while evaluating the main file, this function will return the error
      */
-    QString error()
-    {
-        return this->error_;
-    }
+    QString error() const;
+
+    /**
+     * Returns false if the plugin failed to load or was disabled because it
+     * exceeded its instruction budget too often
+     */
+    bool isRunnable() const;
+
+    Usage usage() const;
 
     int addTimeout(QTimer *timer);
     void removeTimeout(QTimer *timer);
@@ -137,8 +221,6 @@ public:
     bool hasFSPermissionFor(bool write, const QString &path);
     bool hasHTTPPermissionFor(const QUrl &url);
 
-    std::map<lua::api::EventType, sol::protected_function> callbacks;
-
     // In-flight HTTP Requests
     // This is a lifetime hack to ensure they get deleted with the plugin. This relies on the Plugin getting deleted on reload!
     std::vector<std::shared_ptr<lua::api::HTTPRequest>> httpRequests;
@@ -147,10 +229,39 @@ private:
     QDir loadDirectory_;
     lua_State *state_;
 
+    void setError(QString error);
+
+    /// Installs the instruction counting hook on the Lua state
+    void installWatchdog();
+    static void watchdogHook(lua_State *L, lua_Debug *ar);
+
+    /// Starts the thread worker plugins run on
+    void startWorker();
+
+    std::unique_ptr<QThread> workerThread_;
+    /// Lives on the worker thread, functions passed to invoke are queued on it
+    std::unique_ptr<QObject> workerContext_;
+
+    // Guards everything that's accessed from the GUI thread and the worker
+    // thread: error_, usage_, the names in ownedCommands, callbacks and
+    // messageFilter
+    mutable std::mutex mutex_;
+
     QString error_;
+    Usage usage_;
+
+    // Only accessed from the plugin's thread
+    size_t callDepth_ = 0;
+    std::chrono::steady_clock::time_point callStart_;
+    size_t instructionsUsed_ = 0;
+    bool exceededBudget_ = false;
 
     // maps command name -> function
     std::unordered_map<QString, sol::protected_function> ownedCommands;
+    std::map<lua::api::EventType, sol::protected_function> callbacks;
+    // Filter of the MessagesAdded callback
+    lua::api::MessageFilter messageFilter;
+
     std::vector<QTimer *> activeTimeouts;
     int lastTimerId = 0;
 
@@ -11,12 +11,17 @@
 #    include "controllers/plugins/api/HTTPRequest.hpp"
 #    include "controllers/plugins/api/HTTPResponse.hpp"
 #    include "controllers/plugins/api/IOWrapper.hpp"
+#    include "controllers/plugins/api/MessageView.hpp"
 #    include "controllers/plugins/LuaAPI.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
 #    include "controllers/plugins/SolTypes.hpp"
+#    include "debug/AssertInGuiThread.hpp"
+#    include "messages/Message.hpp"
 #    include "messages/MessageBuilder.hpp"
+#    include "providers/twitch/TwitchChannel.hpp"
 #    include "singletons/Paths.hpp"
 #    include "singletons/Settings.hpp"
+#    include "util/PostToThread.hpp"
 
 #    include <lauxlib.h>
 #    include <lua.h>
@@ -37,6 +42,11 @@ namespace chatterino {
 PluginController::PluginController(const Paths &paths_)
     : paths(paths_)
 {
+    this->observedMessagesTimer_.setSingleShot(true);
+    this->observedMessagesTimer_.setInterval(0);
+    QObject::connect(&this->observedMessagesTimer_, &QTimer::timeout, [this] {
+        this->flushObservedMessages();
+    });
 }
 
 void PluginController::initialize(Settings &settings)
@@ -120,6 +130,7 @@ bool PluginController::tryLoadFromDir(const QDir &pluginDir)
 void PluginController::openLibrariesFor(Plugin *plugin)
 {
     auto *L = plugin->state_;
+    plugin->installWatchdog();
     lua::StackGuard guard(L);
     sol::state_view lua(L);
     // Stuff to change, remove or hide behind a permission system:
@@ -220,10 +231,12 @@ void PluginController::initSol(sol::state_view &lua, Plugin *plugin)
     lua::api::ChannelRef::createUserType(c2);
     lua::api::HTTPResponse::createUserType(c2);
     lua::api::HTTPRequest::createUserType(c2);
+    lua::api::MessageView::createUserType(c2);
     c2["ChannelType"] = lua::createEnumTable<Channel::Type>(lua);
     c2["HTTPMethod"] = lua::createEnumTable<NetworkRequestType>(lua);
     c2["EventType"] = lua::createEnumTable<lua::api::EventType>(lua);
     c2["LogLevel"] = lua::createEnumTable<lua::api::LogLevel>(lua);
+    c2["MessageFlag"] = lua::createEnumTable<MessageFlag>(lua);
 
     sol::table io = g["io"];
     io.set_function(
@@ -273,17 +286,29 @@ void PluginController::load(const QFileInfo &index, const QDir &pluginDir,
     }
     temp->dataDirectory().mkpath(".");
 
-    qCDebug(chatterinoLua) << "Running lua file:" << index;
-    int err = luaL_dofile(l, index.absoluteFilePath().toStdString().c_str());
-    if (err != 0)
+    if (meta.worker)
     {
-        temp->error_ = lua::humanErrorText(l, err);
-        qCWarning(chatterinoLua)
-            << "Failed to load" << pluginName << "plugin from" << index << ": "
-            << temp->error_;
-        return;
+        temp->startWorker();
     }
-    qCInfo(chatterinoLua) << "Loaded" << pluginName << "plugin from" << index;
+
+    temp->invoke([temp, l, index, pluginName] {
+        qCDebug(chatterinoLua) << "Running lua file:" << index;
+        int err = 0;
+        {
+            Plugin::CallGuard call(temp);
+            err = luaL_dofile(l, index.absoluteFilePath().toStdString().c_str());
+        }
+        if (err != 0)
+        {
+            temp->setError(lua::humanErrorText(l, err));
+            qCWarning(chatterinoLua)
+                << "Failed to load" << pluginName << "plugin from" << index
+                << ": " << temp->error();
+            return;
+        }
+        qCInfo(chatterinoLua)
+            << "Loaded" << pluginName << "plugin from" << index;
+    });
 }
 
 bool PluginController::reload(const QString &id)
@@ -294,7 +319,7 @@ bool PluginController::reload(const QString &id)
         return false;
     }
 
-    for (const auto &[cmd, _] : it->second->ownedCommands)
+    for (const auto &cmd : it->second->listRegisteredCommands())
     {
         getApp()->getCommands()->unregisterPluginCommand(cmd);
     }
@@ -310,32 +335,51 @@ QString PluginController::tryExecPluginCommand(const QString &commandName,
 {
     for (auto &[name, plugin] : this->plugins_)
     {
-        if (auto it = plugin->ownedCommands.find(commandName);
-            it != plugin->ownedCommands.end())
+        if (plugin->hasCommand(commandName))
         {
-            sol::state_view lua(plugin->state_);
-            sol::table args = lua.create_table_with(
-                "words", ctx.words,                           //
-                "channel", lua::api::ChannelRef(ctx.channel)  //
-            );
-
-            auto result =
-                lua::tryCall<std::optional<QString>>(it->second, args);
-            if (!result)
+            if (!plugin->isRunnable())
             {
                 ctx.channel->addSystemMessage(
-                    QStringView(
-                        u"Failed to evaluate command from plugin %1: %2")
-                        .arg(plugin->meta.name, result.error()));
+                    QStringView(u"Plugin %1 is disabled: %2")
+                        .arg(plugin->meta.name, plugin->error()));
                 return {};
             }
 
-            auto opt = result.value();
-            if (!opt)
+            if (plugin->isWorker())
             {
+                // The text is sent once the worker ran the command. The worker
+                // only holds a weak reference, so the channel isn't destroyed
+                // on its thread if the split is closed in the meantime.
+                plugin->invoke([pl = plugin.get(), commandName,
+                                words = ctx.words,
+                                hasChannel = ctx.channel != nullptr,
+                                weak = std::weak_ptr<Channel>(ctx.channel)] {
+                    auto channel = releaseInGuiThread(weak.lock());
+                    if (hasChannel && !channel)
+                    {
+                        // the channel was closed
+                        return;
+                    }
+                    auto text = PluginController::runCommand(
+                        pl, commandName,
+                        {
+                            .words = words,
+                            .channel = channel,
+                            .twitchChannel =
+                                dynamic_cast<TwitchChannel *>(channel.get()),
+                        });
+                    if (!text.isEmpty() && channel)
+                    {
+                        postToThread([channel, text] {
+                            channel->sendMessage(text);
+                        });
+                    }
+                });
                 return {};
             }
-            return *opt;
+
+            return PluginController::runCommand(plugin.get(), commandName,
+                                                ctx);
         }
     }
     qCCritical(chatterinoLua)
@@ -345,6 +389,37 @@ QString PluginController::tryExecPluginCommand(const QString &commandName,
     return {};
 }
 
+QString PluginController::runCommand(Plugin *plugin, const QString &commandName,
+                                     const CommandContext &ctx)
+{
+    auto fn = plugin->getCommand(commandName);
+    if (!fn || !plugin->isRunnable())
+    {
+        return {};
+    }
+
+    Plugin::CallGuard call(plugin);
+    sol::state_view lua(plugin->state_);
+    sol::table args = lua.create_table_with(
+        "words", ctx.words,                           //
+        "channel", lua::api::ChannelRef(ctx.channel)  //
+    );
+
+    auto result = lua::tryCall<std::optional<QString>>(*fn, args);
+    if (!result)
+    {
+        auto text =
+            QStringView(u"Failed to evaluate command from plugin %1: %2")
+                .arg(plugin->meta.name, result.error());
+        runInGuiThread([channel = ctx.channel, text] {
+            channel->addSystemMessage(text);
+        });
+        return {};
+    }
+
+    return result.value().value_or(QString{});
+}
+
 bool PluginController::isPluginEnabled(const QString &id)
 {
     auto vec = getSettings()->enabledPlugins.getValue();
@@ -354,19 +429,10 @@ bool PluginController::isPluginEnabled(const QString &id)
 
 Plugin *PluginController::getPluginByStatePtr(lua_State *L)
 {
-    lua_geti(L, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
-    // Use the main thread for identification, not a coroutine instance
-    auto *mainL = lua_tothread(L, -1);
-    lua_pop(L, 1);
-    L = mainL;
-    for (auto &[name, plugin] : this->plugins_)
-    {
-        if (plugin->state_ == L)
-        {
-            return plugin.get();
-        }
-    }
-    return nullptr;
+    // Every thread of a plugin's state (including coroutines) points to the
+    // plugin in its extra space (see Plugin::installWatchdog). Unlike
+    // searching plugins_, this is safe on worker threads.
+    return *static_cast<Plugin **>(lua_getextraspace(L));
 }
 
 const std::map<QString, std::unique_ptr<Plugin>> &PluginController::plugins()
@@ -383,7 +449,7 @@ std::pair<bool, QStringList> PluginController::updateCustomCompletions(
 
     for (const auto &[name, pl] : this->plugins())
     {
-        if (!pl->error().isNull() || pl->state_ == nullptr)
+        if (!pl->isRunnable())
         {
             continue;
         }
@@ -394,6 +460,7 @@ std::pair<bool, QStringList> PluginController::updateCustomCompletions(
             qCDebug(chatterinoLua)
                 << "Processing custom completions from plugin" << name;
             auto &cb = *opt;
+            Plugin::CallGuard call(pl.get());
             sol::state_view view(pl->state_);
             auto errOrList = lua::tryCall<sol::table>(
                 cb,
@@ -425,5 +492,88 @@ std::pair<bool, QStringList> PluginController::updateCustomCompletions(
     return {false, results};
 }
 
+void PluginController::observeMessage(const QString &channelName,
+                                      const MessagePtr &message)
+{
+    if (!isGuiThread())
+    {
+        postToThread([this, channelName, message] {
+            this->observeMessage(channelName, message);
+        });
+        return;
+    }
+
+    bool wanted = std::ranges::any_of(this->plugins_, [&](const auto &it) {
+        return it.second->observes(channelName, *message);
+    });
+    if (!wanted)
+    {
+        return;
+    }
+
+    this->observedMessages_.push_back({channelName, message});
+    if (!this->observedMessagesTimer_.isActive())
+    {
+        this->observedMessagesTimer_.start();
+    }
+}
+
+void PluginController::flushObservedMessages()
+{
+    // Callbacks might add messages, these are delivered in the next batch
+    auto observed = std::exchange(this->observedMessages_, {});
+
+    for (const auto &[name, pl] : this->plugins_)
+    {
+        std::vector<ObservedMessage> batch;
+        for (const auto &entry : observed)
+        {
+            if (pl->observes(entry.channelName, *entry.message))
+            {
+                batch.push_back(entry);
+            }
+        }
+        if (batch.empty())
+        {
+            continue;
+        }
+
+        pl->invoke([pl = pl.get(), batch = std::move(batch)] {
+            PluginController::deliverMessages(pl, batch);
+        });
+    }
+}
+
+void PluginController::deliverMessages(
+    Plugin *plugin, const std::vector<ObservedMessage> &batch)
+{
+    // The callback might have been replaced while the batch was queued
+    auto cb = plugin->getCallback(lua::api::EventType::MessagesAdded);
+    if (!cb || !plugin->isRunnable())
+    {
+        return;
+    }
+
+    lua::StackGuard guard(plugin->state_);
+    sol::state_view lua(plugin->state_);
+    auto messages = lua.create_table(static_cast<int>(batch.size()), 0);
+    int i = 0;
+    for (const auto &entry : batch)
+    {
+        messages.raw_set(
+            ++i, lua::api::MessageView(entry.channelName, entry.message));
+    }
+
+    Plugin::CallGuard call(plugin);
+    auto res =
+        lua::tryCall<void>(*cb, lua.create_table_with("messages", messages));
+    if (!res)
+    {
+        qCWarning(chatterinoLua)
+            << "Got error from plugin" << plugin->meta.name
+            << "while delivering messages:" << res.error();
+    }
+}
+
 }  // namespace chatterino
 #endif
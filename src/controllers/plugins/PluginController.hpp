@@ -10,6 +10,7 @@
 #    include <QJsonArray>
 #    include <QJsonObject>
 #    include <QString>
+#    include <QTimer>
 #    include <sol/forward.hpp>
 
 #    include <algorithm>
@@ -61,6 +62,15 @@ public:
         const QString &query, const QString &fullTextContent,
         int cursorPosition, bool isFirstWord) const;
 
+    /**
+     * @brief Queues a message added to a channel for MessagesAdded callbacks
+     *
+     * Messages are only queued if they match the filter of a callback. The
+     * queued messages are delivered in one batch per plugin in the next event
+     * loop iteration.
+     */
+    void observeMessage(const QString &channelName, const MessagePtr &message);
+
 private:
     void loadPlugins();
     void load(const QFileInfo &index, const QDir &pluginDir,
@@ -73,8 +83,27 @@ private:
 
     static void loadChatterinoLib(lua_State *l);
     bool tryLoadFromDir(const QDir &pluginDir);
+
+    /// Runs the command in the plugin's thread and returns the text to send
+    static QString runCommand(Plugin *plugin, const QString &commandName,
+                              const CommandContext &ctx);
+
+    struct ObservedMessage {
+        QString channelName;
+        MessagePtr message;
+    };
+
+    /// Invokes the MessagesAdded callbacks with the queued messages
+    void flushObservedMessages();
+    /// Invokes the MessagesAdded callback of `plugin` in its thread
+    static void deliverMessages(Plugin *plugin,
+                                const std::vector<ObservedMessage> &batch);
+
     std::map<QString, std::unique_ptr<Plugin>> plugins_;
 
+    std::vector<ObservedMessage> observedMessages_;
+    QTimer observedMessagesTimer_;
+
     // This is for tests, pay no attention
     friend class PluginControllerAccess;
 };
@@ -7,6 +7,7 @@
 #    include "controllers/plugins/SolTypes.hpp"
 #    include "providers/twitch/TwitchChannel.hpp"
 #    include "providers/twitch/TwitchIrcServer.hpp"
+#    include "util/PostToThread.hpp"
 
 #    include <sol/sol.hpp>
 
@@ -22,7 +23,8 @@ ChannelRef::ChannelRef(const std::shared_ptr<Channel> &chan)
 
 std::shared_ptr<Channel> ChannelRef::strong()
 {
-    auto c = this->weak.lock();
+    // Worker plugins must not destroy the channel on their thread
+    auto c = releaseInGuiThread(this->weak.lock());
     if (!c)
     {
         throw std::runtime_error(
@@ -34,7 +36,8 @@ std::shared_ptr<Channel> ChannelRef::strong()
 
 std::shared_ptr<TwitchChannel> ChannelRef::twitch()
 {
-    auto c = std::dynamic_pointer_cast<TwitchChannel>(this->weak.lock());
+    auto c = releaseInGuiThread(
+        std::dynamic_pointer_cast<TwitchChannel>(this->weak.lock()));
     if (!c)
     {
         throw std::runtime_error(
@@ -61,7 +64,14 @@ Channel::Type ChannelRef::get_type()
 
 QString ChannelRef::get_display_name()
 {
-    return this->strong()->getDisplayName();
+    auto chan = this->strong();
+    // Plugins running on a worker thread read a copy that's safe to access
+    // from their thread
+    if (auto *twitch = dynamic_cast<TwitchChannel *>(chan.get()))
+    {
+        return twitch->accessSharedState()->displayName;
+    }
+    return chan->getDisplayName();
 }
 
 void ChannelRef::send_message(QString text, sol::variadic_args va)
@@ -75,17 +85,22 @@ void ChannelRef::send_message(QString text, sol::variadic_args va)
     }();
     text = text.replace('\n', ' ');
     auto chan = this->strong();
-    if (execCommands)
-    {
-        text = getApp()->getCommands()->execCommand(text, chan, false);
-    }
-    chan->sendMessage(text);
+    // Worker plugins send the message asynchronously
+    runInGuiThread([chan, text, execCommands]() mutable {
+        if (execCommands)
+        {
+            text = getApp()->getCommands()->execCommand(text, chan, false);
+        }
+        chan->sendMessage(text);
+    });
 }
 
 void ChannelRef::add_system_message(QString text)
 {
     text = text.replace('\n', ' ');
-    this->strong()->addSystemMessage(text);
+    runInGuiThread([chan = this->strong(), text] {
+        chan->addSystemMessage(text);
+    });
 }
 
 bool ChannelRef::is_twitch_channel()
@@ -110,7 +125,7 @@ QString ChannelRef::get_twitch_id()
 
 bool ChannelRef::is_broadcaster()
 {
-    return this->twitch()->isBroadcaster();
+    return this->twitch()->accessSharedState()->broadcaster;
 }
 
 bool ChannelRef::is_mod()
@@ -125,7 +140,7 @@ bool ChannelRef::is_vip()
 
 QString ChannelRef::to_string()
 {
-    auto chan = this->weak.lock();
+    auto chan = releaseInGuiThread(this->weak.lock());
     if (!chan)
     {
         return "<c2.Channel expired>";
@@ -135,7 +150,8 @@ QString ChannelRef::to_string()
 
 std::optional<ChannelRef> ChannelRef::get_by_name(const QString &name)
 {
-    auto chan = getApp()->getTwitch()->getChannelOrEmpty(name);
+    auto chan =
+        releaseInGuiThread(getApp()->getTwitch()->getChannelOrEmpty(name));
     if (chan->isEmpty())
     {
         return std::nullopt;
@@ -145,7 +161,8 @@ std::optional<ChannelRef> ChannelRef::get_by_name(const QString &name)
 
 std::optional<ChannelRef> ChannelRef::get_by_twitch_id(const QString &id)
 {
-    auto chan = getApp()->getTwitch()->getChannelOrEmptyByID(id);
+    auto chan =
+        releaseInGuiThread(getApp()->getTwitch()->getChannelOrEmptyByID(id));
     if (chan->isEmpty())
     {
         return std::nullopt;
@@ -56,6 +56,7 @@ public:
     /**
      * Sends a message to the target channel.
      * Note that this does not execute client-commands.
+     * Plugins running on a worker thread send the message asynchronously.
      *
      * @lua@param message string
      * @lua@param execute_commands? boolean Should commands be run on the text?
@@ -64,7 +65,8 @@ public:
     void send_message(QString text, sol::variadic_args va);
 
     /**
-     * Adds a system message client-side
+     * Adds a system message client-side.
+     * Plugins running on a worker thread add the message asynchronously.
      *
      * @lua@param message string
      * @exposed c2.Channel:add_system_message
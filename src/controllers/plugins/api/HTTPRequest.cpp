@@ -7,6 +7,7 @@
 #    include "common/network/NetworkResult.hpp"
 #    include "controllers/plugins/api/HTTPResponse.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
+#    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/SolTypes.hpp"
 #    include "util/DebugCount.hpp"
@@ -116,60 +117,75 @@ void HTTPRequest::execute(sol::this_state L)
     auto *pl = getApp()->getPlugins()->getPluginByStatePtr(L);
     pl->httpRequests.push_back(this->shared_from_this());
 
+    // The callbacks run on the GUI thread. They're forwarded to the thread of
+    // the plugin, which outlives the request (see Plugin::httpRequests).
     std::move(this->req_)
-        .onSuccess([L, hack](const NetworkResult &res) {
-            auto self = hack.lock();
-            if (!self)
+        .onSuccess([L, pl, hack](const NetworkResult &res) {
+            if (hack.expired())
             {
                 return;
             }
-            if (!self->cbSuccess.has_value())
-            {
-                return;
-            }
-            lua::StackGuard guard(L);
-            (*self->cbSuccess)(HTTPResponse(res));
-            self->cbSuccess = std::nullopt;
+            pl->invoke([L, pl, hack, res] {
+                auto self = hack.lock();
+                if (!self || !self->cbSuccess.has_value() ||
+                    !pl->isRunnable())
+                {
+                    return;
+                }
+                Plugin::CallGuard call(pl);
+                lua::StackGuard guard(L);
+                (*self->cbSuccess)(HTTPResponse(res));
+                self->cbSuccess = std::nullopt;
+            });
         })
-        .onError([L, hack](const NetworkResult &res) {
-            auto self = hack.lock();
-            if (!self)
+        .onError([L, pl, hack](const NetworkResult &res) {
+            if (hack.expired())
             {
                 return;
             }
-            if (!self->cbError.has_value())
-            {
-                return;
-            }
-            lua::StackGuard guard(L);
-            (*self->cbError)(HTTPResponse(res));
-            self->cbError = std::nullopt;
+            pl->invoke([L, pl, hack, res] {
+                auto self = hack.lock();
+                if (!self || !self->cbError.has_value() || !pl->isRunnable())
+                {
+                    return;
+                }
+                Plugin::CallGuard call(pl);
+                lua::StackGuard guard(L);
+                (*self->cbError)(HTTPResponse(res));
+                self->cbError = std::nullopt;
+            });
         })
-        .finally([L, hack]() {
-            auto self = hack.lock();
-            if (!self)
+        .finally([L, pl, hack]() {
+            if (hack.expired())
             {
                 // this could happen if the plugin was deleted
                 return;
             }
-            auto *pl = getApp()->getPlugins()->getPluginByStatePtr(L);
-            for (auto it = pl->httpRequests.begin();
-                 it < pl->httpRequests.end(); it++)
-            {
-                if (*it == self)
+            pl->invoke([L, pl, hack] {
+                auto self = hack.lock();
+                if (!self)
                 {
-                    pl->httpRequests.erase(it);
-                    break;
+                    return;
+                }
+                for (auto it = pl->httpRequests.begin();
+                     it < pl->httpRequests.end(); it++)
+                {
+                    if (*it == self)
+                    {
+                        pl->httpRequests.erase(it);
+                        break;
+                    }
                 }
-            }
 
-            if (!self->cbFinally.has_value())
-            {
-                return;
-            }
-            lua::StackGuard guard(L);
-            (*self->cbFinally)();
-            self->cbFinally = std::nullopt;
+                if (!self->cbFinally.has_value() || !pl->isRunnable())
+                {
+                    return;
+                }
+                Plugin::CallGuard call(pl);
+                lua::StackGuard guard(L);
+                (*self->cbFinally)();
+                self->cbFinally = std::nullopt;
+            });
         })
         .timeout(this->timeout_)
         .execute();
@@ -0,0 +1,130 @@
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "controllers/plugins/api/MessageView.hpp"
+
+#    include "controllers/plugins/SolTypes.hpp"
+#    include "messages/Message.hpp"
+
+#    include <QDateTime>
+#    include <sol/sol.hpp>
+
+namespace chatterino::lua::api {
+
+MessageFilter::MessageFilter(const sol::table &table)
+{
+    auto readNames = [&](const char *key, std::unordered_set<QString> &out) {
+        sol::optional<sol::table> names = table[key];
+        if (!names)
+        {
+            return;
+        }
+        for (const auto &[_, name] : *names)
+        {
+            out.insert(name.as<QString>().toLower());
+        }
+    };
+    readNames("channels", this->channels);
+    readNames("authors", this->authors);
+
+    sol::optional<sol::table> flags = table["flags"];
+    if (flags)
+    {
+        for (const auto &[_, flag] : *flags)
+        {
+            this->flags.set(flag.as<MessageFlag>());
+        }
+    }
+}
+
+bool MessageFilter::matches(const QString &channelName,
+                            const Message &message) const
+{
+    if (!this->channels.empty() &&
+        !this->channels.contains(channelName.toLower()))
+    {
+        return false;
+    }
+    if (!this->authors.empty() && !this->authors.contains(message.loginName))
+    {
+        return false;
+    }
+    if (this->flags.value() != MessageFlag::None &&
+        !message.flags.hasAny(this->flags))
+    {
+        return false;
+    }
+    return true;
+}
+
+MessageView::MessageView(QString channelName, MessagePtr message)
+    : channelName_(std::move(channelName))
+    , message_(std::move(message))
+{
+}
+
+QString MessageView::get_id() const
+{
+    return this->message_->id;
+}
+
+QString MessageView::get_text() const
+{
+    return this->message_->messageText;
+}
+
+QString MessageView::get_login_name() const
+{
+    return this->message_->loginName;
+}
+
+QString MessageView::get_display_name() const
+{
+    return this->message_->displayName;
+}
+
+QString MessageView::get_channel_name() const
+{
+    return this->channelName_;
+}
+
+int64_t MessageView::get_time() const
+{
+    if (this->message_->serverReceivedTime.isValid())
+    {
+        return this->message_->serverReceivedTime.toMSecsSinceEpoch();
+    }
+    return QDateTime(QDate::currentDate(), this->message_->parseTime)
+        .toMSecsSinceEpoch();
+}
+
+bool MessageView::has_flag(MessageFlag flag) const
+{
+    return this->message_->flags.has(flag);
+}
+
+QString MessageView::to_string() const
+{
+    return QStringView(u"<c2.Message %1: %2>")
+        .arg(this->channelName_, this->message_->messageText);
+}
+
+void MessageView::createUserType(sol::table &c2)
+{
+    // clang-format off
+    c2.new_usertype<MessageView>(
+        "Message", sol::no_constructor,
+        // meta methods
+        sol::meta_method::to_string, &MessageView::to_string,
+
+        "get_id", &MessageView::get_id,
+        "get_text", &MessageView::get_text,
+        "get_login_name", &MessageView::get_login_name,
+        "get_display_name", &MessageView::get_display_name,
+        "get_channel_name", &MessageView::get_channel_name,
+        "get_time", &MessageView::get_time,
+        "has_flag", &MessageView::has_flag
+    );
+    // clang-format on
+}
+
+}  // namespace chatterino::lua::api
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "messages/MessageFlag.hpp"
+
+#    include <QString>
+#    include <sol/forward.hpp>
+
+#    include <cstdint>
+#    include <memory>
+#    include <unordered_set>
+
+namespace chatterino {
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+}  // namespace chatterino
+
+namespace chatterino::lua::api {
+// NOLINTBEGIN(readability-identifier-naming)
+
+/**
+ * @includefile messages/MessageFlag.hpp
+ */
+
+/**
+ * @lua@class MessageFilter
+ */
+struct MessageFilter {
+    MessageFilter() = default;
+    explicit MessageFilter(const sol::table &table);
+
+    /**
+     * @lua@field channels? string[] Only deliver messages from these channels (login names)
+     */
+    std::unordered_set<QString> channels;
+
+    /**
+     * @lua@field authors? string[] Only deliver messages sent by these users (login names)
+     */
+    std::unordered_set<QString> authors;
+
+    /**
+     * @lua@field flags? c2.MessageFlag[] Only deliver messages with at least one of these flags
+     */
+    MessageFlags flags;
+
+    bool matches(const QString &channelName, const Message &message) const;
+};
+
+/**
+ * A read-only view of a message in a channel
+ *
+ * @lua@class c2.Message
+ */
+class MessageView
+{
+public:
+    MessageView(QString channelName, MessagePtr message);
+
+    /**
+     * Returns the ID of the message. This is empty for messages that weren't sent by Twitch (e.g. system messages).
+     *
+     * @lua@return string
+     * @exposed c2.Message:get_id
+     */
+    QString get_id() const;
+
+    /**
+     * Returns the text of the message
+     *
+     * @lua@return string
+     * @exposed c2.Message:get_text
+     */
+    QString get_text() const;
+
+    /**
+     * Returns the login name of the sender. This is empty for system messages.
+     *
+     * @lua@return string
+     * @exposed c2.Message:get_login_name
+     */
+    QString get_login_name() const;
+
+    /**
+     * Returns the display name of the sender
+     *
+     * @lua@return string
+     * @exposed c2.Message:get_display_name
+     */
+    QString get_display_name() const;
+
+    /**
+     * Returns the name of the channel the message was added to
+     *
+     * @lua@return string
+     * @exposed c2.Message:get_channel_name
+     */
+    QString get_channel_name() const;
+
+    /**
+     * Returns the time the message was received in milliseconds since the Unix epoch
+     *
+     * @lua@return integer
+     * @exposed c2.Message:get_time
+     */
+    int64_t get_time() const;
+
+    /**
+     * Returns true if the message has the flag
+     *
+     * @lua@param flag c2.MessageFlag
+     * @lua@return boolean
+     * @exposed c2.Message:has_flag
+     */
+    bool has_flag(MessageFlag flag) const;
+
+    /**
+     * @lua@return string
+     * @exposed c2.Message:__tostring
+     */
+    QString to_string() const;
+
+    static void createUserType(sol::table &c2);
+
+private:
+    QString channelName_;
+    MessagePtr message_;
+};
+
+// NOLINTEND(readability-identifier-naming)
+}  // namespace chatterino::lua::api
+#endif
@@ -1,17 +1,21 @@
 #include "debug/Benchmark.hpp"
 
 #include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
 
 namespace chatterino {
 
 BenchmarkGuard::BenchmarkGuard(const QString &_name)
     : name_(_name)
+    , traceStartNs_(trace::now())
 {
     timer_.start();
 }
 
 BenchmarkGuard::~BenchmarkGuard()
 {
+    trace::recordSpan(trace::category::BENCHMARK, this->name_,
+                      this->traceStartNs_, trace::now());
     qCDebug(chatterinoBenchmark)
         << this->name_ << float(timer_.nsecsElapsed()) / 1000000.0f << "ms";
 }
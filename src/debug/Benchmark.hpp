@@ -22,6 +22,7 @@ public:
 private:
     QElapsedTimer timer_;
     QString name_;
+    int64_t traceStartNs_;
 };
 
 }  // namespace chatterino
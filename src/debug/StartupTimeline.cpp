@@ -0,0 +1,160 @@
+#include "debug/StartupTimeline.hpp"
+
+#include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::startup;
+
+struct Timeline {
+    std::mutex mutex;
+    std::vector<Stage> stages;
+    /// End of the last stage recorded with `mark`
+    int64_t lastEndNs = 0;
+};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> ENABLED{false};
+std::atomic<bool> FINISHED{false};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+Timeline &timeline()
+{
+    static Timeline instance;
+    return instance;
+}
+
+double toMilliseconds(int64_t ns)
+{
+    return static_cast<double>(ns) / 1'000'000.0;
+}
+
+void logTimeline(const std::vector<Stage> &stages)
+{
+    int64_t endNs = 0;
+    for (const auto &stage : stages)
+    {
+        qCInfo(chatterinoApp).noquote()
+            << QStringLiteral("Startup: %1 took %2ms (at %3ms)")
+                   .arg(stage.name)
+                   .arg(toMilliseconds(stage.endNs - stage.startNs), 0, 'f', 1)
+                   .arg(toMilliseconds(stage.endNs), 0, 'f', 1);
+        endNs = std::max(endNs, stage.endNs);
+    }
+
+    auto totalMs = toMilliseconds(endNs);
+    if (totalMs > static_cast<double>(BUDGET_MS))
+    {
+        qCWarning(chatterinoApp)
+            << "Startup took" << totalMs << "ms, which is more than"
+            << BUDGET_MS << "ms";
+    }
+}
+
+}  // namespace
+
+namespace chatterino::startup {
+
+void begin()
+{
+    // trace::now() is relative to its first call
+    trace::now();
+}
+
+void setEnabled(bool enabled)
+{
+    ENABLED.store(enabled, std::memory_order_relaxed);
+}
+
+void mark(const char *name)
+{
+    if (FINISHED.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto &tl = timeline();
+    std::lock_guard lock(tl.mutex);
+    auto endNs = trace::now();
+    tl.stages.push_back({
+        .name = name,
+        .startNs = tl.lastEndNs,
+        .endNs = endNs,
+    });
+    tl.lastEndNs = endNs;
+}
+
+void markBackground(const char *name, int64_t startNs)
+{
+    if (FINISHED.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto &tl = timeline();
+    std::lock_guard lock(tl.mutex);
+    tl.stages.push_back({
+        .name = name,
+        .startNs = startNs,
+        .endNs = trace::now(),
+    });
+}
+
+void markFirstPaint()
+{
+    if (FINISHED.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    mark("first painted message");
+    if (FINISHED.exchange(true))
+    {
+        return;
+    }
+
+    auto stages = startup::stages();
+
+    if (trace::isEnabled())
+    {
+        for (const auto &stage : stages)
+        {
+            trace::recordSpan(trace::category::STARTUP, stage.name,
+                              stage.startNs, stage.endNs);
+        }
+    }
+
+    if (ENABLED.load(std::memory_order_relaxed))
+    {
+        logTimeline(stages);
+    }
+}
+
+bool isFinished()
+{
+    return FINISHED.load(std::memory_order_relaxed);
+}
+
+std::vector<Stage> stages()
+{
+    auto &tl = timeline();
+    std::lock_guard lock(tl.mutex);
+    return tl.stages;
+}
+
+void clear()
+{
+    auto &tl = timeline();
+    std::lock_guard lock(tl.mutex);
+    tl.stages.clear();
+    tl.lastEndNs = trace::now();
+    FINISHED.store(false, std::memory_order_relaxed);
+}
+
+}  // namespace chatterino::startup
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace chatterino::startup {
+
+/// Startup is expected to take less than this from `main` to the first
+/// painted message. Slower starts are logged as a warning.
+inline constexpr int64_t BUDGET_MS = 1000;
+
+struct Stage {
+    /// Name of the stage. Must be a string literal.
+    const char *name = nullptr;
+    /// Times relative to the start of the process
+    int64_t startNs = 0;
+    int64_t endNs = 0;
+};
+
+/// Marks the start of the timeline. Call this as early as possible in `main`.
+void begin();
+
+/// Logs the timeline once the first message is painted. This is enabled
+/// through `--startup-timeline`.
+void setEnabled(bool enabled);
+
+/// Records that the stage `name` finished now. The stage started when the
+/// previous stage recorded with `mark` finished. `name` must be a string
+/// literal.
+void mark(const char *name);
+
+/// Records a stage that ran in the background since `startNs` (from
+/// `trace::now()`), e.g. a request started during initialization.
+///
+/// This can be called from any thread. Stages finishing after the first
+/// painted message are ignored.
+void markBackground(const char *name, int64_t startNs);
+
+/// Records the first painted message and finishes the timeline. Only the
+/// first call has an effect.
+void markFirstPaint();
+
+/// Returns true once the first message was painted
+bool isFinished();
+
+/// Returns the recorded stages in the order they finished
+std::vector<Stage> stages();
+
+/// Discards all recorded stages and starts a new timeline. Used in tests.
+void clear();
+
+}  // namespace chatterino::startup
@@ -0,0 +1,258 @@
+#include "debug/Trace.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::trace;
+
+struct Event {
+    const char *category = nullptr;
+    /// Set for spans with a static name
+    const char *name = nullptr;
+    /// Set for spans with a dynamic name (e.g. from BenchmarkGuard)
+    QString dynamicName;
+    int64_t startNs = 0;
+    int64_t endNs = 0;
+};
+
+/// Ring buffer owned by a single thread.
+///
+/// The mutex is only contended while exporting or clearing, so recording an
+/// event is cheap.
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t next = 0;
+    bool wrapped = false;
+
+    uint64_t threadID = 0;
+    QString threadName;
+
+    void push(Event &&event)
+    {
+        std::lock_guard lock(this->mutex);
+        if (this->events.size() < RING_BUFFER_SIZE)
+        {
+            this->events.emplace_back(std::move(event));
+            return;
+        }
+
+        this->events[this->next] = std::move(event);
+        this->next = (this->next + 1) % RING_BUFFER_SIZE;
+        this->wrapped = true;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint64_t nextThreadID = 1;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> ENABLED{false};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+std::chrono::steady_clock::time_point processStart()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return start;
+}
+
+ThreadBuffer &localBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto created = std::make_shared<ThreadBuffer>();
+
+        auto *thread = QThread::currentThread();
+        if (QCoreApplication::instance() != nullptr &&
+            thread == QCoreApplication::instance()->thread())
+        {
+            created->threadName = QStringLiteral("GUI");
+        }
+        else if (thread != nullptr)
+        {
+            created->threadName = thread->objectName();
+        }
+
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        created->threadID = reg.nextThreadID++;
+        if (created->threadName.isEmpty())
+        {
+            created->threadName =
+                QStringLiteral("Thread %1").arg(created->threadID);
+        }
+        reg.buffers.push_back(created);
+
+        return created;
+    }();
+
+    return *buffer;
+}
+
+double toMicroseconds(int64_t ns)
+{
+    return static_cast<double>(ns) / 1000.0;
+}
+
+}  // namespace
+
+namespace chatterino::trace {
+
+bool isEnabled()
+{
+    return ENABLED.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool enabled)
+{
+    // make sure the epoch is initialized before the first span
+    processStart();
+
+    ENABLED.store(enabled, std::memory_order_relaxed);
+}
+
+void clear()
+{
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (const auto &buffer : reg.buffers)
+    {
+        std::lock_guard bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - processStart())
+        .count();
+}
+
+void recordSpan(const char *category, const char *name, int64_t startNs,
+                int64_t endNs)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    localBuffer().push({
+        .category = category,
+        .name = name,
+        .startNs = startNs,
+        .endNs = endNs,
+    });
+}
+
+void recordSpan(const char *category, const QString &name, int64_t startNs,
+                int64_t endNs)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    localBuffer().push({
+        .category = category,
+        .dynamicName = name,
+        .startNs = startNs,
+        .endNs = endNs,
+    });
+}
+
+bool exportChromeTrace(const QString &filePath)
+{
+    QJsonArray traceEvents;
+    size_t eventCount = 0;
+
+    {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (const auto &buffer : reg.buffers)
+        {
+            std::lock_guard bufferLock(buffer->mutex);
+            auto tid = static_cast<qint64>(buffer->threadID);
+
+            traceEvents.append(QJsonObject{
+                {"name", "thread_name"},
+                {"ph", "M"},
+                {"pid", 1},
+                {"tid", tid},
+                {"args", QJsonObject{{"name", buffer->threadName}}},
+            });
+
+            // oldest event first
+            auto count = buffer->events.size();
+            auto offset = buffer->wrapped ? buffer->next : 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto &event = buffer->events[(offset + i) % count];
+                QString name = event.name != nullptr
+                                   ? QString::fromUtf8(event.name)
+                                   : event.dynamicName;
+
+                traceEvents.append(QJsonObject{
+                    {"name", name},
+                    {"cat", QString::fromUtf8(event.category)},
+                    {"ph", "X"},
+                    {"ts", toMicroseconds(event.startNs)},
+                    {"dur", toMicroseconds(event.endNs - event.startNs)},
+                    {"pid", 1},
+                    {"tid", tid},
+                });
+            }
+            eventCount += count;
+        }
+    }
+
+    QJsonObject root{
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"},
+    };
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Failed to open trace file" << filePath << file.errorString();
+        return false;
+    }
+    auto json = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    if (file.write(json) != json.size())
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Failed to write trace file" << filePath << file.errorString();
+        return false;
+    }
+
+    qCInfo(chatterinoBenchmark).nospace()
+        << "Wrote " << eventCount << " trace events to " << filePath;
+    return true;
+}
+
+}  // namespace chatterino::trace
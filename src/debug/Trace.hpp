@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+
+namespace chatterino::trace {
+
+/// Categories are shown as separate tracks/filters in the trace viewer.
+/// Keep these in sync with the places that are instrumented.
+namespace category {
+
+    inline constexpr const char *IRC = "irc";
+    inline constexpr const char *MESSAGE = "message";
+    inline constexpr const char *HIGHLIGHT = "highlight";
+    inline constexpr const char *FILTER = "filter";
+    inline constexpr const char *LAYOUT = "layout";
+    inline constexpr const char *PAINT = "paint";
+    inline constexpr const char *IMAGE = "image";
+    inline constexpr const char *NETWORK = "network";
+    inline constexpr const char *BENCHMARK = "benchmark";
+    inline constexpr const char *STARTUP = "startup";
+
+}  // namespace category
+
+/// Number of events kept per thread. Older events are overwritten.
+inline constexpr size_t RING_BUFFER_SIZE = 1 << 16;
+
+/// Returns true if spans are currently being recorded.
+bool isEnabled();
+
+/// Starts or stops recording spans.
+///
+/// Recording is off by default. It can be turned on through `--trace` or from
+/// the debug popup.
+void setEnabled(bool enabled);
+
+/// Discards all recorded events from all threads.
+void clear();
+
+/// Monotonic timestamp in nanoseconds, relative to the start of the process.
+int64_t now();
+
+/// Records a finished span. `name` and `category` must outlive the tracer
+/// (i.e. be string literals).
+void recordSpan(const char *category, const char *name, int64_t startNs,
+                int64_t endNs);
+
+/// Records a finished span with a dynamic name.
+void recordSpan(const char *category, const QString &name, int64_t startNs,
+                int64_t endNs);
+
+/// Writes all recorded events in the Chrome trace event format
+/// (https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU).
+/// The file can be opened in Perfetto (https://ui.perfetto.dev) or
+/// chrome://tracing.
+///
+/// Returns false if the file couldn't be written.
+bool exportChromeTrace(const QString &filePath);
+
+/// Records the time between its construction and destruction as a span.
+///
+/// If tracing is disabled when the span is created, this does nothing.
+class Span
+{
+public:
+    Span(const char *category, const char *name)
+        : category_(category)
+        , name_(name)
+        , startNs_(isEnabled() ? now() : -1)
+    {
+    }
+
+    ~Span()
+    {
+        if (this->startNs_ >= 0)
+        {
+            recordSpan(this->category_, this->name_, this->startNs_, now());
+        }
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    Span(Span &&) = delete;
+    Span &operator=(Span &&) = delete;
+
+private:
+    const char *category_;
+    const char *name_;
+    int64_t startNs_;
+};
+
+}  // namespace chatterino::trace
@@ -4,6 +4,7 @@
 #include "common/Modes.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "debug/StartupTimeline.hpp"
 #include "providers/IvrApi.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
 #include "providers/twitch/api/Helix.hpp"
@@ -32,6 +33,8 @@ using namespace chatterino;
 
 int main(int argc, char **argv)
 {
+    startup::begin();
+
     QApplication a(argc, argv);
 
     QCoreApplication::setApplicationName("chatterino");
@@ -67,6 +70,8 @@ int main(int argc, char **argv)
     ipc::initPaths(paths.get());
 
     const Args args(a, *paths);
+    startup::setEnabled(args.startupTimeline);
+    startup::mark("arguments parsed");
 
 #ifdef CHATTERINO_WITH_CRASHPAD
     const auto crashpadHandler = installCrashHandler(args, *paths);
@@ -123,6 +128,7 @@ int main(int argc, char **argv)
 
         IvrApi::initialize();
         Helix::initialize();
+        startup::mark("settings loaded");
 
         runGui(a, *paths, settings, args, updates);
     }
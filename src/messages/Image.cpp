@@ -7,6 +7,7 @@
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Trace.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/helper/GifTimer.hpp"
 #include "singletons/WindowManager.hpp"
@@ -21,6 +22,7 @@
 #include <QNetworkRequest>
 #include <QTimer>
 
+#include <algorithm>
 #include <atomic>
 
 // Duration between each check of every Image instance
@@ -49,29 +51,15 @@ Frames::Frames(QList<Frame> &&frames)
     {
         DebugCount::increase("animated images");
 
-        this->gifTimerConnection_ =
-            getApp()->getEmotes()->getGIFTimer().signal.connect([this] {
-                this->advance();
-            });
-
-        auto totalLength =
-            std::accumulate(this->items_.begin(), this->items_.end(), 0UL,
-                            [](auto init, auto &&frame) {
-                                return init + frame.duration;
-                            });
-
-        if (totalLength == 0)
-        {
-            this->durationOffset_ = 0;
-        }
-        else
+        // All images with the same frame durations show the same frame at
+        // the same time
+        uint64_t end = 0;
+        this->frameEnds_.reserve(static_cast<size_t>(this->items_.size()));
+        for (const auto &frame : this->items_)
         {
-            this->durationOffset_ = std::min<int>(
-                int(getApp()->getEmotes()->getGIFTimer().position() %
-                    totalLength),
-                60000);
+            end += static_cast<uint64_t>(std::max(frame.duration, 1));
+            this->frameEnds_.push_back(end);
         }
-        this->processOffset();
     }
 
     DebugCount::increase("image bytes", this->memoryUsage());
@@ -93,8 +81,6 @@ Frames::~Frames()
     }
     DebugCount::decrease("image bytes", this->memoryUsage());
     DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
-
-    this->gifTimerConnection_.disconnect();
 }
 
 int64_t Frames::memoryUsage() const
@@ -111,33 +97,12 @@ int64_t Frames::memoryUsage() const
     return usage;
 }
 
-void Frames::advance()
+QList<Frame>::size_type Frames::frameAt(uint64_t position) const
 {
-    this->durationOffset_ += GIF_FRAME_LENGTH;
-    this->processOffset();
-}
-
-void Frames::processOffset()
-{
-    if (this->items_.isEmpty())
-    {
-        return;
-    }
-
-    while (true)
-    {
-        this->index_ %= this->items_.size();
-
-        if (this->durationOffset_ > this->items_[this->index_].duration)
-        {
-            this->durationOffset_ -= this->items_[this->index_].duration;
-            this->index_ = (this->index_ + 1) % this->items_.size();
-        }
-        else
-        {
-            break;
-        }
-    }
+    auto offset = position % this->frameEnds_.back();
+    auto it = std::upper_bound(this->frameEnds_.begin(), this->frameEnds_.end(),
+                               offset);
+    return static_cast<QList<Frame>::size_type>(it - this->frameEnds_.begin());
 }
 
 void Frames::clear()
@@ -151,9 +116,7 @@ void Frames::clear()
     DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
 
     this->items_.clear();
-    this->index_ = 0;
-    this->durationOffset_ = 0;
-    this->gifTimerConnection_.disconnect();
+    this->frameEnds_.clear();
 }
 
 bool Frames::empty() const
@@ -172,8 +135,13 @@ std::optional<QPixmap> Frames::current() const
     {
         return std::nullopt;
     }
+    if (!this->animated())
+    {
+        return this->items_.front().image;
+    }
 
-    return this->items_[this->index_].image;
+    auto position = getApp()->getEmotes()->getGIFTimer().position();
+    return this->items_[this->frameAt(position)].image;
 }
 
 std::optional<QPixmap> Frames::first() const
@@ -186,8 +154,22 @@ std::optional<QPixmap> Frames::first() const
     return this->items_.front().image;
 }
 
+std::optional<uint64_t> Frames::nextFrameChange() const
+{
+    if (!this->animated())
+    {
+        return std::nullopt;
+    }
+
+    auto position = getApp()->getEmotes()->getGIFTimer().position();
+    auto loopStart = position - position % this->frameEnds_.back();
+    return loopStart + this->frameEnds_[this->frameAt(position)];
+}
+
 QList<Frame> readFrames(QImageReader &reader, const Url &url)
 {
+    trace::Span span(trace::category::IMAGE, "readFrames");
+
     QList<Frame> frames;
     frames.reserve(reader.imageCount());
 
@@ -438,6 +420,13 @@ bool Image::animated() const
     return this->frames_->animated();
 }
 
+std::optional<uint64_t> Image::nextFrameChange() const
+{
+    assertInGuiThread();
+
+    return this->frames_->nextFrameChange();
+}
+
 int Image::width() const
 {
     assertInGuiThread();
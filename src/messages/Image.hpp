@@ -16,6 +16,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace chatterino {
 
@@ -46,17 +47,22 @@ public:
     void clear();
     bool empty() const;
     bool animated() const;
-    void advance();
+    /// The frame at the current position of the GIFTimer
     std::optional<QPixmap> current() const;
     std::optional<QPixmap> first() const;
+    /// The position of the GIFTimer at which current() changes next.
+    /// Empty if the image isn't animated.
+    std::optional<uint64_t> nextFrameChange() const;
 
 private:
     int64_t memoryUsage() const;
-    void processOffset();
+    /// Index of the frame shown at `position` (in the timer's time)
+    QList<Frame>::size_type frameAt(uint64_t position) const;
+
     QList<Frame> items_;
-    QList<Frame>::size_type index_{0};
-    int durationOffset_{0};
-    pajlada::Signals::Connection gifTimerConnection_;
+    /// The time at which each frame ends, relative to the start of the
+    /// animation
+    std::vector<uint64_t> frameEnds_;
 };
 
 QList<Frame> readFrames(QImageReader &reader, const Url &url);
@@ -99,6 +105,9 @@ public:
     int width() const;
     int height() const;
     bool animated() const;
+    /// The position of the GIFTimer at which the frame of this image changes.
+    /// Empty if the image isn't animated.
+    std::optional<uint64_t> nextFrameChange() const;
 
     bool operator==(const Image &image) = delete;
     bool operator!=(const Image &image) = delete;
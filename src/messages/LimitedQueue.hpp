@@ -2,12 +2,19 @@
 
 #include "messages/LimitedQueueSnapshot.hpp"
 
-#include <boost/circular_buffer.hpp>
+#include <QString>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
@@ -15,10 +22,20 @@ namespace chatterino {
 template <typename T>
 class LimitedQueue
 {
+    using State = detail::LimitedQueueState<T>;
+    using Chunk = typename State::Chunk;
+
 public:
+    /// Maximum number of items stored in one chunk of the backing store
+    static constexpr size_t MAX_CHUNK_SIZE = 256;
+
+    /// Returns the keys an item can be looked up by (see findByKey)
+    using IndexKeys = std::function<std::vector<QString>(const T &)>;
+
     LimitedQueue(size_t limit = 1000)
         : limit_(limit)
-        , buffer_(limit)
+        , chunkSize_(std::clamp<size_t>(limit, 1, MAX_CHUNK_SIZE))
+        , state_(std::make_shared<State>(this->chunkSize_))
     {
     }
 
@@ -31,7 +48,7 @@ private:
      */
     [[nodiscard]] size_t space() const
     {
-        return this->limit() - this->buffer_.size();
+        return this->limit_ - this->state_->size;
     }
 
 public:
@@ -40,6 +57,8 @@ public:
      */
     [[nodiscard]] size_t limit() const
     {
+        std::shared_lock lock(this->mutex_);
+
         return this->limit_;
     }
 
@@ -50,7 +69,7 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        return this->buffer_.empty();
+        return this->state_->size == 0;
     }
 
     /// Value Accessors
@@ -66,12 +85,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->state_->size)
         {
             return std::nullopt;
         }
 
-        return this->buffer_[index];
+        return this->state_->at(index);
     }
 
     /**
@@ -83,12 +102,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->state_->size == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.front();
+        return this->state_->at(0);
     }
 
     /**
@@ -100,12 +119,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->state_->size == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.back();
+        return this->state_->at(this->state_->size - 1);
     }
 
     /// Modifiers
@@ -115,7 +134,66 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        this->buffer_.clear();
+        this->state_ = std::make_shared<State>(this->chunkSize_);
+        this->index_.clear();
+        this->itemKeys_.clear();
+        this->firstSeq_ = 0;
+    }
+
+    /**
+     * @brief Index the items by the keys returned from `keys`
+     *
+     * The index is kept up to date when items are added, replaced or
+     * evicted. `keys` is called once for every item when it's added and the
+     * keys are stored until the item is removed, so the keys of an item must
+     * not change while it's in the queue.
+     *
+     * @param keys the function returning the keys of an item
+     */
+    void setIndexKeys(IndexKeys keys)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        this->indexKeys_ = std::move(keys);
+        this->itemKeys_.clear();
+        if (this->indexKeys_)
+        {
+            for (size_t i = 0; i < this->state_->size; ++i)
+            {
+                this->itemKeys_.push_back(
+                    this->indexKeys_(this->state_->at(i)));
+            }
+        }
+        this->rebuildIndex();
+    }
+
+    /**
+     * @brief Change the limit of the queue
+     *
+     * If the queue holds more items than the new limit, items are removed
+     * from the front.
+     *
+     * @param limit the new limit
+     * @return the number of items that were removed
+     */
+    size_t setLimit(size_t limit)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        this->limit_ = limit;
+        if (this->state_->size <= limit)
+        {
+            return 0;
+        }
+
+        auto &state = this->writableState();
+        size_t nRemoved = state.size - limit;
+        for (size_t i = 0; i < nRemoved; i++)
+        {
+            this->removeFrontFromIndex();
+            this->popFront(state);
+        }
+        return nRemoved;
     }
 
     /**
@@ -129,13 +207,7 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
-        if (full)
-        {
-            deleted = this->buffer_.front();
-        }
-        this->buffer_.push_back(item);
-        return full;
+        return this->pushBackLocked(item, &deleted);
     }
 
     /**
@@ -148,9 +220,7 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
-        this->buffer_.push_back(item);
-        return full;
+        return this->pushBackLocked(item, nullptr);
     }
 
     /**
@@ -168,16 +238,25 @@ public:
         std::unique_lock lock(this->mutex_);
 
         size_t numToPush = std::min(items.size(), this->space());
-        std::vector<T> pushed;
-        pushed.reserve(numToPush);
+        std::vector<T> pushed(items.end() - numToPush, items.end());
+        if (pushed.empty())
+        {
+            return pushed;
+        }
 
-        size_t f = items.size() - numToPush;
-        size_t b = items.size() - 1;
-        for (; f < items.size(); ++f, --b)
+        std::vector<T> all;
+        all.reserve(pushed.size() + this->state_->size);
+        all.insert(all.end(), pushed.begin(), pushed.end());
+        this->appendItemsTo(all);
+        this->state_ = this->makeState(all);
+        if (this->indexKeys_)
         {
-            this->buffer_.push_front(items[b]);
-            pushed.push_back(items[f]);
+            for (auto it = pushed.rbegin(); it != pushed.rend(); ++it)
+            {
+                this->itemKeys_.push_front(this->indexKeys_(*it));
+            }
         }
+        this->rebuildIndex();
 
         return pushed;
     }
@@ -196,12 +275,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (int i = 0; i < this->buffer_.size(); ++i)
+        for (size_t i = 0; i < this->state_->size; ++i)
         {
-            if (eq(this->buffer_[i], needle))
+            if (eq(this->state_->at(i), needle))
             {
-                this->buffer_[i] = replacement;
-                return i;
+                this->replaceAt(i, replacement);
+                return static_cast<int>(i);
             }
         }
         return -1;
@@ -218,12 +297,12 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->state_->size)
         {
             return false;
         }
 
-        this->buffer_[index] = replacement;
+        this->replaceAt(index, replacement);
         return true;
     }
 
@@ -241,11 +320,11 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        for (size_t i = 0; i < this->state_->size; ++i)
         {
-            if (eq(*it, needle))
+            if (eq(this->state_->at(i), needle))
             {
-                this->buffer_.insert(it, item);
+                this->insertAt(i, item);
                 return true;
             }
         }
@@ -267,12 +346,11 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        for (size_t i = 0; i < this->state_->size; ++i)
         {
-            if (eq(*it, needle))
+            if (eq(this->state_->at(i), needle))
             {
-                ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
+                this->insertAt(i + 1, item);
                 return true;
             }
         }
@@ -280,10 +358,61 @@ public:
         return false;
     }
 
+    /**
+     * @brief Returns a snapshot of the current contents
+     *
+     * This doesn't copy any items. Modifications of the queue copy the
+     * parts of the store that are still referenced by a snapshot.
+     */
     [[nodiscard]] LimitedQueueSnapshot<T> getSnapshot() const
     {
         std::shared_lock lock(this->mutex_);
-        return LimitedQueueSnapshot<T>(this->buffer_);
+        return LimitedQueueSnapshot<T>(this->state_);
+    }
+
+    /**
+     * @brief Returns the items indexed under `key` from front to back
+     *
+     * This is empty if no index was set up with setIndexKeys.
+     */
+    [[nodiscard]] std::vector<T> findByKey(const QString &key) const
+    {
+        return this->findByKeys({key});
+    }
+
+    /**
+     * @brief Returns the items indexed under any of `keys` from front to back
+     *
+     * Items with multiple matching keys are only returned once.
+     */
+    [[nodiscard]] std::vector<T> findByKeys(
+        const std::vector<QString> &keys) const
+    {
+        std::shared_lock lock(this->mutex_);
+
+        std::vector<int64_t> seqs;
+        for (const auto &key : keys)
+        {
+            auto it = this->index_.find(key);
+            if (it != this->index_.end())
+            {
+                seqs.insert(seqs.end(), it->second.begin(), it->second.end());
+            }
+        }
+        if (keys.size() > 1)
+        {
+            std::sort(seqs.begin(), seqs.end());
+            seqs.erase(std::unique(seqs.begin(), seqs.end()), seqs.end());
+        }
+
+        std::vector<T> items;
+        items.reserve(seqs.size());
+        for (auto seq : seqs)
+        {
+            items.push_back(
+                this->state_->at(static_cast<size_t>(seq - this->firstSeq_)));
+        }
+        return items;
     }
 
     // Actions
@@ -304,8 +433,9 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (const auto &item : this->buffer_)
+        for (size_t i = 0; i < this->state_->size; ++i)
         {
+            const auto &item = this->state_->at(i);
             if (pred(item))
             {
                 return item;
@@ -331,11 +461,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (auto it = this->buffer_.rbegin(); it != this->buffer_.rend(); ++it)
+        for (size_t i = this->state_->size; i > 0; --i)
         {
-            if (pred(*it))
+            const auto &item = this->state_->at(i - 1);
+            if (pred(item))
             {
-                return *it;
+                return item;
             }
         }
 
@@ -343,10 +474,316 @@ public:
     }
 
 private:
+    /// Returns true if nothing but `ptr` refers to the object.
+    ///
+    /// Snapshots are only created while holding the lock, so the use count
+    /// can only go down while we're writing.
+    template <typename U>
+    static bool isUnique(const std::shared_ptr<U> &ptr)
+    {
+        if (ptr.use_count() != 1)
+        {
+            return false;
+        }
+        // Reads through a snapshot that was just released on another thread
+        // must happen before our writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    /// Returns the current state, copying it first if a snapshot refers to it
+    State &writableState()
+    {
+        if (!isUnique(this->state_))
+        {
+            this->state_ = std::make_shared<State>(*this->state_);
+        }
+        return *this->state_;
+    }
+
+    /// Returns the item at `index`, copying its chunk first if a snapshot
+    /// can see it
+    T &writableItem(size_t index)
+    {
+        auto &state = this->writableState();
+        auto pos = state.offset + index;
+        auto &chunk = state.chunks[pos / state.chunkSize];
+        if (!isUnique(chunk))
+        {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        return (*chunk)[pos % state.chunkSize];
+    }
+
+    bool pushBackLocked(const T &item, T *deleted)
+    {
+        if (this->limit_ == 0)
+        {
+            return false;
+        }
+
+        auto &state = this->writableState();
+
+        bool full = state.size == this->limit_;
+        if (full)
+        {
+            if (deleted != nullptr)
+            {
+                *deleted = state.at(0);
+            }
+            this->removeFrontFromIndex();
+            this->popFront(state);
+        }
+        if (this->indexKeys_)
+        {
+            auto keys = this->indexKeys_(item);
+            this->addToIndex(keys, this->firstSeq_ + int64_t(state.size));
+            this->itemKeys_.push_back(std::move(keys));
+        }
+
+        // Slots past the end were never visible to a snapshot, so they can be
+        // written even if the chunk is shared
+        auto pos = state.offset + state.size;
+        if (pos == state.chunks.size() * state.chunkSize)
+        {
+            state.chunks.emplace_back(
+                std::make_shared<Chunk>(state.chunkSize));
+        }
+        (*state.chunks[pos / state.chunkSize])[pos % state.chunkSize] = item;
+        state.size++;
+
+        return full;
+    }
+
+    void replaceAt(size_t index, const T &replacement)
+    {
+        if (this->indexKeys_)
+        {
+            auto seq = this->firstSeq_ + int64_t(index);
+            auto &keys = this->itemKeys_[index];
+            this->removeFromIndex(keys, seq);
+            keys = this->indexKeys_(replacement);
+            this->addToIndex(keys, seq);
+        }
+        this->writableItem(index) = replacement;
+    }
+
+    void popFront(State &state)
+    {
+        auto &front = state.chunks.front();
+        if (isUnique(front))
+        {
+            // Release the item now instead of when the chunk is dropped
+            (*front)[state.offset] = T{};
+        }
+
+        state.offset++;
+        state.size--;
+        if (state.offset == state.chunkSize)
+        {
+            state.chunks.erase(state.chunks.begin());
+            state.offset = 0;
+        }
+    }
+
+    /// Inserts `item` at `index` with the semantics of
+    /// boost::circular_buffer::insert - if the queue is full, the first item
+    /// is removed and nothing is inserted at the front.
+    void insertAt(size_t index, const T &item)
+    {
+        if (index == this->state_->size)
+        {
+            this->pushBackLocked(item, nullptr);
+            return;
+        }
+
+        bool full = this->state_->size == this->limit_;
+        if (full && index == 0)
+        {
+            return;
+        }
+
+        std::vector<T> all;
+        all.reserve(this->state_->size + 1);
+        this->appendItemsTo(all);
+        all.insert(all.begin() + static_cast<ptrdiff_t>(index), item);
+        if (full)
+        {
+            all.erase(all.begin());
+        }
+        this->state_ = this->makeState(all);
+        if (this->indexKeys_)
+        {
+            this->itemKeys_.insert(
+                this->itemKeys_.begin() + static_cast<ptrdiff_t>(index),
+                this->indexKeys_(item));
+            if (full)
+            {
+                this->itemKeys_.pop_front();
+            }
+        }
+        this->rebuildIndex();
+    }
+
+    void appendItemsTo(std::vector<T> &items) const
+    {
+        for (size_t i = 0; i < this->state_->size; ++i)
+        {
+            items.push_back(this->state_->at(i));
+        }
+    }
+
+    /// Items are indexed by their sequence number, which doesn't change when
+    /// items are evicted from the front. Inserting items in the middle or at
+    /// the front renumbers all items.
+    void addToIndex(const std::vector<QString> &keys, int64_t seq)
+    {
+        for (const auto &key : keys)
+        {
+            this->index_[key].add(seq);
+        }
+    }
+
+    void removeFromIndex(const std::vector<QString> &keys, int64_t seq)
+    {
+        for (const auto &key : keys)
+        {
+            auto entry = this->index_.find(key);
+            if (entry == this->index_.end())
+            {
+                continue;
+            }
+
+            entry->second.remove(seq);
+            if (entry->second.empty())
+            {
+                this->index_.erase(entry);
+            }
+        }
+    }
+
+    /// Removes the first item from the index before it's evicted
+    void removeFrontFromIndex()
+    {
+        if (this->indexKeys_)
+        {
+            this->removeFromIndex(this->itemKeys_.front(), this->firstSeq_);
+            this->itemKeys_.pop_front();
+        }
+        this->firstSeq_++;
+    }
+
+    /// Rebuilds the index from the stored keys
+    void rebuildIndex()
+    {
+        assert(!this->indexKeys_ ||
+               this->itemKeys_.size() == this->state_->size);
+
+        this->index_.clear();
+        this->firstSeq_ = 0;
+        for (size_t i = 0; i < this->itemKeys_.size(); ++i)
+        {
+            this->addToIndex(this->itemKeys_[i], int64_t(i));
+        }
+    }
+
+    std::shared_ptr<State> makeState(const std::vector<T> &items) const
+    {
+        auto state = std::make_shared<State>(this->chunkSize_);
+        for (size_t i = 0; i < items.size(); i += this->chunkSize_)
+        {
+            auto chunk = std::make_shared<Chunk>(this->chunkSize_);
+            auto count = std::min(this->chunkSize_, items.size() - i);
+            std::copy_n(items.begin() + static_cast<ptrdiff_t>(i), count,
+                        chunk->begin());
+            state->chunks.emplace_back(std::move(chunk));
+        }
+        state->size = items.size();
+        return state;
+    }
+
     mutable std::shared_mutex mutex_;
 
-    const size_t limit_;
-    boost::circular_buffer<T> buffer_;
+    size_t limit_;
+    const size_t chunkSize_;
+    std::shared_ptr<State> state_;
+
+    /// Sequence numbers of the items with one key in ascending order.
+    ///
+    /// Items are added at the back and evicted from the front, so evicting
+    /// only advances `head`. The unused front is dropped once it makes up
+    /// half of the vector.
+    class Postings
+    {
+    public:
+        [[nodiscard]] bool empty() const
+        {
+            return this->head_ == this->seqs_.size();
+        }
+
+        [[nodiscard]] auto begin() const
+        {
+            return this->seqs_.begin() + static_cast<ptrdiff_t>(this->head_);
+        }
+
+        [[nodiscard]] auto end() const
+        {
+            return this->seqs_.end();
+        }
+
+        void add(int64_t seq)
+        {
+            if (this->empty() || this->seqs_.back() < seq)
+            {
+                this->seqs_.push_back(seq);
+                return;
+            }
+
+            auto it = std::lower_bound(this->begin(), this->end(), seq);
+            if (it == this->end() || *it != seq)
+            {
+                this->seqs_.insert(it, seq);
+            }
+        }
+
+        void remove(int64_t seq)
+        {
+            if (this->empty())
+            {
+                return;
+            }
+
+            if (this->seqs_[this->head_] == seq)
+            {
+                this->head_++;
+                if (this->head_ * 2 >= this->seqs_.size())
+                {
+                    this->seqs_.erase(this->seqs_.begin(), this->begin());
+                    this->head_ = 0;
+                }
+                return;
+            }
+
+            auto it = std::lower_bound(this->begin(), this->end(), seq);
+            if (it != this->end() && *it == seq)
+            {
+                this->seqs_.erase(it);
+            }
+        }
+
+    private:
+        std::vector<int64_t> seqs_;
+        size_t head_ = 0;
+    };
+
+    IndexKeys indexKeys_;
+    /// key -> sequence numbers of the items with that key
+    std::unordered_map<QString, Postings> index_;
+    /// The keys of every item in the queue, computed once when the item was
+    /// added. Empty if no index was set up.
+    std::deque<std::vector<QString>> itemKeys_;
+    /// Sequence number of the first item
+    int64_t firstSeq_ = 0;
 };
 
 }  // namespace chatterino
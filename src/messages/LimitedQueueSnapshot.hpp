@@ -1,8 +1,9 @@
 #pragma once
 
-#include <boost/circular_buffer.hpp>
-
 #include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -11,52 +12,191 @@ namespace chatterino {
 template <typename T>
 class LimitedQueue;
 
+namespace detail {
+
+    /// The contents of a LimitedQueue at one point in time.
+    ///
+    /// Items are stored in fixed-size chunks. A state is never modified once
+    /// a snapshot refers to it, the queue copies the (small) list of chunks
+    /// instead. Chunks are shared between states and only copied when an item
+    /// that a snapshot can see is replaced.
+    template <typename T>
+    struct LimitedQueueState {
+        using Chunk = std::vector<T>;
+
+        explicit LimitedQueueState(size_t chunkSize_)
+            : chunkSize(chunkSize_)
+        {
+        }
+
+        const T &at(size_t index) const
+        {
+            assert(index < this->size);
+            auto pos = this->offset + index;
+            return (*this->chunks[pos / this->chunkSize])[pos %
+                                                          this->chunkSize];
+        }
+
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        size_t chunkSize;
+        /// Index of the first item in the first chunk
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+}  // namespace detail
+
+/// An immutable view of a LimitedQueue.
+///
+/// Taking a snapshot doesn't copy any items, so it's cheap enough to do on
+/// every paint. The snapshot can be read without holding the queue's lock.
 template <typename T>
 class LimitedQueueSnapshot
 {
 private:
+    using State = detail::LimitedQueueState<T>;
+
     friend class LimitedQueue<T>;
 
-    LimitedQueueSnapshot(const boost::circular_buffer<T> &buf)
-        : buffer_(buf.begin(), buf.end())
+    LimitedQueueSnapshot(std::shared_ptr<const State> state)
+        : state_(std::move(state))
     {
     }
 
 public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        Iterator() = default;
+
+        Iterator(const State *state, size_t index)
+            : state_(state)
+            , index_(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return this->state_->at(this->index_);
+        }
+
+        pointer operator->() const
+        {
+            return &this->state_->at(this->index_);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return this->state_->at(this->index_ + n);
+        }
+
+        Iterator &operator++()
+        {
+            ++this->index_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++this->index_;
+            return copy;
+        }
+
+        Iterator &operator--()
+        {
+            --this->index_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --this->index_;
+            return copy;
+        }
+
+        Iterator &operator+=(difference_type n)
+        {
+            this->index_ += n;
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type n)
+        {
+            this->index_ -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator &a, const Iterator &b)
+        {
+            return static_cast<difference_type>(a.index_) -
+                   static_cast<difference_type>(b.index_);
+        }
+
+        bool operator==(const Iterator &other) const = default;
+        auto operator<=>(const Iterator &other) const = default;
+
+    private:
+        const State *state_ = nullptr;
+        size_t index_ = 0;
+    };
+
     LimitedQueueSnapshot() = default;
 
     size_t size() const
     {
-        return this->buffer_.size();
+        return this->state_ ? this->state_->size : 0;
     }
 
     const T &operator[](size_t index) const
     {
-        return this->buffer_[index];
+        return this->state_->at(index);
     }
 
-    auto begin() const
+    Iterator begin() const
     {
-        return this->buffer_.begin();
+        return {this->state_.get(), 0};
     }
 
-    auto end() const
+    Iterator end() const
     {
-        return this->buffer_.end();
+        return {this->state_.get(), this->size()};
     }
 
     auto rbegin() const
     {
-        return this->buffer_.rbegin();
+        return std::reverse_iterator<Iterator>(this->end());
     }
 
     auto rend() const
     {
-        return this->buffer_.rend();
+        return std::reverse_iterator<Iterator>(this->begin());
     }
 
 private:
-    std::vector<T> buffer_;
+    std::shared_ptr<const State> state_;
 };
 
 }  // namespace chatterino
@@ -14,6 +14,8 @@
 #include <QJsonObject>
 #include <QJsonValue>
 
+#include <algorithm>
+
 namespace chatterino {
 
 using namespace literals;
@@ -121,6 +123,38 @@ std::shared_ptr<const Message> Message::cloneWith(
     return std::move(cloned);
 }
 
+void Message::invalidateLayouts() const
+{
+    this->layoutRevision.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<QString> Message::userKeys() const
+{
+    std::vector<QString> keys;
+    auto add = [&](const QString &name) {
+        if (name.isEmpty())
+        {
+            return;
+        }
+        auto key = name.toLower();
+        if (std::find(keys.begin(), keys.end(), key) == keys.end())
+        {
+            keys.emplace_back(std::move(key));
+        }
+    };
+
+    add(this->loginName);
+    add(this->displayName);
+    add(this->timeoutUser);
+    if (this->flags.has(MessageFlag::Subscription) && this->loginName.isEmpty())
+    {
+        // Sub messages without an author start with the subscriber's name
+        add(this->messageText.section(' ', 0, 0));
+    }
+
+    return keys;
+}
+
 QJsonObject Message::toJson() const
 {
     QJsonObject msg{
@@ -7,6 +7,7 @@
 #include <QColor>
 #include <QTime>
 
+#include <atomic>
 #include <cinttypes>
 #include <functional>
 #include <memory>
@@ -41,6 +42,9 @@ struct Message {
     // const-correct way to deal with this is.
     // This might bring race conditions with it
     mutable MessageFlags flags;
+    /// Incremented when the message changed in a way that requires its
+    /// layouts to be redone (see invalidateLayouts)
+    mutable std::atomic<uint32_t> layoutRevision{0};
     QTime parseTime;
     QString id;
     QString searchText;
@@ -65,6 +69,16 @@ struct Message {
 
     ScrollbarHighlight getScrollBarHighlight() const;
 
+    /// Makes all layouts of this message lay it out again the next time
+    /// they're laid out (e.g. after it was disabled).
+    /// This doesn't ask any view to layout, see
+    /// WindowManager::layoutChannelViews for that.
+    void invalidateLayouts() const;
+
+    /// Lowercase names of the users this message is from or about.
+    /// Channels index their messages by these (see Channel::findMessagesByUser).
+    std::vector<QString> userKeys() const;
+
     std::shared_ptr<ChannelPointReward> reward = nullptr;
 
     /**
@@ -0,0 +1,390 @@
+#include "messages/MessageArchive.hpp"
+
+#include "messages/Link.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageColor.hpp"
+#include "messages/MessageElement.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+/// Texts are appended to arenas of this size
+constexpr size_t ARENA_SIZE = 64 * 1024;
+
+/// Bytes used by one entry in all columns
+constexpr size_t BYTES_PER_MESSAGE =
+    sizeof(int64_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(QRgb) +
+    sizeof(uint64_t) + sizeof(uint32_t);
+
+/// Rough overhead of an interned string in the table and its map
+constexpr size_t BYTES_PER_STRING = 96;
+
+/// Flags that are restored on archived messages. Other flags refer to data
+/// that isn't archived (e.g. highlight colors and reply threads).
+const MessageFlags ARCHIVED_FLAGS{
+    MessageFlag::System,     MessageFlag::Timeout,
+    MessageFlag::Untimeout,  MessageFlag::Disabled,
+    MessageFlag::Action,     MessageFlag::Subscription,
+    MessageFlag::FirstMessage,
+};
+
+}  // namespace
+
+namespace chatterino {
+
+MessageArchiveBudget::MessageArchiveBudget(size_t limit)
+    : limit_(limit)
+{
+}
+
+size_t MessageArchiveBudget::limit() const
+{
+    return this->limit_;
+}
+
+size_t MessageArchiveBudget::usage() const
+{
+    return this->usage_.load(std::memory_order_relaxed);
+}
+
+void MessageArchiveBudget::add(MessageArchive *archive)
+{
+    std::lock_guard lock(this->mutex_);
+    this->archives_.push_back(archive);
+}
+
+void MessageArchiveBudget::remove(MessageArchive *archive)
+{
+    std::lock_guard lock(this->mutex_);
+    std::erase(this->archives_, archive);
+}
+
+void MessageArchiveBudget::trim()
+{
+    if (this->usage() <= this->limit_)
+    {
+        return;
+    }
+
+    std::lock_guard lock(this->mutex_);
+    while (this->usage() > this->limit_)
+    {
+        MessageArchive *victim = nullptr;
+        for (auto *archive : this->archives_)
+        {
+            if (archive->size() == 0)
+            {
+                continue;
+            }
+            if (victim == nullptr ||
+                archive->lastViewed_.load(std::memory_order_relaxed) <
+                    victim->lastViewed_.load(std::memory_order_relaxed))
+            {
+                victim = archive;
+            }
+        }
+        if (victim == nullptr)
+        {
+            return;
+        }
+
+        victim->dropOldest(this->usage() - this->limit_);
+    }
+}
+
+uint64_t MessageArchiveBudget::nextViewTick()
+{
+    return this->viewTicks_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+MessageArchive::MessageArchive(std::shared_ptr<MessageArchiveBudget> budget)
+    : budget_(std::move(budget))
+{
+    this->markViewed();
+    this->budget_->add(this);
+}
+
+MessageArchive::~MessageArchive()
+{
+    // This waits for a trim that might drop messages of this archive
+    this->budget_->remove(this);
+
+    std::lock_guard lock(this->mutex_);
+    this->budget_->usage_ -= this->reportedUsage_;
+    DebugCount::decrease("archived messages",
+                         static_cast<int64_t>(this->times_.size()));
+}
+
+void MessageArchive::add(const Message &message)
+{
+    auto time = message.serverReceivedTime.isValid()
+                    ? message.serverReceivedTime
+                    : QDateTime(QDate::currentDate(), message.parseTime);
+    auto text = message.messageText.toUtf8();
+
+    std::unique_lock lock(this->mutex_);
+
+    this->times_.push_back(time.toMSecsSinceEpoch());
+    this->flags_.push_back(static_cast<uint64_t>(message.flags.value()));
+    this->loginNames_.push_back(this->intern(message.loginName));
+    this->displayNames_.push_back(this->intern(message.displayName));
+    this->colors_.push_back(message.usernameColor.rgba());
+    this->textOffsets_.push_back(this->appendText(text));
+    this->textLengths_.push_back(static_cast<uint32_t>(text.size()));
+    DebugCount::increase("archived messages");
+
+    this->updateUsageLocked();
+    lock.unlock();
+
+    this->budget_->trim();
+}
+
+std::vector<MessagePtr> MessageArchive::materialize(uint64_t begin,
+                                                    uint64_t end) const
+{
+    std::lock_guard lock(this->mutex_);
+
+    begin = std::max(begin, this->firstSeq_);
+    end = std::min<uint64_t>(end, this->firstSeq_ + this->times_.size());
+
+    std::vector<MessagePtr> messages;
+    if (begin >= end)
+    {
+        return messages;
+    }
+    messages.reserve(static_cast<size_t>(end - begin));
+
+    for (auto seq = begin; seq < end; seq++)
+    {
+        auto i = static_cast<size_t>(seq - this->firstSeq_);
+
+        auto flags = MessageFlags(static_cast<MessageFlag>(this->flags_[i]));
+        const auto &loginName = this->interned(this->loginNames_[i]);
+        const auto &displayName = this->interned(this->displayNames_[i]);
+        auto color = QColor::fromRgba(this->colors_[i]);
+        auto text = this->text(this->textOffsets_[i], this->textLengths_[i]);
+        auto time = QDateTime::fromMSecsSinceEpoch(this->times_[i]);
+
+        MessageBuilder builder;
+        builder.emplace<TimestampElement>(time.time());
+
+        bool isSystem = flags.has(MessageFlag::System) || loginName.isEmpty();
+        if (isSystem)
+        {
+            builder.emplace<TextElement>(text, MessageElementFlag::Text,
+                                         MessageColor::System);
+            builder->searchText = text;
+        }
+        else
+        {
+            bool isAction = flags.has(MessageFlag::Action);
+            auto username = isAction ? displayName : displayName + ':';
+            builder
+                .emplace<TextElement>(username, MessageElementFlag::Username,
+                                      MessageColor(color),
+                                      FontStyle::ChatMediumBold)
+                ->setLink({Link::UserInfo, loginName});
+            builder.emplace<TextElement>(
+                text, MessageElementFlag::Text,
+                isAction ? MessageColor(color) : MessageColor::Text);
+            builder->searchText = loginName + ": " + text;
+        }
+
+        builder->flags.set(MessageFlags(static_cast<MessageFlag>(
+            this->flags_[i] &
+            static_cast<uint64_t>(ARCHIVED_FLAGS.value()))));
+        builder->flags.set(MessageFlag::Archived);
+        builder->flags.set(MessageFlag::DoNotLog);
+        builder->flags.set(MessageFlag::DoNotTriggerNotification);
+        builder->parseTime = time.time();
+        builder->serverReceivedTime = time;
+        builder->loginName = loginName;
+        builder->displayName = displayName;
+        builder->localizedName = displayName;
+        builder->usernameColor = color;
+        builder->messageText = text;
+
+        messages.emplace_back(builder.release());
+    }
+
+    return messages;
+}
+
+uint64_t MessageArchive::firstSeq() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->firstSeq_;
+}
+
+uint64_t MessageArchive::endSeq() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->firstSeq_ + this->times_.size();
+}
+
+size_t MessageArchive::size() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->times_.size();
+}
+
+size_t MessageArchive::memoryUsage() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->memoryUsageLocked();
+}
+
+void MessageArchive::clear()
+{
+    std::lock_guard lock(this->mutex_);
+    while (!this->times_.empty())
+    {
+        this->dropFront();
+    }
+    this->strings_.clear();
+    this->stringIds_.clear();
+    this->stringBytes_ = 0;
+    this->updateUsageLocked();
+}
+
+void MessageArchive::markViewed()
+{
+    this->lastViewed_.store(this->budget_->nextViewTick(),
+                            std::memory_order_relaxed);
+}
+
+size_t MessageArchive::memoryUsageLocked() const
+{
+    return this->times_.size() * BYTES_PER_MESSAGE + this->arenaBytes_ +
+           this->stringBytes_;
+}
+
+void MessageArchive::updateUsageLocked()
+{
+    auto usage = this->memoryUsageLocked();
+    if (usage >= this->reportedUsage_)
+    {
+        this->budget_->usage_ += usage - this->reportedUsage_;
+    }
+    else
+    {
+        this->budget_->usage_ -= this->reportedUsage_ - usage;
+    }
+    this->reportedUsage_ = usage;
+}
+
+void MessageArchive::dropOldest(size_t bytes)
+{
+    std::lock_guard lock(this->mutex_);
+
+    auto target = this->memoryUsageLocked();
+    target = target > bytes ? target - bytes : 0;
+    while (!this->times_.empty() && this->memoryUsageLocked() > target)
+    {
+        this->dropFront();
+    }
+
+    if (this->times_.empty())
+    {
+        // Nothing refers to the interned names anymore
+        this->strings_.clear();
+        this->stringIds_.clear();
+        this->stringBytes_ = 0;
+    }
+
+    this->updateUsageLocked();
+}
+
+uint32_t MessageArchive::intern(const QString &string)
+{
+    auto it = this->stringIds_.find(string);
+    if (it != this->stringIds_.end())
+    {
+        return it->second;
+    }
+
+    auto id = static_cast<uint32_t>(this->strings_.size());
+    this->strings_.push_back(string);
+    this->stringIds_.emplace(string, id);
+    this->stringBytes_ +=
+        static_cast<size_t>(string.size()) * sizeof(QChar) + BYTES_PER_STRING;
+    return id;
+}
+
+const QString &MessageArchive::interned(uint32_t id) const
+{
+    return this->strings_[id];
+}
+
+uint64_t MessageArchive::appendText(const QByteArray &text)
+{
+    auto size = static_cast<size_t>(text.size());
+    if (this->arenas_.empty() ||
+        this->arenas_.back().bytes.size() + size >
+            this->arenas_.back().bytes.capacity())
+    {
+        Arena arena;
+        if (!this->arenas_.empty())
+        {
+            const auto &last = this->arenas_.back();
+            arena.base = last.base + last.bytes.size();
+        }
+        arena.bytes.reserve(std::max(ARENA_SIZE, size));
+        this->arenaBytes_ += arena.bytes.capacity();
+        this->arenas_.emplace_back(std::move(arena));
+    }
+
+    auto &arena = this->arenas_.back();
+    auto offset = arena.base + arena.bytes.size();
+    arena.bytes.insert(arena.bytes.end(), text.begin(), text.end());
+    return offset;
+}
+
+QString MessageArchive::text(uint64_t offset, uint32_t length) const
+{
+    // Find the last arena starting at or before offset
+    auto it = std::upper_bound(this->arenas_.begin(), this->arenas_.end(),
+                               offset, [](uint64_t value, const Arena &arena) {
+                                   return value < arena.base;
+                               });
+    assert(it != this->arenas_.begin());
+    --it;
+
+    return QString::fromUtf8(
+        it->bytes.data() + static_cast<size_t>(offset - it->base),
+        static_cast<int>(length));
+}
+
+void MessageArchive::dropFront()
+{
+    this->times_.pop_front();
+    this->flags_.pop_front();
+    this->loginNames_.pop_front();
+    this->displayNames_.pop_front();
+    this->colors_.pop_front();
+    this->textOffsets_.pop_front();
+    this->textLengths_.pop_front();
+    this->firstSeq_++;
+    DebugCount::decrease("archived messages");
+
+    // Free the arenas that only contain texts of dropped messages
+    while (!this->arenas_.empty() &&
+           (this->textOffsets_.empty() ||
+            (this->arenas_.size() > 1 &&
+             this->textOffsets_.front() >= this->arenas_[1].base)))
+    {
+        this->arenaBytes_ -= this->arenas_.front().bytes.capacity();
+        this->arenas_.pop_front();
+    }
+}
+
+}  // namespace chatterino
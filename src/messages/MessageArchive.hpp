@@ -0,0 +1,157 @@
+#pragma once
+
+#include <QRgb>
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+class MessageArchive;
+
+/// A memory limit shared by multiple archives.
+///
+/// Once all archives together use more memory than the limit, the oldest
+/// messages of the archive that was viewed least recently are dropped first.
+class MessageArchiveBudget
+{
+public:
+    explicit MessageArchiveBudget(size_t limit);
+
+    MessageArchiveBudget(const MessageArchiveBudget &) = delete;
+    MessageArchiveBudget &operator=(const MessageArchiveBudget &) = delete;
+    MessageArchiveBudget(MessageArchiveBudget &&) = delete;
+    MessageArchiveBudget &operator=(MessageArchiveBudget &&) = delete;
+
+    size_t limit() const;
+
+    /// Approximate number of bytes used by all archives
+    size_t usage() const;
+
+private:
+    friend class MessageArchive;
+
+    void add(MessageArchive *archive);
+    void remove(MessageArchive *archive);
+
+    /// Drops messages until the usage fits the limit
+    void trim();
+
+    /// Returns a value greater than all previously returned ones
+    uint64_t nextViewTick();
+
+    const size_t limit_;
+    std::atomic<size_t> usage_{0};
+    std::atomic<uint64_t> viewTicks_{0};
+
+    /// Protects `archives_`. This is locked before the mutex of an archive.
+    std::mutex mutex_;
+    std::vector<MessageArchive *> archives_;
+};
+
+/// Compact storage for the messages a channel evicted from its scrollback.
+///
+/// Archived messages are stored in columns: the time they were received,
+/// their flags, the interned names and colors of their senders and their
+/// text in UTF-8 arenas. An archived message takes a fraction of the memory
+/// of a Message with its elements. Messages are only built again (as plain
+/// text messages) when a view scrolls to them (see materialize).
+///
+/// All archives share a budget. The oldest messages are dropped once the
+/// archives use more memory than the budget allows (see
+/// MessageArchiveBudget).
+class MessageArchive
+{
+public:
+    explicit MessageArchive(std::shared_ptr<MessageArchiveBudget> budget);
+    ~MessageArchive();
+
+    MessageArchive(const MessageArchive &) = delete;
+    MessageArchive &operator=(const MessageArchive &) = delete;
+    MessageArchive(MessageArchive &&) = delete;
+    MessageArchive &operator=(MessageArchive &&) = delete;
+
+    /// Archives `message`. This can be called from any thread.
+    void add(const Message &message);
+
+    /// Builds the archived messages with sequence numbers in [begin, end)
+    /// from oldest to newest. Messages that were dropped are skipped.
+    std::vector<MessagePtr> materialize(uint64_t begin, uint64_t end) const;
+
+    /// Sequence number of the oldest archived message.
+    /// Sequence numbers are assigned in the order messages are added and are
+    /// never reused.
+    uint64_t firstSeq() const;
+    /// Sequence number the next archived message will get
+    uint64_t endSeq() const;
+
+    size_t size() const;
+
+    /// Approximate number of bytes used by the archived messages
+    size_t memoryUsage() const;
+
+    /// Removes all messages
+    void clear();
+
+    /// Marks the archive as viewed. Archives that were viewed least recently
+    /// are the first to drop messages when the budget is exceeded.
+    /// This can be called from any thread.
+    void markViewed();
+
+private:
+    friend class MessageArchiveBudget;
+
+    struct Arena {
+        /// Offset of the first byte in the text of all messages
+        uint64_t base = 0;
+        std::vector<char> bytes;
+    };
+
+    size_t memoryUsageLocked() const;
+    /// Reports the change of the memory usage to the budget
+    void updateUsageLocked();
+    /// Drops the oldest messages until at least `bytes` were freed or the
+    /// archive is empty
+    void dropOldest(size_t bytes);
+    uint32_t intern(const QString &string);
+    const QString &interned(uint32_t id) const;
+    /// Appends `text` to the arenas and returns its offset
+    uint64_t appendText(const QByteArray &text);
+    QString text(uint64_t offset, uint32_t length) const;
+    void dropFront();
+
+    const std::shared_ptr<MessageArchiveBudget> budget_;
+    std::atomic<uint64_t> lastViewed_{0};
+
+    mutable std::mutex mutex_;
+    /// The usage the budget knows about
+    size_t reportedUsage_ = 0;
+
+    // One entry per message in every column
+    std::deque<int64_t> times_;
+    std::deque<uint64_t> flags_;
+    std::deque<uint32_t> loginNames_;
+    std::deque<uint32_t> displayNames_;
+    std::deque<QRgb> colors_;
+    std::deque<uint64_t> textOffsets_;
+    std::deque<uint32_t> textLengths_;
+
+    std::deque<Arena> arenas_;
+    size_t arenaBytes_ = 0;
+
+    std::vector<QString> strings_;
+    std::unordered_map<QString, uint32_t> stringIds_;
+    size_t stringBytes_ = 0;
+
+    uint64_t firstSeq_ = 0;
+};
+
+}  // namespace chatterino
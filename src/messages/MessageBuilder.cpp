@@ -8,6 +8,7 @@
 #include "controllers/highlights/HighlightController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnoreRules.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
@@ -2063,8 +2064,8 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         parseTwitchEmotes(tags, content, static_cast<int>(messageOffset));
 
     // This runs through all ignored phrases and runs its replacements on content
-    processIgnorePhrases(*getSettings()->ignoredMessages.readOnly(), content,
-                         twitchEmotes);
+    processIgnorePhrases(getSettings()->ignoreRules()->replacePhrases(),
+                         content, twitchEmotes);
 
     std::ranges::sort(twitchEmotes, [](const auto &a, const auto &b) {
         return a.start < b.start;
@@ -137,8 +137,8 @@ void ImageElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(this->image_->width() * container.getScale(),
                           this->image_->height() * container.getScale());
 
-        container.addElement(
-            (new ImageLayoutElement(*this, this->image_, size)));
+        container.addElement(container.createElement<ImageLayoutElement>(
+            *this, this->image_, size));
     }
 }
 
@@ -176,8 +176,10 @@ void CircularImageElement::addToContainer(MessageLayoutContainer &container,
         auto imgSize = QSize(this->image_->width(), this->image_->height()) *
                        container.getScale();
 
-        container.addElement(new ImageWithCircleBackgroundLayoutElement(
-            *this, this->image_, imgSize, this->background_, this->padding_));
+        container.addElement(
+            container.createElement<ImageWithCircleBackgroundLayoutElement>(
+                *this, this->image_, imgSize, this->background_,
+                this->padding_));
     }
 }
 
@@ -237,7 +239,8 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
                 QSize(int(container.getScale() * image->width() * emoteScale),
                       int(container.getScale() * image->height() * emoteScale));
 
-            container.addElement(this->makeImageLayoutElement(image, size));
+            container.addElement(
+                this->makeImageLayoutElement(container, image, size));
         }
         else
         {
@@ -252,9 +255,10 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
 }
 
 MessageLayoutElement *EmoteElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    return new ImageLayoutElement(*this, image, size);
+    return container.createElement<ImageLayoutElement>(*this, image, size);
 }
 
 std::unique_ptr<MessageElement> EmoteElement::clone() const
@@ -321,7 +325,7 @@ void LayeredEmoteElement::addToContainer(MessageLayoutContainer &container,
             }
 
             container.addElement(this->makeImageLayoutElement(
-                images, individualSizes, largestSize));
+                container, images, individualSizes, largestSize));
         }
         else
         {
@@ -353,10 +357,11 @@ std::vector<ImagePtr> LayeredEmoteElement::getLoadedImages(float scale)
 }
 
 MessageLayoutElement *LayeredEmoteElement::makeImageLayoutElement(
-    const std::vector<ImagePtr> &images, const std::vector<QSize> &sizes,
-    QSize largestSize)
+    MessageLayoutContainer &container, const std::vector<ImagePtr> &images,
+    const std::vector<QSize> &sizes, QSize largestSize)
 {
-    return new LayeredImageLayoutElement(*this, images, sizes, largestSize);
+    return container.createElement<LayeredImageLayoutElement>(
+        *this, images, sizes, largestSize);
 }
 
 void LayeredEmoteElement::updateTooltips()
@@ -512,7 +517,8 @@ void BadgeElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(int(container.getScale() * image->width()),
                           int(container.getScale() * image->height()));
 
-        container.addElement(this->makeImageLayoutElement(image, size));
+        container.addElement(
+            this->makeImageLayoutElement(container, image, size));
     }
 }
 
@@ -522,9 +528,11 @@ EmotePtr BadgeElement::getEmote() const
 }
 
 MessageLayoutElement *BadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    auto *element = new ImageLayoutElement(*this, image, size);
+    auto *element =
+        container.createElement<ImageLayoutElement>(*this, image, size);
 
     return element;
 }
@@ -553,11 +561,12 @@ ModBadgeElement::ModBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *ModBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
     static const QColor modBadgeBackgroundColor("#34AE0A");
 
-    auto *element = new ImageWithBackgroundLayoutElement(
+    auto *element = container.createElement<ImageWithBackgroundLayoutElement>(
         *this, image, size, modBadgeBackgroundColor);
 
     return element;
@@ -586,9 +595,11 @@ VipBadgeElement::VipBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *VipBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    auto *element = new ImageLayoutElement(*this, image, size);
+    auto *element =
+        container.createElement<ImageLayoutElement>(*this, image, size);
 
     return element;
 }
@@ -617,10 +628,11 @@ FfzBadgeElement::FfzBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *FfzBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    auto *element =
-        new ImageWithBackgroundLayoutElement(*this, image, size, this->color);
+    auto *element = container.createElement<ImageWithBackgroundLayoutElement>(
+        *this, image, size, this->color);
 
     return element;
 }
@@ -696,7 +708,7 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 auto color = this->color_.getColor(ctx.messageColors);
                 app->getThemes()->normalizeColor(color);
 
-                auto *e = new TextLayoutElement(
+                auto *e = container.createElement<TextLayoutElement>(
                     *this, text, QSize(width, metrics.height()), color,
                     this->style_, this->color_.type(), container.getScale(),
                     container.getImageScale() / container.getScale());
@@ -825,7 +837,7 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
             auto color = this->color_.getColor(ctx.messageColors);
             app->getThemes()->normalizeColor(color);
 
-            auto *e = new TextLayoutElement(
+            auto *e = container.createElement<TextLayoutElement>(
                 *this, text, QSize(width, metrics.height()), color,
                 this->style_, this->color_.type(), container.getScale());
             e->setTrailingSpace(hasTrailingSpace);
@@ -899,7 +911,9 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
                         currentText.clear();
 
                         container.addElementNoLineBreak(
-                            (new ImageLayoutElement(*this, image, emoteSize))
+                            container
+                                .createElement<ImageLayoutElement>(
+                                    *this, image, emoteSize)
                                 ->setLink(this->getLink())
                                 ->setTrailingSpace(false));
                     }
@@ -1157,15 +1171,17 @@ void TwitchModerationElement::addToContainer(MessageLayoutContainer &container,
             if (auto image = action.getImage())
             {
                 container.addElement(
-                    (new ImageLayoutElement(*this, *image, size))
+                    container
+                        .createElement<ImageLayoutElement>(*this, *image, size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
             else
             {
                 container.addElement(
-                    (new TextIconLayoutElement(*this, action.getLine1(),
-                                               action.getLine2(),
-                                               container.getScale(), size))
+                    container
+                        .createElement<TextIconLayoutElement>(
+                            *this, action.getLine1(), action.getLine2(),
+                            container.getScale(), size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
         }
@@ -1238,7 +1254,8 @@ void ScalingImageElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(image->width() * container.getScale(),
                           image->height() * container.getScale());
 
-        container.addElement(new ImageLayoutElement(*this, image, size));
+        container.addElement(
+            container.createElement<ImageLayoutElement>(*this, image, size));
     }
 }
 
@@ -1276,8 +1293,9 @@ void ReplyCurveElement::addToContainer(MessageLayoutContainer &container,
     {
         float scale = container.getScale();
         container.addElement(
-            new ReplyCurveLayoutElement(*this, width * scale, thickness * scale,
-                                        radius * scale, margin * scale));
+            container.createElement<ReplyCurveLayoutElement>(
+                *this, width * scale, thickness * scale, radius * scale,
+                margin * scale));
     }
 }
 
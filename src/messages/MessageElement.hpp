@@ -409,8 +409,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         const QSize &size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size);
 
 private:
     std::unique_ptr<TextElement> textElement_;
@@ -450,8 +451,8 @@ public:
 
 private:
     MessageLayoutElement *makeImageLayoutElement(
-        const std::vector<ImagePtr> &image, const std::vector<QSize> &sizes,
-        QSize largestSize);
+        MessageLayoutContainer &container, const std::vector<ImagePtr> &image,
+        const std::vector<QSize> &sizes, QSize largestSize);
 
     QString getCopyString() const;
     void updateTooltips();
@@ -479,8 +480,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         const QSize &size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size);
     EmotePtr emote_;
 };
 
@@ -494,8 +496,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
 };
 
 class VipBadgeElement : public BadgeElement
@@ -508,8 +511,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
 };
 
 class FfzBadgeElement : public BadgeElement
@@ -523,8 +527,9 @@ public:
     QJsonObject toJson() const override;
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
     const QColor color;
 };
 
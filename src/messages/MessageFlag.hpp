@@ -6,6 +6,10 @@
 
 namespace chatterino {
 
+// This is for Lua. See scripts/make_luals_meta.py
+/**
+ * @exposeenum c2.MessageFlag
+ */
 enum class MessageFlag : std::int64_t {
     None = 0LL,
     System = (1LL << 0),
@@ -52,6 +56,8 @@ enum class MessageFlag : std::int64_t {
     Action = (1LL << 36),
     /// The message is sent in a different source channel as part of a Shared Chat session
     SharedMessage = (1LL << 37),
+    /// The message was restored from the archive of its channel (see MessageArchive)
+    Archived = (1LL << 38),
 };
 using MessageFlags = FlagsEnum<MessageFlag>;
 
@@ -1,6 +1,8 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "debug/Trace.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
@@ -36,6 +38,7 @@ namespace {
 
 MessageLayout::MessageLayout(MessagePtr message)
     : message_(std::move(message))
+    , shared_(std::make_shared<SharedMessageLayout>())
 {
     DebugCount::increase("message layout");
 }
@@ -55,15 +58,20 @@ const MessagePtr &MessageLayout::getMessagePtr() const
     return this->message_;
 }
 
+const MessageLayoutContainer &MessageLayout::container() const
+{
+    return this->shared_->container;
+}
+
 // Height
 int MessageLayout::getHeight() const
 {
-    return this->container_.getHeight();
+    return this->container().getHeight();
 }
 
 int MessageLayout::getWidth() const
 {
-    return this->container_.getWidth();
+    return this->container().getWidth();
 }
 
 // Layout
@@ -71,57 +79,102 @@ int MessageLayout::getWidth() const
 bool MessageLayout::layout(const MessageLayoutContext &ctx,
                            bool shouldInvalidateBuffer)
 {
-    //    BenchmarkGuard benchmark("MessageLayout::layout()");
+    trace::Span span(trace::category::LAYOUT, "MessageLayout::layout");
 
-    bool layoutRequired = false;
+    this->attachLayout({
+        .width = ctx.width,
+        .scale = ctx.scale,
+        .imageScale = ctx.imageScale,
+        .wordFlags = ctx.flags,
+        .expanded = this->flags.has(MessageLayoutFlag::Expanded),
+        .colors = ctx.messageColors,
+    });
+    auto &shared = *this->shared_;
 
-    // check if width changed
-    bool widthChanged = ctx.width != this->currentLayoutWidth_;
-    layoutRequired |= widthChanged;
-    this->currentLayoutWidth_ = ctx.width;
+    bool layoutRequired = shared.serial == 0;
 
     // check if layout state changed
     const auto layoutGeneration = getApp()->getWindows()->getGeneration();
-    if (this->layoutState_ != layoutGeneration)
+    if (shared.generation != layoutGeneration)
     {
         layoutRequired = true;
         this->flags.set(MessageLayoutFlag::RequiresBufferUpdate);
-        this->layoutState_ = layoutGeneration;
+        shared.generation = layoutGeneration;
     }
 
-    // check if work mask changed
-    layoutRequired |= this->currentWordFlags_ != ctx.flags;
-    this->currentWordFlags_ = ctx.flags;  // getSettings()->getWordTypeMask();
+    // check if the message itself changed (e.g. it was disabled)
+    const auto messageRevision =
+        this->message_->layoutRevision.load(std::memory_order_relaxed);
+    if (shared.messageRevision != messageRevision)
+    {
+        layoutRequired = true;
+        this->flags.set(MessageLayoutFlag::RequiresBufferUpdate);
+        shared.messageRevision = messageRevision;
+    }
 
     // check if layout was requested manually
     layoutRequired |= this->flags.has(MessageLayoutFlag::RequiresLayout);
     this->flags.unset(MessageLayoutFlag::RequiresLayout);
 
-    // check if dpi changed
-    layoutRequired |= this->scale_ != ctx.scale;
-    this->scale_ = ctx.scale;
-    layoutRequired |= this->imageScale_ != ctx.imageScale;
-    this->imageScale_ = ctx.imageScale;
+    if (layoutRequired)
+    {
+        this->actuallyLayout(ctx);
+    }
 
-    if (!layoutRequired)
+    // collapsed state
+    this->flags.unset(MessageLayoutFlag::Collapsed);
+    if (shared.container.isCollapsed())
     {
-        if (shouldInvalidateBuffer)
-        {
-            this->invalidateBuffer();
-            return true;
-        }
-        return false;
+        this->flags.set(MessageLayoutFlag::Collapsed);
     }
 
-    int oldHeight = this->container_.getHeight();
-    this->actuallyLayout(ctx);
-    if (widthChanged || this->container_.getHeight() != oldHeight)
+    // another view might have laid out the shared layout
+    if (this->seenSerial_ != shared.serial)
     {
+        this->seenSerial_ = shared.serial;
+        return true;
+    }
+
+    if (shouldInvalidateBuffer)
+    {
+        this->invalidateBuffer();
+        return true;
+    }
+    return false;
+}
+
+void MessageLayout::attachLayout(const MessageLayoutKey &key)
+{
+    if (this->shared_->key == key)
+    {
+        return;
+    }
+
+    auto &cache = MessageLayoutCache::instance();
+    if (auto shared = cache.find(this->message_.get(), key))
+    {
+        this->shared_ = std::move(shared);
+        this->seenSerial_ = 0;
         this->deleteBuffer();
+        return;
     }
-    this->invalidateBuffer();
 
-    return true;
+    if (this->shared_.use_count() > 1)
+    {
+        // Other views still show the old layout
+        this->shared_ = std::make_shared<SharedMessageLayout>();
+    }
+
+    // Lay out the message again with the new key
+    this->shared_->key = key;
+    this->shared_->serial = 0;
+    if (!this->shared_->cached)
+    {
+        cache.insert(this->message_.get(), this->shared_);
+        this->shared_->cached = true;
+    }
+    this->seenSerial_ = 0;
+    this->deleteBuffer();
 }
 
 void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
@@ -144,7 +197,8 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
     bool hideSimilar = getSettings()->hideSimilar;
     bool hideReplies = !ctx.flags.has(MessageElementFlag::RepliedMessage);
 
-    this->container_.beginLayout(ctx.width, this->scale_, this->imageScale_,
+    auto &shared = *this->shared_;
+    shared.container.beginLayout(ctx.width, ctx.scale, ctx.imageScale,
                                  messageFlags);
 
     for (const auto &element : this->message_->elements)
@@ -176,23 +230,12 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
             continue;
         }
 
-        element->addToContainer(this->container_, ctx);
-    }
-
-    if (this->height_ != this->container_.getHeight())
-    {
-        this->deleteBuffer();
+        element->addToContainer(shared.container, ctx);
     }
 
-    this->container_.endLayout();
-    this->height_ = this->container_.getHeight();
-
-    // collapsed state
-    this->flags.unset(MessageLayoutFlag::Collapsed);
-    if (this->container_.isCollapsed())
-    {
-        this->flags.set(MessageLayoutFlag::Collapsed);
-    }
+    shared.container.endLayout();
+    shared.serial++;
+    DebugCount::increase("message layouts");
 }
 
 // Painting
@@ -200,24 +243,27 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
 
-    QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
-                                         ctx.messageColors.hasTransparency);
+    auto &buffer = this->ensureBuffer(ctx);
+    auto *pixmap = &buffer.pixmap;
 
-    if (!this->bufferValid_)
+    if (buffer.serial != this->shared_->serial)
     {
         if (ctx.messageColors.hasTransparency)
         {
             pixmap->fill(Qt::transparent);
         }
         this->updateBuffer(pixmap, ctx);
+        buffer.serial = this->shared_->serial;
     }
 
+    const auto &container = this->container();
+
     // draw on buffer
     ctx.painter.drawPixmap(0, ctx.y, *pixmap);
 
     // draw gif emotes
-    result.hasAnimatedElements =
-        this->container_.paintAnimatedElements(ctx.painter, ctx.y);
+    result.hasAnimatedElements = container.paintAnimatedElements(
+        ctx.painter, ctx.y, ctx.animatedAreas);
 
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
@@ -238,21 +284,21 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
         ctx.preferences.enableRedeemedHighlight)
     {
         ctx.painter.fillRect(
-            0, ctx.y, int(this->scale_ * 4), pixmap->height(),
+            0, ctx.y, int(this->shared_->key.scale * 4), pixmap->height(),
             *ColorProvider::instance().color(ColorType::RedeemedHighlight));
     }
 
     // draw selection
     if (!ctx.selection.isEmpty())
     {
-        this->container_.paintSelection(ctx.painter, ctx.messageIndex,
+        container.paintSelection(ctx.painter, ctx.messageIndex,
                                         ctx.selection, ctx.y);
     }
 
     // draw message seperation line
     if (ctx.preferences.separateMessages)
     {
-        ctx.painter.fillRect(0, ctx.y, this->container_.getWidth() + 64, 1,
+        ctx.painter.fillRect(0, ctx.y, container.getWidth() + 64, 1,
                              ctx.messageColors.messageSeperator);
     }
 
@@ -273,37 +319,43 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 
         QBrush brush(color, ctx.preferences.lastMessagePattern);
 
-        ctx.painter.fillRect(0, ctx.y + this->container_.getHeight() - 1,
+        ctx.painter.fillRect(0, ctx.y + container.getHeight() - 1,
                              pixmap->width(), 1, brush);
     }
 
-    this->bufferValid_ = true;
-
     return result;
 }
 
-QPixmap *MessageLayout::ensureBuffer(QPainter &painter, int width, bool clear)
+MessageLayoutBuffer &MessageLayout::ensureBuffer(
+    const MessagePaintContext &ctx)
 {
-    if (this->buffer_ != nullptr)
+    MessageBufferKey key{
+        .width = ctx.canvasWidth,
+        .height = this->container().getHeight(),
+        .devicePixelRatio = ctx.painter.device()->devicePixelRatioF(),
+        .alternateBackground =
+            this->flags.has(MessageLayoutFlag::AlternateBackground),
+        .ignoreHighlights = this->flags.has(MessageLayoutFlag::IgnoreHighlights),
+        .colors = ctx.messageColors,
+        .preferences = ctx.preferences,
+    };
+
+    if (this->buffer_ != nullptr && this->buffer_->key == key)
     {
-        return this->buffer_.get();
+        return *this->buffer_;
     }
 
-    // Create new buffer
-    this->buffer_ = std::make_unique<QPixmap>(
-        int(width * painter.device()->devicePixelRatioF()),
-        int(this->container_.getHeight() *
-            painter.device()->devicePixelRatioF()));
-    this->buffer_->setDevicePixelRatio(painter.device()->devicePixelRatioF());
-
-    if (clear)
+    // Reuse the buffer of another view or create a new one
+    this->buffer_ = this->shared_->findBuffer(key);
+    if (this->buffer_ == nullptr)
     {
-        this->buffer_->fill(Qt::transparent);
+        this->buffer_ = this->shared_->addBuffer(std::move(key));
+        if (ctx.messageColors.hasTransparency)
+        {
+            this->buffer_->pixmap.fill(Qt::transparent);
+        }
     }
-
-    this->bufferValid_ = false;
-    DebugCount::increase("message drawing buffers");
-    return this->buffer_.get();
+    return *this->buffer_;
 }
 
 void MessageLayout::updateBuffer(QPixmap *buffer,
@@ -397,7 +449,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     painter.fillRect(buffer->rect(), backgroundColor);
 
     // draw message
-    this->container_.paintElements(painter, ctx);
+    this->container().paintElements(painter, ctx);
 
 #ifdef FOURTF
     // debug
@@ -408,7 +460,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     QTextOption option;
     option.setAlignment(Qt::AlignRight | Qt::AlignTop);
 
-    painter.drawText(QRectF(1, 1, this->container_.getWidth() - 3, 1000),
+    painter.drawText(QRectF(1, 1, this->container().getWidth() - 3, 1000),
                      QString::number(this->layoutCount_) + ", " +
                          QString::number(++this->bufferUpdatedCount_),
                      option);
@@ -417,26 +469,21 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
 
 void MessageLayout::invalidateBuffer()
 {
-    this->bufferValid_ = false;
+    if (this->buffer_ != nullptr)
+    {
+        this->buffer_->serial = 0;
+    }
 }
 
 void MessageLayout::deleteBuffer()
 {
-    if (this->buffer_ != nullptr)
-    {
-        DebugCount::decrease("message drawing buffers");
-
-        this->buffer_ = nullptr;
-    }
+    // The buffer is freed once no other view uses it
+    this->buffer_ = nullptr;
 }
 
 void MessageLayout::deleteCache()
 {
     this->deleteBuffer();
-
-#ifdef XD
-    this->container_.clear();
-#endif
 }
 
 // Elements
@@ -448,7 +495,7 @@ void MessageLayout::deleteCache()
 const MessageLayoutElement *MessageLayout::getElementAt(QPoint point) const
 {
     // go through all words and return the first one that contains the point.
-    return this->container_.getElementAt(point);
+    return this->container().getElementAt(point);
 }
 
 std::pair<int, int> MessageLayout::getWordBounds(
@@ -458,7 +505,7 @@ std::pair<int, int> MessageLayout::getWordBounds(
     // elements in the container
     if (hoveredElement->getWordId() != -1)
     {
-        return this->container_.getWordBounds(hoveredElement);
+        return this->container().getWordBounds(hoveredElement);
     }
 
     const auto wordStart = this->getSelectionIndex(relativePos) -
@@ -472,23 +519,23 @@ std::pair<int, int> MessageLayout::getWordBounds(
 
 size_t MessageLayout::getLastCharacterIndex() const
 {
-    return this->container_.getLastCharacterIndex();
+    return this->container().getLastCharacterIndex();
 }
 
 size_t MessageLayout::getFirstMessageCharacterIndex() const
 {
-    return this->container_.getFirstMessageCharacterIndex();
+    return this->container().getFirstMessageCharacterIndex();
 }
 
 size_t MessageLayout::getSelectionIndex(QPoint position) const
 {
-    return this->container_.getSelectionIndex(position);
+    return this->container().getSelectionIndex(position);
 }
 
 void MessageLayout::addSelectionText(QString &str, uint32_t from, uint32_t to,
                                      CopyMode copymode)
 {
-    this->container_.addSelectionText(str, from, to, copymode);
+    this->container().addSelectionText(str, from, to, copymode);
 }
 
 bool MessageLayout::isReplyable() const
@@ -19,6 +19,10 @@ struct MessageLayoutContainer;
 class MessageLayoutElement;
 struct MessagePaintContext;
 struct MessageLayoutContext;
+struct MessageLayoutKey;
+struct MessageBufferKey;
+struct SharedMessageLayout;
+struct MessageLayoutBuffer;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
@@ -37,6 +41,11 @@ struct MessagePaintResult {
     bool hasAnimatedElements = false;
 };
 
+/// A message shown in a view.
+///
+/// The laid out elements and paint buffers are shared with other views
+/// showing the same message with the same parameters (see
+/// MessageLayoutCache), the flags are specific to this view.
 class MessageLayout
 {
 public:
@@ -112,24 +121,23 @@ public:
 
 private:
     // methods
+    /// Makes shared_ a layout with `key`, reusing the one of another view
+    /// if possible
+    void attachLayout(const MessageLayoutKey &key);
     void actuallyLayout(const MessageLayoutContext &ctx);
     void updateBuffer(QPixmap *buffer, const MessagePaintContext &ctx);
 
-    // Create new buffer if required, returning the buffer
-    QPixmap *ensureBuffer(QPainter &painter, int width, bool clear);
+    // Find or create the buffer for painting with `ctx`, returning the buffer
+    MessageLayoutBuffer &ensureBuffer(const MessagePaintContext &ctx);
+
+    const MessageLayoutContainer &container() const;
 
     // variables
     const MessagePtr message_;
-    MessageLayoutContainer container_;
-    std::unique_ptr<QPixmap> buffer_;
-    bool bufferValid_ = false;
-
-    int height_ = 0;
-    int currentLayoutWidth_ = -1;
-    int layoutState_ = -1;
-    float scale_ = -1;
-    float imageScale_ = -1.F;
-    MessageElementFlags currentWordFlags_;
+    std::shared_ptr<SharedMessageLayout> shared_;
+    std::shared_ptr<MessageLayoutBuffer> buffer_;
+    /// The SharedMessageLayout::serial this view last saw
+    uint64_t seenSerial_ = 0;
 
 #ifdef FOURTF
     // Debug counters
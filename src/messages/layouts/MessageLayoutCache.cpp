@@ -0,0 +1,116 @@
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+MessageLayoutBuffer::MessageLayoutBuffer(MessageBufferKey key_)
+    : key(std::move(key_))
+    , pixmap(int(this->key.width * this->key.devicePixelRatio),
+             int(this->key.height * this->key.devicePixelRatio))
+{
+    this->pixmap.setDevicePixelRatio(this->key.devicePixelRatio);
+    DebugCount::increase("message drawing buffers");
+}
+
+MessageLayoutBuffer::~MessageLayoutBuffer()
+{
+    DebugCount::decrease("message drawing buffers");
+}
+
+SharedMessageLayout::SharedMessageLayout()
+{
+    DebugCount::increase("shared message layouts");
+}
+
+SharedMessageLayout::~SharedMessageLayout()
+{
+    DebugCount::decrease("shared message layouts");
+}
+
+std::shared_ptr<MessageLayoutBuffer> SharedMessageLayout::findBuffer(
+    const MessageBufferKey &key)
+{
+    std::erase_if(this->buffers_, [](const auto &buffer) {
+        return buffer.expired();
+    });
+
+    for (const auto &weak : this->buffers_)
+    {
+        auto buffer = weak.lock();
+        if (buffer && buffer->key == key)
+        {
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<MessageLayoutBuffer> SharedMessageLayout::addBuffer(
+    MessageBufferKey key)
+{
+    auto buffer = std::make_shared<MessageLayoutBuffer>(std::move(key));
+    this->buffers_.emplace_back(buffer);
+    return buffer;
+}
+
+MessageLayoutCache &MessageLayoutCache::instance()
+{
+    static MessageLayoutCache cache;
+    return cache;
+}
+
+std::shared_ptr<SharedMessageLayout> MessageLayoutCache::find(
+    const Message *message, const MessageLayoutKey &key)
+{
+    auto [begin, end] = this->entries_.equal_range(message);
+    for (auto it = begin; it != end;)
+    {
+        auto layout = it->second.lock();
+        if (!layout)
+        {
+            // A new message might have the address of the freed one
+            it = this->entries_.erase(it);
+            continue;
+        }
+        if (layout->key == key)
+        {
+            DebugCount::increase("shared message layout hits");
+            return layout;
+        }
+        ++it;
+    }
+    return nullptr;
+}
+
+void MessageLayoutCache::insert(
+    const Message *message, const std::shared_ptr<SharedMessageLayout> &layout)
+{
+    this->entries_.emplace(message, layout);
+
+    if (this->entries_.size() > this->pruneThreshold_)
+    {
+        this->prune();
+    }
+}
+
+size_t MessageLayoutCache::size() const
+{
+    return this->entries_.size();
+}
+
+void MessageLayoutCache::prune()
+{
+    std::erase_if(this->entries_, [](const auto &entry) {
+        return entry.second.expired();
+    });
+
+    // Pruning is linear in the number of entries, so only do it once the
+    // cache doubled in size
+    this->pruneThreshold_ =
+        std::max(MIN_PRUNE_THRESHOLD, this->entries_.size() * 2);
+}
+
+}  // namespace chatterino
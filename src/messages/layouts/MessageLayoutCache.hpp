@@ -0,0 +1,135 @@
+#pragma once
+
+#include "common/FlagsEnum.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+
+#include <QPixmap>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+
+enum class MessageElementFlag : int64_t;
+using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+
+/// The parameters a message is laid out with
+struct MessageLayoutKey {
+    int width = -1;
+    float scale = -1;
+    float imageScale = -1;
+    MessageElementFlags wordFlags;
+    /// The message was expanded by the user (see MessageLayoutFlag::Expanded)
+    bool expanded = false;
+    MessageColors colors;
+
+    bool operator==(const MessageLayoutKey &other) const = default;
+};
+
+/// The parameters a laid out message is painted with
+struct MessageBufferKey {
+    int width = 0;
+    int height = 0;
+    qreal devicePixelRatio = 1;
+    bool alternateBackground = false;
+    bool ignoreHighlights = false;
+    MessageColors colors;
+    MessagePreferences preferences;
+
+    bool operator==(const MessageBufferKey &other) const = default;
+};
+
+/// A paint buffer of a SharedMessageLayout.
+///
+/// Buffers are owned by the MessageLayouts painting them, so a buffer is
+/// freed once no view shows the message anymore.
+struct MessageLayoutBuffer {
+    explicit MessageLayoutBuffer(MessageBufferKey key_);
+    ~MessageLayoutBuffer();
+
+    MessageLayoutBuffer(const MessageLayoutBuffer &) = delete;
+    MessageLayoutBuffer &operator=(const MessageLayoutBuffer &) = delete;
+    MessageLayoutBuffer(MessageLayoutBuffer &&) = delete;
+    MessageLayoutBuffer &operator=(MessageLayoutBuffer &&) = delete;
+
+    const MessageBufferKey key;
+    QPixmap pixmap;
+    /// The SharedMessageLayout::serial this was painted with.
+    /// 0 if the buffer has to be painted.
+    uint64_t serial = 0;
+};
+
+/// A message laid out with a MessageLayoutKey.
+///
+/// All MessageLayouts that show the same message with the same key share
+/// one of these (see MessageLayoutCache).
+struct SharedMessageLayout {
+    SharedMessageLayout();
+    ~SharedMessageLayout();
+
+    SharedMessageLayout(const SharedMessageLayout &) = delete;
+    SharedMessageLayout &operator=(const SharedMessageLayout &) = delete;
+    SharedMessageLayout(SharedMessageLayout &&) = delete;
+    SharedMessageLayout &operator=(SharedMessageLayout &&) = delete;
+
+    /// Returns the buffer with `key` if any view still holds it
+    std::shared_ptr<MessageLayoutBuffer> findBuffer(
+        const MessageBufferKey &key);
+    std::shared_ptr<MessageLayoutBuffer> addBuffer(MessageBufferKey key);
+
+    MessageLayoutKey key;
+    MessageLayoutContainer container;
+
+    /// The global layout generation this was laid out in
+    /// (see WindowManager::getGeneration)
+    int generation = -1;
+    /// The revision of the message this was laid out with
+    /// (see Message::layoutRevision)
+    uint32_t messageRevision = 0;
+    /// Incremented on every layout. 0 if this has to be laid out.
+    uint64_t serial = 0;
+    /// Whether this was added to the MessageLayoutCache
+    bool cached = false;
+
+private:
+    std::vector<std::weak_ptr<MessageLayoutBuffer>> buffers_;
+};
+
+/// Shares the layouts of messages between all views (splits, overlays,
+/// popups) that show them with the same parameters.
+///
+/// The cache doesn't own any layout, they're freed with the last
+/// MessageLayout referring to them.
+class MessageLayoutCache
+{
+public:
+    static MessageLayoutCache &instance();
+
+    /// Returns the layout of `message` with `key` if any view still uses it
+    std::shared_ptr<SharedMessageLayout> find(const Message *message,
+                                              const MessageLayoutKey &key);
+
+    /// Makes `layout` available to other views showing `message`
+    void insert(const Message *message,
+                const std::shared_ptr<SharedMessageLayout> &layout);
+
+    /// Number of entries, including ones that are no longer used
+    size_t size() const;
+
+private:
+    /// Removes the entries of layouts that are no longer used
+    void prune();
+
+    std::unordered_multimap<const Message *, std::weak_ptr<SharedMessageLayout>>
+        entries_;
+    size_t pruneThreshold_ = MIN_PRUNE_THRESHOLD;
+
+    static constexpr size_t MIN_PRUNE_THRESHOLD = 1024;
+};
+
+}  // namespace chatterino
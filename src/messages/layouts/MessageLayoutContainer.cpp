@@ -34,10 +34,15 @@ int maxUncollapsedLines()
 
 namespace chatterino {
 
+MessageLayoutContainer::~MessageLayoutContainer()
+{
+    this->clearElements();
+}
+
 void MessageLayoutContainer::beginLayout(int width, float scale,
                                          float imageScale, MessageFlags flags)
 {
-    this->elements_.clear();
+    this->clearElements();
     this->lines_.clear();
 
     this->line_ = 0;
@@ -72,7 +77,7 @@ void MessageLayoutContainer::endLayout()
                                      MessageColor::Link);
         static QString dotdotdotText("...");
 
-        auto *element = new TextLayoutElement(
+        auto *element = this->createElement<TextLayoutElement>(
             dotdotdot, dotdotdotText,
             QSize(this->dotdotdotWidth_, this->textLineHeight_),
             QColor("#00D80A"), FontStyle::ChatMediumBold, MessageColor::Text,
@@ -125,6 +130,11 @@ void MessageLayoutContainer::endLayout()
     }
 }
 
+int MessageLayoutContainer::horizontalMargin(float scale)
+{
+    return int(MARGIN.left() * scale) + int(MARGIN.right() * scale);
+}
+
 void MessageLayoutContainer::addElement(MessageLayoutElement *element)
 {
     if (!this->fitsInLine(element->getRect().width()))
@@ -162,8 +172,7 @@ void MessageLayoutContainer::breakLine()
 
     if (this->flags_.has(MessageFlag::Centered) && this->elements_.size() > 0)
     {
-        const int marginOffset = int(MARGIN.left() * this->scale_) +
-                                 int(MARGIN.right() * this->scale_);
+        const int marginOffset = horizontalMargin(this->scale_);
         xOffset = (width_ - marginOffset -
                    this->elements_.at(this->elements_.size() - 1)
                        ->getRect()
@@ -173,7 +182,7 @@ void MessageLayoutContainer::breakLine()
 
     for (size_t i = lineStart_; i < this->elements_.size(); i++)
     {
-        MessageLayoutElement *element = this->elements_.at(i).get();
+        MessageLayoutElement *element = this->elements_.at(i);
 
         bool isCompactEmote =
             !this->flags_.has(MessageFlag::DisableCompactEmotes) &&
@@ -259,13 +268,20 @@ void MessageLayoutContainer::paintElements(QPainter &painter,
     }
 }
 
-bool MessageLayoutContainer::paintAnimatedElements(QPainter &painter,
-                                                   int yOffset) const
+bool MessageLayoutContainer::paintAnimatedElements(
+    QPainter &painter, int yOffset, std::vector<AnimatedImageArea> *areas) const
 {
     bool anyAnimatedElement = false;
     for (const auto &element : this->elements_)
     {
-        anyAnimatedElement |= element->paintAnimated(painter, yOffset);
+        if (element->paintAnimated(painter, yOffset))
+        {
+            anyAnimatedElement = true;
+            if (areas != nullptr)
+            {
+                element->addAnimatedAreas(*areas, yOffset);
+            }
+        }
     }
     return anyAnimatedElement;
 }
@@ -389,7 +405,7 @@ MessageLayoutElement *MessageLayoutContainer::getElementAt(QPoint point) const
     {
         if (element->getRect().contains(point))
         {
-            return element.get();
+            return element;
         }
     }
 
@@ -515,7 +531,7 @@ std::pair<int, int> MessageLayoutContainer::getWordBounds(
         wordEnd += element->getSelectionIndexCount();
     }
 
-    const auto *lastElementInSelection = this->elements_[index - 1].get();
+    const auto *lastElementInSelection = this->elements_[index - 1];
     if (lastElementInSelection->hasTrailingSpace())
     {
         wordEnd--;
@@ -571,8 +587,7 @@ bool MessageLayoutContainer::fitsInLine(int width) const
 
 int MessageLayoutContainer::remainingWidth() const
 {
-    return (this->width_ - int(MARGIN.left() * this->scale_) -
-            int(MARGIN.right() * this->scale_) -
+    return (this->width_ - horizontalMargin(this->scale_) -
             (static_cast<int>(this->line_ + 1) == maxUncollapsedLines()
                  ? this->dotdotdotWidth_
                  : 0)) -
@@ -584,6 +599,16 @@ int MessageLayoutContainer::nextWordId()
     return this->currentWordId_++;
 }
 
+void MessageLayoutContainer::clearElements()
+{
+    for (auto *element : this->elements_)
+    {
+        element->~MessageLayoutElement();
+    }
+    this->elements_.clear();
+    this->arena_.reset();
+}
+
 void MessageLayoutContainer::addElement(MessageLayoutElement *element,
                                         const bool forceAdd,
                                         const qsizetype prevIndex)
@@ -592,7 +617,7 @@ void MessageLayoutContainer::addElement(MessageLayoutElement *element,
     {
         assert(prevIndex == -2 &&
                "element is still referenced in this->elements_");
-        delete element;
+        element->~MessageLayoutElement();
         return;
     }
 
@@ -721,8 +746,7 @@ void MessageLayoutContainer::addElement(MessageLayoutElement *element,
     // add element
     if (isAddingMode)
     {
-        this->elements_.push_back(
-            std::unique_ptr<MessageLayoutElement>(element));
+        this->elements_.push_back(element);
     }
 
     // set current x
@@ -821,13 +845,13 @@ void MessageLayoutContainer::reorderRTL(size_t firstTextIndex)
     // manually do the first call with -1 as previous index
     if (this->canAddElements())
     {
-        this->addElement(this->elements_[correctSequence[0]].get(), false, -1);
+        this->addElement(this->elements_[correctSequence[0]], false, -1);
     }
 
     for (qsizetype i = 1; i < correctSequence.size() && this->canAddElements();
          i++)
     {
-        this->addElement(this->elements_[correctSequence[i]].get(), false,
+        this->addElement(this->elements_[correctSequence[i]], false,
                          static_cast<qsizetype>(correctSequence[i - 1]));
     }
 }
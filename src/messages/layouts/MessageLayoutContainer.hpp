@@ -3,6 +3,7 @@
 #include "common/Common.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/MessageFlag.hpp"
+#include "util/BlockArena.hpp"
 
 #include <QPoint>
 #include <QRect>
@@ -28,9 +29,16 @@ enum class TextDirection : uint8_t {
 class MessageLayoutElement;
 struct Selection;
 struct MessagePaintContext;
+struct AnimatedImageArea;
 
 struct MessageLayoutContainer {
     MessageLayoutContainer() = default;
+    ~MessageLayoutContainer();
+
+    MessageLayoutContainer(const MessageLayoutContainer &) = delete;
+    MessageLayoutContainer &operator=(const MessageLayoutContainer &) = delete;
+    MessageLayoutContainer(MessageLayoutContainer &&) = delete;
+    MessageLayoutContainer &operator=(MessageLayoutContainer &&) = delete;
 
     /**
      * Begin the layout process of this message
@@ -46,6 +54,25 @@ struct MessageLayoutContainer {
      */
     void endLayout();
 
+    /**
+     * Returns the space left free at the left and right edges of a message
+     * with the given `scale`
+     */
+    static int horizontalMargin(float scale);
+
+    /**
+     * Create a layout element in the arena of this container
+     *
+     * The element must be passed to `addElement` or `addElementNoLineBreak`
+     * afterwards, which take care of destroying it. Its memory is reused on
+     * the next layout.
+     */
+    template <typename T, typename... Args>
+    T *createElement(Args &&...args)
+    {
+        return this->arena_.create<T>(std::forward<Args>(args)...);
+    }
+
     /**
      * Add the given `element` to this message.
      *
@@ -71,9 +98,12 @@ struct MessageLayoutContainer {
 
     /**
      * Paint the animated elements in this message
+     * @param areas if set, the painted animated images are added to this
      * @returns true if this container contains at least one animated element
      */
-    bool paintAnimatedElements(QPainter &painter, int yOffset) const;
+    bool paintAnimatedElements(
+        QPainter &painter, int yOffset,
+        std::vector<AnimatedImageArea> *areas = nullptr) const;
 
     /**
      * Paint the selection for this container
@@ -218,6 +248,9 @@ private:
         QRect rect;
     };
 
+    /// Destroys all elements and rewinds the arena
+    void clearElements();
+
     /// @brief Attempts to add @a element to this container
     ///
     /// This can be called in two scenarios.
@@ -237,11 +270,11 @@ private:
     ///    indicate no predecessor.
     ///
     /// @param element[in] The element to add. This must be non-null and
-    ///                    allocated with `new`. Ownership is transferred
-    ///                    into this container.
+    ///                    created with `createElement`. Ownership is
+    ///                    transferred into this container.
     /// @param forceAdd When enabled, @a element will be added regardless of
     ///                 `canAddElements`. If @a element won't be added it will
-    ///                 be `delete`d.
+    ///                 be destroyed.
     /// @param prevIndex Controls the "scenario" (see above). `-2` indicates
     ///                  "regular" mode; other values indicate "repositioning".
     ///                  In case of repositioning, this contains the index of
@@ -365,7 +398,11 @@ private:
     /// either LTR or RTL (afterwards this remains constant).
     TextDirection textDirection_ = TextDirection::Neutral;
 
-    std::vector<std::unique_ptr<MessageLayoutElement>> elements_;
+    /// Elements are created in `arena_` (see createElement) and destroyed in
+    /// clearElements. The arena starts with a small block and grows with the
+    /// number of elements, so short messages don't reserve much memory.
+    std::vector<MessageLayoutElement *> elements_;
+    BlockArena arena_;
 
     /**
      * A list of lines covering this message
@@ -376,6 +413,7 @@ private:
 
 #ifdef FRIEND_TEST
     FRIEND_TEST(MessageLayoutContainerTest, RtlReordering);
+    FRIEND_TEST(MessageLayoutContainer, ReusesArena);
 #endif
 };
 
@@ -4,6 +4,10 @@
 
 #include <QColor>
 #include <QPainter>
+#include <QRect>
+
+#include <cstdint>
+#include <vector>
 
 namespace pajlada::Signals {
 class SignalHolder;
@@ -39,6 +43,8 @@ struct MessageColors {
     QColor unfocusedLastMessageLine;
 
     void applyTheme(Theme *theme, bool isOverlay, int backgroundOpacity);
+
+    bool operator==(const MessageColors &other) const = default;
 };
 
 // TODO: Explore if we can let settings own this
@@ -57,6 +63,17 @@ struct MessagePreferences {
 
     void connectSettings(Settings *settings,
                          pajlada::Signals::SignalHolder &holder);
+
+    bool operator==(const MessagePreferences &other) const = default;
+};
+
+/// An animated image that was painted
+struct AnimatedImageArea {
+    /// Where the image was painted
+    QRect rect;
+    ImagePtr image;
+    /// The position of the GIFTimer at which the image shows its next frame
+    uint64_t nextFrame = 0;
 };
 
 struct MessagePaintContext {
@@ -81,6 +98,9 @@ struct MessagePaintContext {
     size_t messageIndex{};
 
     bool isLastReadMessage{};
+
+    // If set, the animated images that were painted are added to this
+    std::vector<AnimatedImageArea> *animatedAreas{};
 };
 
 struct MessageLayoutContext {
@@ -120,6 +120,11 @@ int MessageLayoutElement::getWordId() const
     return this->wordId_;
 }
 
+void MessageLayoutElement::addAnimatedAreas(
+    std::vector<AnimatedImageArea> & /*areas*/, int /*yOffset*/) const
+{
+}
+
 void MessageLayoutElement::setWordId(int wordId)
 {
     this->wordId_ = wordId;
@@ -194,6 +199,24 @@ bool ImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
     return false;
 }
 
+void ImageLayoutElement::addAnimatedAreas(std::vector<AnimatedImageArea> &areas,
+                                          int yOffset) const
+{
+    if (this->image_ == nullptr)
+    {
+        return;
+    }
+
+    if (auto nextFrame = this->image_->nextFrameChange())
+    {
+        areas.push_back({
+            .rect = this->getRect().translated(0, yOffset),
+            .image = this->image_,
+            .nextFrame = *nextFrame,
+        });
+    }
+}
+
 int ImageLayoutElement::getMouseOverIndex(const QPoint &abs) const
 {
     return 0;
@@ -323,6 +346,28 @@ bool LayeredImageLayoutElement::paintAnimated(QPainter &painter, int yOffset)
     return animatedFlag;
 }
 
+void LayeredImageLayoutElement::addAnimatedAreas(
+    std::vector<AnimatedImageArea> &areas, int yOffset) const
+{
+    auto rect = this->getRect().translated(0, yOffset);
+    for (const auto &img : this->images_)
+    {
+        if (img == nullptr)
+        {
+            continue;
+        }
+
+        if (auto nextFrame = img->nextFrameChange())
+        {
+            areas.push_back({
+                .rect = rect,
+                .image = img,
+                .nextFrame = *nextFrame,
+            });
+        }
+    }
+}
+
 int LayeredImageLayoutElement::getMouseOverIndex(const QPoint &abs) const
 {
     return 0;
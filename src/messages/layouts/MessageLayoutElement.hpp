@@ -12,6 +12,7 @@
 
 #include <climits>
 #include <cstdint>
+#include <vector>
 
 class QPainter;
 
@@ -22,6 +23,7 @@ using ImagePtr = std::shared_ptr<Image>;
 enum class FontStyle : uint8_t;
 enum class MessageElementFlag : int64_t;
 struct MessageColors;
+struct AnimatedImageArea;
 
 class MessageLayoutElement
 {
@@ -60,6 +62,10 @@ public:
                        const MessageColors &messageColors) = 0;
     /// @returns true if anything was painted
     virtual bool paintAnimated(QPainter &painter, int yOffset) = 0;
+    /// Adds the animated images of this element and where they're painted
+    /// with `yOffset`
+    virtual void addAnimatedAreas(std::vector<AnimatedImageArea> &areas,
+                                  int yOffset) const;
     virtual int getMouseOverIndex(const QPoint &abs) const = 0;
     virtual int getXFromIndex(size_t index) = 0;
 
@@ -109,6 +115,8 @@ protected:
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
     bool paintAnimated(QPainter &painter, int yOffset) override;
+    void addAnimatedAreas(std::vector<AnimatedImageArea> &areas,
+                          int yOffset) const override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
@@ -128,6 +136,8 @@ protected:
     size_t getSelectionIndexCount() const override;
     void paint(QPainter &painter, const MessageColors &messageColors) override;
     bool paintAnimated(QPainter &painter, int yOffset) override;
+    void addAnimatedAreas(std::vector<AnimatedImageArea> &areas,
+                          int yOffset) const override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(size_t index) override;
 
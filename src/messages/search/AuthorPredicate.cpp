@@ -15,6 +15,11 @@ AuthorPredicate::AuthorPredicate(const QString &authors, bool negate)
     }
 }
 
+const QStringList &AuthorPredicate::authors() const
+{
+    return this->authors_;
+}
+
 bool AuthorPredicate::appliesToImpl(const Message &message)
 {
     return authors_.contains(message.displayName, Qt::CaseInsensitive) ||
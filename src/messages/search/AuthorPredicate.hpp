@@ -24,6 +24,9 @@ public:
      */
     AuthorPredicate(const QString &authors, bool negate);
 
+    /// The user names passed in the constructor
+    const QStringList &authors() const;
+
 protected:
     /**
      * @brief Checks whether the message is authored by any of the users passed
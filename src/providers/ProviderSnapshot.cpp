@@ -0,0 +1,340 @@
+#include "providers/ProviderSnapshot.hpp"
+
+#include "common/network/NetworkRequest.hpp"
+#include "common/network/NetworkResult.hpp"
+#include "common/QLogging.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <QtEndian>
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+const auto &LOG = chatterinoCache;
+
+/// The file starts with this, followed by the version and the entry count
+constexpr char MAGIC[4] = {'C', '7', 'P', 'S'};
+
+/// Reads little-endian integers and length-prefixed byte strings from a
+/// mapped file without copying
+class Reader
+{
+public:
+    Reader(const uchar *begin, const uchar *end)
+        : pos_(begin)
+        , end_(end)
+    {
+    }
+
+    std::optional<uint32_t> readU32()
+    {
+        if (this->end_ - this->pos_ < 4)
+        {
+            return std::nullopt;
+        }
+        auto value = qFromLittleEndian<uint32_t>(this->pos_);
+        this->pos_ += 4;
+        return value;
+    }
+
+    /// The returned array references the mapping
+    std::optional<QByteArray> readBytes()
+    {
+        auto size = this->readU32();
+        if (!size || static_cast<size_t>(this->end_ - this->pos_) < *size)
+        {
+            return std::nullopt;
+        }
+        auto bytes =
+            QByteArray::fromRawData(reinterpret_cast<const char *>(this->pos_),
+                                    static_cast<qsizetype>(*size));
+        this->pos_ += *size;
+        return bytes;
+    }
+
+private:
+    const uchar *pos_;
+    const uchar *end_;
+};
+
+void writeU32(QByteArray &out, uint32_t value)
+{
+    uchar bytes[4];
+    qToLittleEndian(value, bytes);
+    out.append(reinterpret_cast<const char *>(bytes), 4);
+}
+
+void writeBytes(QByteArray &out, const QByteArray &bytes)
+{
+    writeU32(out, static_cast<uint32_t>(bytes.size()));
+    out.append(bytes);
+}
+
+/// Returns a copy that doesn't reference the mapping
+QByteArray detached(const QByteArray &bytes)
+{
+    return {bytes.constData(), bytes.size()};
+}
+
+}  // namespace
+
+namespace chatterino {
+
+ProviderSnapshot::~ProviderSnapshot()
+{
+    if (this->file_ && this->mapped_ != nullptr)
+    {
+        this->file_->unmap(this->mapped_);
+    }
+}
+
+ProviderSnapshot &ProviderSnapshot::instance()
+{
+    static ProviderSnapshot snapshot;
+    return snapshot;
+}
+
+void ProviderSnapshot::initialize(QString filePath)
+{
+    std::lock_guard lock(this->mutex_);
+    this->unmap();
+    this->entries_.clear();
+    this->modified_ = false;
+    this->filePath_ = std::move(filePath);
+
+    this->file_ = std::make_unique<QFile>(this->filePath_);
+    if (!this->file_->exists() || !this->file_->open(QFile::ReadOnly))
+    {
+        this->file_.reset();
+        return;
+    }
+
+    auto size = this->file_->size();
+    this->mapped_ = this->file_->map(0, size);
+    if (this->mapped_ == nullptr)
+    {
+        qCWarning(LOG) << "Failed to map provider snapshot"
+                       << this->file_->errorString();
+        this->file_.reset();
+        return;
+    }
+
+    this->readIndex(this->mapped_, this->mapped_ + size);
+}
+
+std::optional<ProviderSnapshot::Entry> ProviderSnapshot::get(
+    const QString &key) const
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return std::nullopt;
+    }
+    return Entry{
+        .etag = detached(it->second.etag),
+        .data = detached(it->second.data),
+    };
+}
+
+bool ProviderSnapshot::contains(const QString &key,
+                                const QByteArray &data) const
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->entries_.find(key);
+    return it != this->entries_.end() && it->second.data == data;
+}
+
+void ProviderSnapshot::set(const QString &key, Entry entry)
+{
+    std::lock_guard lock(this->mutex_);
+    if (this->filePath_.isEmpty())
+    {
+        return;
+    }
+    this->entries_[key] = std::move(entry);
+    this->modified_ = true;
+}
+
+void ProviderSnapshot::remove(const QString &key)
+{
+    std::lock_guard lock(this->mutex_);
+    if (this->entries_.erase(key) > 0)
+    {
+        this->modified_ = true;
+    }
+}
+
+void ProviderSnapshot::save()
+{
+    std::lock_guard lock(this->mutex_);
+    if (this->filePath_.isEmpty() || !this->modified_)
+    {
+        return;
+    }
+
+    QByteArray out;
+    out.append(MAGIC, sizeof(MAGIC));
+    writeU32(out, VERSION);
+    writeU32(out, static_cast<uint32_t>(this->entries_.size()));
+    for (const auto &[key, entry] : this->entries_)
+    {
+        writeBytes(out, key.toUtf8());
+        writeBytes(out, entry.etag);
+        writeBytes(out, entry.data);
+    }
+
+    // The file can't be replaced while it's mapped on Windows
+    this->unmap();
+
+    QSaveFile file(this->filePath_);
+    if (!file.open(QSaveFile::WriteOnly))
+    {
+        qCWarning(LOG) << "Failed to write provider snapshot"
+                       << file.errorString();
+        return;
+    }
+    file.write(out);
+    if (!file.commit())
+    {
+        qCWarning(LOG) << "Failed to write provider snapshot"
+                       << file.errorString();
+        return;
+    }
+    this->modified_ = false;
+}
+
+void ProviderSnapshot::restore(const QString &key,
+                               std::function<void(const QByteArray &)> apply,
+                               std::function<void()> revalidate)
+{
+    auto entry = this->get(key);
+    if (!entry)
+    {
+        revalidate();
+        return;
+    }
+
+    std::ignore = QtConcurrent::run([apply = std::move(apply),
+                                     revalidate = std::move(revalidate),
+                                     data = std::move(entry->data)] {
+        apply(data);
+        postToThread(revalidate);
+    });
+}
+
+void ProviderSnapshot::load(const QString &key, const QUrl &url,
+                            std::function<bool(const QByteArray &)> apply,
+                            std::function<void()> onDone)
+{
+    this->restore(
+        key,
+        [this, key, apply](const QByteArray &data) {
+            if (!apply(data))
+            {
+                // Revalidating with its ETag would keep the provider empty
+                // if the response didn't change
+                qCWarning(LOG) << "Dropping unusable snapshot of" << key;
+                this->remove(key);
+            }
+        },
+        [this, key, url, apply, onDone] {
+            std::vector<std::pair<QByteArray, QByteArray>> headers;
+            if (auto entry = this->get(key); entry && !entry->etag.isEmpty())
+            {
+                headers.emplace_back("If-None-Match", entry->etag);
+            }
+
+            NetworkRequest(url)
+                .headerList(headers)
+                .timeout(30000)
+                .onSuccess([this, key, apply, onDone](const auto &result) {
+                    std::ignore = QtConcurrent::run([this, key, apply, onDone,
+                                                     result] {
+                        // 304 Not Modified: the snapshot is up to date
+                        if (result.status() != 304 &&
+                            !this->contains(key, result.getData()) &&
+                            apply(result.getData()))
+                        {
+                            this->set(key,
+                                      Entry{result.etag(), result.getData()});
+                        }
+                        if (onDone)
+                        {
+                            onDone();
+                        }
+                    });
+                })
+                .execute();
+        });
+}
+
+void ProviderSnapshot::readIndex(const uchar *begin, const uchar *end)
+{
+    if (end - begin < static_cast<ptrdiff_t>(sizeof(MAGIC)) ||
+        std::memcmp(begin, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        qCWarning(LOG) << "Discarding provider snapshot with unknown format";
+        return;
+    }
+
+    Reader reader(begin + sizeof(MAGIC), end);
+    auto version = reader.readU32();
+    if (version != VERSION)
+    {
+        qCDebug(LOG) << "Discarding provider snapshot of version"
+                     << version.value_or(0);
+        return;
+    }
+
+    auto count = reader.readU32();
+    if (!count)
+    {
+        return;
+    }
+
+    std::unordered_map<QString, Entry> entries;
+    for (uint32_t i = 0; i < *count; i++)
+    {
+        auto key = reader.readBytes();
+        auto etag = reader.readBytes();
+        auto data = reader.readBytes();
+        if (!key || !etag || !data)
+        {
+            qCWarning(LOG) << "Discarding truncated provider snapshot";
+            return;
+        }
+        entries[QString::fromUtf8(*key)] = {
+            .etag = *etag,
+            .data = *data,
+        };
+    }
+    this->entries_ = std::move(entries);
+}
+
+void ProviderSnapshot::unmap()
+{
+    for (auto &[key, entry] : this->entries_)
+    {
+        entry.etag = detached(entry.etag);
+        entry.data = detached(entry.data);
+    }
+
+    if (this->file_ && this->mapped_ != nullptr)
+    {
+        this->file_->unmap(this->mapped_);
+    }
+    this->mapped_ = nullptr;
+    this->file_.reset();
+}
+
+}  // namespace chatterino
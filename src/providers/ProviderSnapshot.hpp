@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QUrl>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace chatterino {
+
+/// A binary snapshot of the responses the global emotes and badges were
+/// built from.
+///
+/// On startup, providers are built from the snapshot before their requests
+/// complete, so emotes and badges show up right away. The requests then
+/// revalidate the snapshot in the background. Responses that didn't change
+/// (matching ETag or contents) don't rebuild the provider.
+///
+/// The file is memory-mapped, so only the entries that are used are read.
+class ProviderSnapshot
+{
+public:
+    /// Version of the file format. Snapshots of other versions are discarded.
+    static constexpr uint32_t VERSION = 1;
+
+    struct Entry {
+        /// The `ETag` of the response. Empty if the provider doesn't send one.
+        QByteArray etag;
+        QByteArray data;
+    };
+
+    ProviderSnapshot() = default;
+    ~ProviderSnapshot();
+
+    ProviderSnapshot(const ProviderSnapshot &) = delete;
+    ProviderSnapshot &operator=(const ProviderSnapshot &) = delete;
+    ProviderSnapshot(ProviderSnapshot &&) = delete;
+    ProviderSnapshot &operator=(ProviderSnapshot &&) = delete;
+
+    static ProviderSnapshot &instance();
+
+    /// Maps the snapshot at `filePath`. Nothing is read or recorded before
+    /// this is called.
+    void initialize(QString filePath);
+
+    /// Returns a copy of the entry for `key`.
+    /// This can be called from any thread.
+    std::optional<Entry> get(const QString &key) const;
+
+    /// Returns true if the entry for `key` holds exactly `data`.
+    /// This can be called from any thread.
+    bool contains(const QString &key, const QByteArray &data) const;
+
+    /// Replaces the entry for `key`. This can be called from any thread.
+    void set(const QString &key, Entry entry);
+
+    /// Removes the entry for `key`. This can be called from any thread.
+    void remove(const QString &key);
+
+    /// Writes the snapshot if an entry was replaced
+    void save();
+
+    /// Calls `apply` with the data of `key` on a worker thread (if there's
+    /// an entry) and `revalidate` on the GUI thread once it returned.
+    ///
+    /// Revalidating after the snapshot was applied makes sure the snapshot
+    /// never replaces a newer response.
+    void restore(const QString &key,
+                 std::function<void(const QByteArray &)> apply,
+                 std::function<void()> revalidate);
+
+    /// Restores `key` and requests `url` with the ETag of the entry.
+    ///
+    /// `apply` is called on a worker thread with the snapshot and then with
+    /// the response if it changed. It returns false if the data couldn't be
+    /// parsed, which keeps the data out of the snapshot. A snapshot that
+    /// can't be applied is dropped and revalidated without its ETag.
+    /// `onDone` is called on a worker thread once the response was handled.
+    void load(const QString &key, const QUrl &url,
+              std::function<bool(const QByteArray &)> apply,
+              std::function<void()> onDone = {});
+
+private:
+    /// Reads the index of the mapped file
+    void readIndex(const uchar *begin, const uchar *end);
+    /// Copies all entries out of the mapping and unmaps the file
+    void unmap();
+
+    mutable std::mutex mutex_;
+    QString filePath_;
+    std::unique_ptr<QFile> file_;
+    uchar *mapped_ = nullptr;
+    std::unordered_map<QString, Entry> entries_;
+    bool modified_ = false;
+};
+
+}  // namespace chatterino
@@ -4,21 +4,28 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/liveupdates/BttvLiveUpdateMessages.hpp"
+#include "providers/ProviderSnapshot.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Settings.hpp"
 
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QThread>
 
 namespace {
 
 using namespace chatterino;
 
+/// Key of the global emotes in the `ProviderSnapshot`
+const QString GLOBAL_SNAPSHOT_KEY = QStringLiteral("bttv.global");
+
 const QString CHANNEL_HAS_NO_EMOTES(
     "This channel has no BetterTTV channel emotes.");
 
@@ -214,18 +221,30 @@ void BttvEmotes::loadEmotes()
         return;
     }
 
-    NetworkRequest(QString(globalEmoteApiUrl))
-        .timeout(30000)
-        .onSuccess([this](auto result) {
+    // The emotes are parsed on a worker thread. The parsed map replaces the
+    // current one atomically.
+    auto startNs = trace::now();
+    ProviderSnapshot::instance().load(
+        GLOBAL_SNAPSHOT_KEY, QUrl(globalEmoteApiUrl),
+        [this](const QByteArray &data) {
+            auto doc = QJsonDocument::fromJson(data);
+            if (!doc.isArray())
+            {
+                return false;
+            }
+
             auto emotes = this->global_.get();
-            auto pair = parseGlobalEmotes(result.parseJsonArray(), *emotes);
+            auto pair = parseGlobalEmotes(doc.array(), *emotes);
             if (pair.first)
             {
                 this->setEmotes(
                     std::make_shared<EmoteMap>(std::move(pair.second)));
             }
-        })
-        .execute();
+            return static_cast<bool>(pair.first);
+        },
+        [startNs] {
+            startup::markBackground("BTTV global emotes loaded", startNs);
+        });
 }
 
 void BttvEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
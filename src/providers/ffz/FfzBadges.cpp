@@ -1,18 +1,78 @@
 #include "providers/ffz/FfzBadges.hpp"
 
 #include "Application.hpp"
-#include "common/network/NetworkRequest.hpp"
-#include "common/network/NetworkResult.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "providers/ffz/FfzUtil.hpp"
+#include "providers/ProviderSnapshot.hpp"
+#include "util/PostToThread.hpp"
 
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QThread>
 #include <QUrl>
 
+namespace {
+
+using namespace chatterino;
+
+/// Key of the badges in the `ProviderSnapshot`
+const QString SNAPSHOT_KEY = QStringLiteral("ffz.badges");
+
+struct ParsedBadges {
+    std::unordered_map<int, FfzBadges::Badge> badges;
+    std::unordered_map<QString, std::set<int>> userBadges;
+};
+
+ParsedBadges parseBadges(const QJsonObject &jsonRoot)
+{
+    ParsedBadges parsed;
+
+    for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
+    {
+        auto jsonBadge = jsonBadge_.toObject();
+        auto jsonUrls = jsonBadge.value("urls").toObject();
+        QSize baseSize(jsonBadge["width"].toInt(18),
+                       jsonBadge["height"].toInt(18));
+
+        auto emote = Emote{
+            EmoteName{},
+            ImageSet{
+                Image::fromUrl(parseFfzUrl(jsonUrls.value("1").toString()),
+                               1.0, baseSize),
+                Image::fromUrl(parseFfzUrl(jsonUrls.value("2").toString()),
+                               0.5, baseSize * 2),
+                Image::fromUrl(parseFfzUrl(jsonUrls.value("4").toString()),
+                               0.25, baseSize * 4)},
+            Tooltip{jsonBadge.value("title").toString()}, Url{}};
+
+        int badgeID = jsonBadge.value("id").toInt();
+
+        parsed.badges[badgeID] = FfzBadges::Badge{
+            std::make_shared<const Emote>(std::move(emote)),
+            QColor(jsonBadge.value("color").toString()),
+        };
+
+        // Find users with this badge
+        auto badgeIDString = QString::number(badgeID);
+        for (const auto &user : jsonRoot.value("users")
+                                    .toObject()
+                                    .value(badgeIDString)
+                                    .toArray())
+        {
+            parsed.userBadges[QString::number(user.toInt())].emplace(badgeID);
+        }
+    }
+
+    return parsed;
+}
+
+}  // namespace
+
 namespace chatterino {
 
 std::vector<FfzBadges::Badge> FfzBadges::getUserBadges(const UserId &id)
@@ -52,62 +112,30 @@ void FfzBadges::load()
 {
     static QUrl url("https://api.frankerfacez.com/v1/badges/ids");
 
-    NetworkRequest(url)
-        .onSuccess([this](auto result) {
-            std::unique_lock lock(this->mutex_);
-
-            auto jsonRoot = result.parseJson();
-            this->tgBadges.guard();
-            for (const auto &jsonBadge_ : jsonRoot.value("badges").toArray())
+    // The badges are parsed on a worker thread and swapped in on the GUI
+    // thread
+    auto startNs = trace::now();
+    ProviderSnapshot::instance().load(
+        SNAPSHOT_KEY, url,
+        [this](const QByteArray &data) {
+            auto jsonRoot = QJsonDocument::fromJson(data).object();
+            if (!jsonRoot.contains("badges"))
             {
-                auto jsonBadge = jsonBadge_.toObject();
-                auto jsonUrls = jsonBadge.value("urls").toObject();
-                QSize baseSize(jsonBadge["width"].toInt(18),
-                               jsonBadge["height"].toInt(18));
-
-                auto emote = Emote{
-                    EmoteName{},
-                    ImageSet{Image::fromUrl(
-                                 parseFfzUrl(jsonUrls.value("1").toString()),
-                                 1.0, baseSize),
-                             Image::fromUrl(
-                                 parseFfzUrl(jsonUrls.value("2").toString()),
-                                 0.5, baseSize * 2),
-                             Image::fromUrl(
-                                 parseFfzUrl(jsonUrls.value("4").toString()),
-                                 0.25, baseSize * 4)},
-                    Tooltip{jsonBadge.value("title").toString()}, Url{}};
-
-                Badge badge;
-
-                int badgeID = jsonBadge.value("id").toInt();
-
-                this->badges[badgeID] = Badge{
-                    std::make_shared<const Emote>(std::move(emote)),
-                    QColor(jsonBadge.value("color").toString()),
-                };
-
-                // Find users with this badge
-                auto badgeIDString = QString::number(badgeID);
-                for (const auto &user : jsonRoot.value("users")
-                                            .toObject()
-                                            .value(badgeIDString)
-                                            .toArray())
-                {
-                    auto userIDString = QString::number(user.toInt());
-
-                    auto [userBadges, created] = this->userBadges.emplace(
-                        std::make_pair<QString, std::set<int>>(
-                            std::move(userIDString), {badgeID}));
-                    if (!created)
-                    {
-                        // User already had a badge assigned
-                        userBadges->second.emplace(badgeID);
-                    }
-                }
+                return false;
             }
-        })
-        .execute();
+
+            postToThread([this, parsed = parseBadges(jsonRoot)]() mutable {
+                std::unique_lock lock(this->mutex_);
+                this->tgBadges.guard();
+
+                this->badges = std::move(parsed.badges);
+                this->userBadges = std::move(parsed.userBadges);
+            });
+            return true;
+        },
+        [startNs] {
+            startup::markBackground("FFZ badges loaded", startNs);
+        });
 }
 
 void FfzBadges::registerBadge(int badgeID, Badge badge)
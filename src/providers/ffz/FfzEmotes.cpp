@@ -3,13 +3,18 @@
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/ffz/FfzUtil.hpp"
+#include "providers/ProviderSnapshot.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Settings.hpp"
 
+#include <QJsonDocument>
+
 namespace {
 
 using namespace chatterino;
@@ -17,6 +22,9 @@ using namespace chatterino;
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoFfzemotes;
 
+/// Key of the global emotes in the `ProviderSnapshot`
+const QString GLOBAL_SNAPSHOT_KEY = QStringLiteral("ffz.global");
+
 const QString CHANNEL_HAS_NO_EMOTES(
     "This channel has no FrankerFaceZ channel emotes.");
 
@@ -237,16 +245,25 @@ void FfzEmotes::loadEmotes()
         return;
     }
 
-    QString url("https://api.frankerfacez.com/v1/set/global");
-
-    NetworkRequest(url)
+    // The emotes are parsed on a worker thread. The parsed map replaces the
+    // current one atomically.
+    auto startNs = trace::now();
+    ProviderSnapshot::instance().load(
+        GLOBAL_SNAPSHOT_KEY, QUrl("https://api.frankerfacez.com/v1/set/global"),
+        [this](const QByteArray &data) {
+            auto doc = QJsonDocument::fromJson(data);
+            if (!doc.isObject())
+            {
+                return false;
+            }
 
-        .timeout(30000)
-        .onSuccess([this](auto result) {
-            auto parsedSet = parseGlobalEmotes(result.parseJson());
+            auto parsedSet = parseGlobalEmotes(doc.object());
             this->setEmotes(std::make_shared<EmoteMap>(std::move(parsedSet)));
-        })
-        .execute();
+            return true;
+        },
+        [startNs] {
+            startup::markBackground("FFZ global emotes loaded", startNs);
+        });
 }
 
 void FfzEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
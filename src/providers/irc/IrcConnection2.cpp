@@ -17,6 +17,9 @@ namespace {
 
 IrcConnection::IrcConnection(QObject *parent)
     : Communi::IrcConnection(parent)
+    // the timers are children so they follow the connection to its thread
+    , pingTimer_(this)
+    , reconnectTimer_(this)
 {
     // Log connection errors for ease-of-debugging
     QObject::connect(this, &Communi::IrcConnection::socketError, this,
@@ -29,6 +32,7 @@ IrcConnection::IrcConnection(QObject *parent)
         [this](QAbstractSocket::SocketState state) {
             if (state == QAbstractSocket::UnconnectedState)
             {
+                this->connected_ = false;
                 this->pingTimer_.stop();
 
                 // The socket will enter unconnected state both in case of
@@ -107,8 +111,13 @@ IrcConnection::IrcConnection(QObject *parent)
     });
 
     QObject::connect(this, &Communi::IrcConnection::connected, this, [this] {
+        this->connected_ = true;
         this->pingTimer_.start();
     });
+    QObject::connect(this, &Communi::IrcConnection::disconnected, this,
+                     [this] {
+                         this->connected_ = false;
+                     });
 
     QObject::connect(this, &Communi::IrcConnection::pongMessageReceived,
                      [this](Communi::IrcPongMessage *message) {
@@ -135,6 +144,11 @@ IrcConnection::~IrcConnection()
     this->disconnect();
 }
 
+bool IrcConnection::isConnectedFromAnyThread() const
+{
+    return this->connected_.load(std::memory_order_relaxed);
+}
+
 void IrcConnection::smartReconnect()
 {
     if (this->reconnectTimer_.isActive())
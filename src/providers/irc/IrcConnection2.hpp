@@ -6,6 +6,7 @@
 #include <pajlada/signals/signal.hpp>
 #include <QTimer>
 
+#include <atomic>
 #include <chrono>
 
 namespace chatterino {
@@ -31,6 +32,13 @@ public:
     virtual void open();
     virtual void close();
 
+    /// Returns whether the connection was connected the last time its
+    /// `connected` or `disconnected` signal fired.
+    ///
+    /// Unlike `isConnected`, this can be called from threads other than the
+    /// one the connection lives on.
+    bool isConnectedFromAnyThread() const;
+
 private:
     QTimer pingTimer_;
     QTimer reconnectTimer_;
@@ -42,6 +50,8 @@ private:
 
     std::atomic<bool> expectConnectionLoss_{false};
 
+    std::atomic<bool> connected_{false};
+
     // waitingForPong_ is set to true when we send a PING message, and back to
     // false when we receive the matching PONG response
     std::atomic<bool> waitingForPong_{false};
@@ -3,18 +3,148 @@
 #include "common/Env.hpp"
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "providers/links/LinkInfo.hpp"
 #include "singletons/Settings.hpp"
+#include "util/PostToThread.hpp"
 
+#include <lrucache/lrucache.hpp>
+#include <QPointer>
 #include <QStringBuilder>
+#include <QUrl>
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+/// Number of URLs whose info is kept
+constexpr size_t CACHE_SIZE = 1000;
+
+/// How long resolved info is reused
+constexpr auto RESOLVED_TTL = std::chrono::minutes(15);
+
+/// How long errors are reused, so links that fail to resolve aren't
+/// requested again for every message they're posted in
+constexpr auto ERROR_TTL = std::chrono::minutes(1);
+
+}  // namespace
 
 namespace chatterino {
 
+struct LinkResolver::Entry {
+    using Clock = std::chrono::steady_clock;
+
+    LinkInfo::State state = LinkInfo::State::Loading;
+    QString tooltip;
+    /// The unshortened link as returned by the resolver
+    QString link;
+    ImagePtr thumbnail;
+    Clock::time_point expiresAt;
+
+    /// Infos waiting for the request in flight
+    std::vector<QPointer<LinkInfo>> waiting;
+
+    bool isExpired() const
+    {
+        return this->state != LinkInfo::State::Loading &&
+               this->expiresAt <= Clock::now();
+    }
+
+    void applyTo(LinkInfo *info) const
+    {
+        assert(this->state != LinkInfo::State::Loading);
+
+        if (this->thumbnail)
+        {
+            info->setThumbnail(this->thumbnail);
+        }
+        if (!this->link.isEmpty() && getSettings()->unshortLinks)
+        {
+            info->setResolvedUrl(this->link);
+        }
+        info->setTooltip(this->tooltip);
+        info->setState(this->state);
+    }
+
+    void finish(LinkInfo::State newState, std::chrono::minutes ttl)
+    {
+        this->state = newState;
+        this->expiresAt = Clock::now() + ttl;
+
+        auto waiting = std::move(this->waiting);
+        this->waiting.clear();
+        for (const auto &info : waiting)
+        {
+            if (info)
+            {
+                this->applyTo(info.data());
+            }
+        }
+    }
+};
+
+struct LinkResolver::Cache {
+    QString resolverUrl;
+    cache::lru_cache<QString, std::shared_ptr<Entry>> entries{CACHE_SIZE};
+};
+
+LinkResolver::LinkResolver(QString resolverUrl)
+    : cache_(std::make_shared<Cache>())
+{
+    if (resolverUrl.isEmpty())
+    {
+        resolverUrl = Env::get().linkResolverUrl;
+    }
+    this->cache_->resolverUrl = std::move(resolverUrl);
+}
+
+LinkResolver::~LinkResolver() = default;
+
 void LinkResolver::resolve(LinkInfo *info)
+{
+    assert(info);
+
+    if (isGuiThread())
+    {
+        resolveIn(this->cache_, info);
+        return;
+    }
+
+    // Messages can be built on other threads
+    postToThread([cache = std::weak_ptr(this->cache_),
+                  info = QPointer<LinkInfo>(info)] {
+        auto locked = cache.lock();
+        if (locked && info)
+        {
+            resolveIn(locked, info.data());
+        }
+    });
+}
+
+QString LinkResolver::normalizeUrl(const QString &url)
+{
+    QUrl parsed(url.trimmed());
+    if (!parsed.isValid() || parsed.scheme().isEmpty())
+    {
+        return url.trimmed();
+    }
+
+    // QUrl lowercases the scheme and host
+    parsed = parsed.adjusted(QUrl::NormalizePathSegments);
+    if (parsed.path().isEmpty())
+    {
+        parsed.setPath("/");
+    }
+    return parsed.toString(QUrl::FullyEncoded);
+}
+
+void LinkResolver::resolveIn(const std::shared_ptr<Cache> &cache,
+                             LinkInfo *info)
 {
     using State = LinkInfo::State;
 
-    assert(info);
+    assertInGuiThread();
 
     if (info->state() != State::Created)
     {
@@ -27,30 +157,58 @@ void LinkResolver::resolve(LinkInfo *info)
         return;
     }
 
+    auto key = normalizeUrl(info->originalUrl());
+
+    std::shared_ptr<Entry> entry;
+    if (cache->entries.exists(key))
+    {
+        entry = cache->entries.get(key);
+        if (entry->isExpired())
+        {
+            entry.reset();
+        }
+    }
+
+    if (entry && entry->state != State::Loading)
+    {
+        entry->applyTo(info);
+        return;
+    }
+
     info->setTooltip("Loading...");
     info->setState(State::Loading);
 
-    NetworkRequest(Env::get().linkResolverUrl.arg(QString::fromUtf8(
+    if (entry)
+    {
+        // A request for this URL is in flight
+        entry->waiting.emplace_back(info);
+        return;
+    }
+
+    entry = std::make_shared<Entry>();
+    entry->waiting.emplace_back(info);
+    cache->entries.put(key, entry);
+
+    // The request isn't bound to the info, as other infos might wait for it.
+    // The entry is kept alive by the callbacks even if it's evicted.
+    NetworkRequest(cache->resolverUrl.arg(QString::fromUtf8(
                        QUrl::toPercentEncoding(info->originalUrl(), {}, "/:"))))
-        .caller(info)
         .timeout(30000)
-        .onSuccess([info](const NetworkResult &result) {
+        .onSuccess([entry](const NetworkResult &result) {
             const auto root = result.parseJson();
             QString response;
-            QString url;
-            ImagePtr thumbnail = nullptr;
             if (root["status"].toInt() == 200)
             {
                 response = root["tooltip"].toString();
 
                 if (root.contains("thumbnail"))
                 {
-                    info->setThumbnail(
-                        Image::fromUrl({root["thumbnail"].toString()}));
+                    entry->thumbnail =
+                        Image::fromUrl({root["thumbnail"].toString()});
                 }
-                if (getSettings()->unshortLinks && root.contains("link"))
+                if (root.contains("link"))
                 {
-                    info->setResolvedUrl(root["link"].toString());
+                    entry->link = root["link"].toString();
                 }
             }
             else
@@ -58,13 +216,13 @@ void LinkResolver::resolve(LinkInfo *info)
                 response = root["message"].toString();
             }
 
-            info->setTooltip(QUrl::fromPercentEncoding(response.toUtf8()));
-            info->setState(State::Resolved);
+            entry->tooltip = QUrl::fromPercentEncoding(response.toUtf8());
+            entry->finish(State::Resolved, RESOLVED_TTL);
         })
-        .onError([info](const auto &result) {
-            info->setTooltip(u"No link info found (" % result.formatError() %
-                             u')');
-            info->setState(State::Errored);
+        .onError([entry](const auto &result) {
+            entry->tooltip =
+                u"No link info found (" % result.formatError() % u')';
+            entry->finish(State::Errored, ERROR_TTL);
         })
         .execute();
 }
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <QString>
+
+#include <memory>
+
 namespace chatterino {
 
 class LinkInfo;
@@ -20,17 +24,39 @@ public:
 class LinkResolver : public ILinkResolver
 {
 public:
-    LinkResolver() = default;
+    /// @param resolverUrl The URL of the resolver with a `%1` placeholder for
+    ///                    the link. Defaults to Env::linkResolverUrl.
+    explicit LinkResolver(QString resolverUrl = {});
+    ~LinkResolver() override;
 
     /// @brief Loads and updates the link info
     ///
     /// Calling this with an already resolved or currently loading info is a
     /// no-op. Loading can be blocked by disabling the "linkInfoTooltip"
     /// setting. URLs will be unshortened if the "unshortLinks" setting is
-    /// enabled. The resolver is set through Env::linkResolverUrl.
+    /// enabled.
+    ///
+    /// Results are cached by the normalized URL. Only one request is made
+    /// for a URL at a time, infos for the same URL wait for the request in
+    /// flight. This can be called from any thread, infos are updated in the
+    /// GUI thread.
     ///
     /// @pre @a info must not be nullptr
     void resolve(LinkInfo *info) override;
+
+    /// @brief Normalizes @a url to the key it's cached by
+    ///
+    /// The scheme and host are lowercased, path segments are normalized and
+    /// an empty path is replaced with `/`.
+    static QString normalizeUrl(const QString &url);
+
+private:
+    struct Entry;
+    struct Cache;
+
+    static void resolveIn(const std::shared_ptr<Cache> &cache, LinkInfo *info);
+
+    std::shared_ptr<Cache> cache_;
 };
 
 }  // namespace chatterino
@@ -165,6 +165,7 @@ private:
     void start()
     {
         assert(!this->isStarted());
+        this->connectedAt_ = std::chrono::steady_clock::now();
         this->started_.store(true, std::memory_order_release);
         this->onConnectionEstablished();
     }
@@ -182,6 +183,10 @@ private:
 
     std::atomic<bool> started_{false};
 
+    // Only used for BasicPubSubManager::connectionStats
+    std::chrono::steady_clock::time_point connectedAt_;
+    std::atomic<uint64_t> messagesReceived_{0};
+
     template <typename ManagerSubscription>
     friend class BasicPubSubManager;
 };
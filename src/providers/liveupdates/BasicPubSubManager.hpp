@@ -22,6 +22,7 @@
 #include <exception>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <utility>
@@ -34,6 +35,16 @@ namespace chatterino {
  * simple PubSub servers over the Websocket protocol.
  * It acts as a pool for connections (see BasicPubSubClient).
  *
+ * Subscriptions are packed densely: a new subscription goes to the most used
+ * connection that still has room. Some time after subscriptions were removed,
+ * the pool is rebalanced. Subscriptions are moved off the least used
+ * connections, which are then closed, as long as the remaining connections
+ * have room for them.
+ *
+ * (Un-)subscribing only queues the change. All changes queued before the
+ * websocket thread gets to them are applied in one batch. A subscription that
+ * is added and removed within a batch doesn't send any frames.
+ *
  * You can customize the clients, by creating your custom
  * client in ::createClient.
  *
@@ -61,9 +72,12 @@ template <typename Subscription>
 class BasicPubSubManager
 {
 public:
-    BasicPubSubManager(QString host, QString shortName)
+    BasicPubSubManager(QString host, QString shortName,
+                       std::chrono::milliseconds rebalanceDelay =
+                           std::chrono::seconds(30))
         : host_(std::move(host))
         , shortName_(std::move(shortName))
+        , rebalanceDelay_(rebalanceDelay)
     {
         this->websocketClient_.set_access_channels(
             websocketpp::log::alevel::all);
@@ -73,12 +87,20 @@ public:
 
         this->websocketClient_.init_asio();
 
+        this->rebalanceTimer_ = std::make_shared<boost::asio::steady_timer>(
+            this->websocketClient_.get_io_service());
+
         // SSL Handshake
         this->websocketClient_.set_tls_init_handler([this](auto hdl) {
             return this->onTLSInit(hdl);
         });
 
         this->websocketClient_.set_message_handler([this](auto hdl, auto msg) {
+            if (auto client = this->findClient(hdl))
+            {
+                client->messagesReceived_.fetch_add(1,
+                                                    std::memory_order_relaxed);
+            }
             this->onMessage(hdl, msg);
         });
         this->websocketClient_.set_open_handler([this](auto hdl) {
@@ -108,13 +130,47 @@ public:
     BasicPubSubManager &operator=(const BasicPubSubManager &) = delete;
     BasicPubSubManager &operator=(const BasicPubSubManager &&) = delete;
 
-    /** This is only used for testing. */
+    /** Shown in the debug popup and checked in tests */
     struct {
         std::atomic<uint32_t> connectionsClosed{0};
         std::atomic<uint32_t> connectionsOpened{0};
         std::atomic<uint32_t> connectionsFailed{0};
+        /// Subscriptions moved to another connection while rebalancing
+        std::atomic<uint32_t> subscriptionsMigrated{0};
     } diag;
 
+    struct ConnectionStats {
+        size_t subscriptions = 0;
+        size_t maxSubscriptions = 0;
+        uint64_t messagesReceived = 0;
+        std::chrono::steady_clock::duration uptime{};
+    };
+
+    /// Returns the stats of all open connections, most used first
+    std::vector<ConnectionStats> connectionStats() const
+    {
+        std::lock_guard lock(this->clientsMutex_);
+
+        auto now = std::chrono::steady_clock::now();
+        std::vector<ConnectionStats> stats;
+        stats.reserve(this->clients_.size());
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            stats.push_back({
+                .subscriptions = client->subscriptions_.size(),
+                .maxSubscriptions = client->maxSubscriptions,
+                .messagesReceived =
+                    client->messagesReceived_.load(std::memory_order_relaxed),
+                .uptime = now - client->connectedAt_,
+            });
+        }
+        std::sort(stats.begin(), stats.end(), [](const auto &a, const auto &b) {
+            return a.subscriptions > b.subscriptions;
+        });
+
+        return stats;
+    }
+
     void start()
     {
         this->work_ = std::make_shared<boost::asio::io_service::work>(
@@ -135,9 +191,18 @@ public:
 
         this->stopping_ = true;
 
-        for (const auto &client : this->clients_)
+        boost::asio::post(
+            this->websocketClient_.get_io_service().get_executor(),
+            [this] {
+                this->rebalanceTimer_->cancel();
+            });
+
         {
-            client.second->close("Shutting down");
+            std::lock_guard lock(this->clientsMutex_);
+            for (const auto &client : this->clients_)
+            {
+                client.second->close("Shutting down");
+            }
         }
 
         this->work_.reset();
@@ -194,18 +259,120 @@ protected:
 
     void unsubscribe(const Subscription &subscription)
     {
-        for (auto &client : this->clients_)
+        this->queueOperation(subscription, false);
+    }
+
+    void subscribe(const Subscription &subscription)
+    {
+        this->queueOperation(subscription, true);
+    }
+
+private:
+    struct Operation {
+        Subscription subscription;
+        bool subscribe;
+    };
+
+    void queueOperation(const Subscription &subscription, bool subscribe)
+    {
+        bool scheduleFlush = false;
         {
-            if (client.second->unsubscribe(subscription))
+            std::lock_guard lock(this->operationsMutex_);
+            scheduleFlush = this->operations_.empty();
+            this->operations_.push_back({subscription, subscribe});
+        }
+
+        if (scheduleFlush)
+        {
+            boost::asio::post(
+                this->websocketClient_.get_io_service().get_executor(),
+                [this] {
+                    this->flushOperations();
+                });
+        }
+    }
+
+    /// Applies all queued operations (websocket thread)
+    void flushOperations()
+    {
+        std::vector<Operation> operations;
+        {
+            std::lock_guard lock(this->operationsMutex_);
+            operations.swap(this->operations_);
+        }
+
+        if (this->stopping_)
+        {
+            return;
+        }
+
+        // Only the last operation on a subscription matters
+        std::unordered_map<Subscription, bool> wanted;
+        std::vector<Subscription> order;
+        for (const auto &operation : operations)
+        {
+            bool inserted = wanted
+                                .insert_or_assign(operation.subscription,
+                                                  operation.subscribe)
+                                .second;
+            if (inserted)
             {
-                return;
+                order.push_back(operation.subscription);
+            }
+        }
+
+        std::lock_guard lock(this->clientsMutex_);
+
+        // Unsubscribe first to make room on the connections
+        bool unsubscribed = false;
+        for (const auto &subscription : order)
+        {
+            if (!wanted[subscription])
+            {
+                unsubscribed |= this->unsubscribeNow(subscription);
             }
         }
+        for (const auto &subscription : order)
+        {
+            if (wanted[subscription])
+            {
+                this->subscribeNow(subscription);
+            }
+        }
+
+        if (unsubscribed)
+        {
+            this->scheduleRebalance();
+        }
     }
 
-    void subscribe(const Subscription &subscription)
+    /// Subscribes on the most used connection with room, or queues the
+    /// subscription for a new connection
+    void subscribeNow(const Subscription &subscription)
     {
-        if (this->trySubscribe(subscription))
+        BasicPubSubClient<Subscription> *target = nullptr;
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            if (client->subscriptions_.contains(subscription))
+            {
+                return;
+            }
+            if (client->subscriptions_.size() < client->maxSubscriptions &&
+                (target == nullptr || client->subscriptions_.size() >
+                                          target->subscriptions_.size()))
+            {
+                target = client.get();
+            }
+        }
+
+        if (target != nullptr && target->subscribe(subscription))
+        {
+            return;
+        }
+
+        if (std::find(this->pendingSubscriptions_.begin(),
+                      this->pendingSubscriptions_.end(),
+                      subscription) != this->pendingSubscriptions_.end())
         {
             return;
         }
@@ -215,7 +382,116 @@ protected:
         DebugCount::increase("LiveUpdates subscription backlog");
     }
 
-private:
+    /// @return true if a connection unsubscribed from the subscription
+    bool unsubscribeNow(const Subscription &subscription)
+    {
+        auto pendingIt =
+            std::find(this->pendingSubscriptions_.begin(),
+                      this->pendingSubscriptions_.end(), subscription);
+        if (pendingIt != this->pendingSubscriptions_.end())
+        {
+            this->pendingSubscriptions_.erase(pendingIt);
+            DebugCount::decrease("LiveUpdates subscription backlog");
+            return false;
+        }
+
+        for (auto &client : this->clients_)
+        {
+            if (client.second->unsubscribe(subscription))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void scheduleRebalance()
+    {
+        if (this->rebalanceScheduled_ || this->stopping_)
+        {
+            return;
+        }
+
+        this->rebalanceScheduled_ = true;
+        runAfter(this->rebalanceTimer_, this->rebalanceDelay_,
+                 [this](auto /*timer*/) {
+                     this->rebalance();
+                 });
+    }
+
+    /// Moves the subscriptions of the least used connections to the other
+    /// connections and closes them, as long as the others have room.
+    void rebalance()
+    {
+        this->rebalanceScheduled_ = false;
+
+        // Connections are still being added
+        if (this->stopping_ || this->addingClient_ ||
+            !this->pendingSubscriptions_.empty())
+        {
+            return;
+        }
+
+        std::lock_guard lock(this->clientsMutex_);
+
+        std::vector<std::shared_ptr<BasicPubSubClient<Subscription>>> clients;
+        for (const auto &[hdl, client] : this->clients_)
+        {
+            if (client->isStarted())
+            {
+                clients.push_back(client);
+            }
+        }
+        std::sort(clients.begin(), clients.end(),
+                  [](const auto &a, const auto &b) {
+                      return a->subscriptions_.size() <
+                             b->subscriptions_.size();
+                  });
+
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            auto &source = clients[i];
+
+            size_t room = 0;
+            for (size_t j = i + 1; j < clients.size(); j++)
+            {
+                room += clients[j]->maxSubscriptions -
+                        clients[j]->subscriptions_.size();
+            }
+            if (source->subscriptions_.size() > room)
+            {
+                break;
+            }
+
+            auto subscriptions = std::move(source->subscriptions_);
+            source->subscriptions_.clear();
+            DebugCount::decrease("LiveUpdates subscriptions",
+                                 static_cast<int64_t>(subscriptions.size()));
+
+            for (const auto &subscription : subscriptions)
+            {
+                // Fill up the most used connections first
+                for (size_t j = clients.size() - 1; j > i; j--)
+                {
+                    if (clients[j]->subscribe(subscription))
+                    {
+                        break;
+                    }
+                }
+            }
+            this->diag.subscriptionsMigrated.fetch_add(
+                static_cast<uint32_t>(subscriptions.size()),
+                std::memory_order_acq_rel);
+
+            qCDebug(chatterinoLiveupdates)
+                << "Closing connection after moving" << subscriptions.size()
+                << "subscriptions";
+            // The server drops the subscriptions with the connection, so
+            // there's no need to unsubscribe
+            source->close("Rebalancing connections");
+        }
+    }
+
     void onConnectionOpen(websocketpp::connection_hdl hdl)
     {
         DebugCount::increase("LiveUpdates connections");
@@ -230,6 +506,8 @@ private:
         // shared_from_this
         client->start();
 
+        std::lock_guard lock(this->clientsMutex_);
+
         this->clients_.emplace(hdl, client);
 
         auto pendingSubsToTake = std::min(this->pendingSubscriptions_.size(),
@@ -293,6 +571,8 @@ private:
         DebugCount::decrease("LiveUpdates connections");
         this->diag.connectionsClosed.fetch_add(1, std::memory_order_acq_rel);
 
+        std::lock_guard lock(this->clientsMutex_);
+
         auto clientIt = this->clients_.find(hdl);
 
         // If this assert goes off, there's something wrong with the connection
@@ -309,7 +589,7 @@ private:
         {
             for (const auto &sub : client->subscriptions_)
             {
-                this->subscribe(sub);
+                this->subscribeNow(sub);
             }
         }
     }
@@ -369,24 +649,20 @@ private:
         this->websocketClient_.connect(con);
     }
 
-    bool trySubscribe(const Subscription &subscription)
-    {
-        for (auto &client : this->clients_)
-        {
-            if (client.second->subscribe(subscription))
-            {
-                return true;
-            }
-        }
-        return false;
-    }
-
+    /// Locked on the websocket thread while connections or their
+    /// subscriptions change, so stats can be read from other threads
+    mutable std::mutex clientsMutex_;
     std::map<liveupdates::WebsocketHandle,
              std::shared_ptr<BasicPubSubClient<Subscription>>,
              std::owner_less<liveupdates::WebsocketHandle>>
         clients_;
 
     std::vector<Subscription> pendingSubscriptions_;
+
+    std::mutex operationsMutex_;
+    std::vector<Operation> operations_;
+
+    bool rebalanceScheduled_{false};
     std::atomic<bool> addingClient_{false};
     ExponentialBackoff<5> connectBackoff_{std::chrono::milliseconds(1000)};
 
@@ -395,11 +671,17 @@ private:
     liveupdates::WebsocketClient websocketClient_;
     std::unique_ptr<std::thread> mainThread_;
 
+    // Declared after the client, so it's destroyed before its io_service
+    std::shared_ptr<boost::asio::steady_timer> rebalanceTimer_;
+
     const QString host_;
 
     /// Short name of the service (e.g. "7TV" or "BTTV")
     const QString shortName_;
 
+    /// Time between removing subscriptions and rebalancing the connections
+    const std::chrono::milliseconds rebalanceDelay_;
+
     bool stopping_{false};
 };
 
@@ -4,13 +4,40 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
 #include "providers/recentmessages/Impl.hpp"
+#include "providers/recentmessages/MessageCache.hpp"
 #include "util/PostToThread.hpp"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtConcurrent>
+
 namespace {
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoRecentMessages;
 
+using namespace chatterino;
+
+/// Notifies the user about a possible gap in logs if the API returned some
+/// messages but isn't currently joined to the channel
+void notifyApiError(const QJsonObject &root, Channel &channel,
+                    const std::vector<MessagePtr> &messages)
+{
+    const auto errorCode = root.value("error_code").toString();
+    if (errorCode.isEmpty())
+    {
+        return;
+    }
+
+    qCDebug(LOG) << QString("Got error from API: error_code=%1, channel=%2")
+                        .arg(errorCode, channel.getName());
+    if (errorCode == "channel_not_joined" && !messages.empty())
+    {
+        channel.addSystemMessage("Message history service recovering, there "
+                                 "may be gaps in the message history.");
+    }
+}
+
 }  // namespace
 
 namespace chatterino::recentmessages {
@@ -34,46 +61,41 @@ void load(
     const long delayMs = jitter ? std::rand() % 100 : 0;
     QTimer::singleShot(delayMs, [=] {
         NetworkRequest(url)
-            .onSuccess([channelPtr, onLoaded](const auto &result) {
-                auto shared = channelPtr.lock();
-                if (!shared)
+            .onSuccess([channelName, channelPtr,
+                        onLoaded](const auto &result) {
+                if (channelPtr.expired())
                 {
                     return;
                 }
 
                 qCDebug(LOG) << "Successfully loaded recent messages for"
-                             << shared->getName();
-
-                auto root = result.parseJson();
-                auto parsedMessages = parseRecentMessages(root);
-
-                // build the Communi messages into chatterino messages
-                auto builtMessages =
-                    buildRecentMessages(parsedMessages, shared.get());
-
-                postToThread([shared = std::move(shared),
-                              root = std::move(root),
-                              messages = std::move(builtMessages),
-                              onLoaded]() mutable {
-                    // Notify user about a possible gap in logs if it returned some messages
-                    // but isn't currently joined to a channel
-                    const auto errorCode = root.value("error_code").toString();
-                    if (!errorCode.isEmpty())
-                    {
-                        qCDebug(LOG)
-                            << QString("Got error from API: error_code=%1, "
-                                       "channel=%2")
-                                   .arg(errorCode, shared->getName());
-                        if (errorCode == "channel_not_joined" &&
-                            !messages.empty())
-                        {
-                            shared->addSystemMessage(
-                                "Message history service recovering, there may "
-                                "be gaps in the message history.");
-                        }
-                    }
-
-                    onLoaded(messages);
+                             << channelName;
+
+                // The response and its messages are parsed and built on
+                // worker threads
+                std::ignore = QtConcurrent::run([channelName, channelPtr,
+                                                 onLoaded,
+                                                 data = result.getData()] {
+                    auto root = QJsonDocument::fromJson(data).object();
+                    auto jsonMessages = root.value("messages").toArray();
+                    MessageCache::instance().add(channelName, jsonMessages);
+
+                    postToThread([channelPtr, onLoaded, root = std::move(root),
+                                  jsonMessages =
+                                      std::move(jsonMessages)]() mutable {
+                        buildRecentMessagesConcurrently(
+                            std::move(jsonMessages), channelPtr,
+                            [channelPtr, onLoaded, root = std::move(root)](
+                                std::vector<MessagePtr> &&messages) {
+                                auto shared = channelPtr.lock();
+                                if (!shared)
+                                {
+                                    return;
+                                }
+                                notifyApiError(root, *shared, messages);
+                                onLoaded(messages);
+                            });
+                    });
                 });
             })
             .onError([channelPtr, onError](const NetworkResult &result) {
@@ -97,4 +119,40 @@ void load(
     });
 }
 
+void loadPersisted(const QString &channelName,
+                   std::weak_ptr<Channel> channelPtr,
+                   PersistedCallback onLoaded, ErrorCallback onEmpty)
+{
+    // Lines received from now on are shown live
+    auto before = std::chrono::system_clock::now();
+    std::ignore = QtConcurrent::run([channelName, channelPtr, onLoaded,
+                                     onEmpty, before] {
+        auto persisted =
+            MessageCache::instance().loadPersisted(channelName, before);
+        if (!persisted)
+        {
+            postToThread(onEmpty);
+            return;
+        }
+
+        // The messages are built on worker threads like the ones from the API
+        postToThread([channelPtr, onLoaded, onEmpty,
+                      jsonMessages =
+                          persisted->root.value("messages").toArray(),
+                      newest = persisted->newest]() mutable {
+            buildRecentMessagesConcurrently(
+                std::move(jsonMessages), channelPtr,
+                [onLoaded, onEmpty,
+                 newest](std::vector<MessagePtr> &&builtMessages) {
+                    if (builtMessages.empty())
+                    {
+                        onEmpty();
+                        return;
+                    }
+                    onLoaded(builtMessages, newest);
+                });
+        });
+    });
+}
+
 }  // namespace chatterino::recentmessages
@@ -22,6 +22,9 @@ namespace chatterino::recentmessages {
 
 using ResultCallback = std::function<void(const std::vector<MessagePtr> &)>;
 using ErrorCallback = std::function<void()>;
+using PersistedCallback = std::function<void(
+    const std::vector<MessagePtr> &,
+    std::chrono::time_point<std::chrono::system_clock>)>;
 
 /**
  * @brief Loads recent messages for a channel using the Recent Messages API
@@ -42,4 +45,19 @@ void load(
     std::optional<std::chrono::time_point<std::chrono::system_clock>> before,
     bool jitter);
 
+/**
+ * @brief Restores the messages of a channel that were recorded before it was joined
+ *
+ * On the first join, these are the messages persisted on the previous run.
+ * The messages are read and parsed on a worker thread (see MessageCache).
+ *
+ * @param channelName Name of Twitch channel
+ * @param channelPtr Weak pointer to Channel to use to build messages
+ * @param onLoaded Callback taking the built messages and the time the newest of them was received
+ * @param onEmpty Callback called when no messages were persisted for the channel
+ */
+void loadPersisted(const QString &channelName,
+                   std::weak_ptr<Channel> channelPtr,
+                   PersistedCallback onLoaded, ErrorCallback onEmpty);
+
 }  // namespace chatterino::recentmessages
@@ -1,13 +1,106 @@
 #include "providers/recentmessages/Impl.hpp"
 
 #include "common/Env.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "util/Helpers.hpp"
+#include "util/PostToThread.hpp"
 
+#include <QCoreApplication>
 #include <QJsonArray>
+#include <QtConcurrent>
 #include <QUrlQuery>
 
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::recentmessages::detail;
+
+/// Replies need the reply threads of the channel and timeouts replace
+/// previous messages, so these can't be built independently
+bool dependsOnLoadedMessages(const Communi::IrcMessage *message)
+{
+    if (message->command() == u"CLEARCHAT")
+    {
+        return true;
+    }
+
+    const auto &tags = message->tags();
+    return tags.contains("reply-thread-parent-msg-id") ||
+           tags.contains("reply-parent-msg-id");
+}
+
+/// The state of one buildRecentMessagesConcurrently call. This is only
+/// accessed on the GUI thread.
+struct ConcurrentBuild {
+    ConcurrentBuild(std::weak_ptr<Channel> channel_,
+                    std::function<void(std::vector<MessagePtr> &&)> onBuilt_,
+                    size_t nChunks)
+        : channel(std::move(channel_))
+        , onBuilt(std::move(onBuilt_))
+        , chunks(nChunks)
+    {
+    }
+
+    ~ConcurrentBuild()
+    {
+        for (const auto &chunk : this->chunks)
+        {
+            if (!chunk)
+            {
+                continue;
+            }
+            for (const auto &pending : *chunk)
+            {
+                delete pending.deferred;
+            }
+        }
+    }
+
+    ConcurrentBuild(const ConcurrentBuild &) = delete;
+    ConcurrentBuild &operator=(const ConcurrentBuild &) = delete;
+    ConcurrentBuild(ConcurrentBuild &&) = delete;
+    ConcurrentBuild &operator=(ConcurrentBuild &&) = delete;
+
+    /// Finishes all chunks whose previous chunks are finished
+    void finishReadyChunks()
+    {
+        auto shared = this->channel.lock();
+        if (!shared)
+        {
+            return;
+        }
+
+        while (this->nextChunk < this->chunks.size() &&
+               this->chunks[this->nextChunk])
+        {
+            auto &chunk = this->chunks[this->nextChunk];
+            finishRecentMessages(*chunk, shared.get(),
+                                 this->allBuiltMessages);
+            chunk->clear();
+            this->nextChunk++;
+        }
+
+        if (this->nextChunk == this->chunks.size() && this->onBuilt)
+        {
+            auto onBuilt = std::move(this->onBuilt);
+            this->onBuilt = nullptr;
+            onBuilt(std::move(this->allBuiltMessages));
+        }
+    }
+
+    const std::weak_ptr<Channel> channel;
+    std::function<void(std::vector<MessagePtr> &&)> onBuilt;
+    std::vector<std::optional<std::vector<PendingRecentMessage>>> chunks;
+    size_t nextChunk = 0;
+    std::vector<MessagePtr> allBuiltMessages;
+};
+
+}  // namespace
+
 namespace chatterino::recentmessages::detail {
 
 // Parse the IRC messages returned in JSON form into Communi messages
@@ -15,16 +108,23 @@ std::vector<Communi::IrcMessage *> parseRecentMessages(
     const QJsonObject &jsonRoot)
 {
     const auto jsonMessages = jsonRoot.value("messages").toArray();
-    std::vector<Communi::IrcMessage *> messages;
+    return parseRecentMessages(jsonMessages, 0, jsonMessages.size());
+}
 
-    if (jsonMessages.empty())
+// Parse the lines [begin, end) of the "messages" array of a response
+std::vector<Communi::IrcMessage *> parseRecentMessages(
+    const QJsonArray &jsonMessages, qsizetype begin, qsizetype end)
+{
+    std::vector<Communi::IrcMessage *> messages;
+    if (begin >= end)
     {
         return messages;
     }
+    messages.reserve(static_cast<size_t>(end - begin));
 
-    for (const auto &jsonMessage : jsonMessages)
+    for (auto i = begin; i < end; i++)
     {
-        auto content = unescapeZeroWidthJoiner(jsonMessage.toString());
+        auto content = unescapeZeroWidthJoiner(jsonMessages.at(i).toString());
 
         auto *message =
             Communi::IrcMessage::fromData(content.toUtf8(), nullptr);
@@ -40,42 +140,144 @@ std::vector<Communi::IrcMessage *> parseRecentMessages(
 std::vector<MessagePtr> buildRecentMessages(
     std::vector<Communi::IrcMessage *> &messages, Channel *channel)
 {
+    auto pending = prepareRecentMessages(messages, channel);
+
     std::vector<MessagePtr> allBuiltMessages;
+    finishRecentMessages(pending, channel, allBuiltMessages);
+
+    return allBuiltMessages;
+}
+
+std::vector<PendingRecentMessage> prepareRecentMessages(
+    std::vector<Communi::IrcMessage *> &messages, Channel *channel)
+{
+    std::vector<PendingRecentMessage> pending;
+    pending.reserve(messages.size());
 
     for (auto *message : messages)
     {
+        PendingRecentMessage entry;
         if (message->tags().contains("rm-received-ts"))
         {
-            const auto msgDate =
+            entry.date =
                 QDateTime::fromMSecsSinceEpoch(
                     message->tags().value("rm-received-ts").toLongLong())
                     .date();
+        }
 
-            // Check if we need to insert a message stating that a new day began
-            if (msgDate != channel->lastDate_)
+        if (dependsOnLoadedMessages(message))
+        {
+            entry.deferred = message;
+        }
+        else
+        {
+            std::vector<MessagePtr> noOtherLoaded;
+            entry.built = IrcMessageHandler::parseMessageWithReply(
+                channel, message, noOtherLoaded);
+            for (const auto &builtMessage : entry.built)
             {
-                channel->lastDate_ = msgDate;
-                auto msg = makeSystemMessage(
-                    QLocale().toString(msgDate, QLocale::LongFormat),
-                    QTime(0, 0));
-                msg->flags.set(MessageFlag::RecentMessage);
-                allBuiltMessages.emplace_back(msg);
+                builtMessage->flags.set(MessageFlag::RecentMessage);
             }
+            delete message;
         }
 
-        auto builtMessages = IrcMessageHandler::parseMessageWithReply(
-            channel, message, allBuiltMessages);
+        pending.emplace_back(std::move(entry));
+    }
+    messages.clear();
+
+    return pending;
+}
 
-        for (const auto &builtMessage : builtMessages)
+void finishRecentMessages(std::vector<PendingRecentMessage> &pending,
+                          Channel *channel,
+                          std::vector<MessagePtr> &allBuiltMessages)
+{
+    for (auto &entry : pending)
+    {
+        // Check if we need to insert a message stating that a new day began
+        if (entry.date.isValid() && entry.date != channel->lastDate_)
         {
-            builtMessage->flags.set(MessageFlag::RecentMessage);
-            allBuiltMessages.emplace_back(builtMessage);
+            channel->lastDate_ = entry.date;
+            auto msg = makeSystemMessage(
+                QLocale().toString(entry.date, QLocale::LongFormat),
+                QTime(0, 0));
+            msg->flags.set(MessageFlag::RecentMessage);
+            allBuiltMessages.emplace_back(msg);
         }
 
-        message->deleteLater();
+        if (entry.deferred)
+        {
+            entry.built = IrcMessageHandler::parseMessageWithReply(
+                channel, entry.deferred, allBuiltMessages);
+            for (const auto &builtMessage : entry.built)
+            {
+                builtMessage->flags.set(MessageFlag::RecentMessage);
+            }
+            entry.deferred->deleteLater();
+            entry.deferred = nullptr;
+        }
+
+        for (auto &builtMessage : entry.built)
+        {
+            allBuiltMessages.emplace_back(std::move(builtMessage));
+        }
+        entry.built.clear();
     }
+}
 
-    return allBuiltMessages;
+void buildRecentMessagesConcurrently(
+    QJsonArray jsonMessages, std::weak_ptr<Channel> channel,
+    std::function<void(std::vector<MessagePtr> &&)> onBuilt)
+{
+    assertInGuiThread();
+
+    auto nChunks = static_cast<size_t>(
+        (static_cast<qsizetype>(jsonMessages.size()) +
+         RECENT_MESSAGES_CHUNK_SIZE - 1) /
+        RECENT_MESSAGES_CHUNK_SIZE);
+    auto state = std::make_shared<ConcurrentBuild>(
+        std::move(channel), std::move(onBuilt), nChunks);
+
+    if (nChunks == 0)
+    {
+        state->finishReadyChunks();
+        return;
+    }
+
+    for (size_t i = 0; i < nChunks; i++)
+    {
+        auto begin = static_cast<qsizetype>(i) * RECENT_MESSAGES_CHUNK_SIZE;
+        auto end = std::min<qsizetype>(begin + RECENT_MESSAGES_CHUNK_SIZE,
+                                       jsonMessages.size());
+
+        std::ignore = QtConcurrent::run([state, jsonMessages, i, begin,
+                                         end]() mutable {
+            std::vector<PendingRecentMessage> pending;
+            auto shared = state->channel.lock();
+            if (shared)
+            {
+                auto parsed = parseRecentMessages(jsonMessages, begin, end);
+                pending = prepareRecentMessages(parsed, shared.get());
+                for (const auto &entry : pending)
+                {
+                    if (entry.deferred)
+                    {
+                        // finishRecentMessages deletes them later on the GUI
+                        // thread
+                        entry.deferred->moveToThread(
+                            QCoreApplication::instance()->thread());
+                    }
+                }
+            }
+
+            // The channel and the state must be released on the GUI thread
+            postToThread([state = std::move(state), shared = std::move(shared),
+                          i, pending = std::move(pending)]() mutable {
+                state->chunks[i] = std::move(pending);
+                state->finishReadyChunks();
+            });
+        });
+    }
 }
 
 // Returns the URL to be used for querying the Recent Messages API for the
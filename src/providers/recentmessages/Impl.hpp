@@ -4,26 +4,73 @@
 #include "messages/Message.hpp"
 
 #include <IrcMessage>
+#include <QDate>
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QString>
 #include <QUrl>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <vector>
 
 namespace chatterino::recentmessages::detail {
 
+/// Number of lines that are parsed and built by one worker task in
+/// buildRecentMessagesConcurrently
+constexpr qsizetype RECENT_MESSAGES_CHUNK_SIZE = 100;
+
+/// A line of a Recent Messages API response that's (partially) built
+struct PendingRecentMessage {
+    /// The day the line was received on, invalid if unknown
+    QDate date;
+    /// The messages built from the line
+    std::vector<MessagePtr> built;
+    /// The parsed line if it depends on the messages loaded before it
+    /// (replies and timeouts). These are built by finishRecentMessages.
+    Communi::IrcMessage *deferred = nullptr;
+};
+
 // Parse the IRC messages returned in JSON form into Communi messages
 std::vector<Communi::IrcMessage *> parseRecentMessages(
     const QJsonObject &jsonRoot);
 
+// Parse the lines [begin, end) of the "messages" array of a response
+std::vector<Communi::IrcMessage *> parseRecentMessages(
+    const QJsonArray &jsonMessages, qsizetype begin, qsizetype end);
+
 // Build Communi messages retrieved from the recent messages API into
 // proper chatterino messages.
 std::vector<MessagePtr> buildRecentMessages(
     std::vector<Communi::IrcMessage *> &messages, Channel *channel);
 
+/// Builds all messages that don't depend on other messages and deletes their
+/// Communi messages. This doesn't modify the channel and can be called
+/// from any thread.
+std::vector<PendingRecentMessage> prepareRecentMessages(
+    std::vector<Communi::IrcMessage *> &messages, Channel *channel);
+
+/// Builds the deferred messages of `pending` and inserts the date separators.
+/// The result is appended to `allBuiltMessages`, which must contain the
+/// messages of the previous lines. This must be called on the GUI thread in
+/// the order of the lines.
+void finishRecentMessages(std::vector<PendingRecentMessage> &pending,
+                          Channel *channel,
+                          std::vector<MessagePtr> &allBuiltMessages);
+
+/// Parses and builds the lines of a Recent Messages API response in chunks
+/// on the global thread pool. The chunks are finished on the GUI thread as
+/// soon as all previous ones are, so the event loop keeps running between
+/// them. `onBuilt` is called on the GUI thread with all messages in order,
+/// unless the channel is destroyed.
+///
+/// This must be called on the GUI thread.
+void buildRecentMessagesConcurrently(
+    QJsonArray jsonMessages, std::weak_ptr<Channel> channel,
+    std::function<void(std::vector<MessagePtr> &&)> onBuilt);
+
 // Returns the URL to be used for querying the Recent Messages API for the
 // given channel.
 QUrl constructRecentMessagesUrl(
@@ -0,0 +1,326 @@
+#include "providers/recentmessages/MessageCache.hpp"
+
+#include "common/QLogging.hpp"
+#include "providers/twitch/TwitchIrcLine.hpp"
+#include "util/CombinePath.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+
+namespace {
+
+using namespace chatterino;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+const auto &LOG = chatterinoRecentMessages;
+
+/// Messages received this far apart are never the same message
+constexpr int64_t DUPLICATE_WINDOW_MS = 60 * 1000;
+
+/// Commands that show up in the history of a channel
+bool isChannelMessage(const TwitchIrcLine &line)
+{
+    if (!line.isCommand("PRIVMSG") && !line.isCommand("USERNOTICE") &&
+        !line.isCommand("CLEARCHAT") && !line.isCommand("CLEARMSG"))
+    {
+        return false;
+    }
+
+    auto target = line.rawParameter(0);
+    return target.size() > 1 && target.front() == '#';
+}
+
+int64_t parseTimestamp(std::string_view value)
+{
+    int64_t result = 0;
+    std::from_chars(value.data(), value.data() + value.size(), result);
+    return result;
+}
+
+}  // namespace
+
+namespace chatterino::recentmessages {
+
+MessageCache &MessageCache::instance()
+{
+    static MessageCache cache;
+    return cache;
+}
+
+void MessageCache::initialize(QString directory, size_t limit)
+{
+    std::lock_guard lock(this->mutex_);
+    this->directory_ = std::move(directory);
+    this->limit_ = limit;
+}
+
+void MessageCache::add(const TwitchIrcLine &line, TimePoint receivedAt)
+{
+    if (!isChannelMessage(line))
+    {
+        return;
+    }
+
+    auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  receivedAt.time_since_epoch())
+                  .count();
+
+    // Store the line like the Recent Messages API would return it
+    auto raw = line.raw();
+    auto extraTags = QByteArray("historical=1;rm-received-ts=") +
+                     QByteArray::number(static_cast<qint64>(ts));
+    if (raw.startsWith('@'))
+    {
+        raw.insert(1, extraTags + ';');
+    }
+    else
+    {
+        raw.prepend('@' + extraTags + ' ');
+    }
+
+    std::lock_guard lock(this->mutex_);
+    if (this->limit_ == 0)
+    {
+        return;
+    }
+
+    auto channelName = line.parameter(0).mid(1).toLower();
+    this->insert(this->channels_[channelName], {
+                                                   .line = std::move(raw),
+                                                   .receivedAt = ts,
+                                                   .id = line.tag("id"),
+                                               });
+}
+
+void MessageCache::add(const QString &channelName, const QJsonArray &lines)
+{
+    std::lock_guard lock(this->mutex_);
+    if (this->limit_ == 0)
+    {
+        return;
+    }
+
+    auto &channel = this->channels_[channelName.toLower()];
+    for (const auto &value : lines)
+    {
+        auto raw = value.toString().toUtf8();
+        auto line = TwitchIrcLine::parse(raw);
+        if (!line || !isChannelMessage(*line))
+        {
+            continue;
+        }
+
+        this->insert(channel, {
+                                  .line = std::move(raw),
+                                  .receivedAt = parseTimestamp(
+                                      line->rawTag("rm-received-ts")),
+                                  .id = line->tag("id"),
+                              });
+    }
+}
+
+std::optional<MessageCache::Persisted> MessageCache::loadPersisted(
+    const QString &channelName, TimePoint before)
+{
+    auto beforeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        before.time_since_epoch())
+                        .count();
+
+    QString path;
+    {
+        std::lock_guard lock(this->mutex_);
+        if (this->directory_.isEmpty() || this->limit_ == 0)
+        {
+            return std::nullopt;
+        }
+
+        auto &channel = this->channels_[channelName.toLower()];
+        if (channel.restored)
+        {
+            // The file was read on an earlier join. The lines recorded since
+            // then include everything in it.
+            return this->history(channel, beforeMs);
+        }
+        channel.restored = true;
+        path = this->filePath(channelName);
+    }
+
+    QFile file(path);
+    if (file.open(QFile::ReadOnly))
+    {
+        auto root = QJsonDocument::fromJson(file.readAll()).object();
+        auto lines = root.value("messages").toArray();
+
+        // Keep the persisted lines if no new ones are received
+        this->add(channelName, lines);
+        qCDebug(LOG) << "Restored" << lines.size() << "persisted messages for"
+                     << channelName;
+    }
+
+    std::lock_guard lock(this->mutex_);
+    return this->history(this->channels_[channelName.toLower()], beforeMs);
+}
+
+void MessageCache::save()
+{
+    std::lock_guard lock(this->mutex_);
+    if (this->directory_.isEmpty() || this->limit_ == 0)
+    {
+        return;
+    }
+
+    QDir().mkpath(this->directory_);
+
+    for (auto &[channelName, channel] : this->channels_)
+    {
+        if (!channel.modified || channel.entries.empty())
+        {
+            continue;
+        }
+
+        QJsonArray lines;
+        for (const auto &entry : channel.entries)
+        {
+            lines.append(QString::fromUtf8(entry.line));
+        }
+
+        QJsonObject root{
+            {"messages", lines},
+            {"newest",
+             static_cast<double>(channel.entries.back().receivedAt)},
+        };
+
+        QSaveFile file(this->filePath(channelName));
+        if (!file.open(QSaveFile::WriteOnly))
+        {
+            qCWarning(LOG) << "Failed to persist messages of" << channelName
+                           << file.errorString();
+            continue;
+        }
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        if (!file.commit())
+        {
+            qCWarning(LOG) << "Failed to persist messages of" << channelName
+                           << file.errorString();
+            continue;
+        }
+        channel.modified = false;
+    }
+}
+
+std::vector<QByteArray> MessageCache::lines(const QString &channelName) const
+{
+    std::lock_guard lock(this->mutex_);
+
+    std::vector<QByteArray> result;
+    auto it = this->channels_.find(channelName.toLower());
+    if (it == this->channels_.end())
+    {
+        return result;
+    }
+
+    result.reserve(it->second.entries.size());
+    for (const auto &entry : it->second.entries)
+    {
+        result.push_back(entry.line);
+    }
+    return result;
+}
+
+void MessageCache::insert(ChannelLines &channel, Entry entry)
+{
+    auto &entries = channel.entries;
+
+    // Messages are mostly received in order, so the position is found from
+    // the back
+    auto pos = entries.end();
+    while (pos != entries.begin() &&
+           std::prev(pos)->receivedAt > entry.receivedAt)
+    {
+        --pos;
+    }
+
+    if (!entry.id.isEmpty())
+    {
+        // The same message is usually received within a short time (live
+        // and from the API), so only messages around the position are
+        // checked
+        for (auto it = pos; it != entries.begin();)
+        {
+            --it;
+            if (entry.receivedAt - it->receivedAt > DUPLICATE_WINDOW_MS)
+            {
+                break;
+            }
+            if (it->id == entry.id)
+            {
+                return;
+            }
+        }
+        for (auto it = pos; it != entries.end(); ++it)
+        {
+            if (it->receivedAt - entry.receivedAt > DUPLICATE_WINDOW_MS)
+            {
+                break;
+            }
+            if (it->id == entry.id)
+            {
+                return;
+            }
+        }
+    }
+
+    if (entries.size() >= this->limit_ && pos == entries.begin())
+    {
+        // Older than everything that's kept
+        return;
+    }
+
+    entries.insert(pos, std::move(entry));
+    while (entries.size() > this->limit_)
+    {
+        entries.pop_front();
+    }
+    channel.modified = true;
+}
+
+std::optional<MessageCache::Persisted> MessageCache::history(
+    const ChannelLines &channel, int64_t before) const
+{
+    QJsonArray lines;
+    int64_t newest = 0;
+    for (const auto &entry : channel.entries)
+    {
+        if (entry.receivedAt >= before)
+        {
+            // Received live since the channel was joined
+            break;
+        }
+        lines.append(QString::fromUtf8(entry.line));
+        newest = entry.receivedAt;
+    }
+
+    if (lines.isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    return Persisted{
+        .root = QJsonObject{{"messages", lines}},
+        .newest = TimePoint(std::chrono::milliseconds(newest)),
+    };
+}
+
+QString MessageCache::filePath(const QString &channelName) const
+{
+    return combinePath(this->directory_, channelName.toLower() + ".json");
+}
+
+}  // namespace chatterino::recentmessages
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class TwitchIrcLine;
+
+}  // namespace chatterino
+
+namespace chatterino::recentmessages {
+
+/// The raw IRC lines of the last messages of every channel.
+///
+/// The lines are persisted on shutdown, so the history of a channel can be
+/// shown right away on the next start. Only the messages sent after the
+/// newest persisted one have to be requested from the Recent Messages API
+/// then.
+///
+/// Lines are stored in the format of the Recent Messages API (with the
+/// `historical` and `rm-received-ts` tags), so they're parsed and built like
+/// the messages returned by the API.
+class MessageCache
+{
+public:
+    using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+    struct Persisted {
+        /// The lines in the format of a Recent Messages API response
+        QJsonObject root;
+        /// When the newest line was received
+        TimePoint newest;
+    };
+
+    static MessageCache &instance();
+
+    /// Sets the directory the lines are persisted in and how many lines are
+    /// kept per channel. Nothing is recorded before this is called.
+    void initialize(QString directory, size_t limit);
+
+    /// Records a line received from Twitch if it's a message in a channel
+    void add(const TwitchIrcLine &line, TimePoint receivedAt);
+
+    /// Records the lines of a Recent Messages API response for `channelName`
+    void add(const QString &channelName, const QJsonArray &lines);
+
+    /// Returns the lines of `channelName` that were received before `before`.
+    ///
+    /// The lines persisted on the previous run are only read from disk on the
+    /// first call for a channel. Later calls (when the channel is joined
+    /// again) return the lines recorded since then.
+    /// This can be called from any thread.
+    std::optional<Persisted> loadPersisted(const QString &channelName,
+                                           TimePoint before);
+
+    /// Writes the lines of all channels that received messages to disk
+    void save();
+
+    /// The recorded lines of `channelName` from oldest to newest
+    std::vector<QByteArray> lines(const QString &channelName) const;
+
+private:
+    struct Entry {
+        QByteArray line;
+        int64_t receivedAt = 0;
+        QString id;
+    };
+
+    struct ChannelLines {
+        std::deque<Entry> entries;
+        bool modified = false;
+        /// Set once the persisted lines were read from disk
+        bool restored = false;
+    };
+
+    /// Inserts `entry` ordered by the time it was received, skipping
+    /// messages that are already recorded
+    void insert(ChannelLines &channel, Entry entry);
+    /// The entries of `channel` received before `before` (in milliseconds)
+    std::optional<Persisted> history(const ChannelLines &channel,
+                                     int64_t before) const;
+    QString filePath(const QString &channelName) const;
+
+    mutable std::mutex mutex_;
+    QString directory_;
+    size_t limit_ = 0;
+    std::unordered_map<QString, ChannelLines> channels_;
+};
+
+}  // namespace chatterino::recentmessages
@@ -4,22 +4,28 @@
 #include "common/Literals.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "providers/ProviderSnapshot.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/SeventvAPI.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Settings.hpp"
 #include "util/Helpers.hpp"
+#include "util/Variant.hpp"
 
 #include <QImageReader>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QtConcurrent>
 #include <QThread>
 
 #include <array>
+#include <atomic>
 #include <utility>
 
 /**
@@ -40,10 +46,14 @@ using namespace seventv::eventapi;
 const QString CHANNEL_HAS_NO_EMOTES("This channel has no 7TV channel emotes.");
 const QString EMOTE_LINK_FORMAT("https://7tv.app/emotes/%1");
 
-// This is non-const, but only used on the GUI thread
+/// Key of the global emotes in the `ProviderSnapshot`
+const QString GLOBAL_SNAPSHOT_KEY = QStringLiteral("seventv.global");
+
+// This is non-const. The handler is registered on the GUI thread (see
+// loadGlobalEmotes), but the value is also read on worker threads.
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 auto ALLOW_AVIF_IMAGES = []() {
-    static bool allow = true;
+    static std::atomic<bool> allow = true;
     static bool registered = false;
     if (!registered)
     {
@@ -55,7 +65,7 @@ auto ALLOW_AVIF_IMAGES = []() {
         });
         registered = true;
     }
-    return allow;
+    return allow.load(std::memory_order_relaxed);
 };
 
 struct CreateEmoteResult {
@@ -274,21 +284,52 @@ void SeventvEmotes::loadGlobalEmotes()
 
     qCDebug(chatterinoSeventv) << "Loading 7TV Global Emotes";
 
-    getApp()->getSeventvAPI()->getEmoteSet(
-        u"global"_s,
-        [this](const auto &json) {
-            QJsonArray parsedEmotes = json["emotes"].toArray();
-
-            auto emoteMap =
-                parseEmotes(parsedEmotes, SeventvEmoteSetKind::Global);
-            qCDebug(chatterinoSeventv)
-                << "Loaded" << emoteMap.size() << "7TV Global Emotes";
-            this->setGlobalEmotes(
-                std::make_shared<EmoteMap>(std::move(emoteMap)));
+    // The setting handler has to be registered on the GUI thread before
+    // emotes are created on a worker thread
+    std::ignore = ALLOW_AVIF_IMAGES();
+
+    // The emotes are created on a worker thread. The parsed map replaces the
+    // current one atomically.
+    auto startNs = trace::now();
+    ProviderSnapshot::instance().restore(
+        GLOBAL_SNAPSHOT_KEY,
+        [this](const QByteArray &data) {
+            auto json = QJsonDocument::fromJson(data).object();
+            this->setGlobalEmotes(std::make_shared<EmoteMap>(parseEmotes(
+                json["emotes"].toArray(), SeventvEmoteSetKind::Global)));
         },
-        [](const auto &result) {
-            qCWarning(chatterinoSeventv)
-                << "Couldn't load 7TV global emotes" << result.getData();
+        [this, startNs] {
+            getApp()->getSeventvAPI()->getEmoteSet(
+                u"global"_s,
+                [this, startNs](const QJsonObject &json) {
+                    std::ignore = QtConcurrent::run([this, startNs, json] {
+                        // The API doesn't send an ETag, so the snapshot is
+                        // revalidated by its contents
+                        auto data = QJsonDocument(json).toJson(
+                            QJsonDocument::Compact);
+                        if (!ProviderSnapshot::instance().contains(
+                                GLOBAL_SNAPSHOT_KEY, data))
+                        {
+                            auto emoteMap =
+                                parseEmotes(json["emotes"].toArray(),
+                                            SeventvEmoteSetKind::Global);
+                            qCDebug(chatterinoSeventv)
+                                << "Loaded" << emoteMap.size()
+                                << "7TV Global Emotes";
+                            this->setGlobalEmotes(std::make_shared<EmoteMap>(
+                                std::move(emoteMap)));
+                            ProviderSnapshot::instance().set(
+                                GLOBAL_SNAPSHOT_KEY, {{}, std::move(data)});
+                        }
+                        startup::markBackground("7TV global emotes loaded",
+                                                startNs);
+                    });
+                },
+                [](const auto &result) {
+                    qCWarning(chatterinoSeventv)
+                        << "Couldn't load 7TV global emotes"
+                        << result.getData();
+                });
         });
 }
 
@@ -387,74 +428,87 @@ void SeventvEmotes::loadChannelEmotes(
         });
 }
 
-std::optional<EmotePtr> SeventvEmotes::addEmote(
-    Atomic<std::shared_ptr<const EmoteMap>> &map,
-    const EmoteAddDispatch &dispatch, SeventvEmoteSetKind kind)
+std::vector<SeventvEmotes::AppliedEmoteChange>
+    SeventvEmotes::applyEmoteSetChanges(
+        Atomic<std::shared_ptr<const EmoteMap>> &map,
+        const EmoteSetChanges &changes, SeventvEmoteSetKind kind)
 {
-    // Check for visibility first, so we don't copy the map.
-    auto emoteData = dispatch.emoteJson["data"].toObject();
-    if (emoteData.empty() || !checkEmoteVisibility(emoteData, kind))
+    std::vector<AppliedEmoteChange> applied;
+    if (changes.changes.empty())
     {
-        return std::nullopt;
+        return applied;
     }
 
-    // This copies the map.
+    // This copies the map once for all changes.
     EmoteMap updatedMap = *map.get();
-    auto result = createEmote(dispatch.emoteJson, emoteData, kind);
-    if (!result.hasImages)
-    {
-        // Incoming emote didn't contain any images, abort
-        qCDebug(chatterinoSeventv)
-            << "Emote without images:" << dispatch.emoteJson;
-        return std::nullopt;
-    }
-    auto emote = std::make_shared<const Emote>(std::move(result.emote));
-    updatedMap[result.name] = emote;
-    map.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
 
-    return emote;
-}
-
-std::optional<EmotePtr> SeventvEmotes::updateEmote(
-    Atomic<std::shared_ptr<const EmoteMap>> &map,
-    const EmoteUpdateDispatch &dispatch, SeventvEmoteSetKind kind)
-{
-    auto oldMap = map.get();
-    auto oldEmote = oldMap->findEmote(dispatch.emoteName, dispatch.emoteID);
-    if (oldEmote == oldMap->end())
+    for (size_t i = 0; i < changes.changes.size(); i++)
     {
-        return std::nullopt;
-    }
+        auto emote = std::visit(
+            variant::Overloaded{
+                [&](const EmoteAddDispatch &dispatch) -> EmotePtr {
+                    auto emoteData = dispatch.emoteJson["data"].toObject();
+                    if (emoteData.empty() ||
+                        !checkEmoteVisibility(emoteData, kind))
+                    {
+                        return nullptr;
+                    }
 
-    // This copies the map.
-    EmoteMap updatedMap = *map.get();
-    updatedMap.erase(oldEmote->second->name);
+                    auto result =
+                        createEmote(dispatch.emoteJson, emoteData, kind);
+                    if (!result.hasImages)
+                    {
+                        // Incoming emote didn't contain any images, skip it
+                        qCDebug(chatterinoSeventv)
+                            << "Emote without images:" << dispatch.emoteJson;
+                        return nullptr;
+                    }
+                    auto added =
+                        std::make_shared<const Emote>(std::move(result.emote));
+                    updatedMap[result.name] = added;
+                    return added;
+                },
+                [&](const EmoteUpdateDispatch &dispatch) -> EmotePtr {
+                    auto oldEmote = updatedMap.findEmote(dispatch.emoteName,
+                                                         dispatch.emoteID);
+                    if (oldEmote == updatedMap.end())
+                    {
+                        return nullptr;
+                    }
 
-    auto emote = createUpdatedEmote(oldEmote->second, dispatch, kind);
-    updatedMap[emote->name] = emote;
-    map.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
+                    auto updated =
+                        createUpdatedEmote(oldEmote->second, dispatch, kind);
+                    updatedMap.erase(oldEmote);
+                    updatedMap[updated->name] = updated;
+                    return updated;
+                },
+                [&](const EmoteRemoveDispatch &dispatch) -> EmotePtr {
+                    auto it = updatedMap.findEmote(dispatch.emoteName,
+                                                   dispatch.emoteID);
+                    if (it == updatedMap.end())
+                    {
+                        return nullptr;
+                    }
 
-    return emote;
-}
+                    auto removed = it->second;
+                    updatedMap.erase(it);
+                    return removed;
+                },
+            },
+            changes.changes[i]);
 
-std::optional<EmotePtr> SeventvEmotes::removeEmote(
-    Atomic<std::shared_ptr<const EmoteMap>> &map,
-    const EmoteRemoveDispatch &dispatch)
-{
-    // This copies the map.
-    EmoteMap updatedMap = *map.get();
-    auto it = updatedMap.findEmote(dispatch.emoteName, dispatch.emoteID);
-    if (it == updatedMap.end())
+        if (emote)
+        {
+            applied.push_back({i, std::move(emote)});
+        }
+    }
+
+    if (!applied.empty())
     {
-        // We already copied the map at this point and are now discarding the copy.
-        // This is fine, because this case should be really rare.
-        return std::nullopt;
+        map.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
     }
-    auto emote = it->second;
-    updatedMap.erase(it);
-    map.set(std::make_shared<EmoteMap>(std::move(updatedMap)));
 
-    return emote;
+    return applied;
 }
 
 void SeventvEmotes::getEmoteSet(
@@ -21,9 +21,7 @@ namespace chatterino {
 class ImageSet;
 class Channel;
 namespace seventv::eventapi {
-    struct EmoteAddDispatch;
-    struct EmoteUpdateDispatch;
-    struct EmoteRemoveDispatch;
+    struct EmoteSetChanges;
 }  // namespace seventv::eventapi
 
 // https://github.com/SevenTV/API/blob/a84e884b5590dbb5d91a5c6b3548afabb228f385/data/model/emote-set.model.go#L29-L36
@@ -111,41 +109,25 @@ public:
         std::function<void(EmoteMap &&, ChannelInfo)> callback,
         bool manualRefresh);
 
-    /**
-     * Adds an emote to the `map` if it's valid.
-     * This will _copy_ the emote map and
-     * update the `Atomic`.
-     *
-     * @return The added emote if an emote was added.
-     */
-    static std::optional<EmotePtr> addEmote(
-        Atomic<std::shared_ptr<const EmoteMap>> &map,
-        const seventv::eventapi::EmoteAddDispatch &dispatch,
-        SeventvEmoteSetKind kind = SeventvEmoteSetKind::Channel);
+    struct AppliedEmoteChange {
+        /// Index of the change in `EmoteSetChanges::changes`
+        size_t index;
+        /// The added or updated emote, or the removed emote
+        EmotePtr emote;
+    };
 
     /**
-     * Updates an emote in this `map`.
-     * This will _copy_ the emote map and
-     * update the `Atomic`.
+     * Applies all changes to the `map` in order.
+     * This will _copy_ the emote map once and
+     * update the `Atomic` if any change was applied.
      *
-     * @return The updated emote if any emote was updated.
+     * @return The changes that were applied.
      */
-    static std::optional<EmotePtr> updateEmote(
+    static std::vector<AppliedEmoteChange> applyEmoteSetChanges(
         Atomic<std::shared_ptr<const EmoteMap>> &map,
-        const seventv::eventapi::EmoteUpdateDispatch &dispatch,
+        const seventv::eventapi::EmoteSetChanges &changes,
         SeventvEmoteSetKind kind = SeventvEmoteSetKind::Channel);
 
-    /**
-     * Removes an emote from this `map`.
-     * This will _copy_ the emote map and
-     * update the `Atomic`.
-     *
-     * @return The removed emote if any emote was removed.
-     */
-    static std::optional<EmotePtr> removeEmote(
-        Atomic<std::shared_ptr<const EmoteMap>> &map,
-        const seventv::eventapi::EmoteRemoveDispatch &dispatch);
-
     /** Fetches an emote-set by its id */
     static void getEmoteSet(
         const QString &emoteSetId,
@@ -10,8 +10,9 @@
 #include "providers/seventv/SeventvPaints.hpp"
 #include "providers/seventv/SeventvPersonalEmotes.hpp"
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
 
-#include <QJsonArray>
+#include <rapidjson/document.h>
 
 #include <utility>
 
@@ -125,17 +126,18 @@ void SeventvEventAPI::onMessage(
     websocketpp::connection_hdl hdl,
     BasicPubSubManager<Subscription>::WebsocketMessagePtr msg)
 {
-    const auto &payload = QString::fromStdString(msg->get_payload());
+    const auto &payload = msg->get_payload();
 
     auto pMessage = parseBaseMessage(payload);
 
     if (!pMessage)
     {
         qCDebug(chatterinoSeventvEventAPI)
-            << "Unable to parse incoming event-api message: " << payload;
+            << "Unable to parse incoming event-api message: "
+            << QString::fromStdString(payload);
         return;
     }
-    auto message = *pMessage;
+    auto &message = *pMessage;
     switch (message.op)
     {
         case Opcode::Hello: {
@@ -144,7 +146,7 @@ void SeventvEventAPI::onMessage(
                 if (auto *stvClient = dynamic_cast<Client *>(client.get()))
                 {
                     stvClient->setHeartbeatInterval(
-                        message.data["heartbeat_interval"].toInt());
+                        message.heartbeatInterval);
                 }
             }
         }
@@ -164,7 +166,7 @@ void SeventvEventAPI::onMessage(
             if (!dispatch)
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Malformed dispatch" << payload;
+                    << "Malformed dispatch" << QString::fromStdString(payload);
                 return;
             }
             this->handleDispatch(*dispatch);
@@ -185,7 +187,8 @@ void SeventvEventAPI::onMessage(
         }
         break;
         default: {
-            qCDebug(chatterinoSeventvEventAPI) << "Unhandled op:" << payload;
+            qCDebug(chatterinoSeventvEventAPI)
+                << "Unhandled op:" << QString::fromStdString(payload);
         }
         break;
     }
@@ -216,7 +219,8 @@ void SeventvEventAPI::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid cosmetic dispatch" << dispatch.body;
+                    << "Invalid cosmetic dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -229,7 +233,8 @@ void SeventvEventAPI::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid entitlement create dispatch" << dispatch.body;
+                    << "Invalid entitlement create dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -242,7 +247,8 @@ void SeventvEventAPI::handleDispatch(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid entitlement delete dispatch" << dispatch.body;
+                    << "Invalid entitlement delete dispatch"
+                    << rj::stringify(dispatch.body);
             }
         }
         break;
@@ -250,7 +256,7 @@ void SeventvEventAPI::handleDispatch(const Dispatch &dispatch)
             qCDebug(chatterinoSeventvEventAPI)
                 << "Unknown subscription type:"
                 << qmagicenum::enumName(dispatch.type)
-                << "body:" << dispatch.body;
+                << "body:" << rj::stringify(dispatch.body);
         }
         break;
     }
@@ -263,79 +269,85 @@ void SeventvEventAPI::onEmoteSetUpdate(const Dispatch &dispatch)
     //   pulled:  Array<{ key,        old_value }>,
     //   updated: Array<{ key, value, old_value }>,
     // }
-    auto pushedArray = dispatch.body["pushed"].toArray();
-    auto pulledArray = dispatch.body["pulled"].toArray();
-    auto updatedArray = dispatch.body["updated"].toArray();
+    auto pushedArray = rj::memberArray(dispatch.body, "pushed");
+    auto pulledArray = rj::memberArray(dispatch.body, "pulled");
+    auto updatedArray = rj::memberArray(dispatch.body, "updated");
     qCDebug(chatterinoSeventvEventAPI).nospace()
         << "Update emote set " << dispatch.id
-        << " added: " << pushedArray.count()
-        << ", removed: " << pulledArray.count()
-        << ", updated: " << updatedArray.count();
+        << " added: " << pushedArray.Size()
+        << ", removed: " << pulledArray.Size()
+        << ", updated: " << updatedArray.Size();
+
+    EmoteSetChanges changes{.emoteSetID = dispatch.id, .changes = {}};
+    changes.changes.reserve(static_cast<size_t>(pushedArray.Size()) +
+                            updatedArray.Size() + pulledArray.Size());
 
-    for (const auto pushedRef : pushedArray)
+    for (const auto &pushed : pushedArray)
     {
-        auto pushed = pushedRef.toObject();
-        if (pushed["key"].toString() != "emotes")
+        if (rj::toQString(rj::member(pushed, "key")) != "emotes")
         {
             continue;
         }
 
-        const EmoteAddDispatch added(dispatch, pushed["value"].toObject());
+        // Emotes are built from Qt JSON, so only the added emote is converted
+        EmoteAddDispatch added(
+            dispatch, rj::toQJsonValue(rj::member(pushed, "value")).toObject());
 
         if (added.validate())
         {
-            this->signals_.emoteAdded.invoke(added);
+            changes.changes.emplace_back(std::move(added));
         }
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
-    for (const auto updatedRef : updatedArray)
+    for (const auto &updated : updatedArray)
     {
-        auto updated = updatedRef.toObject();
-        if (updated["key"].toString() != "emotes")
+        if (rj::toQString(rj::member(updated, "key")) != "emotes")
         {
             continue;
         }
 
-        const EmoteUpdateDispatch update(dispatch,
-                                         updated["old_value"].toObject(),
-                                         updated["value"].toObject());
+        EmoteUpdateDispatch update(dispatch, rj::member(updated, "old_value"),
+                                   rj::member(updated, "value"));
 
         if (update.validate())
         {
-            this->signals_.emoteUpdated.invoke(update);
+            changes.changes.emplace_back(std::move(update));
         }
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
-    for (const auto pulledRef : pulledArray)
+    for (const auto &pulled : pulledArray)
     {
-        auto pulled = pulledRef.toObject();
-        if (pulled["key"].toString() != "emotes")
+        if (rj::toQString(rj::member(pulled, "key")) != "emotes")
         {
             continue;
         }
 
-        const EmoteRemoveDispatch removed(dispatch,
-                                          pulled["old_value"].toObject());
+        EmoteRemoveDispatch removed(dispatch, rj::member(pulled, "old_value"));
 
         if (removed.validate())
         {
-            this->signals_.emoteRemoved.invoke(removed);
+            changes.changes.emplace_back(std::move(removed));
         }
         else
         {
             qCDebug(chatterinoSeventvEventAPI)
-                << "Invalid dispatch" << dispatch.body;
+                << "Invalid dispatch" << rj::stringify(dispatch.body);
         }
     }
 
+    if (!changes.changes.empty())
+    {
+        this->signals_.emoteSetChanged.invoke(changes);
+    }
+
     if (!this->lastPersonalEmoteAssignment_)
     {
         return;
@@ -362,23 +374,25 @@ void SeventvEventAPI::onUserUpdate(const Dispatch &dispatch)
     // dispatchBody: {
     //   updated: Array<{ key, value: Array<{key, value}> }>
     // }
-    for (const auto updatedRef : dispatch.body["updated"].toArray())
+    for (const auto &updated : rj::memberArray(dispatch.body, "updated"))
     {
-        auto updated = updatedRef.toObject();
-        if (updated["key"].toString() != "connections")
+        if (rj::toQString(rj::member(updated, "key")) != "connections")
         {
             continue;
         }
-        for (const auto valueRef : updated["value"].toArray())
+
+        const auto &index = rj::member(updated, "index");
+        auto connectionIndex = index.IsUint() ? index.GetUint() : 0U;
+
+        for (const auto &value : rj::memberArray(updated, "value"))
         {
-            auto value = valueRef.toObject();
-            if (value["key"].toString() != "emote_set")
+            if (rj::toQString(rj::member(value, "key")) != "emote_set")
             {
                 continue;
             }
 
-            const UserConnectionUpdateDispatch update(
-                dispatch, value, (size_t)updated["index"].toInt());
+            const UserConnectionUpdateDispatch update(dispatch, value,
+                                                      connectionIndex);
 
             if (update.validate())
             {
@@ -387,7 +401,7 @@ void SeventvEventAPI::onUserUpdate(const Dispatch &dispatch)
             else
             {
                 qCDebug(chatterinoSeventvEventAPI)
-                    << "Invalid dispatch" << dispatch.body;
+                    << "Invalid dispatch" << rj::stringify(dispatch.body);
             }
         }
     }
@@ -486,11 +500,11 @@ void SeventvEventAPI::onEmoteSetCreate(const Dispatch &dispatch)
 {
     // We're using `Application::instance` instead of getApp(), because we're not in the GUI thread.
     // `seventvBadges` and `seventvPaints` do their own locking.
-    EmoteSetCreateDispatch createDispatch(dispatch.body["object"].toObject());
+    EmoteSetCreateDispatch createDispatch(rj::member(dispatch.body, "object"));
     if (!createDispatch.validate())
     {
         qCDebug(chatterinoSeventvEventAPI)
-            << "Invalid dispatch" << dispatch.body;
+            << "Invalid dispatch" << rj::stringify(dispatch.body);
         return;
     }
 
@@ -14,6 +14,7 @@ namespace seventv::eventapi {
     struct EmoteAddDispatch;
     struct EmoteUpdateDispatch;
     struct EmoteRemoveDispatch;
+    struct EmoteSetChanges;
     struct UserConnectionUpdateDispatch;
     struct CosmeticCreateDispatch;
     struct EntitlementCreateDeleteDispatch;
@@ -38,9 +39,8 @@ public:
     ~SeventvEventAPI() override;
 
     struct {
-        Signal<seventv::eventapi::EmoteAddDispatch> emoteAdded;
-        Signal<seventv::eventapi::EmoteUpdateDispatch> emoteUpdated;
-        Signal<seventv::eventapi::EmoteRemoveDispatch> emoteRemoved;
+        /// All emote changes from one emote set update
+        Signal<seventv::eventapi::EmoteSetChanges> emoteSetChanged;
         Signal<seventv::eventapi::UserConnectionUpdateDispatch> userUpdated;
         Signal<std::pair<QString, std::shared_ptr<const EmoteMap>>>
             personalEmoteSetAdded;
@@ -51,41 +51,14 @@ std::optional<std::shared_ptr<const EmoteMap>>
 }
 
 void SeventvPersonalEmotes::updateEmoteSet(
-    const QString &id, const seventv::eventapi::EmoteAddDispatch &dispatch)
+    const seventv::eventapi::EmoteSetChanges &changes)
 {
     std::unique_lock<std::shared_mutex> lock(this->mutex_);
-    auto emoteSet = this->emoteSets_.find(id);
+    auto emoteSet = this->emoteSets_.find(changes.emoteSetID);
     if (emoteSet != this->emoteSets_.end())
     {
-        // Make sure this emote is actually new to avoid copying the map
-        if (emoteSet->second.get()->contains(
-                EmoteName{dispatch.emoteJson["name"].toString()}))
-        {
-            return;
-        }
-        SeventvEmotes::addEmote(emoteSet->second, dispatch,
-                                SeventvEmoteSetKind::Personal);
-    }
-}
-void SeventvPersonalEmotes::updateEmoteSet(
-    const QString &id, const seventv::eventapi::EmoteUpdateDispatch &dispatch)
-{
-    std::unique_lock<std::shared_mutex> lock(this->mutex_);
-    auto emoteSet = this->emoteSets_.find(id);
-    if (emoteSet != this->emoteSets_.end())
-    {
-        SeventvEmotes::updateEmote(emoteSet->second, dispatch,
-                                   SeventvEmoteSetKind::Personal);
-    }
-}
-void SeventvPersonalEmotes::updateEmoteSet(
-    const QString &id, const seventv::eventapi::EmoteRemoveDispatch &dispatch)
-{
-    std::unique_lock<std::shared_mutex> lock(this->mutex_);
-    auto emoteSet = this->emoteSets_.find(id);
-    if (emoteSet != this->emoteSets_.end())
-    {
-        SeventvEmotes::removeEmote(emoteSet->second, dispatch);
+        SeventvEmotes::applyEmoteSetChanges(emoteSet->second, changes,
+                                            SeventvEmoteSetKind::Personal);
     }
 }
 
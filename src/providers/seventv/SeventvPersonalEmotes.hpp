@@ -25,12 +25,7 @@ public:
     std::optional<std::shared_ptr<const EmoteMap>> assignUserToEmoteSet(
         const QString &emoteSetID, const QString &userTwitchID);
 
-    void updateEmoteSet(const QString &id,
-                        const seventv::eventapi::EmoteAddDispatch &dispatch);
-    void updateEmoteSet(const QString &id,
-                        const seventv::eventapi::EmoteUpdateDispatch &dispatch);
-    void updateEmoteSet(const QString &id,
-                        const seventv::eventapi::EmoteRemoveDispatch &dispatch);
+    void updateEmoteSet(const seventv::eventapi::EmoteSetChanges &changes);
 
     void addEmoteSetForUser(const QString &emoteSetID, EmoteMap &&map,
                             const QString &userTwitchID);
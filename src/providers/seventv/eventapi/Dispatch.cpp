@@ -1,19 +1,24 @@
 #include "providers/seventv/eventapi/Dispatch.hpp"
 
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
 
-#include <QJsonArray>
+#include <rapidjson/document.h>
 
+#include <cassert>
+#include <iterator>
 #include <utility>
 
 namespace chatterino::seventv::eventapi {
 
-Dispatch::Dispatch(QJsonObject obj)
-    : type(qmagicenum::enumCast<SubscriptionType>(obj["type"].toString())
+Dispatch::Dispatch(const rapidjson::Value &obj)
+    : type(qmagicenum::enumCast<SubscriptionType>(
+               rj::toQString(rj::member(obj, "type")))
                .value_or(SubscriptionType::INVALID))
-    , body(obj["body"].toObject())
-    , id(this->body["id"].toString())
-    , actorName(this->body["actor"].toObject()["display_name"].toString())
+    , body(rj::member(obj, "body"))
+    , id(rj::toQString(rj::member(this->body, "id")))
+    , actorName(rj::toQString(
+          rj::member(rj::member(this->body, "actor"), "display_name")))
 {
 }
 
@@ -54,6 +59,15 @@ EmoteRemoveDispatch::EmoteRemoveDispatch(const Dispatch &dispatch,
 {
 }
 
+EmoteRemoveDispatch::EmoteRemoveDispatch(const Dispatch &dispatch,
+                                         const rapidjson::Value &emote)
+    : emoteSetID(dispatch.id)
+    , actorName(dispatch.actorName)
+    , emoteName(rj::toQString(rj::member(emote, "name")))
+    , emoteID(rj::toQString(rj::member(emote, "id")))
+{
+}
+
 bool EmoteRemoveDispatch::validate() const
 {
     return !this->emoteSetID.isEmpty() && !this->emoteName.isEmpty() &&
@@ -71,6 +85,17 @@ EmoteUpdateDispatch::EmoteUpdateDispatch(const Dispatch &dispatch,
 {
 }
 
+EmoteUpdateDispatch::EmoteUpdateDispatch(const Dispatch &dispatch,
+                                         const rapidjson::Value &oldValue,
+                                         const rapidjson::Value &value)
+    : emoteSetID(dispatch.id)
+    , actorName(dispatch.actorName)
+    , emoteID(rj::toQString(rj::member(value, "id")))
+    , oldEmoteName(rj::toQString(rj::member(oldValue, "name")))
+    , emoteName(rj::toQString(rj::member(value, "name")))
+{
+}
+
 bool EmoteUpdateDispatch::validate() const
 {
     return !this->emoteSetID.isEmpty() && !this->emoteID.isEmpty() &&
@@ -78,12 +103,23 @@ bool EmoteUpdateDispatch::validate() const
            this->oldEmoteName != this->emoteName;
 }
 
+void EmoteSetChanges::append(EmoteSetChanges &&other)
+{
+    assert(this->emoteSetID == other.emoteSetID);
+
+    this->changes.insert(this->changes.end(),
+                         std::make_move_iterator(other.changes.begin()),
+                         std::make_move_iterator(other.changes.end()));
+}
+
 UserConnectionUpdateDispatch::UserConnectionUpdateDispatch(
-    const Dispatch &dispatch, const QJsonObject &update, size_t connectionIndex)
+    const Dispatch &dispatch, const rapidjson::Value &update,
+    size_t connectionIndex)
     : userID(dispatch.id)
     , actorName(dispatch.actorName)
-    , oldEmoteSetID(update["old_value"].toObject()["id"].toString())
-    , emoteSetID(update["value"].toObject()["id"].toString())
+    , oldEmoteSetID(
+          rj::toQString(rj::member(rj::member(update, "old_value"), "id")))
+    , emoteSetID(rj::toQString(rj::member(rj::member(update, "value"), "id")))
     , connectionIndex(connectionIndex)
 {
 }
@@ -95,11 +131,17 @@ bool UserConnectionUpdateDispatch::validate() const
 }
 
 CosmeticCreateDispatch::CosmeticCreateDispatch(const Dispatch &dispatch)
-    : data(dispatch.body["object"]["data"].toObject())
-    , kind(qmagicenum::enumCast<CosmeticKind>(
-               dispatch.body["object"]["kind"].toString())
+    : kind(qmagicenum::enumCast<CosmeticKind>(
+               rj::toQString(
+                   rj::member(rj::member(dispatch.body, "object"), "kind")))
                .value_or(CosmeticKind::INVALID))
 {
+    // Badges and paints are parsed from Qt JSON, only this part is converted
+    const auto &data = rj::member(rj::member(dispatch.body, "object"), "data");
+    if (data.IsObject())
+    {
+        this->data = rj::toQJsonValue(data).toObject();
+    }
 }
 
 bool CosmeticCreateDispatch::validate() const
@@ -110,19 +152,20 @@ bool CosmeticCreateDispatch::validate() const
 EntitlementCreateDeleteDispatch::EntitlementCreateDeleteDispatch(
     const Dispatch &dispatch)
 {
-    const auto obj = dispatch.body["object"].toObject();
-    this->refID = obj["ref_id"].toString();
-    this->kind = qmagicenum::enumCast<CosmeticKind>(obj["kind"].toString())
+    const auto &obj = rj::member(dispatch.body, "object");
+    this->refID = rj::toQString(rj::member(obj, "ref_id"));
+    this->kind = qmagicenum::enumCast<CosmeticKind>(
+                     rj::toQString(rj::member(obj, "kind")))
                      .value_or(CosmeticKind::INVALID);
 
-    const auto userConnections = obj["user"]["connections"].toArray();
-    for (const auto &connectionJson : userConnections)
+    const auto userConnections =
+        rj::memberArray(rj::member(obj, "user"), "connections");
+    for (const auto &connection : userConnections)
     {
-        const auto connection = connectionJson.toObject();
-        if (connection["platform"].toString() == "TWITCH")
+        if (rj::toQString(rj::member(connection, "platform")) == "TWITCH")
         {
-            this->userID = connection["id"].toString();
-            this->userName = connection["username"].toString();
+            this->userID = rj::toQString(rj::member(connection, "id"));
+            this->userName = rj::toQString(rj::member(connection, "username"));
             break;
         }
     }
@@ -134,10 +177,16 @@ bool EntitlementCreateDeleteDispatch::validate() const
            !this->refID.isEmpty() && this->kind != CosmeticKind::INVALID;
 }
 
-EmoteSetCreateDispatch::EmoteSetCreateDispatch(const QJsonObject &emoteSet)
-    : emoteSetID(emoteSet["id"].toString())
-    , isPersonal((emoteSet["flags"].toInt() & 4) != 0)
+EmoteSetCreateDispatch::EmoteSetCreateDispatch(
+    const rapidjson::Value &emoteSet)
+    : emoteSetID(rj::toQString(rj::member(emoteSet, "id")))
+    , isPersonal(false)
 {
+    const auto &flags = rj::member(emoteSet, "flags");
+    if (flags.IsInt())
+    {
+        this->isPersonal = (flags.GetInt() & 4) != 0;
+    }
 }
 
 bool EmoteSetCreateDispatch::validate() const
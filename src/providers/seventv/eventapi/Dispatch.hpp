@@ -5,18 +5,24 @@
 
 #include <QJsonObject>
 #include <QString>
+#include <rapidjson/fwd.h>
+
+#include <variant>
+#include <vector>
 
 namespace chatterino::seventv::eventapi {
 
 // https://github.com/SevenTV/EventAPI/tree/ca4ff15cc42b89560fa661a76c5849047763d334#message-payload
 struct Dispatch {
     SubscriptionType type;
-    QJsonObject body;
+    /// This points into the message the dispatch was decoded from, so the
+    /// dispatch must not outlive it.
+    const rapidjson::Value &body;
     QString id;
     // it's okay for this to be empty
     QString actorName;
 
-    Dispatch(QJsonObject obj);
+    Dispatch(const rapidjson::Value &obj);
 };
 
 struct EmoteAddDispatch {
@@ -37,6 +43,8 @@ struct EmoteRemoveDispatch {
     QString emoteID;
 
     EmoteRemoveDispatch(const Dispatch &dispatch, QJsonObject emote);
+    EmoteRemoveDispatch(const Dispatch &dispatch,
+                        const rapidjson::Value &emote);
 
     bool validate() const;
 };
@@ -50,10 +58,25 @@ struct EmoteUpdateDispatch {
 
     EmoteUpdateDispatch(const Dispatch &dispatch, QJsonObject oldValue,
                         QJsonObject value);
+    EmoteUpdateDispatch(const Dispatch &dispatch,
+                        const rapidjson::Value &oldValue,
+                        const rapidjson::Value &value);
 
     bool validate() const;
 };
 
+/// The emote changes to one emote set, in the order they were received
+struct EmoteSetChanges {
+    using Change = std::variant<EmoteAddDispatch, EmoteUpdateDispatch,
+                                EmoteRemoveDispatch>;
+
+    QString emoteSetID;
+    std::vector<Change> changes;
+
+    /// Appends the changes of a later update to the same emote set
+    void append(EmoteSetChanges &&other);
+};
+
 struct UserConnectionUpdateDispatch {
     QString userID;
     QString actorName;
@@ -62,7 +85,7 @@ struct UserConnectionUpdateDispatch {
     size_t connectionIndex;
 
     UserConnectionUpdateDispatch(const Dispatch &dispatch,
-                                 const QJsonObject &update,
+                                 const rapidjson::Value &update,
                                  size_t connectionIndex);
 
     bool validate() const;
@@ -94,7 +117,7 @@ struct EmoteSetCreateDispatch {
     QString emoteSetID;
     bool isPersonal;
 
-    EmoteSetCreateDispatch(const QJsonObject &emoteSet);
+    EmoteSetCreateDispatch(const rapidjson::Value &emoteSet);
 
     bool validate() const;
 };
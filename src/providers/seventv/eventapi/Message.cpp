@@ -1,23 +1,57 @@
 #include "providers/seventv/eventapi/Message.hpp"
 
+#include "util/RapidjsonHelpers.hpp"
+
+#include <rapidjson/document.h>
+
+#include <utility>
+
 namespace chatterino::seventv::eventapi {
 
-Message::Message(QJsonObject _json)
-    : data(_json["d"].toObject())
-    , op(Opcode(_json["op"].toInt()))
+std::optional<Message> parseBaseMessage(std::string_view blob)
 {
-}
+    rapidjson::Document doc;
+    doc.Parse(blob.data(), blob.size());
+    if (doc.HasParseError() || !doc.IsObject())
+    {
+        return std::nullopt;
+    }
 
-std::optional<Message> parseBaseMessage(const QString &blob)
-{
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    Message message;
+    int op = -1;
+    rj::getSafe(doc, "op", op);
+    message.op = Opcode(op);
 
-    if (jsonDoc.isNull())
+    auto dataIt = doc.FindMember("d");
+    if (dataIt == doc.MemberEnd() || !dataIt->value.IsObject())
     {
-        return std::nullopt;
+        return message;
+    }
+    const auto &data = dataIt->value;
+
+    switch (message.op)
+    {
+        case Opcode::Hello: {
+            rj::getSafe(data, "heartbeat_interval", message.heartbeatInterval);
+        }
+        break;
+        case Opcode::Dispatch: {
+            // `data` points into the document, it must not be used after this
+            message.document = std::move(doc);
+        }
+        break;
+        default:
+            break;
     }
 
-    return Message(jsonDoc.object());
+    return message;
+}
+
+std::optional<Message> parseBaseMessage(const QString &blob)
+{
+    auto utf8 = blob.toUtf8();
+    return parseBaseMessage(
+        std::string_view(utf8.constData(), static_cast<size_t>(utf8.size())));
 }
 
 }  // namespace chatterino::seventv::eventapi
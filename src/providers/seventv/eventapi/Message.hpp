@@ -1,33 +1,42 @@
 #pragma once
 
 #include "providers/seventv/eventapi/Subscription.hpp"
+#include "util/RapidjsonHelpers.hpp"
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QString>
+#include <rapidjson/document.h>
 
 #include <optional>
+#include <string_view>
 
 namespace chatterino::seventv::eventapi {
 
 struct Message {
-    QJsonObject data;
+    /// The parsed message - this is only kept for dispatches, which decode
+    /// `d` from it in toInner
+    rapidjson::Document document;
 
     Opcode op;
 
-    Message(QJsonObject _json);
+    /// `d.heartbeat_interval` of a hello message
+    int heartbeatInterval = 0;
 
     template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    std::optional<InnerClass> toInner() const;
 };
 
 template <class InnerClass>
-std::optional<InnerClass> Message::toInner()
+std::optional<InnerClass> Message::toInner() const
 {
-    return InnerClass{this->data};
+    return InnerClass{rj::member(this->document, "d")};
 }
 
+/// Decodes the envelope of an EventAPI message.
+///
+/// Messages without a payload we need (heartbeats, acks) don't keep their
+/// document around.
+std::optional<Message> parseBaseMessage(std::string_view blob);
 std::optional<Message> parseBaseMessage(const QString &blob);
 
 }  // namespace chatterino::seventv::eventapi
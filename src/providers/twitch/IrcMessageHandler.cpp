@@ -7,6 +7,7 @@
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
+#include "debug/Trace.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
@@ -19,6 +20,7 @@
 #include "providers/twitch/TwitchAccountManager.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchHelpers.hpp"
+#include "providers/twitch/TwitchIrcLine.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
@@ -332,28 +334,39 @@ struct ReplyContext {
     return ctx;
 }
 
-std::optional<ClearChatMessage> parseClearChatMessage(
-    Communi::IrcMessage *message)
+/// `username` is the second parameter of CLEARCHAT (the timed out user).
+/// It's empty if the chat was cleared.
+std::optional<ClearChatMessage> buildClearChatMessage(
+    qsizetype parameterCount, const QString &username,
+    const QString &durationInSeconds, const QTime &time)
 {
     // check parameter count
-    if (message->parameters().length() < 1)
+    if (parameterCount < 1)
     {
         return std::nullopt;
     }
 
     // check if the chat has been cleared by a moderator
-    if (message->parameters().length() == 1)
+    if (parameterCount == 1)
     {
         return ClearChatMessage{
-            .message =
-                makeSystemMessage("Chat has been cleared by a moderator.",
-                                  calculateMessageTime(message).time()),
+            .message = makeSystemMessage(
+                "Chat has been cleared by a moderator.", time),
             .disableAllMessages = true,
         };
     }
 
+    auto timeoutMsg = MessageBuilder(timeoutMessage, username,
+                                     durationInSeconds, false, time)
+                          .release();
+
+    return ClearChatMessage{.message = timeoutMsg, .disableAllMessages = false};
+}
+
+std::optional<ClearChatMessage> parseClearChatMessage(
+    Communi::IrcMessage *message)
+{
     // get username, duration and message of the timed out user
-    QString username = message->parameter(1);
     QString durationInSeconds;
     QVariant v = message->tag("ban-duration");
     if (v.isValid())
@@ -361,12 +374,158 @@ std::optional<ClearChatMessage> parseClearChatMessage(
         durationInSeconds = v.toString();
     }
 
-    auto timeoutMsg =
-        MessageBuilder(timeoutMessage, username, durationInSeconds, false,
-                       calculateMessageTime(message).time())
-            .release();
+    return buildClearChatMessage(message->parameters().length(),
+                                 message->parameter(1), durationInSeconds,
+                                 calculateMessageTime(message).time());
+}
 
-    return ClearChatMessage{.message = timeoutMsg, .disableAllMessages = false};
+std::optional<ClearChatMessage> parseClearChatMessage(
+    const TwitchIrcLine &line)
+{
+    return buildClearChatMessage(static_cast<qsizetype>(line.parameterCount()),
+                                 line.parameter(1), line.tag("ban-duration"),
+                                 calculateMessageTime(line).time());
+}
+
+/// Applies a parsed CLEARCHAT to the channel `chanName`
+void applyClearChatMessage(ClearChatMessage &clearChat, const QString &chanName)
+{
+    // get channel
+    auto chan = getApp()->getTwitch()->getChannelOrEmpty(chanName);
+
+    if (chan->isEmpty())
+    {
+        qCDebug(chatterinoTwitch)
+            << "[IrcMessageHandler::handleClearChatMessage] Twitch channel"
+            << chanName << "not found";
+        return;
+    }
+
+    // chat has been cleared by a moderator
+    if (clearChat.disableAllMessages)
+    {
+        chan->disableAllMessages();
+        chan->addMessage(std::move(clearChat.message),
+                         MessageContext::Original);
+
+        return;
+    }
+
+    chan->addOrReplaceTimeout(std::move(clearChat.message));
+
+    // The disabled messages are shown in other views too (e.g. /mentions,
+    // search popups). They were invalidated, so the views only lay out these
+    // messages again.
+    getApp()->getWindows()->layoutChannelViews();
+}
+
+/// Disables the message with the id `targetID` in the channel `chanName`
+void applyClearMessageMessage(const QString &chanName, const QString &targetID)
+{
+    // get channel
+    auto chan = getApp()->getTwitch()->getChannelOrEmpty(chanName);
+
+    if (chan->isEmpty())
+    {
+        qCDebug(chatterinoTwitch)
+            << "[IrcMessageHandler:handleClearMessageMessage] Twitch "
+               "channel"
+            << chanName << "not found";
+        return;
+    }
+
+    auto msg = chan->findMessage(targetID);
+    if (msg == nullptr)
+    {
+        return;
+    }
+
+    msg->flags.set(MessageFlag::Disabled);
+    msg->invalidateLayouts();
+    // Like for CLEARCHAT, every view that shows the message lays it out again
+    getApp()->getWindows()->layoutChannelViews();
+    if (!getSettings()->hideDeletionActions)
+    {
+        chan->addMessage(MessageBuilder::makeDeletionMessageFromIRC(msg),
+                         MessageContext::Original);
+    }
+}
+
+/// `badges` and `mod` are nullopt if the tags weren't present
+void applyUserStateMessage(const QString &channelName,
+                           const std::optional<QString> &badges,
+                           const std::optional<QString> &mod)
+{
+    auto c = getApp()->getTwitch()->getChannelOrEmpty(channelName);
+    if (c->isEmpty())
+    {
+        return;
+    }
+
+    auto *tc = dynamic_cast<TwitchChannel *>(c.get());
+    if (tc == nullptr)
+    {
+        return;
+    }
+
+    // Checking if currentUser is a VIP or staff member
+    if (badges)
+    {
+        auto parsedBadges = parseBadges(*badges);
+        tc->setVIP(parsedBadges.contains("vip"));
+        tc->setStaff(parsedBadges.contains("staff"));
+    }
+
+    // Checking if currentUser is a moderator
+    if (mod)
+    {
+        tc->setMod(*mod == "1");
+    }
+}
+
+void applyJoinMessage(const QString &channelName, const QString &nick)
+{
+    auto channel = getApp()->getTwitch()->getChannelOrEmpty(channelName);
+
+    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
+    if (!twitchChannel)
+    {
+        return;
+    }
+
+    if (nick == getApp()->getAccounts()->twitch.getCurrent()->getUserName())
+    {
+        twitchChannel->addSystemMessage("joined channel");
+        twitchChannel->joined.invoke();
+    }
+    else if (getSettings()->showJoins.getValue())
+    {
+        twitchChannel->addJoinedUser(nick);
+    }
+}
+
+void applyPartMessage(const QString &channelName, const QString &nick)
+{
+    auto channel = getApp()->getTwitch()->getChannelOrEmpty(channelName);
+
+    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
+    if (!twitchChannel)
+    {
+        return;
+    }
+
+    const auto selfAccountName =
+        getApp()->getAccounts()->twitch.getCurrent()->getUserName();
+    if (nick != selfAccountName && getSettings()->showParts.getValue())
+    {
+        twitchChannel->addPartedUser(nick);
+    }
+
+    if (nick == selfAccountName)
+    {
+        channel->addMessage(generateBannedMessage(false),
+                            MessageContext::Original);
+    }
 }
 
 /**
@@ -758,8 +917,7 @@ std::vector<MessagePtr> IrcMessageHandler::parseMessageWithReply(
                 },
                 [&](auto &&msg) {
                     builtMessages.emplace_back(msg);
-                },
-                false);
+                });
         }
 
         return builtMessages;
@@ -808,13 +966,11 @@ void IrcMessageHandler::handlePrivMessage(Communi::IrcPrivateMessage *message,
     }
 }
 
-void IrcMessageHandler::handleRoomStateMessage(Communi::IrcMessage *message)
+void IrcMessageHandler::handleRoomStateMessage(const TwitchIrcLine &line)
 {
-    const auto &tags = message->tags();
-
     // get Twitch channel
     QString chanName;
-    if (!trimChannelName(message->parameter(0), chanName))
+    if (!trimChannelName(line.parameter(0), chanName))
     {
         return;
     }
@@ -828,35 +984,34 @@ void IrcMessageHandler::handleRoomStateMessage(Communi::IrcMessage *message)
 
     // room-id
 
-    if (auto it = tags.find("room-id"); it != tags.end())
+    if (auto roomId = line.findTag("room-id"))
     {
-        auto roomId = it.value().toString();
-        twitchChannel->setRoomId(roomId);
+        twitchChannel->setRoomId(*roomId);
     }
 
     // Room modes
     {
         auto roomModes = *twitchChannel->accessRoomModes();
 
-        if (auto it = tags.find("emote-only"); it != tags.end())
+        if (line.hasTag("emote-only"))
         {
-            roomModes.emoteOnly = it.value() == "1";
+            roomModes.emoteOnly = line.rawTag("emote-only") == "1";
         }
-        if (auto it = tags.find("subs-only"); it != tags.end())
+        if (line.hasTag("subs-only"))
         {
-            roomModes.submode = it.value() == "1";
+            roomModes.submode = line.rawTag("subs-only") == "1";
         }
-        if (auto it = tags.find("slow"); it != tags.end())
+        if (auto slow = line.findTag("slow"))
         {
-            roomModes.slowMode = it.value().toInt();
+            roomModes.slowMode = slow->toInt();
         }
-        if (auto it = tags.find("r9k"); it != tags.end())
+        if (line.hasTag("r9k"))
         {
-            roomModes.r9k = it.value() == "1";
+            roomModes.r9k = line.rawTag("r9k") == "1";
         }
-        if (auto it = tags.find("followers-only"); it != tags.end())
+        if (auto followersOnly = line.findTag("followers-only"))
         {
-            roomModes.followerOnly = it.value().toInt();
+            roomModes.followerOnly = followersOnly->toInt();
         }
         twitchChannel->setRoomModes(roomModes);
     }
@@ -871,7 +1026,6 @@ void IrcMessageHandler::handleClearChatMessage(Communi::IrcMessage *message)
     {
         return;
     }
-    auto &clearChat = *cc;
 
     QString chanName;
     if (!trimChannelName(message->parameter(0), chanName))
@@ -879,35 +1033,24 @@ void IrcMessageHandler::handleClearChatMessage(Communi::IrcMessage *message)
         return;
     }
 
-    // get channel
-    auto chan = getApp()->getTwitch()->getChannelOrEmpty(chanName);
+    applyClearChatMessage(*cc, chanName);
+}
 
-    if (chan->isEmpty())
+void IrcMessageHandler::handleClearChatMessage(const TwitchIrcLine &line)
+{
+    auto cc = parseClearChatMessage(line);
+    if (!cc)
     {
-        qCDebug(chatterinoTwitch)
-            << "[IrcMessageHandler::handleClearChatMessage] Twitch channel"
-            << chanName << "not found";
         return;
     }
 
-    // chat has been cleared by a moderator
-    if (clearChat.disableAllMessages)
+    QString chanName;
+    if (!trimChannelName(line.parameter(0), chanName))
     {
-        chan->disableAllMessages();
-        chan->addMessage(std::move(clearChat.message),
-                         MessageContext::Original);
-
         return;
     }
 
-    chan->addOrReplaceTimeout(std::move(clearChat.message));
-
-    // refresh all
-    getApp()->getWindows()->repaintVisibleChatWidgets(chan.get());
-    if (getSettings()->hideModerated)
-    {
-        getApp()->getWindows()->forceLayoutChannelViews();
-    }
+    applyClearChatMessage(*cc, chanName);
 }
 
 void IrcMessageHandler::handleClearMessageMessage(Communi::IrcMessage *message)
@@ -924,34 +1067,25 @@ void IrcMessageHandler::handleClearMessageMessage(Communi::IrcMessage *message)
         return;
     }
 
-    // get channel
-    auto chan = getApp()->getTwitch()->getChannelOrEmpty(chanName);
+    applyClearMessageMessage(chanName,
+                             message->tag("target-msg-id").toString());
+}
 
-    if (chan->isEmpty())
+void IrcMessageHandler::handleClearMessageMessage(const TwitchIrcLine &line)
+{
+    // check parameter count
+    if (line.parameterCount() < 1)
     {
-        qCDebug(chatterinoTwitch)
-            << "[IrcMessageHandler:handleClearMessageMessage] Twitch "
-               "channel"
-            << chanName << "not found";
         return;
     }
 
-    auto tags = message->tags();
-
-    QString targetID = tags.value("target-msg-id").toString();
-
-    auto msg = chan->findMessage(targetID);
-    if (msg == nullptr)
+    QString chanName;
+    if (!trimChannelName(line.parameter(0), chanName))
     {
         return;
     }
 
-    msg->flags.set(MessageFlag::Disabled);
-    if (!getSettings()->hideDeletionActions)
-    {
-        chan->addMessage(MessageBuilder::makeDeletionMessageFromIRC(msg),
-                         MessageContext::Original);
-    }
+    applyClearMessageMessage(chanName, line.tag("target-msg-id"));
 }
 
 void IrcMessageHandler::handleUserStateMessage(Communi::IrcMessage *message)
@@ -962,35 +1096,29 @@ void IrcMessageHandler::handleUserStateMessage(Communi::IrcMessage *message)
         return;
     }
 
-    auto c = getApp()->getTwitch()->getChannelOrEmpty(channelName);
-    if (c->isEmpty())
-    {
-        return;
-    }
-
-    // Checking if currentUser is a VIP or staff member
-    QVariant badgesTag = message->tag("badges");
-    if (badgesTag.isValid())
-    {
-        auto *tc = dynamic_cast<TwitchChannel *>(c.get());
-        if (tc != nullptr)
+    auto optionalTag = [message](const QString &key) -> std::optional<QString> {
+        QVariant tag = message->tag(key);
+        if (!tag.isValid())
         {
-            auto parsedBadges = parseBadges(badgesTag.toString());
-            tc->setVIP(parsedBadges.contains("vip"));
-            tc->setStaff(parsedBadges.contains("staff"));
+            return std::nullopt;
         }
-    }
+        return tag.toString();
+    };
 
-    // Checking if currentUser is a moderator
-    QVariant modTag = message->tag("mod");
-    if (modTag.isValid())
+    applyUserStateMessage(channelName, optionalTag("badges"),
+                          optionalTag("mod"));
+}
+
+void IrcMessageHandler::handleUserStateMessage(const TwitchIrcLine &line)
+{
+    QString channelName;
+    if (!trimChannelName(line.parameter(0), channelName))
     {
-        auto *tc = dynamic_cast<TwitchChannel *>(c.get());
-        if (tc != nullptr)
-        {
-            tc->setMod(modTag == "1");
-        }
+        return;
     }
+
+    applyUserStateMessage(channelName, line.findTag("badges"),
+                          line.findTag("mod"));
 }
 
 void IrcMessageHandler::handleWhisperMessage(Communi::IrcMessage *ircMessage)
@@ -1358,51 +1486,22 @@ void IrcMessageHandler::handleNoticeMessage(Communi::IrcNoticeMessage *message)
 
 void IrcMessageHandler::handleJoinMessage(Communi::IrcMessage *message)
 {
-    auto channel = getApp()->getTwitch()->getChannelOrEmpty(
-        message->parameter(0).remove(0, 1));
-
-    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
-    if (!twitchChannel)
-    {
-        return;
-    }
+    applyJoinMessage(message->parameter(0).remove(0, 1), message->nick());
+}
 
-    if (message->nick() ==
-        getApp()->getAccounts()->twitch.getCurrent()->getUserName())
-    {
-        twitchChannel->addSystemMessage("joined channel");
-        twitchChannel->joined.invoke();
-    }
-    else if (getSettings()->showJoins.getValue())
-    {
-        twitchChannel->addJoinedUser(message->nick());
-    }
+void IrcMessageHandler::handleJoinMessage(const TwitchIrcLine &line)
+{
+    applyJoinMessage(line.parameter(0).remove(0, 1), line.nick());
 }
 
 void IrcMessageHandler::handlePartMessage(Communi::IrcMessage *message)
 {
-    auto channel = getApp()->getTwitch()->getChannelOrEmpty(
-        message->parameter(0).remove(0, 1));
-
-    auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
-    if (!twitchChannel)
-    {
-        return;
-    }
-
-    const auto selfAccountName =
-        getApp()->getAccounts()->twitch.getCurrent()->getUserName();
-    if (message->nick() != selfAccountName &&
-        getSettings()->showParts.getValue())
-    {
-        twitchChannel->addPartedUser(message->nick());
-    }
+    applyPartMessage(message->parameter(0).remove(0, 1), message->nick());
+}
 
-    if (message->nick() == selfAccountName)
-    {
-        channel->addMessage(generateBannedMessage(false),
-                            MessageContext::Original);
-    }
+void IrcMessageHandler::handlePartMessage(const TwitchIrcLine &line)
+{
+    applyPartMessage(line.parameter(0).remove(0, 1), line.nick());
 }
 
 float IrcMessageHandler::similarity(
@@ -1476,6 +1575,8 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         return;
     }
 
+    trace::Span span(trace::category::MESSAGE, "IrcMessageHandler::addMessage");
+
     MessageParseArgs args;
     if (isSub)
     {
@@ -16,6 +16,7 @@ struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class TwitchChannel;
 class TwitchMessageBuilder;
+class TwitchIrcLine;
 
 struct ClearChatMessage {
     MessagePtr message;
@@ -40,10 +41,13 @@ public:
     void handlePrivMessage(Communi::IrcPrivateMessage *message,
                            ITwitchIrcServer &twitchServer);
 
-    void handleRoomStateMessage(Communi::IrcMessage *message);
+    void handleRoomStateMessage(const TwitchIrcLine &line);
     void handleClearChatMessage(Communi::IrcMessage *message);
+    void handleClearChatMessage(const TwitchIrcLine &line);
     void handleClearMessageMessage(Communi::IrcMessage *message);
+    void handleClearMessageMessage(const TwitchIrcLine &line);
     void handleUserStateMessage(Communi::IrcMessage *message);
+    void handleUserStateMessage(const TwitchIrcLine &line);
     void handleWhisperMessage(Communi::IrcMessage *ircMessage);
 
     void handleUserNoticeMessage(Communi::IrcMessage *message,
@@ -52,7 +56,9 @@ public:
     void handleNoticeMessage(Communi::IrcNoticeMessage *message);
 
     void handleJoinMessage(Communi::IrcMessage *message);
+    void handleJoinMessage(const TwitchIrcLine &line);
     void handlePartMessage(Communi::IrcMessage *message);
+    void handlePartMessage(const TwitchIrcLine &line);
 
     void addMessage(Communi::IrcMessage *message, const ChannelPtr &chan,
                     const QString &originalContent, ITwitchIrcServer &server,
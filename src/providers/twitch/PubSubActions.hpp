@@ -1,8 +1,9 @@
 #pragma once
 
+#include "providers/twitch/pubsubmessages/ChatModeratorAction.hpp"
+
 #include <QColor>
 #include <QDebug>
-#include <QJsonObject>
 #include <QString>
 #include <QStringList>
 
@@ -35,7 +36,9 @@ inline QDebug operator<<(QDebug dbg, const ActionUser &user)
 
 struct PubSubAction {
     PubSubAction() = default;
-    PubSubAction(const QJsonObject &data, const QString &_roomID);
+    PubSubAction(const PubSubChatModeratorActionMessage::Data &data,
+                 const QString &_roomID);
+    explicit PubSubAction(const QString &_roomID);
     ActionUser source;
 
     std::chrono::steady_clock::time_point timestamp;
@@ -60,7 +60,7 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         action.mode = ModeChangedAction::Mode::Slow;
         action.state = ModeChangedAction::State::On;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.empty())
         {
@@ -71,7 +71,7 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
 
         bool ok;
 
-        action.duration = args.at(0).toString().toUInt(&ok, 10);
+        action.duration = args.at(0).toUInt(&ok, 10);
 
         this->moderation.modeChanged.invoke(action);
     };
@@ -140,16 +140,16 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                      const auto &roomID) {
         ModerationStateAction action(data, roomID);
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.isEmpty())
         {
             return;
         }
 
-        action.target.login = args[0].toString();
+        action.target.login = args[0];
 
         action.modded = false;
 
@@ -161,15 +161,15 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         ModerationStateAction action(data, roomID);
         action.modded = true;
 
-        auto innerType = data.value("type").toString();
+        const auto &innerType = data.type;
         if (innerType == "chat_login_moderation")
         {
             // Don't display the old message type
             return;
         }
 
-        action.target.id = data.value("target_user_id").toString();
-        action.target.login = data.value("target_user_login").toString();
+        action.target.id = data.targetUserID;
+        action.target.login = data.targetUserLogin;
 
         this->moderation.moderationStateChanged.invoke(action);
     };
@@ -178,22 +178,22 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                        const auto &roomID) {
         BanAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.size() < 2)
         {
             return;
         }
 
-        action.target.login = args[0].toString();
+        action.target.login = args[0];
         bool ok;
-        action.duration = args[1].toString().toUInt(&ok, 10);
-        action.reason = args[2].toString();  // May be omitted
+        action.duration = args[1].toUInt(&ok, 10);
+        action.reason = data.arg(2);  // May be omitted
 
         this->moderation.userBanned.invoke(action);
     };
@@ -202,21 +202,21 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                       const auto &roomID) {
         DeleteAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.size() < 3)
         {
             return;
         }
 
-        action.target.login = args[0].toString();
-        action.messageText = args[1].toString();
-        action.messageId = args[2].toString();
+        action.target.login = args[0];
+        action.messageText = args[1];
+        action.messageId = args[2];
 
         this->moderation.messageDeleted.invoke(action);
     };
@@ -225,20 +225,20 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                    const auto &roomID) {
         BanAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.isEmpty())
         {
             return;
         }
 
-        action.target.login = args[0].toString();
-        action.reason = args[1].toString();  // May be omitted
+        action.target.login = args[0];
+        action.reason = data.arg(1);  // May be omitted
 
         this->moderation.userBanned.invoke(action);
     };
@@ -247,21 +247,21 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                      const auto &roomID) {
         UnbanAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
         action.previousState = UnbanAction::Banned;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.isEmpty())
         {
             return;
         }
 
-        action.target.login = args[0].toString();
+        action.target.login = args[0];
 
         this->moderation.userUnbanned.invoke(action);
     };
@@ -270,21 +270,21 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                          const auto &roomID) {
         UnbanAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        action.target.id = data.value("target_user_id").toString();
+        action.target.id = data.targetUserID;
 
         action.previousState = UnbanAction::TimedOut;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.isEmpty())
         {
             return;
         }
 
-        action.target.login = args[0].toString();
+        action.target.login = args[0];
 
         this->moderation.userUnbanned.invoke(action);
     };
@@ -293,16 +293,16 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                     const auto &roomID) {
         WarnAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
+        action.source.id = data.createdByUserID;
         action.source.login =
-            data.value("created_by").toString();  // currently always empty
+            data.createdBy;  // currently always empty
 
-        action.target.id = data.value("target_user_id").toString();
-        action.target.login = data.value("target_user_login").toString();
+        action.target.id = data.targetUserID;
+        action.target.login = data.targetUserLogin;
 
-        const auto reasons = data.value("args").toArray();
+        const auto &reasons = data.args;
         bool firstArg = true;
-        for (const auto &reasonValue : reasons)
+        for (const auto &reason : reasons)
         {
             if (firstArg)
             {
@@ -310,7 +310,6 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                 firstArg = false;
                 continue;
             }
-            const auto &reason = reasonValue.toString();
             if (!reason.isEmpty())
             {
                 action.reasons.append(reason);
@@ -324,17 +323,17 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                     const auto &roomID) {
         RaidAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
-        const auto args = data.value("args").toArray();
+        const auto &args = data.args;
 
         if (args.isEmpty())
         {
             return;
         }
 
-        action.target = args[0].toString();
+        action.target = args[0];
 
         this->moderation.raidStarted.invoke(action);
     };
@@ -343,8 +342,8 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                                                       const auto &roomID) {
         UnraidAction action(data, roomID);
 
-        action.source.id = data.value("created_by_user_id").toString();
-        action.source.login = data.value("created_by").toString();
+        action.source.id = data.createdByUserID;
+        action.source.login = data.createdBy;
 
         this->moderation.raidCanceled.invoke(action);
     };
@@ -355,19 +354,19 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         [this](const auto &data, const auto &roomID) {
             AutomodAction action(data, roomID);
 
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
-            action.target.id = data.value("target_user_id").toString();
+            action.target.id = data.targetUserID;
 
-            const auto args = data.value("args").toArray();
+            const auto &args = data.args;
 
             if (args.isEmpty())
             {
                 return;
             }
 
-            action.msgID = data.value("msg_id").toString();
+            action.msgID = data.msgID;
 
             if (action.msgID.isEmpty())
             {
@@ -375,9 +374,9 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                 return;
             }
 
-            action.target.login = args[0].toString();
-            action.message = args[1].toString();  // May be omitted
-            action.reason = args[2].toString();   // May be omitted
+            action.target.login = args[0];
+            action.message = data.arg(1);  // May be omitted
+            action.reason = args[2];   // May be omitted
 
             this->moderation.autoModMessageBlocked.invoke(action);
         };
@@ -408,12 +407,12 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         [this](const auto &data, const auto &roomID) {
             // This term got a pass through automod
             AutomodUserAction action(data, roomID);
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
             action.type = AutomodUserAction::AddPermitted;
-            action.message = data.value("text").toString();
-            action.source.login = data.value("requester_login").toString();
+            action.message = data.text;
+            action.source.login = data.requesterLogin;
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -422,12 +421,12 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         [this](const auto &data, const auto &roomID) {
             // A term has been added
             AutomodUserAction action(data, roomID);
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
             action.type = AutomodUserAction::AddBlocked;
-            action.message = data.value("text").toString();
-            action.source.login = data.value("requester_login").toString();
+            action.message = data.text;
+            action.source.login = data.requesterLogin;
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -436,10 +435,10 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         [this](const auto &data, const auto &roomID) {
             // This term got deleted
             AutomodUserAction action(data, roomID);
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
-            const auto args = data.value("args").toArray();
+            const auto &args = data.args;
             action.type = AutomodUserAction::RemovePermitted;
 
             if (args.isEmpty())
@@ -447,7 +446,7 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                 return;
             }
 
-            action.message = args[0].toString();
+            action.message = args[0];
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -456,12 +455,12 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
         [this](const auto &data, const auto &roomID) {
             // This term got deleted
             AutomodUserAction action(data, roomID);
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
             action.type = AutomodUserAction::RemovePermitted;
-            action.message = data.value("text").toString();
-            action.source.login = data.value("requester_login").toString();
+            action.message = data.text;
+            action.source.login = data.requesterLogin;
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -471,10 +470,10 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
             // This term got deleted
             AutomodUserAction action(data, roomID);
 
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
-            const auto args = data.value("args").toArray();
+            const auto &args = data.args;
             action.type = AutomodUserAction::RemoveBlocked;
 
             if (args.isEmpty())
@@ -482,7 +481,7 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
                 return;
             }
 
-            action.message = args[0].toString();
+            action.message = args[0];
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -491,12 +490,12 @@ PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
             // This term got deleted
             AutomodUserAction action(data, roomID);
 
-            action.source.id = data.value("created_by_user_id").toString();
-            action.source.login = data.value("created_by").toString();
+            action.source.id = data.createdByUserID;
+            action.source.login = data.createdBy;
 
             action.type = AutomodUserAction::RemoveBlocked;
-            action.message = data.value("text").toString();
-            action.source.login = data.value("requester_login").toString();
+            action.message = data.text;
+            action.source.login = data.requesterLogin;
 
             this->moderation.automodUserMessage.invoke(action);
         };
@@ -854,20 +853,19 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
 {
     this->diag.messagesReceived += 1;
 
-    const auto &payload =
-        QString::fromStdString(websocketMessage->get_payload());
+    const auto &payload = websocketMessage->get_payload();
 
     auto oMessage = parsePubSubBaseMessage(payload);
 
     if (!oMessage)
     {
-        qCDebug(chatterinoPubSub)
-            << "Unable to parse incoming pubsub message" << payload;
+        qCDebug(chatterinoPubSub) << "Unable to parse incoming pubsub message"
+                                  << QString::fromStdString(payload);
         this->diag.messagesFailedToParse += 1;
         return;
     }
 
-    auto message = *oMessage;
+    const auto &message = *oMessage;
 
     switch (message.type)
     {
@@ -893,7 +891,8 @@ void PubSub::onMessage(websocketpp::connection_hdl hdl,
             auto oMessageMessage = message.toInner<PubSubMessageMessage>();
             if (!oMessageMessage)
             {
-                qCDebug(chatterinoPubSub) << "Malformed MESSAGE:" << payload;
+                qCDebug(chatterinoPubSub)
+                    << "Malformed MESSAGE:" << QString::fromStdString(payload);
                 return;
             }
 
@@ -1175,7 +1174,7 @@ void PubSub::handleMessageResponse(const PubSubMessageMessage &message)
         {
             case PubSubChatModeratorActionMessage::Type::ModerationAction: {
                 QString moderationAction =
-                    innerMessage.data.value("moderation_action").toString();
+                    innerMessage.data.moderationAction;
 
                 auto handlerIt =
                     this->moderationActionHandlers.find(moderationAction);
@@ -1193,7 +1192,7 @@ void PubSub::handleMessageResponse(const PubSubMessageMessage &message)
             break;
             case PubSubChatModeratorActionMessage::Type::ChannelTermsAction: {
                 QString channelTermsAction =
-                    innerMessage.data.value("type").toString();
+                    innerMessage.data.type;
 
                 auto handlerIt =
                     this->channelTermsActionHandlers.find(channelTermsAction);
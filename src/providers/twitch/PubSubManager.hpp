@@ -1,6 +1,7 @@
 #pragma once
 
 #include "providers/twitch/PubSubClientOptions.hpp"
+#include "providers/twitch/pubsubmessages/ChatModeratorAction.hpp"
 #include "providers/twitch/PubSubWebsocket.hpp"
 #include "util/ExponentialBackoff.hpp"
 
@@ -233,12 +234,13 @@ private:
              std::owner_less<WebsocketHandle>>
         clients;
 
-    std::unordered_map<
-        QString, std::function<void(const QJsonObject &, const QString &)>>
+    using ModerationActionHandler = std::function<void(
+        const PubSubChatModeratorActionMessage::Data &, const QString &)>;
+
+    std::unordered_map<QString, ModerationActionHandler>
         moderationActionHandlers;
 
-    std::unordered_map<
-        QString, std::function<void(const QJsonObject &, const QString &)>>
+    std::unordered_map<QString, ModerationActionHandler>
         channelTermsActionHandlers;
 
     void onMessage(websocketpp::connection_hdl hdl, WebsocketMessagePtr msg);
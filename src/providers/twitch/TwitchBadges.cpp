@@ -3,11 +3,15 @@
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
+#include "providers/ProviderSnapshot.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "util/DisplayBadge.hpp"
 #include "util/LoadPixmap.hpp"
+#include "util/PostToThread.hpp"
 
 #include <QBuffer>
 #include <QFile>
@@ -16,14 +20,48 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonValue>
+#include <QtConcurrent>
 #include <QThread>
 #include <QUrlQuery>
 
 namespace {
 
+using namespace chatterino;
+
 // From Twitch docs - expected size for a badge (1x)
 constexpr QSize BADGE_BASE_SIZE(18, 18);
 
+/// Key of the global badges in the `ProviderSnapshot`
+const QString SNAPSHOT_KEY = QStringLiteral("twitch.badges");
+
+/// Serializes the badges like the Helix response they were parsed from
+QByteArray serializeGlobalBadges(const HelixGlobalBadges &globalBadges)
+{
+    QJsonArray badgeSets;
+    for (const auto &badgeSet : globalBadges.badgeSets)
+    {
+        QJsonArray versions;
+        for (const auto &version : badgeSet.versions)
+        {
+            versions.append(QJsonObject{
+                {"id", version.id},
+                {"image_url_1x", version.imageURL1x.string},
+                {"image_url_2x", version.imageURL2x.string},
+                {"image_url_4x", version.imageURL4x.string},
+                {"title", version.title},
+                {"click_url", version.clickURL.string},
+            });
+        }
+        badgeSets.append(QJsonObject{
+            {"set_id", badgeSet.setID},
+            {"versions", versions},
+        });
+    }
+
+    return QJsonDocument(QJsonObject{{"data", badgeSets}})
+        .toJson(QJsonDocument::Compact);
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -32,35 +70,36 @@ void TwitchBadges::loadTwitchBadges()
 {
     assert(this->loaded_ == false);
 
-    getHelix()->getGlobalBadges(
-        [this](auto globalBadges) {
-            auto badgeSets = this->badgeSets_.access();
+    // The badges are created on a worker thread and merged into the badge
+    // sets at once
+    auto startNs = trace::now();
+    ProviderSnapshot::instance().restore(
+        SNAPSHOT_KEY,
+        [this](const QByteArray &data) {
+            this->applyGlobalBadges(
+                HelixGlobalBadges(QJsonDocument::fromJson(data).object()));
+        },
+        [this, startNs] {
+            this->requestGlobalBadges(startNs);
+        });
+}
 
-            for (const auto &badgeSet : globalBadges.badgeSets)
-            {
-                const auto &setID = badgeSet.setID;
-                for (const auto &version : badgeSet.versions)
+void TwitchBadges::requestGlobalBadges(int64_t startNs)
+{
+    getHelix()->getGlobalBadges(
+        [this, startNs](auto globalBadges) {
+            std::ignore = QtConcurrent::run([this, startNs, globalBadges] {
+                // Helix doesn't send an ETag, so the snapshot is revalidated
+                // by its contents
+                auto data = serializeGlobalBadges(globalBadges);
+                if (!ProviderSnapshot::instance().contains(SNAPSHOT_KEY, data))
                 {
-                    const auto &emote = Emote{
-                        .name = EmoteName{},
-                        .images =
-                            ImageSet{
-                                Image::fromUrl(version.imageURL1x, 1,
-                                               BADGE_BASE_SIZE),
-                                Image::fromUrl(version.imageURL2x, .5,
-                                               BADGE_BASE_SIZE * 2),
-                                Image::fromUrl(version.imageURL4x, .25,
-                                               BADGE_BASE_SIZE * 4),
-                            },
-                        .tooltip = Tooltip{version.title},
-                        .homePage = version.clickURL,
-                    };
-                    (*badgeSets)[setID][version.id] =
-                        std::make_shared<Emote>(emote);
+                    this->applyGlobalBadges(globalBadges);
+                    ProviderSnapshot::instance().set(SNAPSHOT_KEY,
+                                                     {{}, std::move(data)});
                 }
-            }
-
-            this->loaded();
+                startup::markBackground("Twitch badges loaded", startNs);
+            });
         },
         [this](auto error, auto message) {
             QString errorMessage("Failed to load global badges - ");
@@ -79,10 +118,60 @@ void TwitchBadges::loadTwitchBadges()
                 break;
             }
             qCWarning(chatterinoTwitch) << errorMessage;
-            this->loadLocalBadges();
+
+            // The badges from the snapshot are newer than the local ones
+            if (!this->isLoaded())
+            {
+                this->loadLocalBadges();
+            }
         });
 }
 
+void TwitchBadges::applyGlobalBadges(const HelixGlobalBadges &globalBadges)
+{
+    BadgeSets parsed;
+    for (const auto &badgeSet : globalBadges.badgeSets)
+    {
+        const auto &setID = badgeSet.setID;
+        for (const auto &version : badgeSet.versions)
+        {
+            const auto &emote = Emote{
+                .name = EmoteName{},
+                .images =
+                    ImageSet{
+                        Image::fromUrl(version.imageURL1x, 1, BADGE_BASE_SIZE),
+                        Image::fromUrl(version.imageURL2x, .5,
+                                       BADGE_BASE_SIZE * 2),
+                        Image::fromUrl(version.imageURL4x, .25,
+                                       BADGE_BASE_SIZE * 4),
+                    },
+                .tooltip = Tooltip{version.title},
+                .homePage = version.clickURL,
+            };
+            parsed[setID][version.id] = std::make_shared<Emote>(emote);
+        }
+    }
+
+    postToThread([this, parsed = std::move(parsed)] {
+        {
+            auto badgeSets = this->badgeSets_.access();
+            for (const auto &[setID, versions] : parsed)
+            {
+                auto &set = (*badgeSets)[setID];
+                for (const auto &[versionID, emote] : versions)
+                {
+                    set[versionID] = emote;
+                }
+            }
+        }
+
+        if (!this->isLoaded())
+        {
+            this->loaded();
+        }
+    });
+}
+
 void TwitchBadges::loadLocalBadges()
 {
     QFile file(":/twitch-badges.json");
@@ -134,6 +223,12 @@ void TwitchBadges::loadLocalBadges()
     this->loaded();
 }
 
+bool TwitchBadges::isLoaded()
+{
+    std::shared_lock lock(this->loadedMutex_);
+    return this->loaded_;
+}
+
 void TwitchBadges::loaded()
 {
     std::unique_lock loadedLock(this->loadedMutex_);
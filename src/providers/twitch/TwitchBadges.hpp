@@ -9,6 +9,7 @@
 #include <QMap>
 #include <QString>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <queue>
@@ -24,6 +25,7 @@ class Settings;
 class Paths;
 class Image;
 class DisplayBadge;
+struct HelixGlobalBadges;
 
 class TwitchBadges
 {
@@ -49,6 +51,17 @@ public:
     void loadLocalBadges();
 
 private:
+    using BadgeSets =
+        std::unordered_map<QString, std::unordered_map<QString, EmotePtr>>;
+
+    /// Requests the global badges from Helix. Falls back to the local badges
+    /// if that fails and no badges were loaded from the snapshot.
+    void requestGlobalBadges(int64_t startNs);
+    /// Creates the badges and merges them into the badge sets on the GUI
+    /// thread. This can be called from any thread.
+    void applyGlobalBadges(const HelixGlobalBadges &globalBadges);
+
+    bool isLoaded();
     void loaded();
     void loadEmoteImage(const QString &name, const ImagePtr &image,
                         BadgeIconCallback &&callback);
@@ -62,9 +75,7 @@ private:
     std::shared_mutex loadedMutex_;
     bool loaded_ = false;
 
-    UniqueAccess<
-        std::unordered_map<QString, std::unordered_map<QString, EmotePtr>>>
-        badgeSets_;  // "bits": { "100": ... "500": ...
+    UniqueAccess<BadgeSets> badgeSets_;  // "bits": { "100": ... "500": ...
 };
 
 }  // namespace chatterino
@@ -15,6 +15,7 @@
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageArchive.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/MessageThread.hpp"
@@ -44,6 +45,7 @@
 #include "util/Helpers.hpp"
 #include "util/PostToThread.hpp"
 #include "util/QStringHash.hpp"
+#include "util/Variant.hpp"
 #include "widgets/Window.hpp"
 
 #include <IrcConnection>
@@ -85,6 +87,23 @@ namespace {
 
     // From Twitch docs - expected size for a badge (1x)
     constexpr QSize BASE_BADGE_SIZE(18, 18);
+
+    /// The memory limit shared by the archives of all channels, nullptr if
+    /// archives are disabled
+    std::shared_ptr<MessageArchiveBudget> archiveBudget()
+    {
+        static auto budget = [] {
+            auto limit =
+                getSettings()->scrollbackArchiveMemoryLimit.getValue();
+            if (limit <= 0)
+            {
+                return std::shared_ptr<MessageArchiveBudget>();
+            }
+            return std::make_shared<MessageArchiveBudget>(
+                static_cast<size_t>(limit) * 1024 * 1024);
+        }();
+        return budget;
+    }
 }  // namespace
 
 TwitchChannel::TwitchChannel(const QString &name)
@@ -101,8 +120,18 @@ TwitchChannel::TwitchChannel(const QString &name)
 {
     qCDebug(chatterinoTwitch) << "[TwitchChannel" << name << "] Opened";
 
+    // Keep the messages that leave the scrollback in a compact form
+    if (auto budget = archiveBudget())
+    {
+        this->archive_ = std::make_unique<MessageArchive>(std::move(budget));
+    }
+
+    this->sharedState_.access()->displayName = name;
+    this->sharedState_.access()->broadcaster = this->isBroadcaster();
+
     this->bSignals_.emplace_back(
         getApp()->getAccounts()->twitch.currentUserChanged.connect([this] {
+            this->sharedState_.access()->broadcaster = this->isBroadcaster();
             this->setMod(false);
             this->refreshPubSub();
             this->refreshTwitchChannelEmotes(false);
@@ -224,6 +253,7 @@ const QString &TwitchChannel::getDisplayName() const
 void TwitchChannel::setDisplayName(const QString &name)
 {
     this->nameOptions.displayName = name;
+    this->sharedState_.access()->displayName = name;
 }
 
 const QString &TwitchChannel::getLocalizedName() const
@@ -916,6 +946,12 @@ SharedAccessGuard<const TwitchChannel::StreamStatus>
     return this->streamStatus_.accessConst();
 }
 
+SharedAccessGuard<const TwitchChannel::SharedState>
+    TwitchChannel::accessSharedState() const
+{
+    return this->sharedState_.accessConst();
+}
+
 std::optional<EmotePtr> TwitchChannel::twitchEmote(const EmoteName &name) const
 {
     auto emotes = this->localTwitchEmotes();
@@ -1053,43 +1089,35 @@ void TwitchChannel::removeBttvEmote(
                                            (*removed)->name.string);
 }
 
-void TwitchChannel::addSeventvEmote(
-    const seventv::eventapi::EmoteAddDispatch &dispatch)
-{
-    if (!SeventvEmotes::addEmote(this->seventvEmotes_, dispatch))
-    {
-        return;
-    }
-
-    this->addOrReplaceLiveUpdatesAddRemove(
-        true, "7TV", dispatch.actorName, dispatch.emoteJson["name"].toString());
-}
-
-void TwitchChannel::updateSeventvEmote(
-    const seventv::eventapi::EmoteUpdateDispatch &dispatch)
+void TwitchChannel::applySeventvEmoteSetChanges(
+    const seventv::eventapi::EmoteSetChanges &changes)
 {
-    if (!SeventvEmotes::updateEmote(this->seventvEmotes_, dispatch))
-    {
-        return;
-    }
-
-    auto builder =
-        MessageBuilder(liveUpdatesUpdateEmoteMessage, "7TV", dispatch.actorName,
-                       dispatch.emoteName, dispatch.oldEmoteName);
-    this->addMessage(builder.release(), MessageContext::Original);
-}
+    auto applied =
+        SeventvEmotes::applyEmoteSetChanges(this->seventvEmotes_, changes);
 
-void TwitchChannel::removeSeventvEmote(
-    const seventv::eventapi::EmoteRemoveDispatch &dispatch)
-{
-    auto removed = SeventvEmotes::removeEmote(this->seventvEmotes_, dispatch);
-    if (!removed)
+    for (const auto &[index, emote] : applied)
     {
-        return;
+        std::visit(
+            variant::Overloaded{
+                [&](const seventv::eventapi::EmoteAddDispatch &dispatch) {
+                    this->addOrReplaceLiveUpdatesAddRemove(
+                        true, "7TV", dispatch.actorName, emote->name.string);
+                },
+                [&](const seventv::eventapi::EmoteUpdateDispatch &dispatch) {
+                    auto builder = MessageBuilder(
+                        liveUpdatesUpdateEmoteMessage, "7TV",
+                        dispatch.actorName, dispatch.emoteName,
+                        dispatch.oldEmoteName);
+                    this->addMessage(builder.release(),
+                                     MessageContext::Original);
+                },
+                [&](const seventv::eventapi::EmoteRemoveDispatch &dispatch) {
+                    this->addOrReplaceLiveUpdatesAddRemove(
+                        false, "7TV", dispatch.actorName, emote->name.string);
+                },
+            },
+            changes.changes[index]);
     }
-
-    this->addOrReplaceLiveUpdatesAddRemove(false, "7TV", dispatch.actorName,
-                                           (*removed)->name.string);
 }
 
 void TwitchChannel::updateSeventvUser(
@@ -1329,10 +1357,12 @@ void TwitchChannel::loadRecentMessages()
         return;  // already loading
     }
 
+    // Show the messages persisted on the last run right away and only request
+    // the ones sent since then
     auto weak = weakOf<Channel>(this);
-    recentmessages::load(
+    recentmessages::loadPersisted(
         this->getName(), weak,
-        [weak](const auto &messages) {
+        [weak](const auto &messages, auto newest) {
             auto shared = weak.lock();
             if (!shared)
             {
@@ -1345,26 +1375,47 @@ void TwitchChannel::loadRecentMessages()
                 return;
             }
 
-            tc->addMessagesAtStart(messages);
-            tc->loadingRecentMessages_.clear();
+            tc->addRecentMessages(messages, true);
+            tc->loadRecentMessagesSince(newest);
+        },
+        [weak] {
+            auto shared = weak.lock();
+            if (!shared)
+            {
+                return;
+            }
 
-            std::vector<MessagePtr> msgs;
-            for (const auto &msg : messages)
+            auto *tc = dynamic_cast<TwitchChannel *>(shared.get());
+            if (!tc)
             {
-                const auto highlighted =
-                    msg->flags.has(MessageFlag::Highlighted);
-                const auto showInMentions =
-                    msg->flags.has(MessageFlag::ShowInMentions);
-                if (highlighted && showInMentions)
-                {
-                    msgs.push_back(msg);
-                }
+                return;
+            }
+
+            tc->loadRecentMessagesSince(std::nullopt);
+        });
+}
 
-                tc->addRecentChatter(msg->displayName);
+void TwitchChannel::loadRecentMessagesSince(
+    std::optional<std::chrono::time_point<std::chrono::system_clock>> after)
+{
+    auto weak = weakOf<Channel>(this);
+    recentmessages::load(
+        this->getName(), weak,
+        [weak, isDelta = after.has_value()](const auto &messages) {
+            auto shared = weak.lock();
+            if (!shared)
+            {
+                return;
             }
 
-            getApp()->getTwitch()->getMentionsChannel()->fillInMissingMessages(
-                msgs);
+            auto *tc = dynamic_cast<TwitchChannel *>(shared.get());
+            if (!tc)
+            {
+                return;
+            }
+
+            tc->addRecentMessages(messages, !isDelta);
+            tc->loadingRecentMessages_.clear();
         },
         [weak]() {
             auto shared = weak.lock();
@@ -1381,10 +1432,38 @@ void TwitchChannel::loadRecentMessages()
 
             tc->loadingRecentMessages_.clear();
         },
-        getSettings()->twitchMessageHistoryLimit.getValue(), std::nullopt,
+        getSettings()->twitchMessageHistoryLimit.getValue(), after,
         std::nullopt, false);
 }
 
+void TwitchChannel::addRecentMessages(const std::vector<MessagePtr> &messages,
+                                      bool atStart)
+{
+    if (atStart)
+    {
+        this->addMessagesAtStart(messages);
+    }
+    else
+    {
+        this->fillInMissingMessages(messages);
+    }
+
+    std::vector<MessagePtr> msgs;
+    for (const auto &msg : messages)
+    {
+        const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
+        const auto showInMentions = msg->flags.has(MessageFlag::ShowInMentions);
+        if (highlighted && showInMentions)
+        {
+            msgs.push_back(msg);
+        }
+
+        this->addRecentChatter(msg->displayName);
+    }
+
+    getApp()->getTwitch()->getMentionsChannel()->fillInMissingMessages(msgs);
+}
+
 void TwitchChannel::loadRecentMessagesReconnect()
 {
     if (!getSettings()->loadTwitchMessageHistoryOnConnect)
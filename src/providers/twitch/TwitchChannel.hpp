@@ -43,9 +43,7 @@ struct BttvLiveUpdateEmoteRemoveMessage;
 
 class SeventvEmotes;
 namespace seventv::eventapi {
-    struct EmoteAddDispatch;
-    struct EmoteUpdateDispatch;
-    struct EmoteRemoveDispatch;
+    struct EmoteSetChanges;
     struct UserConnectionUpdateDispatch;
 }  // namespace seventv::eventapi
 
@@ -136,6 +134,13 @@ public:
         int slowMode = 0;
     };
 
+    /// Copies of state that's otherwise only accessed on the GUI thread.
+    /// Plugins running on a worker thread read these.
+    struct SharedState {
+        QString displayName;
+        bool broadcaster = false;
+    };
+
     explicit TwitchChannel(const QString &channelName);
     ~TwitchChannel() override;
 
@@ -171,6 +176,8 @@ public:
     QString roomId() const;
     SharedAccessGuard<const RoomModes> accessRoomModes() const;
     SharedAccessGuard<const StreamStatus> accessStreamStatus() const;
+    /// This can be accessed from any thread
+    SharedAccessGuard<const SharedState> accessSharedState() const;
 
     /**
      * Records that the channel is no longer joined.
@@ -212,14 +219,12 @@ public:
     /** Removes a BTTV channel emote from this channel. */
     void removeBttvEmote(const BttvLiveUpdateEmoteRemoveMessage &message);
 
-    /** Adds a 7TV channel emote to this channel. */
-    void addSeventvEmote(const seventv::eventapi::EmoteAddDispatch &dispatch);
-    /** Updates a 7TV channel emote's name in this channel */
-    void updateSeventvEmote(
-        const seventv::eventapi::EmoteUpdateDispatch &dispatch);
-    /** Removes a 7TV channel emote from this channel */
-    void removeSeventvEmote(
-        const seventv::eventapi::EmoteRemoveDispatch &dispatch);
+    /**
+     * Adds, updates and removes 7TV channel emotes in this channel.
+     * The emote map is only replaced once for all changes.
+     */
+    void applySeventvEmoteSetChanges(
+        const seventv::eventapi::EmoteSetChanges &changes);
     /** Updates the current 7TV user. Currently, only the emote-set is updated. */
     void updateSeventvUser(
         const seventv::eventapi::UserConnectionUpdateDispatch &dispatch);
@@ -343,6 +348,15 @@ private:
     void refreshBadges();
     void refreshCheerEmotes();
     void loadRecentMessages();
+    /// Requests the recent messages sent after `after`, or the full history
+    /// if `after` isn't set
+    void loadRecentMessagesSince(
+        std::optional<std::chrono::time_point<std::chrono::system_clock>>
+            after);
+    /// Adds messages from the history of this channel and forwards the
+    /// highlighted ones to /mentions
+    void addRecentMessages(const std::vector<MessagePtr> &messages,
+                           bool atStart);
     void loadRecentMessagesReconnect();
     void cleanUpReplyThreads();
     void showLoginMessage();
@@ -425,6 +439,7 @@ private:
     int chatterCount_{};
     UniqueAccess<StreamStatus> streamStatus_;
     UniqueAccess<RoomModes> roomModes;
+    UniqueAccess<SharedState> sharedState_;
     bool disconnected_{};
     std::optional<std::chrono::time_point<std::chrono::system_clock>>
         lastConnectedAt_{};
@@ -454,9 +469,10 @@ private:
     boost::circular_buffer_space_optimized<QueuedRedemption>
         waitingRedemptions_{MAX_QUEUED_REDEMPTIONS};
 
-    bool mod_ = false;
-    bool vip_ = false;
-    bool staff_ = false;
+    // These are read by plugins running on a worker thread
+    std::atomic<bool> mod_ = false;
+    std::atomic<bool> vip_ = false;
+    std::atomic<bool> staff_ = false;
     UniqueAccess<QString> roomID_;
 
     // --
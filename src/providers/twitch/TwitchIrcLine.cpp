@@ -0,0 +1,289 @@
+#include "providers/twitch/TwitchIrcLine.hpp"
+
+namespace {
+
+using namespace chatterino;
+
+std::string_view::size_type findSpace(std::string_view data,
+                                      std::string_view::size_type from)
+{
+    auto pos = data.find(' ', from);
+    if (pos == std::string_view::npos)
+    {
+        return data.size();
+    }
+    return pos;
+}
+
+std::string_view::size_type skipSpaces(std::string_view data,
+                                       std::string_view::size_type pos)
+{
+    while (pos < data.size() && data[pos] == ' ')
+    {
+        pos++;
+    }
+    return pos;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+QString unescapeTagValue(std::string_view value)
+{
+    auto firstEscape = value.find('\\');
+    if (firstEscape == std::string_view::npos)
+    {
+        return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
+    }
+
+    QByteArray unescaped;
+    unescaped.reserve(static_cast<int>(value.size()));
+    unescaped.append(value.data(), static_cast<int>(firstEscape));
+
+    for (auto i = firstEscape; i < value.size(); i++)
+    {
+        char c = value[i];
+        // a trailing backslash is kept (same as parseTagString)
+        if (c != '\\' || i + 1 == value.size())
+        {
+            unescaped.append(c);
+            continue;
+        }
+
+        i++;
+        switch (value[i])
+        {
+            case 'n':
+                unescaped.append('\n');
+                break;
+            case 'r':
+                unescaped.append('\r');
+                break;
+            case 's':
+                unescaped.append(' ');
+                break;
+            case ':':
+                unescaped.append(';');
+                break;
+            default:
+                // covers "\\" and unknown escapes
+                unescaped.append(value[i]);
+                break;
+        }
+    }
+
+    return QString::fromUtf8(unescaped);
+}
+
+std::optional<TwitchIrcLine> TwitchIrcLine::parse(QByteArray raw)
+{
+    while (raw.endsWith('\n') || raw.endsWith('\r'))
+    {
+        raw.chop(1);
+    }
+
+    TwitchIrcLine line;
+    line.raw_ = std::move(raw);
+
+    std::string_view data(line.raw_.constData(),
+                          static_cast<size_t>(line.raw_.size()));
+    auto slice = [](size_t start, size_t end) {
+        return Slice{
+            .start = static_cast<uint32_t>(start),
+            .length = static_cast<uint32_t>(end - start),
+        };
+    };
+
+    size_t pos = 0;
+
+    if (!data.empty() && data[0] == '@')
+    {
+        auto tagsEnd = findSpace(data, 1);
+        size_t tagStart = 1;
+        while (tagStart < tagsEnd)
+        {
+            auto tagEnd = data.find(';', tagStart);
+            if (tagEnd == std::string_view::npos || tagEnd > tagsEnd)
+            {
+                tagEnd = tagsEnd;
+            }
+
+            if (tagEnd > tagStart)
+            {
+                auto equals = data.find('=', tagStart);
+                if (equals == std::string_view::npos || equals > tagEnd)
+                {
+                    line.tags_.push_back({
+                        .key = slice(tagStart, tagEnd),
+                        .value = slice(tagEnd, tagEnd),
+                    });
+                }
+                else
+                {
+                    line.tags_.push_back({
+                        .key = slice(tagStart, equals),
+                        .value = slice(equals + 1, tagEnd),
+                    });
+                }
+            }
+
+            tagStart = tagEnd + 1;
+        }
+
+        pos = skipSpaces(data, tagsEnd);
+    }
+
+    if (pos < data.size() && data[pos] == ':')
+    {
+        auto prefixEnd = findSpace(data, pos + 1);
+        line.prefix_ = slice(pos + 1, prefixEnd);
+        pos = skipSpaces(data, prefixEnd);
+    }
+
+    auto commandEnd = findSpace(data, pos);
+    if (commandEnd == pos)
+    {
+        return std::nullopt;
+    }
+    line.command_ = slice(pos, commandEnd);
+    pos = commandEnd;
+
+    while (true)
+    {
+        pos = skipSpaces(data, pos);
+        if (pos >= data.size())
+        {
+            break;
+        }
+
+        if (data[pos] == ':')
+        {
+            line.params_.push_back(slice(pos + 1, data.size()));
+            break;
+        }
+
+        auto paramEnd = findSpace(data, pos);
+        line.params_.push_back(slice(pos, paramEnd));
+        pos = paramEnd;
+    }
+
+    return line;
+}
+
+const QByteArray &TwitchIrcLine::raw() const
+{
+    return this->raw_;
+}
+
+std::string_view TwitchIrcLine::command() const
+{
+    return this->view(this->command_);
+}
+
+bool TwitchIrcLine::isCommand(std::string_view command) const
+{
+    return this->command() == command;
+}
+
+QString TwitchIrcLine::prefix() const
+{
+    return this->decode(this->prefix_);
+}
+
+QString TwitchIrcLine::nick() const
+{
+    auto prefix = this->view(this->prefix_);
+    auto end = prefix.find_first_of("!@");
+    if (end == std::string_view::npos)
+    {
+        end = prefix.size();
+    }
+    return QString::fromUtf8(prefix.data(), static_cast<int>(end));
+}
+
+size_t TwitchIrcLine::parameterCount() const
+{
+    return this->params_.size();
+}
+
+QString TwitchIrcLine::parameter(size_t index) const
+{
+    if (index >= this->params_.size())
+    {
+        return {};
+    }
+    return this->decode(this->params_[index]);
+}
+
+std::string_view TwitchIrcLine::rawParameter(size_t index) const
+{
+    if (index >= this->params_.size())
+    {
+        return {};
+    }
+    return this->view(this->params_[index]);
+}
+
+size_t TwitchIrcLine::tagCount() const
+{
+    return this->tags_.size();
+}
+
+bool TwitchIrcLine::hasTag(std::string_view key) const
+{
+    return this->findTagSlice(key) != nullptr;
+}
+
+std::string_view TwitchIrcLine::rawTag(std::string_view key) const
+{
+    const auto *tag = this->findTagSlice(key);
+    if (tag == nullptr)
+    {
+        return {};
+    }
+    return this->view(tag->value);
+}
+
+QString TwitchIrcLine::tag(std::string_view key) const
+{
+    return unescapeTagValue(this->rawTag(key));
+}
+
+std::optional<QString> TwitchIrcLine::findTag(std::string_view key) const
+{
+    const auto *tag = this->findTagSlice(key);
+    if (tag == nullptr)
+    {
+        return std::nullopt;
+    }
+    return unescapeTagValue(this->view(tag->value));
+}
+
+std::string_view TwitchIrcLine::view(Slice slice) const
+{
+    return {this->raw_.constData() + slice.start, slice.length};
+}
+
+QString TwitchIrcLine::decode(Slice slice) const
+{
+    return QString::fromUtf8(this->raw_.constData() + slice.start,
+                             static_cast<int>(slice.length));
+}
+
+const TwitchIrcLine::Tag *TwitchIrcLine::findTagSlice(
+    std::string_view key) const
+{
+    // Twitch sends ~20 tags per message, a linear scan over the offsets is
+    // faster than building a map.
+    for (const auto &tag : this->tags_)
+    {
+        if (this->view(tag.key) == key)
+        {
+            return &tag;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace chatterino
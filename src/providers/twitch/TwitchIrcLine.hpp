@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace chatterino {
+
+/// Unescapes an IRCv3 tag value (see https://ircv3.net/specs/extensions/message-tags#escaping-values).
+///
+/// This behaves like `parseTagString` but works on the raw UTF-8 bytes, so
+/// values without escapes are decoded without an intermediate copy.
+QString unescapeTagValue(std::string_view value);
+
+/// A single Twitch IRCv3 line, tokenized without copying.
+///
+/// The line keeps a (shared) reference to the raw bytes and only stores
+/// offsets into them. Nothing is decoded until it's accessed: tag values are
+/// unescaped and converted to `QString` on demand, so handlers only pay for
+/// the tags they actually look at. This is much cheaper than building a
+/// `QVariantMap` of all tags for every message.
+///
+/// Format: [@tags ][:prefix ]COMMAND[ params...][ :trailing]
+class TwitchIrcLine
+{
+public:
+    /// Tokenizes a line. Trailing CR/LF are ignored.
+    /// Returns nullopt if the line doesn't contain a command.
+    static std::optional<TwitchIrcLine> parse(QByteArray raw);
+
+    /// The bytes this line was parsed from (without CR/LF)
+    const QByteArray &raw() const;
+
+    /// The command, e.g. PRIVMSG or 001
+    std::string_view command() const;
+    bool isCommand(std::string_view command) const;
+
+    /// The full prefix without the leading colon
+    QString prefix() const;
+    /// The nick part of the prefix (`nick!user@host`)
+    QString nick() const;
+
+    size_t parameterCount() const;
+    /// Returns the decoded parameter or an empty string if `index` is out of
+    /// range.
+    QString parameter(size_t index) const;
+    std::string_view rawParameter(size_t index) const;
+
+    size_t tagCount() const;
+    bool hasTag(std::string_view key) const;
+    /// The escaped value of `key`, empty if the tag isn't present
+    std::string_view rawTag(std::string_view key) const;
+    /// The unescaped value of `key`, empty if the tag isn't present
+    QString tag(std::string_view key) const;
+    /// The unescaped value of `key`, nullopt if the tag isn't present
+    std::optional<QString> findTag(std::string_view key) const;
+
+    /// Calls `fn(key, rawValue)` for every tag in order of appearance.
+    template <typename Fn>
+    void forEachRawTag(Fn &&fn) const
+    {
+        for (const auto &tag : this->tags_)
+        {
+            fn(this->view(tag.key), this->view(tag.value));
+        }
+    }
+
+private:
+    struct Slice {
+        uint32_t start = 0;
+        uint32_t length = 0;
+    };
+
+    struct Tag {
+        Slice key;
+        Slice value;
+    };
+
+    TwitchIrcLine() = default;
+
+    std::string_view view(Slice slice) const;
+    QString decode(Slice slice) const;
+    const Tag *findTagSlice(std::string_view key) const;
+
+    QByteArray raw_;
+    std::vector<Tag> tags_;
+    Slice prefix_;
+    Slice command_;
+    std::vector<Slice> params_;
+};
+
+}  // namespace chatterino
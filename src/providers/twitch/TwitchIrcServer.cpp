@@ -1,17 +1,21 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 
 #include "Application.hpp"
+#include "common/Args.hpp"
 #include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "common/Env.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "debug/Trace.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/irc/IrcConnection2.hpp"
+#include "providers/recentmessages/MessageCache.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/seventv/SeventvEventAPI.hpp"
 #include "providers/twitch/api/Helix.hpp"
@@ -21,8 +25,12 @@
 #include "providers/twitch/pubsubmessages/AutoMod.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
+#include "singletons/WindowManager.hpp"
+#include "util/CombinePath.hpp"
+#include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
 #include "util/RatelimitBucket.hpp"
 
@@ -32,7 +40,9 @@
 #include <pajlada/signals/signalholder.hpp>
 #include <QCoreApplication>
 #include <QMetaEnum>
+#include <QThread>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <mutex>
@@ -45,6 +55,9 @@ namespace {
 constexpr int JOIN_RATELIMIT_BUDGET = 18;
 constexpr int JOIN_RATELIMIT_COOLDOWN = 12500;
 
+// Number of read connections channels are distributed across
+constexpr size_t READ_CONNECTION_COUNT = 4;
+
 using namespace chatterino;
 
 void sendHelixMessage(const std::shared_ptr<TwitchChannel> &channel,
@@ -153,6 +166,7 @@ TwitchIrcServer::TwitchIrcServer()
     , liveChannel(new Channel("/live", Channel::Type::TwitchLive))
     , automodChannel(new Channel("/automod", Channel::Type::TwitchAutomod))
     , watchingChannel(Channel::getEmpty(), Channel::Type::TwitchWatching)
+    , readConnectionRing_(READ_CONNECTION_COUNT)
 {
     // Initialize the connections
     // XXX: don't create write connection if there is no separate write connection.
@@ -166,7 +180,10 @@ TwitchIrcServer::TwitchIrcServer()
         {
             return;
         }
-        this->readConnection_->sendRaw("JOIN #" + message);
+        auto *connection = this->readConnectionFor(message);
+        this->runOnConnectionThread(connection, [connection, message] {
+            connection->sendRaw("JOIN #" + message);
+        });
     };
     this->joinBucket_.reset(new RatelimitBucket(
         JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN, actuallyJoin, this));
@@ -188,47 +205,119 @@ TwitchIrcServer::TwitchIrcServer()
         });
 
     // Listen to read connection message signals
-    this->readConnection_.reset(new IrcConnection);
-    this->readConnection_->moveToThread(QCoreApplication::instance()->thread());
+    this->readThread_ = std::make_unique<QThread>();
+    this->readThread_->setObjectName("TwitchIrcRead");
+    this->readThread_->start();
+
+    // Channels are distributed across multiple read connections. Each
+    // connection only (re)joins its own channels, so a dropped socket only
+    // affects a part of the channels.
+    for (size_t i = 0; i < READ_CONNECTION_COUNT; i++)
+    {
+        auto &connection = this->readConnections_.emplace_back(new IrcConnection);
+        connection->moveToThread(this->readThread_.get());
+        this->initializeReadConnection(connection.get());
+    }
+}
 
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::messageReceived, this,
-                     [this](auto msg) {
-                         this->readConnectionMessageReceived(msg);
-                     });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::privateMessageReceived, this,
-                     [this](auto msg) {
-                         this->privateMessageReceived(msg);
+TwitchIrcServer::~TwitchIrcServer()
+{
+    // The read connections have to be deleted on their own thread. The
+    // deferred deletes are processed before the thread finishes.
+    this->readConnections_.clear();
+    this->readThread_->quit();
+    this->readThread_->wait();
+}
+
+void TwitchIrcServer::initializeReadConnection(IrcConnection *connection)
+{
+    // This runs on the read thread. Only the parsed lines are sent to the GUI
+    // thread (see processReceivedLines).
+    QObject::connect(connection, &Communi::IrcConnection::messageReceived,
+                     connection, [this, connection](auto msg) {
+                         this->readThreadMessageReceived(connection, msg);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::connected, this, [this] {
-                         this->onReadConnected(this->readConnection_.get());
+    QObject::connect(connection, &Communi::IrcConnection::connected, this,
+                     [this, connection] {
+                         this->onReadConnected(connection);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::disconnected, this, [this] {
-                         this->onDisconnected();
+    QObject::connect(connection, &Communi::IrcConnection::disconnected, this,
+                     [this, connection] {
+                         this->onDisconnected(connection);
                      });
     this->connections_.managedConnect(
-        this->readConnection_->connectionLost, [this](bool timeout) {
+        connection->connectionLost, [this, connection](bool timeout) {
             qCDebug(chatterinoIrc)
                 << "Read connection reconnect requested. Timeout:" << timeout;
             if (timeout)
             {
                 // Show additional message since this is going to interrupt a
                 // connection that is still "connected"
-                this->addGlobalSystemMessage(
-                    "Server connection timed out, reconnecting");
+                postToThread([this, connection] {
+                    this->forEachChannelOnConnection(
+                        connection, [](const ChannelPtr &chan) {
+                            chan->addSystemMessage(
+                                "Server connection timed out, reconnecting");
+                        });
+                });
             }
-            this->readConnection_->smartReconnect();
+            // we're on the read thread here
+            connection->smartReconnect();
+        });
+    this->connections_.managedConnect(
+        connection->heartbeat, [this, connection] {
+            postToThread([this, connection] {
+                this->markChannelsConnected(connection);
+            });
         });
-    this->connections_.managedConnect(this->readConnection_->heartbeat, [this] {
-        this->markChannelsConnected();
-    });
+}
+
+IrcConnection *TwitchIrcServer::readConnectionFor(
+    const QString &channelName) const
+{
+    return this->readConnections_[this->readConnectionRing_.nodeFor(
+                                      channelName)]
+        .get();
+}
+
+void TwitchIrcServer::forEachChannelOnConnection(
+    const IrcConnection *connection,
+    const std::function<void(const ChannelPtr &)> &func)
+{
+    std::vector<ChannelPtr> channels;
+    {
+        std::lock_guard lock(this->channelMutex);
+        for (auto it = this->channels.begin(); it != this->channels.end();
+             ++it)
+        {
+            if (this->readConnectionFor(it.key()) != connection)
+            {
+                continue;
+            }
+            if (auto chan = it.value().lock())
+            {
+                channels.emplace_back(std::move(chan));
+            }
+        }
+    }
+
+    for (const auto &chan : channels)
+    {
+        func(chan);
+    }
 }
 
 void TwitchIrcServer::initialize()
 {
+    if (getSettings()->loadTwitchMessageHistoryOnConnect &&
+        !getApp()->getArgs().dontSaveSettings)
+    {
+        recentmessages::MessageCache::instance().initialize(
+            combinePath(getApp()->getPaths().miscDirectory, "recent-messages"),
+            static_cast<size_t>(std::max(
+                0, getSettings()->twitchMessageHistoryLimit.getValue())));
+    }
+
     getApp()->getAccounts()->twitch.currentUserChanged.connect([this]() {
         postToThread([this] {
             this->connect();
@@ -247,7 +336,7 @@ void TwitchIrcServer::initialize()
             QString text =
                 QString("%1 cleared the chat.").arg(action.source.login);
 
-            postToThread([chan, text] {
+            this->pubSubBatch_.post([chan, text] {
                 chan->addSystemMessage(text);
             });
         });
@@ -273,7 +362,7 @@ void TwitchIrcServer::initialize()
                 text += QString(" (%1 seconds)").arg(action.duration);
             }
 
-            postToThread([chan, text] {
+            this->pubSubBatch_.post([chan, text] {
                 chan->addSystemMessage(text);
             });
         });
@@ -294,7 +383,7 @@ void TwitchIrcServer::initialize()
                             (action.modded ? "modded" : "unmodded"),
                             action.target.login);
 
-            postToThread([chan, text] {
+            this->pubSubBatch_.post([chan, text] {
                 chan->addSystemMessage(text);
             });
         });
@@ -309,7 +398,7 @@ void TwitchIrcServer::initialize()
                 return;
             }
 
-            postToThread([chan, action] {
+            this->pubSubBatch_.post([chan, action] {
                 MessageBuilder msg(action);
                 msg->flags.set(MessageFlag::PubSub);
                 chan->addOrReplaceTimeout(msg.release());
@@ -327,7 +416,7 @@ void TwitchIrcServer::initialize()
             }
 
             // TODO: Resolve the moderator's user ID into a full user here, so message can look better
-            postToThread([chan, action] {
+            this->pubSubBatch_.post([chan, action] {
                 MessageBuilder msg(action);
                 msg->flags.set(MessageFlag::PubSub);
                 chan->addMessage(msg.release(), MessageContext::Original);
@@ -346,7 +435,7 @@ void TwitchIrcServer::initialize()
 
             auto msg = MessageBuilder::makeDeletionMessageFromPubSub(action);
 
-            postToThread([chan, msg] {
+            this->pubSubBatch_.post([chan, msg] {
                 auto replaced = false;
                 LimitedQueueSnapshot<MessagePtr> snapshot =
                     chan->getMessageSnapshot();
@@ -385,7 +474,7 @@ void TwitchIrcServer::initialize()
 
             auto msg = MessageBuilder(action).release();
 
-            postToThread([chan, msg] {
+            this->pubSubBatch_.post([chan, msg] {
                 chan->addMessage(msg, MessageContext::Original);
             });
         });
@@ -429,7 +518,7 @@ void TwitchIrcServer::initialize()
                 return;
             }
 
-            postToThread([twitchChannel, action] {
+            this->pubSubBatch_.post([twitchChannel, action] {
                 const auto p = MessageBuilder::makeLowTrustUserMessage(
                     action, twitchChannel->getName(), twitchChannel.get());
                 twitchChannel->addMessage(p.first, MessageContext::Original);
@@ -467,7 +556,7 @@ void TwitchIrcServer::initialize()
                 return;
             }
 
-            postToThread([chan, action] {
+            this->pubSubBatch_.post([chan, action] {
                 auto msg = MessageBuilder::makeLowTrustUpdateMessage(action);
                 chan->addMessage(msg, MessageContext::Original);
             });
@@ -487,7 +576,7 @@ void TwitchIrcServer::initialize()
                 case PubSubAutoModQueueMessage::Type::AutoModCaughtMessage: {
                     if (msg.status == "PENDING")
                     {
-                        AutomodAction action(msg.data, channelID);
+                        AutomodAction action(channelID);
                         action.reason = QString("%1 level %2")
                                             .arg(msg.contentCategory)
                                             .arg(msg.contentLevel);
@@ -548,7 +637,7 @@ void TwitchIrcServer::initialize()
                         action.target =
                             ActionUser{msg.senderUserID, msg.senderUserLogin,
                                        senderDisplayName, senderColor};
-                        postToThread([chan, action] {
+                        this->pubSubBatch_.post([chan, action] {
                             const auto p = MessageBuilder::makeAutomodMessage(
                                 action, chan->getName());
                             chan->addMessage(p.first, MessageContext::Original);
@@ -605,7 +694,7 @@ void TwitchIrcServer::initialize()
                 return;
             }
 
-            postToThread([chan, action] {
+            this->pubSubBatch_.post([chan, action] {
                 const auto p =
                     MessageBuilder::makeAutomodMessage(action, chan->getName());
                 chan->addMessage(p.first, MessageContext::Original);
@@ -630,7 +719,7 @@ void TwitchIrcServer::initialize()
 
             auto msg = MessageBuilder(action).release();
 
-            postToThread([chan, msg] {
+            this->pubSubBatch_.post([chan, msg] {
                 chan->addMessage(msg, MessageContext::Original);
             });
         });
@@ -645,7 +734,7 @@ void TwitchIrcServer::initialize()
                 return;
             }
 
-            postToThread([chan, action] {
+            this->pubSubBatch_.post([chan, action] {
                 const auto p = MessageBuilder::makeAutomodInfoMessage(action);
                 chan->addMessage(p, MessageContext::Original);
             });
@@ -663,7 +752,7 @@ void TwitchIrcServer::initialize()
 
             auto msg = MessageBuilder(action).release();
 
-            postToThread([chan, msg] {
+            this->pubSubBatch_.post([chan, msg] {
                 chan->addMessage(msg, MessageContext::Original);
             });
         });
@@ -680,7 +769,7 @@ void TwitchIrcServer::initialize()
 
             auto msg = MessageBuilder(action).release();
 
-            postToThread([chan, msg] {
+            this->pubSubBatch_.post([chan, msg] {
                 chan->addMessage(msg, MessageContext::Original);
             });
         });
@@ -699,7 +788,7 @@ void TwitchIrcServer::initialize()
 
             auto reward = ChannelPointReward(data);
 
-            postToThread([chan, reward] {
+            this->pubSubBatch_.post([chan, reward] {
                 if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
                 {
                     channel->addChannelPointReward(reward);
@@ -726,9 +815,6 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
         caps.push_back("twitch.tv/membership");
     }
 
-    connection->network()->setSkipCapabilityValidation(true);
-    connection->network()->setRequestedCapabilities(caps);
-
     QString username = account->getUserName();
     QString oauthToken = account->getOAuthToken();
 
@@ -737,21 +823,34 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
         oauthToken.prepend("oauth:");
     }
 
-    connection->setUserName(username);
-    connection->setNickName(username);
-    connection->setRealName(username);
+    QString host = Env::get().twitchServerHost;
+    auto port = Env::get().twitchServerPort;
+    bool secure = Env::get().twitchServerSecure;
 
-    if (!account->isAnon())
-    {
-        connection->setPassword(oauthToken);
-    }
+    // The read connection lives on the read thread, so it has to be
+    // configured there
+    this->runOnConnectionThread(
+        connection, [connection, caps, username, oauthToken,
+                     isAnon = account->isAnon(), host, port, secure] {
+            connection->network()->setSkipCapabilityValidation(true);
+            connection->network()->setRequestedCapabilities(caps);
 
-    // https://dev.twitch.tv/docs/irc#connecting-to-the-twitch-irc-server
-    // SSL disabled: irc://irc.chat.twitch.tv:6667 (or port 80)
-    // SSL enabled: irc://irc.chat.twitch.tv:6697 (or port 443)
-    connection->setHost(Env::get().twitchServerHost);
-    connection->setPort(Env::get().twitchServerPort);
-    connection->setSecure(Env::get().twitchServerSecure);
+            connection->setUserName(username);
+            connection->setNickName(username);
+            connection->setRealName(username);
+
+            if (!isAnon)
+            {
+                connection->setPassword(oauthToken);
+            }
+
+            // https://dev.twitch.tv/docs/irc#connecting-to-the-twitch-irc-server
+            // SSL disabled: irc://irc.chat.twitch.tv:6667 (or port 80)
+            // SSL enabled: irc://irc.chat.twitch.tv:6697 (or port 443)
+            connection->setHost(host);
+            connection->setPort(port);
+            connection->setSecure(secure);
+        });
 
     this->open(type);
 }
@@ -793,12 +892,16 @@ std::shared_ptr<Channel> TwitchIrcServer::createChannel(
 void TwitchIrcServer::privateMessageReceived(
     Communi::IrcPrivateMessage *message)
 {
+    trace::Span span(trace::category::IRC, "privateMessageReceived");
+
     IrcMessageHandler::instance().handlePrivMessage(message, *this);
 }
 
 void TwitchIrcServer::readConnectionMessageReceived(
     Communi::IrcMessage *message)
 {
+    trace::Span span(trace::category::IRC, "readConnectionMessageReceived");
+
     if (message->type() == Communi::IrcMessage::Type::Private)
     {
         // We already have a handler for private messages
@@ -823,11 +926,6 @@ void TwitchIrcServer::readConnectionMessageReceived(
         // Received USERSTATE upon JOINing a channel
         handler.handleUserStateMessage(message);
     }
-    else if (command == "ROOMSTATE")
-    {
-        // Received ROOMSTATE upon JOINing a channel
-        handler.handleRoomStateMessage(message);
-    }
     else if (command == "CLEARCHAT")
     {
         handler.handleClearChatMessage(message);
@@ -849,13 +947,177 @@ void TwitchIrcServer::readConnectionMessageReceived(
     {
         handler.handleWhisperMessage(message);
     }
-    else if (command == "RECONNECT")
+}
+
+void TwitchIrcServer::readLineReceived(const TwitchIrcLine &line,
+                                       Communi::IrcMessage *message,
+                                       IrcConnection *connection)
+{
+    trace::Span span(trace::category::IRC, "readLineReceived");
+
+    if (connection != nullptr)
     {
-        this->addGlobalSystemMessage(
-            "Twitch Servers requested us to reconnect, reconnecting");
-        this->markChannelsConnected();
-        this->connect();
+        recentmessages::MessageCache::instance().add(
+            line, std::chrono::system_clock::now());
+    }
+
+    auto &handler = IrcMessageHandler::instance();
+
+    // These commands are frequent during raids and mass bans, so they're
+    // handled on the tokenized line directly
+    if (line.isCommand("RECONNECT"))
+    {
+        if (connection == nullptr)
+        {
+            // Fake messages aren't bound to a connection
+            this->addGlobalSystemMessage(
+                "Twitch Servers requested us to reconnect, reconnecting");
+            this->markChannelsConnected();
+            this->connect();
+            return;
+        }
+
+        // Only the connection that received the RECONNECT has to reconnect
+        this->forEachChannelOnConnection(
+            connection, [](const ChannelPtr &chan) {
+                chan->addSystemMessage(
+                    "Twitch Servers requested us to reconnect, reconnecting");
+            });
+        this->markChannelsConnected(connection);
+        this->runOnConnectionThread(connection, [connection] {
+            connection->close();
+            connection->open();
+        });
+    }
+    else if (line.isCommand("ROOMSTATE"))
+    {
+        // Received ROOMSTATE upon JOINing a channel
+        handler.handleRoomStateMessage(line);
+    }
+    else if (line.isCommand("CLEARCHAT"))
+    {
+        handler.handleClearChatMessage(line);
     }
+    else if (line.isCommand("CLEARMSG"))
+    {
+        handler.handleClearMessageMessage(line);
+    }
+    else if (line.isCommand("JOIN"))
+    {
+        handler.handleJoinMessage(line);
+    }
+    else if (line.isCommand("PART"))
+    {
+        handler.handlePartMessage(line);
+    }
+    else if (line.isCommand("USERSTATE"))
+    {
+        handler.handleUserStateMessage(line);
+    }
+    else if (message != nullptr)
+    {
+        if (message->type() == Communi::IrcMessage::Type::Private)
+        {
+            this->privateMessageReceived(
+                static_cast<Communi::IrcPrivateMessage *>(message));
+        }
+        else
+        {
+            this->readConnectionMessageReceived(message);
+        }
+    }
+}
+
+void TwitchIrcServer::readThreadMessageReceived(IrcConnection *connection,
+                                                Communi::IrcMessage *message)
+{
+    // toData() returns the bytes Communi received, it doesn't serialize the
+    // message again
+    auto line = TwitchIrcLine::parse(message->toData());
+    if (!line)
+    {
+        return;
+    }
+
+    this->queueReceivedLine(std::move(*line), connection, message);
+}
+
+void TwitchIrcServer::queueReceivedLine(TwitchIrcLine &&line,
+                                        IrcConnection *connection,
+                                        Communi::IrcMessage *parsed)
+{
+    ReceivedLine received{
+        .line = std::move(line),
+        .message = nullptr,
+        .connection = connection,
+    };
+
+    // Everything else is either handled on the line directly or only
+    // relevant to the connection itself (PING, CAP, numerics...)
+    static const std::vector<std::string_view> communiCommands{
+        "PRIVMSG",
+        "USERNOTICE",
+        "NOTICE",
+        "WHISPER",
+    };
+    auto needsMessage = std::any_of(
+        communiCommands.begin(), communiCommands.end(), [&](auto command) {
+            return received.line.isCommand(command);
+        });
+    if (needsMessage)
+    {
+        // Communi deletes its message once it's handled on the read thread,
+        // so we keep a copy of it rather than parsing the line again
+        received.message.reset(
+            parsed != nullptr
+                ? parsed->clone()
+                : Communi::IrcMessage::fromData(received.line.raw(), nullptr));
+        received.message->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    bool scheduleProcessing = false;
+    {
+        std::lock_guard lock(this->receivedLinesMutex_);
+        scheduleProcessing = this->receivedLines_.empty();
+        this->receivedLines_.emplace_back(std::move(received));
+    }
+
+    if (scheduleProcessing)
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this] {
+                this->processReceivedLines();
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+void TwitchIrcServer::processReceivedLines()
+{
+    assertInGuiThread();
+
+    std::vector<ReceivedLine> lines;
+    {
+        std::lock_guard lock(this->receivedLinesMutex_);
+        lines.swap(this->receivedLines_);
+    }
+
+    DebugCount::increase("irc lines received",
+                         static_cast<int64_t>(lines.size()));
+
+    for (const auto &received : lines)
+    {
+        this->readLineReceived(received.line, received.message.get(),
+                               received.connection);
+    }
+}
+
+void TwitchIrcServer::runOnConnectionThread(IrcConnection *connection,
+                                            std::function<void()> fn)
+{
+    // AutoConnection calls `fn` directly if we're already on that thread
+    QMetaObject::invokeMethod(connection, std::move(fn));
 }
 
 void TwitchIrcServer::writeConnectionMessageReceived(
@@ -887,17 +1149,22 @@ void TwitchIrcServer::writeConnectionMessageReceived(
 
 void TwitchIrcServer::onReadConnected(IrcConnection *connection)
 {
-    (void)connection;
-
-    std::lock_guard lock(this->channelMutex);
-
-    // join channels
-    for (auto &&weak : this->channels)
+    std::vector<ChannelPtr> channels;
+    this->forEachChannelOnConnection(connection,
+                                     [&channels](const ChannelPtr &chan) {
+                                         channels.push_back(chan);
+                                     });
+
+    // join channels, the ones that are currently visible first
+    auto visibleChannels = getApp()->getWindows()->getVisibleChannelNames();
+    std::stable_partition(channels.begin(), channels.end(),
+                          [&visibleChannels](const ChannelPtr &chan) {
+                              return visibleChannels.contains(chan->getName());
+                          });
+    for (const auto &chan : channels)
     {
-        if (auto channel = weak.lock())
-        {
-            this->joinBucket_->send(channel->getName());
-        }
+        this->joinBucket_->send(chan->getName(),
+                                visibleChannels.contains(chan->getName()));
     }
 
     // connected/disconnected message
@@ -906,14 +1173,8 @@ void TwitchIrcServer::onReadConnected(IrcConnection *connection)
     auto reconnected = makeSystemMessage("reconnected");
     reconnected->flags.set(MessageFlag::ConnectedMessage);
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    for (const auto &chan : channels)
     {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
-        {
-            continue;
-        }
-
         LimitedQueueSnapshot<MessagePtr> snapshot = chan->getMessageSnapshot();
 
         bool replaceMessage =
@@ -938,29 +1199,21 @@ void TwitchIrcServer::onWriteConnected(IrcConnection *connection)
     (void)connection;
 }
 
-void TwitchIrcServer::onDisconnected()
+void TwitchIrcServer::onDisconnected(IrcConnection *connection)
 {
-    std::lock_guard<std::mutex> lock(this->channelMutex);
-
     MessageBuilder b(systemMessage, "disconnected");
     b->flags.set(MessageFlag::DisconnectedMessage);
     auto disconnectedMsg = b.release();
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
-    {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
-        {
-            continue;
-        }
-
-        chan->addMessage(disconnectedMsg, MessageContext::Original);
+    this->forEachChannelOnConnection(
+        connection, [&disconnectedMsg](const ChannelPtr &chan) {
+            chan->addMessage(disconnectedMsg, MessageContext::Original);
 
-        if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
-        {
-            channel->markDisconnected();
-        }
-    }
+            if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
+            {
+                channel->markDisconnected();
+            }
+        });
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::getCustomChannel(
@@ -1387,20 +1640,27 @@ void TwitchIrcServer::markChannelsConnected()
     });
 }
 
-void TwitchIrcServer::addFakeMessage(const QString &data)
+void TwitchIrcServer::markChannelsConnected(const IrcConnection *connection)
 {
-    auto *fakeMessage = Communi::IrcMessage::fromData(
-        data.toUtf8(), this->readConnection_.get());
+    this->forEachChannelOnConnection(connection, [](const ChannelPtr &chan) {
+        if (auto *channel = dynamic_cast<TwitchChannel *>(chan.get()))
+        {
+            channel->markConnected();
+        }
+    });
+}
 
-    if (fakeMessage->command() == "PRIVMSG")
-    {
-        this->privateMessageReceived(
-            static_cast<Communi::IrcPrivateMessage *>(fakeMessage));
-    }
-    else
+void TwitchIrcServer::addFakeMessage(const QString &data)
+{
+    // Fake messages go through the same path as messages from the read
+    // connection
+    auto line = TwitchIrcLine::parse(data.toUtf8());
+    if (!line)
     {
-        this->readConnectionMessageReceived(fakeMessage);
+        return;
     }
+
+    this->queueReceivedLine(std::move(*line), nullptr, nullptr);
 }
 
 void TwitchIrcServer::addGlobalSystemMessage(const QString &messageText)
@@ -1444,15 +1704,23 @@ void TwitchIrcServer::connect()
 
     this->initializeConnection(this->writeConnection_.get(),
                                ConnectionType::Write);
-    this->initializeConnection(this->readConnection_.get(),
-                               ConnectionType::Read);
+    for (const auto &connection : this->readConnections_)
+    {
+        this->initializeConnection(connection.get(), ConnectionType::Read);
+    }
 }
 
 void TwitchIrcServer::disconnect()
 {
     std::lock_guard<std::mutex> locker(this->connectionMutex_);
 
-    this->readConnection_->close();
+    for (const auto &connection : this->readConnections_)
+    {
+        this->runOnConnectionThread(connection.get(),
+                                    [connection = connection.get()] {
+                                        connection->close();
+                                    });
+    }
     this->writeConnection_->close();
 }
 
@@ -1497,9 +1765,14 @@ ChannelPtr TwitchIrcServer::getOrAddChannel(const QString &dirtyChannelName)
                                << "was destroyed";
         this->channels.remove(channelName);
 
-        if (this->readConnection_)
+        if (!this->readConnections_.empty())
         {
-            this->readConnection_->sendRaw("PART #" + channelName);
+            auto *connection = this->readConnectionFor(channelName);
+            this->runOnConnectionThread(connection,
+                                        [connection, channelName] {
+                                            connection->sendRaw("PART #" +
+                                                                channelName);
+                                        });
         }
     });
 
@@ -1507,11 +1780,17 @@ ChannelPtr TwitchIrcServer::getOrAddChannel(const QString &dirtyChannelName)
     {
         std::lock_guard<std::mutex> lock2(this->connectionMutex_);
 
-        if (this->readConnection_)
+        if (!this->readConnections_.empty())
         {
-            if (this->readConnection_->isConnected())
+            // this is only a hint, the read connection might be on its way
+            // to (dis)connect on the read thread
+            if (this->readConnectionFor(channelName)
+                    ->isConnectedFromAnyThread())
             {
-                this->joinBucket_->send(channelName);
+                // Channels are added when they're opened in a split, so
+                // they're joined before channels that are rejoined after a
+                // reconnect.
+                this->joinBucket_->send(channelName, true);
             }
         }
     }
@@ -1557,7 +1836,13 @@ void TwitchIrcServer::open(ConnectionType type)
     }
     if (type == ConnectionType::Read)
     {
-        this->readConnection_->open();
+        for (const auto &connection : this->readConnections_)
+        {
+            this->runOnConnectionThread(connection.get(),
+                                        [connection = connection.get()] {
+                                            connection->open();
+                                        });
+        }
     }
 }
 
@@ -4,6 +4,9 @@
 #include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "providers/irc/IrcConnection2.hpp"
+#include "providers/twitch/TwitchIrcLine.hpp"
+#include "util/ConsistentHashRing.hpp"
+#include "util/GuiThreadBatch.hpp"
 #include "util/RatelimitBucket.hpp"
 
 #include <IrcMessage>
@@ -15,6 +18,9 @@
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
+
+class QThread;
 
 namespace chatterino {
 
@@ -80,7 +86,7 @@ public:
     };
 
     TwitchIrcServer();
-    ~TwitchIrcServer() override = default;
+    ~TwitchIrcServer() override;
 
     TwitchIrcServer(const TwitchIrcServer &) = delete;
     TwitchIrcServer(TwitchIrcServer &&) = delete;
@@ -160,12 +166,16 @@ protected:
 
     void privateMessageReceived(Communi::IrcPrivateMessage *message);
     void readConnectionMessageReceived(Communi::IrcMessage *message);
+    void readLineReceived(const TwitchIrcLine &line,
+                          Communi::IrcMessage *message,
+                          IrcConnection *connection);
     void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
     void onReadConnected(IrcConnection *connection);
     void onWriteConnected(IrcConnection *connection);
-    void onDisconnected();
+    void onDisconnected(IrcConnection *connection);
     void markChannelsConnected();
+    void markChannelsConnected(const IrcConnection *connection);
 
     std::shared_ptr<Channel> getCustomChannel(const QString &channelname);
 
@@ -180,11 +190,60 @@ private:
 
     bool prepareToSend(const std::shared_ptr<TwitchChannel> &channel);
 
+    /// A line received on the read thread, waiting to be handled on the GUI
+    /// thread
+    struct ReceivedLine {
+        TwitchIrcLine line;
+        /// Only set for commands whose handlers still need a Communi message
+        /// (PRIVMSG, USERNOTICE, NOTICE and WHISPER). It's a copy of the
+        /// message Communi parsed on the read thread.
+        std::unique_ptr<Communi::IrcMessage> message;
+        /// The read connection this line was received on, nullptr for fake
+        /// messages
+        IrcConnection *connection = nullptr;
+    };
+
+    /// Connects the signals of a read connection (called once per shard)
+    void initializeReadConnection(IrcConnection *connection);
+    /// The read connection `channelName` is joined on
+    IrcConnection *readConnectionFor(const QString &channelName) const;
+    /// Calls `func` with all channels joined on `connection`.
+    /// `func` is called without holding the channel mutex.
+    void forEachChannelOnConnection(
+        const IrcConnection *connection,
+        const std::function<void(const ChannelPtr &)> &func);
+
+    /// Called on the read thread for every message of a read connection
+    void readThreadMessageReceived(IrcConnection *connection,
+                                   Communi::IrcMessage *message);
+    /// Queues a line to be handled on the GUI thread.
+    /// Lines are handled in batches, once per event loop iteration.
+    ///
+    /// `parsed` is the message Communi parsed the line into, if any. It's
+    /// copied for the commands whose handlers still need a Communi message.
+    void queueReceivedLine(TwitchIrcLine &&line, IrcConnection *connection,
+                           Communi::IrcMessage *parsed);
+    /// Handles all queued lines (GUI thread)
+    void processReceivedLines();
+
+    /// Runs `fn` on the thread `connection` lives on
+    void runOnConnectionThread(IrcConnection *connection,
+                               std::function<void()> fn);
+
     QMap<QString, std::weak_ptr<Channel>> channels;
     std::mutex channelMutex;
 
     QObjectPtr<IrcConnection> writeConnection_ = nullptr;
-    QObjectPtr<IrcConnection> readConnection_ = nullptr;
+    // Channels are split across these connections by readConnectionRing_
+    std::vector<QObjectPtr<IrcConnection>> readConnections_;
+    ConsistentHashRing readConnectionRing_;
+
+    // The read connections live on this thread. Socket reads and parsing
+    // happen here, only the parsed lines are sent to the GUI thread.
+    std::unique_ptr<QThread> readThread_;
+
+    std::mutex receivedLinesMutex_;
+    std::vector<ReceivedLine> receivedLines_;
 
     // Our rate limiting bucket for the Twitch join rate limits
     // https://dev.twitch.tv/docs/irc/guide#rate-limits
@@ -196,6 +255,9 @@ private:
     std::mutex connectionMutex_;
 
     pajlada::Signals::SignalHolder connections_;
+    // Messages from PubSub events are added to channels in batches, so bursts
+    // of moderation events only wake the GUI thread once
+    GuiThreadBatch pubSubBatch_;
 
     std::mutex lastMessageMutex_;
     std::queue<std::chrono::steady_clock::time_point> lastMessagePleb_;
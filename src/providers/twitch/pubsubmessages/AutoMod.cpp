@@ -1,13 +1,15 @@
 #include "providers/twitch/pubsubmessages/AutoMod.hpp"
 
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
+
+#include <rapidjson/document.h>
 
 namespace chatterino {
 
-PubSubAutoModQueueMessage::PubSubAutoModQueueMessage(const QJsonObject &root)
-    : typeString(root.value("type").toString())
-    , data(root.value("data").toObject())
-    , status(this->data.value("status").toString())
+PubSubAutoModQueueMessage::PubSubAutoModQueueMessage(
+    const rapidjson::Value &root)
+    : typeString(rj::toQString(rj::member(root, "type")))
 {
     auto oType = qmagicenum::enumCast<Type>(this->typeString);
     if (oType.has_value())
@@ -15,28 +17,36 @@ PubSubAutoModQueueMessage::PubSubAutoModQueueMessage(const QJsonObject &root)
         this->type = oType.value();
     }
 
-    auto contentClassification =
-        data.value("content_classification").toObject();
+    const auto &data = rj::member(root, "data");
+
+    this->status = rj::toQString(rj::member(data, "status"));
 
-    this->contentCategory = contentClassification.value("category").toString();
-    this->contentLevel = contentClassification.value("level").toInt();
+    const auto &contentClassification =
+        rj::member(data, "content_classification");
 
-    auto message = data.value("message").toObject();
+    this->contentCategory =
+        rj::toQString(rj::member(contentClassification, "category"));
+    const auto &contentLevel = rj::member(contentClassification, "level");
+    if (contentLevel.IsInt())
+    {
+        this->contentLevel = contentLevel.GetInt();
+    }
 
-    this->messageID = message.value("id").toString();
+    const auto &message = rj::member(data, "message");
 
-    auto messageContent = message.value("content").toObject();
+    this->messageID = rj::toQString(rj::member(message, "id"));
 
-    this->messageText = messageContent.value("text").toString();
+    this->messageText =
+        rj::toQString(rj::member(rj::member(message, "content"), "text"));
 
-    auto messageSender = message.value("sender").toObject();
+    const auto &messageSender = rj::member(message, "sender");
 
-    this->senderUserID = messageSender.value("user_id").toString();
-    this->senderUserLogin = messageSender.value("login").toString();
+    this->senderUserID = rj::toQString(rj::member(messageSender, "user_id"));
+    this->senderUserLogin = rj::toQString(rj::member(messageSender, "login"));
     this->senderUserDisplayName =
-        messageSender.value("display_name").toString();
+        rj::toQString(rj::member(messageSender, "display_name"));
     this->senderUserChatColor =
-        QColor(messageSender.value("chat_color").toString());
+        QColor(rj::toQString(rj::member(messageSender, "chat_color")));
 }
 
 }  // namespace chatterino
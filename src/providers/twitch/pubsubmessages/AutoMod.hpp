@@ -2,8 +2,8 @@
 
 #include <magic_enum/magic_enum.hpp>
 #include <QColor>
-#include <QJsonObject>
 #include <QString>
+#include <rapidjson/fwd.h>
 
 namespace chatterino {
 
@@ -16,12 +16,10 @@ struct PubSubAutoModQueueMessage {
     QString typeString;
     Type type = Type::INVALID;
 
-    QJsonObject data;
-
     QString status;
 
     QString contentCategory;
-    int contentLevel;
+    int contentLevel = 0;
 
     QString messageID;
     QString messageText;
@@ -32,7 +30,7 @@ struct PubSubAutoModQueueMessage {
     QColor senderUserChatColor;
 
     PubSubAutoModQueueMessage() = default;
-    explicit PubSubAutoModQueueMessage(const QJsonObject &root);
+    explicit PubSubAutoModQueueMessage(const rapidjson::Value &root);
 };
 
 }  // namespace chatterino
@@ -1,33 +1,57 @@
 #include "providers/twitch/pubsubmessages/Base.hpp"
 
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
 
-namespace chatterino {
+#include <rapidjson/document.h>
 
-PubSubMessage::PubSubMessage(QJsonObject _object)
+namespace chatterino {
 
-    : object(std::move(_object))
-    , nonce(this->object.value("nonce").toString())
-    , error(this->object.value("error").toString())
-    , typeString(this->object.value("type").toString())
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string_view blob)
 {
-    auto oType = qmagicenum::enumCast<Type>(this->typeString);
-    if (oType.has_value())
+    rapidjson::Document doc;
+    doc.Parse(blob.data(), blob.size());
+    if (doc.HasParseError() || !doc.IsObject())
     {
-        this->type = oType.value();
+        return std::nullopt;
     }
-}
 
-std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
-{
-    QJsonDocument jsonDoc(QJsonDocument::fromJson(blob.toUtf8()));
+    PubSubMessage message;
+    rj::getSafe(doc, "nonce", message.nonce);
+    rj::getSafe(doc, "error", message.error);
+    rj::getSafe(doc, "type", message.typeString);
+
+    auto oType = qmagicenum::enumCast<PubSubMessage::Type>(message.typeString);
+    if (oType.has_value())
+    {
+        message.type = oType.value();
+    }
 
-    if (jsonDoc.isNull())
+    auto dataIt = doc.FindMember("data");
+    if (dataIt != doc.MemberEnd() && dataIt->value.IsObject())
     {
-        return std::nullopt;
+        const auto &data = dataIt->value;
+        message.hasData = true;
+        rj::getSafe(data, "topic", message.topic);
+
+        auto payloadIt = data.FindMember("message");
+        if (payloadIt != data.MemberEnd() && payloadIt->value.IsString())
+        {
+            message.messagePayload =
+                QByteArray(payloadIt->value.GetString(),
+                           static_cast<qsizetype>(
+                               payloadIt->value.GetStringLength()));
+        }
     }
 
-    return PubSubMessage(jsonDoc.object());
+    return message;
+}
+
+std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob)
+{
+    auto utf8 = blob.toUtf8();
+    return parsePubSubBaseMessage(
+        std::string_view(utf8.constData(), static_cast<size_t>(utf8.size())));
 }
 
 }  // namespace chatterino
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonDocument>
-#include <QJsonObject>
+#include <QByteArray>
 #include <QString>
 
 #include <optional>
+#include <string_view>
 
 namespace chatterino {
 
@@ -18,33 +18,38 @@ struct PubSubMessage {
         INVALID,
     };
 
-    QJsonObject object;
-
     QString nonce;
     QString error;
     QString typeString;
-    Type type;
+    Type type = Type::INVALID;
 
-    PubSubMessage(QJsonObject _object);
+    /// Set if the message had a `data` object (only for MESSAGE)
+    bool hasData = false;
+    /// `data.topic`
+    QString topic;
+    /// `data.message` - the inner message is a JSON encoded string
+    QByteArray messagePayload;
 
     template <class InnerClass>
-    std::optional<InnerClass> toInner();
+    std::optional<InnerClass> toInner() const;
 };
 
 template <class InnerClass>
-std::optional<InnerClass> PubSubMessage::toInner()
+std::optional<InnerClass> PubSubMessage::toInner() const
 {
-    auto dataValue = this->object.value("data");
-    if (!dataValue.isObject())
+    if (!this->hasData)
     {
         return std::nullopt;
     }
 
-    auto data = dataValue.toObject();
-
-    return InnerClass{this->nonce, data};
+    return InnerClass{this->nonce, this->topic, this->messagePayload};
 }
 
+/// Decodes the envelope of a PubSub message.
+///
+/// Only the fields of PubSubMessage are read from the JSON document, no Qt
+/// JSON tree is built for the envelope.
+std::optional<PubSubMessage> parsePubSubBaseMessage(std::string_view blob);
 std::optional<PubSubMessage> parsePubSubBaseMessage(const QString &blob);
 
 }  // namespace chatterino
@@ -1,19 +1,51 @@
 #include "providers/twitch/pubsubmessages/ChatModeratorAction.hpp"
 
 #include "util/QMagicEnum.hpp"
+#include "util/RapidjsonHelpers.hpp"
+
+#include <rapidjson/document.h>
 
 namespace chatterino {
 
+QString PubSubChatModeratorActionMessage::Data::arg(qsizetype index) const
+{
+    return this->args.value(index);
+}
+
 PubSubChatModeratorActionMessage::PubSubChatModeratorActionMessage(
-    const QJsonObject &root)
-    : typeString(root.value("type").toString())
-    , data(root.value("data").toObject())
+    const rapidjson::Value &root)
+    : typeString(rj::toQString(rj::member(root, "type")))
 {
     auto oType = qmagicenum::enumCast<Type>(this->typeString);
     if (oType.has_value())
     {
         this->type = oType.value();
     }
+
+    const auto &data = rj::member(root, "data");
+
+    this->data.moderationAction =
+        rj::toQString(rj::member(data, "moderation_action"));
+    this->data.type = rj::toQString(rj::member(data, "type"));
+
+    auto args = rj::memberArray(data, "args");
+    this->data.args.reserve(static_cast<qsizetype>(args.Size()));
+    for (const auto &arg : args)
+    {
+        this->data.args.append(rj::toQString(arg));
+    }
+
+    this->data.targetUserID = rj::toQString(rj::member(data, "target_user_id"));
+    this->data.targetUserLogin =
+        rj::toQString(rj::member(data, "target_user_login"));
+    this->data.createdByUserID =
+        rj::toQString(rj::member(data, "created_by_user_id"));
+    this->data.createdBy = rj::toQString(rj::member(data, "created_by"));
+
+    this->data.msgID = rj::toQString(rj::member(data, "msg_id"));
+    this->data.text = rj::toQString(rj::member(data, "text"));
+    this->data.requesterLogin =
+        rj::toQString(rj::member(data, "requester_login"));
 }
 
 }  // namespace chatterino
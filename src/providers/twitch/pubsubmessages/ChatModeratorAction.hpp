@@ -1,8 +1,9 @@
 #pragma once
 
 #include <magic_enum/magic_enum.hpp>
-#include <QJsonObject>
 #include <QString>
+#include <QStringList>
+#include <rapidjson/fwd.h>
 
 namespace chatterino {
 
@@ -14,12 +15,34 @@ struct PubSubChatModeratorActionMessage {
         INVALID,
     };
 
+    /// The fields of `data` read by the moderation and channel terms
+    /// handlers
+    struct Data {
+        /// `moderation_action` - set for ModerationAction
+        QString moderationAction;
+        /// `type` - set for ChannelTermsAction and some moderation actions
+        QString type;
+        QStringList args;
+
+        QString targetUserID;
+        QString targetUserLogin;
+        QString createdByUserID;
+        QString createdBy;
+
+        QString msgID;
+        QString text;
+        QString requesterLogin;
+
+        /// Returns `args[index]` or an empty string if it was omitted
+        QString arg(qsizetype index) const;
+    };
+
     QString typeString;
     Type type = Type::INVALID;
 
-    QJsonObject data;
+    Data data;
 
-    PubSubChatModeratorActionMessage(const QJsonObject &root);
+    explicit PubSubChatModeratorActionMessage(const rapidjson::Value &root);
 };
 
 }  // namespace chatterino
@@ -2,11 +2,14 @@
 
 #include "common/QLogging.hpp"
 
+#include <QByteArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
+#include <rapidjson/document.h>
 
 #include <optional>
+#include <type_traits>
 
 namespace chatterino {
 
@@ -14,32 +17,18 @@ struct PubSubMessageMessage {
     QString nonce;
     QString topic;
 
-    QJsonObject messageObject;
+    /// The inner message - a JSON encoded object
+    ///
+    /// This is only decoded in toInner, with rapidjson if the inner class can
+    /// be constructed from a rapidjson value.
+    QByteArray messagePayload;
 
-    PubSubMessageMessage(QString _nonce, const QJsonObject &data)
+    PubSubMessageMessage(QString _nonce, QString _topic,
+                         QByteArray _messagePayload)
         : nonce(std::move(_nonce))
-        , topic(data.value("topic").toString())
+        , topic(std::move(_topic))
+        , messagePayload(std::move(_messagePayload))
     {
-        auto messagePayload = data.value("message").toString().toUtf8();
-
-        auto messageDoc = QJsonDocument::fromJson(messagePayload);
-
-        if (messageDoc.isNull())
-        {
-            qCWarning(chatterinoPubSub) << "PubSub message (type MESSAGE) "
-                                           "missing inner message payload";
-            return;
-        }
-
-        if (!messageDoc.isObject())
-        {
-            qCWarning(chatterinoPubSub)
-                << "PubSub message (type MESSAGE) inner message payload is not "
-                   "an object";
-            return;
-        }
-
-        this->messageObject = messageDoc.object();
     }
 
     template <class InnerClass>
@@ -49,12 +38,43 @@ struct PubSubMessageMessage {
 template <class InnerClass>
 std::optional<InnerClass> PubSubMessageMessage::toInner() const
 {
-    if (this->messageObject.empty())
+    if (this->messagePayload.isEmpty())
     {
+        qCWarning(chatterinoPubSub) << "PubSub message (type MESSAGE) "
+                                       "missing inner message payload";
         return std::nullopt;
     }
 
-    return InnerClass{this->messageObject};
+    if constexpr (std::is_constructible_v<InnerClass, const rapidjson::Value &>)
+    {
+        rapidjson::Document doc;
+        doc.Parse(this->messagePayload.constData(),
+                  static_cast<size_t>(this->messagePayload.size()));
+
+        if (doc.HasParseError() || !doc.IsObject() || doc.ObjectEmpty())
+        {
+            qCWarning(chatterinoPubSub)
+                << "PubSub message (type MESSAGE) inner message payload is not "
+                   "an object";
+            return std::nullopt;
+        }
+
+        return InnerClass{doc};
+    }
+    else
+    {
+        auto messageDoc = QJsonDocument::fromJson(this->messagePayload);
+
+        if (!messageDoc.isObject() || messageDoc.object().empty())
+        {
+            qCWarning(chatterinoPubSub)
+                << "PubSub message (type MESSAGE) inner message payload is not "
+                   "an object";
+            return std::nullopt;
+        }
+
+        return InnerClass{messageDoc.object()};
+    }
 }
 
 }  // namespace chatterino
@@ -7,14 +7,18 @@
 #include "controllers/highlights/HighlightBlacklistUser.hpp"
 #include "controllers/highlights/HighlightPhrase.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnoreRules.hpp"
 #include "controllers/moderationactions/ModerationAction.hpp"
 #include "controllers/nicknames/Nickname.hpp"
+#include "controllers/nicknames/NicknameRules.hpp"
 #include "debug/Benchmark.hpp"
 #include "pajlada/settings/signalargs.hpp"
 #include "util/WindowsHelper.hpp"
 
 #include <pajlada/signals/scoped-connection.hpp>
 
+#include <unordered_set>
+
 namespace {
 
 using namespace chatterino;
@@ -40,6 +44,20 @@ void initializeSignalVector(pajlada::Signals::SignalHolder &signalHolder,
 
 namespace chatterino {
 
+/// The muted channels compiled for lookups by name
+struct MutedChannelRules {
+    explicit MutedChannelRules(const std::vector<QString> &channels)
+    {
+        for (const auto &channel : channels)
+        {
+            this->names.insert(channel.toLower());
+        }
+    }
+
+    /// Lowercase names of the muted channels
+    std::unordered_set<QString> names;
+};
+
 std::vector<std::weak_ptr<pajlada::Settings::SettingData>> _settings;
 
 void _actuallyRegisterSetting(
@@ -80,31 +98,18 @@ bool Settings::isBlacklistedUser(const QString &username)
 
 bool Settings::isMutedChannel(const QString &channelName)
 {
-    auto items = this->mutedChannels.readOnly();
-
-    for (const auto &channel : *items)
-    {
-        if (channelName.toLower() == channel.toLower())
-        {
-            return true;
-        }
-    }
-    return false;
+    auto rules = this->mutedChannelRules_.get(this->mutedChannels);
+    return rules->names.contains(channelName.toLower());
 }
 
 std::optional<QString> Settings::matchNickname(const QString &usernameText)
 {
-    auto nicknames = this->nicknames.readOnly();
-
-    for (const auto &nickname : *nicknames)
-    {
-        if (auto nicknameText = nickname.match(usernameText))
-        {
-            return nicknameText;
-        }
-    }
+    return this->nicknameRules_.get(this->nicknames)->match(usernameText);
+}
 
-    return std::nullopt;
+std::shared_ptr<const IgnoreRules> Settings::ignoreRules()
+{
+    return this->ignoreRules_.get(this->ignoredMessages);
 }
 
 void Settings::mute(const QString &channelName)
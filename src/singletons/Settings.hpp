@@ -2,6 +2,7 @@
 
 #include "common/Channel.hpp"
 #include "common/ChatterinoSetting.hpp"
+#include "common/CompiledRules.hpp"
 #include "common/enums/MessageOverflow.hpp"
 #include "common/SignalVector.hpp"
 #include "controllers/filters/FilterRecord.hpp"
@@ -26,6 +27,9 @@ using TimeoutButton = std::pair<QString, int>;
 namespace chatterino {
 
 class Args;
+class IgnoreRules;
+class NicknameRules;
+struct MutedChannelRules;
 
 #ifdef Q_OS_WIN32
 #    define DEFAULT_FONT_FAMILY "Segoe UI"
@@ -568,6 +572,12 @@ public:
         "/misc/scrollback/usercardLimit",
         1000,
     };
+    /// Memory in MiB shared by all channels for messages beyond the split
+    /// scrollback limit (see MessageArchive). 0 disables the archive.
+    IntSetting scrollbackArchiveMemoryLimit = {
+        "/misc/scrollback/archiveMemoryLimit",
+        64,
+    };
     BoolSetting displaySevenTVAnimatedProfile = {
         "/misc/displaySevenTVAnimatedProfile", true};
 
@@ -671,6 +681,9 @@ public:
     bool toggleMutedChannel(const QString &channelName);
     std::optional<QString> matchNickname(const QString &username);
 
+    /// The ignored phrases compiled for matching messages
+    std::shared_ptr<const IgnoreRules> ignoreRules();
+
 private:
     void mute(const QString &channelName);
     void unmute(const QString &channelName);
@@ -679,6 +692,10 @@ private:
 
     std::unique_ptr<rapidjson::Document> snapshot_;
 
+    CompiledRules<IgnorePhrase, IgnoreRules> ignoreRules_;
+    CompiledRules<Nickname, NicknameRules> nicknameRules_;
+    CompiledRules<QString, MutedChannelRules> mutedChannelRules_;
+
     pajlada::Signals::SignalHolder signalHolder;
 };
 
@@ -10,10 +10,12 @@
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 #include "util/CombinePath.hpp"
+#include "util/DebugCount.hpp"
 #include "util/SignalListener.hpp"
 #include "widgets/AccountSwitchPopup.hpp"
 #include "widgets/dialogs/SettingsDialog.hpp"
 #include "widgets/FramelessEmbedWindow.hpp"
+#include "widgets/helper/ChannelView.hpp"
 #include "widgets/helper/NotebookTab.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/OverlayWindow.hpp"
@@ -22,6 +24,7 @@
 #include "widgets/Window.hpp"
 
 #include <QDebug>
+#include <QGuiApplication>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -29,7 +32,9 @@
 #include <QSaveFile>
 #include <QScreen>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <optional>
 
 namespace chatterino {
@@ -41,6 +46,9 @@ namespace {
         return x;
     }
 
+    /// Used if the refresh rate of the screen is unknown
+    constexpr int DEFAULT_FRAME_INTERVAL = 16;
+
 }  // namespace
 
 const QString WindowManager::WINDOW_LAYOUT_FILENAME(
@@ -158,6 +166,12 @@ WindowManager::WindowManager(const Paths &paths, Settings &settings,
         getApp()->getWindows()->save();
     });
 
+    this->frameTimer_.setSingleShot(true);
+    this->frameTimer_.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&this->frameTimer_, &QTimer::timeout, [this] {
+        this->runViewFrame();
+    });
+
     this->updateWordTypeMask();
 }
 
@@ -260,6 +274,77 @@ void WindowManager::repaintGifEmotes()
     this->gifRepaintRequested.invoke();
 }
 
+void WindowManager::scheduleViewFrame(ChannelView *view)
+{
+    assertInGuiThread();
+
+    this->scheduledViews_.emplace_back(view);
+
+    if (!this->frameTimer_.isActive())
+    {
+        this->frameRequested_.start();
+        this->frameTimer_.start(this->frameInterval());
+    }
+}
+
+void WindowManager::runViewFrame()
+{
+    auto interval = this->frameInterval();
+
+    // The event loop was busy for longer than a frame
+    auto late = this->frameRequested_.elapsed() - interval;
+    if (late >= interval)
+    {
+        DebugCount::increase("skipped view frames", late / interval);
+    }
+    DebugCount::increase("view frames");
+
+    // Views that are scheduled while running the frame (e.g. because the
+    // layout changed the scrollbar) run in the next frame
+    auto views = std::move(this->scheduledViews_);
+    this->scheduledViews_.clear();
+    for (const auto &view : views)
+    {
+        if (view)
+        {
+            view->runScheduledFrame();
+        }
+    }
+}
+
+int WindowManager::frameInterval() const
+{
+    auto *screen = QGuiApplication::primaryScreen();
+    if (screen == nullptr || screen->refreshRate() < 1)
+    {
+        return DEFAULT_FRAME_INTERVAL;
+    }
+
+    return std::max(1, static_cast<int>(std::lround(1000.0 /
+                                                    screen->refreshRate())));
+}
+
+QSet<QString> WindowManager::getVisibleChannelNames() const
+{
+    assertInGuiThread();
+
+    QSet<QString> names;
+    for (auto *window : this->windows_)
+    {
+        auto *page = window->getNotebook().getSelectedPage();
+        if (page == nullptr)
+        {
+            continue;
+        }
+
+        for (auto *split : page->getSplits())
+        {
+            names.insert(split->getChannel()->getName());
+        }
+    }
+    return names;
+}
+
 // void WindowManager::updateAll()
 //{
 //    if (this->mainWindow != nullptr) {
@@ -5,10 +5,14 @@
 #include "widgets/splits/SplitContainer.hpp"
 
 #include <pajlada/settings/settinglistener.hpp>
+#include <QElapsedTimer>
 #include <QPoint>
+#include <QPointer>
+#include <QSet>
 #include <QTimer>
 
 #include <memory>
+#include <vector>
 
 namespace chatterino {
 
@@ -78,6 +82,13 @@ public:
     void repaintVisibleChatWidgets(Channel *channel = nullptr);
     void repaintGifEmotes();
 
+    /// Runs the queued layout and repaint of `view` with the next display
+    /// frame. All views scheduled until then are handled in the same frame.
+    void scheduleViewFrame(ChannelView *view);
+
+    // Names of the channels shown in the selected tab of any window
+    QSet<QString> getVisibleChannelNames() const;
+
     Window &getMainWindow();
 
     // Returns a pointer to the last selected window.
@@ -157,6 +168,11 @@ private:
     // Apply a window layout for this window manager.
     void applyWindowLayout(const WindowLayout &layout);
 
+    /// Lays out and repaints all views scheduled for this frame
+    void runViewFrame();
+    /// Duration of a display frame in milliseconds
+    int frameInterval() const;
+
     // Contains the full path to the window layout file, e.g. /home/pajlada/.local/share/Chatterino/Settings/window-layout.json
     const QString windowLayoutFilePath;
 
@@ -176,6 +192,11 @@ private:
 
     QTimer *saveTimer;
 
+    QTimer frameTimer_;
+    /// Started when the frame timer is started
+    QElapsedTimer frameRequested_;
+    std::vector<QPointer<ChannelView>> scheduledViews_;
+
     pajlada::Signals::SignalHolder signalHolder;
 
     SignalListener updateWordTypeMaskListener;
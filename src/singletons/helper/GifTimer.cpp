@@ -3,39 +3,113 @@
 #include "Application.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/DebugCount.hpp"
 
 #include <QApplication>
 
+#include <algorithm>
+
+namespace {
+
+/// How often to check if animations can run again while they're paused
+constexpr int PAUSED_POLL_INTERVAL = 100;
+
+}  // namespace
+
 namespace chatterino {
 
 void GIFTimer::initialize()
 {
-    this->timer.setInterval(GIF_FRAME_LENGTH);
+    this->timer.setSingleShot(true);
     this->timer.setTimerType(Qt::PreciseTimer);
+    this->clock_.start();
 
     getSettings()->animateEmotes.connect([this](bool enabled, auto) {
+        this->advance();
         if (enabled)
         {
-            this->timer.start();
+            // Let views request their next frames
+            getApp()->getWindows()->repaintGifEmotes();
         }
         else
         {
             this->timer.stop();
+            this->deadline_.reset();
         }
     });
 
     QObject::connect(&this->timer, &QTimer::timeout, [this] {
-        if (getSettings()->animationsWhenFocused &&
-            this->openOverlayWindows_ == 0 &&
-            QApplication::activeWindow() == nullptr)
-        {
-            return;
-        }
-
-        this->position_ += GIF_FRAME_LENGTH;
-        this->signal.invoke();
-        getApp()->getWindows()->repaintGifEmotes();
+        this->onTimeout();
     });
 }
 
+uint64_t GIFTimer::position()
+{
+    this->advance();
+    return this->position_;
+}
+
+void GIFTimer::requestFrame(uint64_t deadline)
+{
+    if (!this->clock_.isValid() || !getSettings()->animateEmotes)
+    {
+        return;
+    }
+
+    if (this->deadline_ && *this->deadline_ <= deadline)
+    {
+        // The timer fires early enough
+        return;
+    }
+
+    auto position = this->position();
+    auto delay = deadline > position ? deadline - position : 0;
+    this->deadline_ = deadline;
+    this->timer.start(
+        static_cast<int>(std::max<uint64_t>(delay, GIF_FRAME_LENGTH)));
+}
+
+bool GIFTimer::paused() const
+{
+    if (!getSettings()->animateEmotes)
+    {
+        return true;
+    }
+
+    return getSettings()->animationsWhenFocused &&
+           this->openOverlayWindows_ == 0 &&
+           QApplication::activeWindow() == nullptr;
+}
+
+void GIFTimer::advance()
+{
+    if (!this->clock_.isValid())
+    {
+        return;
+    }
+
+    auto now = this->clock_.elapsed();
+    if (!this->paused())
+    {
+        this->position_ += static_cast<uint64_t>(now - this->lastAdvance_);
+    }
+    this->lastAdvance_ = now;
+}
+
+void GIFTimer::onTimeout()
+{
+    this->advance();
+
+    if (this->paused())
+    {
+        // Keep the request around until animations can run again
+        this->timer.start(PAUSED_POLL_INTERVAL);
+        return;
+    }
+
+    this->deadline_.reset();
+    DebugCount::increase("gif frames");
+    getApp()->getWindows()->repaintGifEmotes();
+}
+
 }  // namespace chatterino
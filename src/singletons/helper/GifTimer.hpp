@@ -1,22 +1,36 @@
 #pragma once
 
-#include <pajlada/signals/signal.hpp>
+#include <QElapsedTimer>
 #include <QTimer>
 
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
 namespace chatterino {
 
+/// Minimum time between two animation frames in milliseconds
 constexpr long unsigned GIF_FRAME_LENGTH = 20;
 
+/// Drives the animation of images.
+///
+/// Animated images pick their frame based on #position(), so only images that
+/// are painted do any work. Views that painted animated images request a
+/// repaint for when the next frame of one of them is due (#requestFrame). The
+/// timer only fires at the earliest requested time and then invokes
+/// WindowManager::repaintGifEmotes.
 class GIFTimer
 {
 public:
     void initialize();
 
-    pajlada::Signals::NoArgSignal signal;
-    long unsigned position()
-    {
-        return this->position_;
-    }
+    /// The animation time in milliseconds.
+    /// This only advances while animations are running.
+    uint64_t position();
+
+    /// Requests WindowManager::repaintGifEmotes to be invoked once the
+    /// animation time reaches `deadline`
+    void requestFrame(uint64_t deadline);
 
     void registerOpenOverlayWindow()
     {
@@ -30,8 +44,18 @@ public:
     }
 
 private:
+    /// Returns true if animations are disabled or stopped because no window
+    /// is focused
+    bool paused() const;
+    /// Advances the animation time by the time since the last call
+    void advance();
+    void onTimeout();
+
     QTimer timer;
-    long unsigned position_{};
+    QElapsedTimer clock_;
+    int64_t lastAdvance_ = 0;
+    uint64_t position_{};
+    std::optional<uint64_t> deadline_;
     size_t openOverlayWindows_ = 0;
 };
 
@@ -0,0 +1,129 @@
+#include "util/AhoCorasick.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace chatterino {
+
+AhoCorasick::AhoCorasick(const std::vector<QString> &phrases)
+{
+    if (std::ranges::all_of(phrases, [](const auto &phrase) {
+            return phrase.isEmpty();
+        }))
+    {
+        return;
+    }
+
+    this->nodes_.emplace_back();
+
+    // Build the trie of all phrases
+    for (size_t i = 0; i < phrases.size(); i++)
+    {
+        const auto &phrase = phrases[i];
+        if (phrase.isEmpty())
+        {
+            continue;
+        }
+
+        uint32_t node = ROOT;
+        for (auto qc : phrase)
+        {
+            auto c = static_cast<char16_t>(qc.unicode());
+            auto &next = this->nodes_[node].next;
+            auto it = std::ranges::lower_bound(
+                next, c, {}, &std::pair<char16_t, uint32_t>::first);
+            if (it != next.end() && it->first == c)
+            {
+                node = it->second;
+                continue;
+            }
+
+            auto created = static_cast<uint32_t>(this->nodes_.size());
+            next.insert(it, {c, created});
+            this->nodes_.emplace_back();
+            node = created;
+        }
+
+        auto &match = this->nodes_[node].match;
+        match = std::min(match, static_cast<uint32_t>(i));
+    }
+
+    // Link every node to its longest proper suffix in the trie (breadth
+    // first, so the suffix links of shorter nodes are known)
+    std::deque<uint32_t> queue;
+    for (const auto &[c, next] : this->nodes_[ROOT].next)
+    {
+        queue.push_back(next);
+    }
+    while (!queue.empty())
+    {
+        auto node = queue.front();
+        queue.pop_front();
+
+        for (const auto &[c, next] : this->nodes_[node].next)
+        {
+            auto fail = this->step(this->nodes_[node].fail, c);
+            this->nodes_[next].fail = fail;
+            if (this->nodes_[next].match == NO_MATCH)
+            {
+                this->nodes_[next].match = this->nodes_[fail].match;
+            }
+            queue.push_back(next);
+        }
+    }
+}
+
+std::optional<size_t> AhoCorasick::findAny(QStringView text) const
+{
+    if (this->nodes_.empty())
+    {
+        return std::nullopt;
+    }
+
+    uint32_t node = ROOT;
+    for (auto c : text)
+    {
+        node = this->step(node, static_cast<char16_t>(c.unicode()));
+        if (this->nodes_[node].match != NO_MATCH)
+        {
+            return this->nodes_[node].match;
+        }
+    }
+    return std::nullopt;
+}
+
+bool AhoCorasick::empty() const
+{
+    return this->nodes_.empty();
+}
+
+uint32_t AhoCorasick::child(uint32_t node, char16_t c) const
+{
+    const auto &next = this->nodes_[node].next;
+    auto it = std::ranges::lower_bound(next, c, {},
+                                       &std::pair<char16_t, uint32_t>::first);
+    if (it != next.end() && it->first == c)
+    {
+        return it->second;
+    }
+    return NO_MATCH;
+}
+
+uint32_t AhoCorasick::step(uint32_t node, char16_t c) const
+{
+    while (true)
+    {
+        auto next = this->child(node, c);
+        if (next != NO_MATCH)
+        {
+            return next;
+        }
+        if (node == ROOT)
+        {
+            return ROOT;
+        }
+        node = this->nodes_[node].fail;
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// An automaton that finds any of a set of phrases in a text.
+///
+/// All phrases are matched in a single pass over the text, so the cost of a
+/// search doesn't grow with the number of phrases. The automaton is built
+/// once and can't be changed afterwards, which makes it safe to search
+/// from multiple threads.
+///
+/// Phrases and texts are compared by UTF-16 code units. For
+/// case-insensitive matching, phrases and texts have to be case folded
+/// (QString::toCaseFolded) by the caller.
+class AhoCorasick
+{
+public:
+    AhoCorasick() = default;
+    explicit AhoCorasick(const std::vector<QString> &phrases);
+
+    /// Returns the index of a phrase found in `text`. If multiple phrases are
+    /// found, the one that ends first is returned. Empty phrases never match.
+    std::optional<size_t> findAny(QStringView text) const;
+
+    bool empty() const;
+
+private:
+    static constexpr uint32_t ROOT = 0;
+    static constexpr uint32_t NO_MATCH = UINT32_MAX;
+
+    struct Node {
+        /// Transitions sorted by their character
+        std::vector<std::pair<char16_t, uint32_t>> next;
+        uint32_t fail = ROOT;
+        /// Index of a phrase ending here or at a suffix of this node
+        uint32_t match = NO_MATCH;
+    };
+
+    uint32_t child(uint32_t node, char16_t c) const;
+    uint32_t step(uint32_t node, char16_t c) const;
+
+    std::vector<Node> nodes_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,81 @@
+#include "util/BlockArena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace chatterino {
+
+BlockArena::BlockArena(size_t initialBlockSize, size_t maxBlockSize)
+    : nextBlockSize_(initialBlockSize)
+    , maxBlockSize_(std::max(initialBlockSize, maxBlockSize))
+{
+}
+
+void *BlockArena::allocate(size_t size, size_t alignment)
+{
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    while (this->current_ < this->blocks_.size())
+    {
+        auto &block = this->blocks_[this->current_];
+        auto address =
+            reinterpret_cast<uintptr_t>(block.data.get()) + this->offset_;
+        auto padding = (alignment - (address % alignment)) % alignment;
+
+        if (this->offset_ + padding + size <= block.size)
+        {
+            auto *result = block.data.get() + this->offset_ + padding;
+            this->offset_ += padding + size;
+            this->used_ += padding + size;
+            return result;
+        }
+
+        // The rest of this block is wasted until the next reset
+        this->current_++;
+        this->offset_ = 0;
+    }
+
+    // Blocks from operator new[] are aligned for all fundamental types, so
+    // only over-aligned types need padding here
+    auto blockSize = std::max(this->nextBlockSize_, size + alignment);
+    this->nextBlockSize_ =
+        std::min(this->nextBlockSize_ * 2, this->maxBlockSize_);
+    this->blocks_.push_back({
+        .data = std::unique_ptr<std::byte[]>(new std::byte[blockSize]),
+        .size = blockSize,
+    });
+    this->current_ = this->blocks_.size() - 1;
+    this->offset_ = 0;
+
+    return this->allocate(size, alignment);
+}
+
+void BlockArena::reset()
+{
+    this->current_ = 0;
+    this->offset_ = 0;
+    this->used_ = 0;
+}
+
+size_t BlockArena::used() const
+{
+    return this->used_;
+}
+
+size_t BlockArena::capacity() const
+{
+    size_t capacity = 0;
+    for (const auto &block : this->blocks_)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+size_t BlockArena::blockCount() const
+{
+    return this->blocks_.size();
+}
+
+}  // namespace chatterino
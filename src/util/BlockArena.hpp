@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// A bump allocator over a list of blocks.
+///
+/// Allocations are never freed individually. Instead, the whole arena is
+/// rewound with `reset`, which keeps the blocks around for the next round of
+/// allocations. Once an arena has grown to fit its largest round, allocating
+/// doesn't touch the heap anymore.
+///
+/// The first block is small and each following block doubles in size (up to
+/// `maxBlockSize`), so arenas that only hold a few objects stay small.
+///
+/// Objects created in the arena must be destroyed by their owner before the
+/// arena is reset.
+class BlockArena
+{
+public:
+    explicit BlockArena(size_t initialBlockSize = 256,
+                        size_t maxBlockSize = 4096);
+
+    BlockArena(const BlockArena &) = delete;
+    BlockArena &operator=(const BlockArena &) = delete;
+    BlockArena(BlockArena &&) = default;
+    BlockArena &operator=(BlockArena &&) = default;
+
+    /// Returns `size` bytes aligned to `alignment` that stay valid until the
+    /// arena is reset or destroyed
+    void *allocate(size_t size, size_t alignment);
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        return new (this->allocate(sizeof(T), alignof(T)))
+            T(std::forward<Args>(args)...);
+    }
+
+    /// Makes all blocks available again without freeing them
+    void reset();
+
+    /// Number of bytes allocated since the last reset
+    size_t used() const;
+
+    /// Number of bytes in all blocks
+    size_t capacity() const;
+
+    /// Number of blocks allocated from the heap
+    size_t blockCount() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    /// Size of the next block, unless the allocation needs a larger one
+    size_t nextBlockSize_;
+    size_t maxBlockSize_;
+    std::vector<Block> blocks_;
+    /// Index of the block allocations are made from
+    size_t current_ = 0;
+    /// Offset of the next free byte in the current block
+    size_t offset_ = 0;
+    size_t used_ = 0;
+};
+
+}  // namespace chatterino
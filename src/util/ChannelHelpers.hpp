@@ -13,11 +13,12 @@ namespace chatterino {
 ///                       - replace `buffer[i]` (=toReplace) with `replacement`
 /// @param addMessage A function of type `void (MessagePtr message)`
 ///                   - adds the `message`.
-/// @param disableUserMessages If set, disables all message by the timed out user.
+/// Disabling the messages of the timed out user is up to the caller
+/// (see Channel::addOrReplaceTimeout).
 template <typename Buf, typename Replace, typename Add>
 void addOrReplaceChannelTimeout(const Buf &buffer, MessagePtr message,
                                 QTime now, Replace replaceMessage,
-                                Add addMessage, bool disableUserMessages)
+                                Add addMessage)
 {
     // NOTE: This function uses the messages PARSE time to figure out whether they should be replaced
     // This works as expected for incoming messages, but not for historic messages.
@@ -95,23 +96,6 @@ void addOrReplaceChannelTimeout(const Buf &buffer, MessagePtr message,
         }
     }
 
-    // disable the messages from the user
-    if (disableUserMessages)
-    {
-        for (qsizetype i = 0; i < snapshotLength; i++)
-        {
-            auto &s = buffer[i];
-            if (s->loginName == message->timeoutUser &&
-                s->flags.hasNone({MessageFlag::Timeout, MessageFlag::Untimeout,
-                                  MessageFlag::Whisper}))
-            {
-                // FOURTF: disabled for now
-                // PAJLADA: Shitty solution described in Message.hpp
-                s->flags.set(MessageFlag::Disabled);
-            }
-        }
-    }
-
     if (shouldAddMessage)
     {
         addMessage(message);
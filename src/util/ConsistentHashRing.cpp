@@ -0,0 +1,65 @@
+#include "util/ConsistentHashRing.hpp"
+
+#include <QCryptographicHash>
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+/// A stable hash (unlike qHash, which is seeded per process for QHash)
+uint32_t ringHash(const QString &key)
+{
+    auto digest =
+        QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5);
+    return (static_cast<uint32_t>(static_cast<uint8_t>(digest[0])) << 24) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(digest[1])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(digest[2])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(digest[3]));
+}
+
+}  // namespace
+
+namespace chatterino {
+
+ConsistentHashRing::ConsistentHashRing(size_t nodeCount, size_t virtualNodes)
+    : nodeCount_(nodeCount)
+{
+    assert(nodeCount > 0);
+
+    this->ring_.reserve(nodeCount * virtualNodes);
+    for (size_t node = 0; node < nodeCount; node++)
+    {
+        for (size_t i = 0; i < virtualNodes; i++)
+        {
+            this->ring_.emplace_back(
+                ringHash(QStringLiteral("node-%1-%2").arg(node).arg(i)), node);
+        }
+    }
+    std::sort(this->ring_.begin(), this->ring_.end());
+}
+
+size_t ConsistentHashRing::nodeFor(const QString &key) const
+{
+    if (this->nodeCount_ == 1)
+    {
+        return 0;
+    }
+
+    auto hash = ringHash(key);
+    auto it = std::lower_bound(this->ring_.begin(), this->ring_.end(),
+                               std::make_pair(hash, size_t{0}));
+    if (it == this->ring_.end())
+    {
+        // wrap around
+        it = this->ring_.begin();
+    }
+    return it->second;
+}
+
+size_t ConsistentHashRing::nodeCount() const
+{
+    return this->nodeCount_;
+}
+
+}  // namespace chatterino
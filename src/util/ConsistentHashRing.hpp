@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// Assigns keys to one of `nodeCount` nodes using consistent hashing.
+///
+/// Every node is placed on a hash ring `virtualNodes` times. A key belongs to
+/// the first node found clockwise from the key's hash. Changing the number
+/// of nodes only moves about 1/n of the keys to a different node.
+class ConsistentHashRing
+{
+public:
+    explicit ConsistentHashRing(size_t nodeCount, size_t virtualNodes = 64);
+
+    /// Returns the node (in [0, nodeCount)) that `key` belongs to
+    size_t nodeFor(const QString &key) const;
+
+    size_t nodeCount() const;
+
+private:
+    /// (hash, node), sorted by hash
+    std::vector<std::pair<uint32_t, size_t>> ring_;
+    size_t nodeCount_;
+};
+
+}  // namespace chatterino
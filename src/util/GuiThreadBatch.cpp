@@ -0,0 +1,53 @@
+#include "util/GuiThreadBatch.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/PostToThread.hpp"
+
+namespace chatterino {
+
+GuiThreadBatch::GuiThreadBatch()
+    : state_(std::make_shared<State>())
+{
+}
+
+void GuiThreadBatch::post(std::function<void()> fn)
+{
+    bool scheduleFlush = false;
+    {
+        std::lock_guard lock(this->state_->mutex);
+        scheduleFlush = this->state_->pending.empty();
+        this->state_->pending.emplace_back(std::move(fn));
+    }
+
+    if (scheduleFlush)
+    {
+        postToThread([state = this->state_] {
+            state->flush();
+        });
+    }
+}
+
+size_t GuiThreadBatch::flushCount() const
+{
+    std::lock_guard lock(this->state_->mutex);
+    return this->state_->flushes;
+}
+
+void GuiThreadBatch::State::flush()
+{
+    assertInGuiThread();
+
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard lock(this->mutex);
+        batch.swap(this->pending);
+        this->flushes++;
+    }
+
+    for (auto &fn : batch)
+    {
+        fn();
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+/// Runs functions posted from other threads on the GUI thread in batches.
+///
+/// The first function posted after a flush schedules the next flush, so a
+/// burst of posts (e.g. from a websocket thread) wakes the GUI thread once per
+/// event loop iteration instead of once per post. Functions run in the order
+/// they were posted.
+class GuiThreadBatch
+{
+public:
+    GuiThreadBatch();
+
+    void post(std::function<void()> fn);
+
+    /// Number of times a batch was run on the GUI thread
+    size_t flushCount() const;
+
+private:
+    struct State {
+        mutable std::mutex mutex;
+        std::vector<std::function<void()>> pending;
+        size_t flushes = 0;
+
+        void flush();
+    };
+
+    // Shared with the scheduled flush, which can outlive this object
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace chatterino
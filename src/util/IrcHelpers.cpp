@@ -1,41 +1,45 @@
 #include "util/IrcHelpers.hpp"
 
 #include "Application.hpp"
+#include "providers/twitch/TwitchIrcLine.hpp"
+
+#include <optional>
 
 namespace {
 
 using namespace chatterino;
 
-QDateTime calculateMessageTimeBase(const Communi::IrcMessage *message)
+/// `findTag(key)` must return the tag value as a `std::optional<QString>`
+template <typename FindTag>
+QDateTime calculateMessageTimeBase(const FindTag &findTag)
 {
     // Check if message is from recent-messages API
-    if (message->tags().contains("historical"))
+    if (findTag("historical"))
     {
         bool customReceived = false;
-        auto ts =
-            message->tags().value("rm-received-ts").toLongLong(&customReceived);
+        auto ts = findTag("rm-received-ts")
+                      .value_or(QString())
+                      .toLongLong(&customReceived);
         if (!customReceived)
         {
-            ts = message->tags().value("tmi-sent-ts").toLongLong();
+            ts = findTag("tmi-sent-ts").value_or(QString()).toLongLong();
         }
 
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // If present, handle tmi-sent-ts tag and use it as timestamp
-    if (message->tags().contains("tmi-sent-ts"))
+    if (auto sentTs = findTag("tmi-sent-ts"))
     {
-        auto ts = message->tags().value("tmi-sent-ts").toLongLong();
+        auto ts = sentTs->toLongLong();
         return QDateTime::fromMSecsSinceEpoch(ts);
     }
 
     // Some IRC Servers might have server-time tag containing UTC date in ISO format, use it as timestamp
     // See: https://ircv3.net/irc/#server-time
-    if (message->tags().contains("time"))
+    if (auto timedate = findTag("time"))
     {
-        QString timedate = message->tags().value("time").toString();
-
-        auto date = QDateTime::fromString(timedate, Qt::ISODate);
+        auto date = QDateTime::fromString(*timedate, Qt::ISODate);
         date.setTimeZone(QTimeZone::utc());
         return date.toLocalTime();
     }
@@ -51,14 +55,8 @@ QDateTime calculateMessageTimeBase(const Communi::IrcMessage *message)
     return QDateTime::currentDateTime();
 }
 
-}  // namespace
-
-namespace chatterino {
-
-QDateTime calculateMessageTime(const Communi::IrcMessage *message)
+QDateTime finalizeMessageTime(const QDateTime &dt)
 {
-    auto dt = calculateMessageTimeBase(message);
-
 #ifdef CHATTERINO_WITH_TESTS
     if (getApp()->isTest())
     {
@@ -69,4 +67,30 @@ QDateTime calculateMessageTime(const Communi::IrcMessage *message)
     return dt;
 }
 
+}  // namespace
+
+namespace chatterino {
+
+QDateTime calculateMessageTime(const Communi::IrcMessage *message)
+{
+    const auto tags = message->tags();
+    return finalizeMessageTime(calculateMessageTimeBase(
+        [&tags](const char *key) -> std::optional<QString> {
+            auto it = tags.find(key);
+            if (it == tags.end())
+            {
+                return std::nullopt;
+            }
+            return it.value().toString();
+        }));
+}
+
+QDateTime calculateMessageTime(const TwitchIrcLine &line)
+{
+    return finalizeMessageTime(
+        calculateMessageTimeBase([&line](const char *key) {
+            return line.findTag(key);
+        }));
+}
+
 }  // namespace chatterino
@@ -0,0 +1,265 @@
+#include "util/NgramIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr qsizetype TRIGRAM_LENGTH = 3;
+
+uint64_t trigramAt(const QString &key, qsizetype pos)
+{
+    return (uint64_t(key[pos].unicode()) << 32) |
+           (uint64_t(key[pos + 1].unicode()) << 16) |
+           uint64_t(key[pos + 2].unicode());
+}
+
+/// The distinct trigrams of `key`
+std::vector<uint64_t> trigramsOf(const QString &key)
+{
+    std::vector<uint64_t> grams;
+    if (key.size() < TRIGRAM_LENGTH)
+    {
+        return grams;
+    }
+
+    grams.reserve(static_cast<size_t>(key.size() - TRIGRAM_LENGTH + 1));
+    for (qsizetype i = 0; i + TRIGRAM_LENGTH <= key.size(); i++)
+    {
+        grams.push_back(trigramAt(key, i));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+NgramIndex::Id NgramIndex::insert(const QString &text)
+{
+    Id id{};
+    if (this->freeIds_.empty())
+    {
+        id = static_cast<Id>(this->entries_.size());
+        this->entries_.emplace_back();
+    }
+    else
+    {
+        id = this->freeIds_.back();
+        this->freeIds_.pop_back();
+    }
+
+    auto &entry = this->entries_[id];
+    entry.text = text;
+    entry.key = text.toLower();
+    entry.alive = true;
+    this->size_++;
+
+    this->sortedKeys_.emplace(entry.key, id);
+    this->addTrigrams(id);
+
+    return id;
+}
+
+void NgramIndex::remove(Id id)
+{
+    if (!this->contains(id))
+    {
+        return;
+    }
+
+    auto &entry = this->entries_[id];
+    this->removeTrigrams(id);
+
+    auto [begin, end] = this->sortedKeys_.equal_range(entry.key);
+    for (auto it = begin; it != end; ++it)
+    {
+        if (it->second == id)
+        {
+            this->sortedKeys_.erase(it);
+            break;
+        }
+    }
+
+    entry = {};
+    this->freeIds_.push_back(id);
+    this->size_--;
+}
+
+void NgramIndex::setText(Id id, const QString &text)
+{
+    if (!this->contains(id))
+    {
+        return;
+    }
+
+    assert(text.toLower() == this->entries_[id].key);
+    this->entries_[id].text = text;
+}
+
+void NgramIndex::clear()
+{
+    this->entries_.clear();
+    this->freeIds_.clear();
+    this->size_ = 0;
+    this->sortedKeys_.clear();
+    this->trigrams_.clear();
+}
+
+size_t NgramIndex::size() const
+{
+    return this->size_;
+}
+
+bool NgramIndex::contains(Id id) const
+{
+    return id < this->entries_.size() && this->entries_[id].alive;
+}
+
+const QString &NgramIndex::text(Id id) const
+{
+    return this->entries_[id].text;
+}
+
+const QString &NgramIndex::key(Id id) const
+{
+    return this->entries_[id].key;
+}
+
+std::vector<NgramIndex::Id> NgramIndex::findPrefix(QStringView query) const
+{
+    auto needle = query.toString().toLower();
+
+    std::vector<Id> result;
+    for (auto it = this->sortedKeys_.lower_bound(needle);
+         it != this->sortedKeys_.end() && it->first.startsWith(needle); ++it)
+    {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+std::vector<NgramIndex::Id> NgramIndex::findSubstring(QStringView query) const
+{
+    auto needle = query.toString().toLower();
+
+    std::vector<Id> result;
+    if (needle.size() < TRIGRAM_LENGTH)
+    {
+        for (Id id = 0; id < static_cast<Id>(this->entries_.size()); id++)
+        {
+            const auto &entry = this->entries_[id];
+            if (entry.alive && entry.key.contains(needle))
+            {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    // Every match contains all trigrams of the query, so it's enough to check
+    // the entries with the rarest one
+    const std::vector<Id> *candidates = nullptr;
+    for (auto gram : trigramsOf(needle))
+    {
+        auto it = this->trigrams_.find(gram);
+        if (it == this->trigrams_.end())
+        {
+            return result;
+        }
+        if (candidates == nullptr || it->second.size() < candidates->size())
+        {
+            candidates = &it->second;
+        }
+    }
+
+    for (auto id : *candidates)
+    {
+        if (this->entries_[id].key.contains(needle))
+        {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+std::vector<NgramIndex::Id> NgramIndex::topK(QStringView query,
+                                             size_t limit) const
+{
+    auto needle = query.toString().toLower();
+    auto matches = this->findSubstring(needle);
+
+    struct Rank {
+        int group;
+        qsizetype pos;
+        qsizetype length;
+        const QString *key;
+    };
+    auto rank = [&](Id id) {
+        const auto &key = this->entries_[id].key;
+        auto pos = key.indexOf(needle);
+        int group = 2;
+        if (pos == 0)
+        {
+            group = key.size() == needle.size() ? 0 : 1;
+        }
+        return Rank{group, pos, key.size(), &key};
+    };
+    auto better = [&](Id a, Id b) {
+        auto ra = rank(a);
+        auto rb = rank(b);
+        if (std::tie(ra.group, ra.pos, ra.length) !=
+            std::tie(rb.group, rb.pos, rb.length))
+        {
+            return std::tie(ra.group, ra.pos, ra.length) <
+                   std::tie(rb.group, rb.pos, rb.length);
+        }
+        return *ra.key < *rb.key;
+    };
+
+    auto count = std::min(limit, matches.size());
+    std::partial_sort(matches.begin(),
+                      matches.begin() + static_cast<ptrdiff_t>(count),
+                      matches.end(), better);
+    matches.resize(count);
+    return matches;
+}
+
+void NgramIndex::addTrigrams(Id id)
+{
+    for (auto gram : trigramsOf(this->entries_[id].key))
+    {
+        this->trigrams_[gram].push_back(id);
+    }
+}
+
+void NgramIndex::removeTrigrams(Id id)
+{
+    for (auto gram : trigramsOf(this->entries_[id].key))
+    {
+        auto it = this->trigrams_.find(gram);
+        if (it == this->trigrams_.end())
+        {
+            continue;
+        }
+
+        auto &ids = it->second;
+        auto pos = std::find(ids.begin(), ids.end(), id);
+        if (pos != ids.end())
+        {
+            *pos = ids.back();
+            ids.pop_back();
+        }
+        if (ids.empty())
+        {
+            this->trigrams_.erase(it);
+        }
+    }
+}
+
+}  // namespace chatterino
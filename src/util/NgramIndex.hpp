@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+/// A case-insensitive index of strings for prefix and substring queries.
+///
+/// Entries can be added and removed one at a time, so the index can be kept
+/// up to date with a list that changes often (e.g. recent chatters) instead
+/// of being rebuilt.
+///
+/// Prefix queries use a sorted map of the lowercase keys. Substring queries
+/// look up the trigrams of the query and only check the entries of the
+/// smallest posting list. Queries shorter than a trigram check all entries.
+class NgramIndex
+{
+public:
+    using Id = uint32_t;
+
+    /// Adds `text` to the index and returns its id.
+    /// Ids of removed entries are reused.
+    Id insert(const QString &text);
+    /// Removes the entry. Does nothing if `id` isn't in the index.
+    void remove(Id id);
+    /// Replaces the text of an entry with one that has the same lowercase key
+    /// (e.g. a user name with different casing)
+    void setText(Id id, const QString &text);
+    void clear();
+
+    /// Number of entries
+    size_t size() const;
+    bool contains(Id id) const;
+
+    /// The text as it was inserted
+    const QString &text(Id id) const;
+    /// The lowercase text that's matched against queries
+    const QString &key(Id id) const;
+
+    /// Ids of all entries whose key starts with `query` (case-insensitive),
+    /// sorted by key
+    std::vector<Id> findPrefix(QStringView query) const;
+    /// Ids of all entries whose key contains `query` (case-insensitive) in
+    /// no particular order
+    std::vector<Id> findSubstring(QStringView query) const;
+
+    /// Returns the `limit` best matches for `query`.
+    ///
+    /// Exact matches come first, then prefix matches and then other
+    /// substring matches. Matches in the same group are ordered by the
+    /// position of the match, their length and finally alphabetically.
+    std::vector<Id> topK(QStringView query, size_t limit) const;
+
+private:
+    struct Entry {
+        QString text;
+        QString key;
+        bool alive = false;
+    };
+
+    void addTrigrams(Id id);
+    void removeTrigrams(Id id);
+
+    std::vector<Entry> entries_;
+    std::vector<Id> freeIds_;
+    size_t size_ = 0;
+
+    std::multimap<QString, Id> sortedKeys_;
+    std::unordered_map<uint64_t, std::vector<Id>> trigrams_;
+};
+
+}  // namespace chatterino
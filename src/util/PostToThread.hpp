@@ -4,6 +4,8 @@
 
 #include <QCoreApplication>
 
+#include <memory>
+
 namespace chatterino {
 
 // Taken from
@@ -46,6 +48,26 @@ static void runInGuiThread(F &&fun)
     }
 }
 
+/// Returns a pointer to the same object that hands its reference to the GUI
+/// thread when it's released.
+///
+/// Objects that must be destroyed on the GUI thread (like channels) can be
+/// held with this on other threads, in case theirs is the last reference.
+template <typename T>
+std::shared_ptr<T> releaseInGuiThread(std::shared_ptr<T> ptr)
+{
+    if (!ptr || isGuiThread())
+    {
+        return ptr;
+    }
+
+    auto *raw = ptr.get();
+    return std::shared_ptr<T>(
+        raw, [ptr = std::move(ptr)](T * /*unused*/) mutable {
+            postToThread([ptr = std::move(ptr)] {});
+        });
+}
+
 template <typename F>
 inline void postToGuiThread(F &&fun)
 {
@@ -1,5 +1,7 @@
 #include "util/RapidjsonHelpers.hpp"
 
+#include <QJsonArray>
+#include <QJsonObject>
 #include <rapidjson/prettywriter.h>
 
 namespace chatterino {
@@ -28,6 +30,95 @@ namespace rj {
         return buffer.GetString();
     }
 
+    const rapidjson::Value &member(const rapidjson::Value &obj,
+                                   const char *key)
+    {
+        static const rapidjson::Value null;
+
+        if (!obj.IsObject())
+        {
+            return null;
+        }
+
+        auto it = obj.FindMember(key);
+        if (it == obj.MemberEnd())
+        {
+            return null;
+        }
+
+        return it->value;
+    }
+
+    rapidjson::Value::ConstArray memberArray(const rapidjson::Value &obj,
+                                             const char *key)
+    {
+        static const rapidjson::Value empty(rapidjson::kArrayType);
+
+        const auto &value = member(obj, key);
+        if (!value.IsArray())
+        {
+            return empty.GetArray();
+        }
+
+        return value.GetArray();
+    }
+
+    QString toQString(const rapidjson::Value &value)
+    {
+        if (!value.IsString())
+        {
+            return {};
+        }
+
+        return QString::fromUtf8(
+            value.GetString(), static_cast<qsizetype>(value.GetStringLength()));
+    }
+
+    QJsonValue toQJsonValue(const rapidjson::Value &value)
+    {
+        switch (value.GetType())
+        {
+            case rapidjson::kNullType:
+                return QJsonValue::Null;
+            case rapidjson::kFalseType:
+                return false;
+            case rapidjson::kTrueType:
+                return true;
+            case rapidjson::kStringType:
+                return QString::fromUtf8(
+                    value.GetString(),
+                    static_cast<qsizetype>(value.GetStringLength()));
+            case rapidjson::kNumberType:
+                if (value.IsInt64())
+                {
+                    return static_cast<qint64>(value.GetInt64());
+                }
+                return value.GetDouble();
+            case rapidjson::kArrayType: {
+                QJsonArray array;
+                for (const auto &item : value.GetArray())
+                {
+                    array.append(toQJsonValue(item));
+                }
+                return array;
+            }
+            case rapidjson::kObjectType: {
+                QJsonObject object;
+                for (const auto &member : value.GetObject())
+                {
+                    object.insert(
+                        QString::fromUtf8(member.name.GetString(),
+                                          static_cast<qsizetype>(
+                                              member.name.GetStringLength())),
+                        toQJsonValue(member.value));
+                }
+                return object;
+            }
+        }
+
+        return QJsonValue::Undefined;
+    }
+
     bool getSafeObject(rapidjson::Value &obj, const char *key,
                        rapidjson::Value &out)
     {
@@ -3,6 +3,7 @@
 #include "util/RapidJsonSerializeQString.hpp"
 
 #include <pajlada/serialize.hpp>
+#include <QJsonValue>
 #include <rapidjson/document.h>
 
 #include <cassert>
@@ -97,5 +98,25 @@ namespace rj {
 
     QString stringify(const rapidjson::Value &value);
 
+    /// Returns the member `key` of `obj`.
+    ///
+    /// A null value is returned if `obj` isn't an object or doesn't have the
+    /// member, so lookups can be chained without checks in between.
+    const rapidjson::Value &member(const rapidjson::Value &obj,
+                                   const char *key);
+
+    /// Returns the array member `key` of `obj` or an empty array
+    rapidjson::Value::ConstArray memberArray(const rapidjson::Value &obj,
+                                             const char *key);
+
+    /// Returns the string `value` or an empty string if it isn't a string
+    QString toQString(const rapidjson::Value &value);
+
+    /// Converts a rapidjson value to its Qt equivalent.
+    ///
+    /// Use this to hand over the parts of a document that are consumed as Qt
+    /// JSON, instead of parsing the whole document with QJsonDocument.
+    QJsonValue toQJsonValue(const rapidjson::Value &value);
+
 }  // namespace rj
 }  // namespace chatterino
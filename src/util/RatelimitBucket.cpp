@@ -14,9 +14,20 @@ RatelimitBucket::RatelimitBucket(int budget, int cooldown,
 {
 }
 
-void RatelimitBucket::send(QString channel)
+void RatelimitBucket::send(QString channel, bool prioritized)
 {
-    this->queue_.append(channel);
+    if (prioritized)
+    {
+        this->queue_.removeAll(channel);
+        if (!this->priorityQueue_.contains(channel))
+        {
+            this->priorityQueue_.append(channel);
+        }
+    }
+    else
+    {
+        this->queue_.append(channel);
+    }
 
     if (this->budget_ > 0)
     {
@@ -26,12 +37,13 @@ void RatelimitBucket::send(QString channel)
 
 void RatelimitBucket::handleOne()
 {
-    if (queue_.isEmpty())
+    if (priorityQueue_.isEmpty() && queue_.isEmpty())
     {
         return;
     }
 
-    auto item = queue_.takeFirst();
+    auto item = priorityQueue_.isEmpty() ? queue_.takeFirst()
+                                         : priorityQueue_.takeFirst();
 
     this->budget_--;
     callback_(item);
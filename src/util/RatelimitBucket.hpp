@@ -14,7 +14,15 @@ public:
     RatelimitBucket(int budget, int cooldown,
                     std::function<void(QString)> callback, QObject *parent);
 
-    void send(QString channel);
+    /**
+     * @brief Queue `channel` for the callback.
+     *
+     * Prioritized entries are handled before all other queued entries (in
+     * the order they were sent). Sending an entry that is already queued
+     * with a lower priority moves it to the prioritized queue. Entries that
+     * are already prioritized are only queued once.
+     **/
+    void send(QString channel, bool prioritized = false);
 
 private:
     /**
@@ -28,6 +36,7 @@ private:
     const int cooldown_;
 
     std::function<void(QString)> callback_;
+    QList<QString> priorityQueue_;
     QList<QString> queue_;
 
     /**
@@ -80,6 +80,11 @@ void Scrollbar::replaceHighlight(size_t index, ScrollbarHighlight replacement)
     this->highlights_[index] = std::move(replacement);
 }
 
+void Scrollbar::setHighlightLimit(size_t limit)
+{
+    this->highlights_.rset_capacity(limit);
+}
+
 void Scrollbar::clearHighlights()
 {
     this->highlights_.clear();
@@ -93,6 +93,10 @@ public:
         const std::vector<ScrollbarHighlight> &highlights_);
     void replaceHighlight(size_t index, ScrollbarHighlight replacement);
 
+    /// Sets how many highlights are kept. If there are more, the first ones
+    /// are removed.
+    void setHighlightLimit(size_t limit);
+
     void clearHighlights();
 
     void scrollToBottom(bool animate = false);
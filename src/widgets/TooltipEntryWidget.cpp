@@ -1,5 +1,9 @@
 #include "widgets/TooltipEntryWidget.hpp"
 
+#include "Application.hpp"
+#include "singletons/Emotes.hpp"
+#include "singletons/helper/GifTimer.hpp"
+
 #include <QVBoxLayout>
 
 namespace chatterino {
@@ -105,6 +109,11 @@ bool TooltipEntryWidget::refreshPixmap()
     }
     this->displayImage_->show();
 
+    if (auto nextFrame = this->image_->nextFrameChange())
+    {
+        getApp()->getEmotes()->getGIFTimer().requestFrame(*nextFrame);
+    }
+
     return true;
 }
 
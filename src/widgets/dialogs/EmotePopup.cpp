@@ -6,6 +6,8 @@
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "debug/Benchmark.hpp"
 #include "messages/Emote.hpp"
+#include "messages/Image.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
@@ -16,10 +18,11 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "singletons/Emotes.hpp"
+#include "singletons/Fonts.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
-#include "util/Helpers.hpp"
 #include "widgets/helper/ChannelView.hpp"
+#include "widgets/helper/EmoteGridModel.hpp"
 #include "widgets/helper/TrimRegExpValidator.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/Scrollbar.hpp"
@@ -29,8 +32,11 @@
 #include <QRegularExpression>
 #include <QStringBuilder>
 #include <QTabWidget>
+#include <QTimer>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -44,97 +50,106 @@ auto makeTitleMessage(const QString &title)
     return builder.release();
 }
 
-auto makeEmoteMessage(std::vector<EmotePtr> emotes,
-                      const MessageElementFlag &emoteFlag)
+auto makeSystemTextMessage(const QString &text)
 {
     MessageBuilder builder;
     builder->flags.set(MessageFlag::Centered);
     builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-    if (emotes.empty())
-    {
-        builder.emplace<TextElement>("no emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        return builder.release();
-    }
-
-    std::sort(emotes.begin(), emotes.end(), [](const auto &l, const auto &r) {
-        return compareEmoteStrings(l->name.string, r->name.string);
-    });
-    for (const auto &emote : emotes)
-    {
-        builder
-            .emplace<EmoteElement>(
-                emote,
-                MessageElementFlags{MessageElementFlag::AlwaysShow, emoteFlag})
-            ->setLink(Link(Link::InsertText, emote->name.string));
-    }
-
+    builder.emplace<TextElement>(text, MessageElementFlag::Text,
+                                 MessageColor::System);
     return builder.release();
 }
 
-auto makeEmoteMessage(const EmoteMap &map, const MessageElementFlag &emoteFlag)
+MessagePtr makeRowMessage(const EmoteGridModel &model,
+                          const EmoteGridModel::Row &row)
 {
-    if (map.empty())
+    const auto &section = model.sections()[row.section];
+    if (row.isTitle)
     {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        return builder.release();
+        return makeTitleMessage(section.title);
     }
-
-    std::vector<EmotePtr> vec;
-    vec.reserve(map.size());
-    for (const auto &[_name, ptr] : map)
+    if (row.begin == row.end)
     {
-        vec.emplace_back(ptr);
+        return makeSystemTextMessage("no emotes available");
     }
-    return makeEmoteMessage(std::move(vec), emoteFlag);
-}
 
-auto makeEmojiMessage(const std::vector<EmojiPtr> &emojiMap)
-{
     MessageBuilder builder;
     builder->flags.set(MessageFlag::Centered);
     builder->flags.set(MessageFlag::DisableCompactEmotes);
 
-    for (const auto &value : emojiMap)
+    const auto &matches = model.matches(row.section);
+    for (auto i = row.begin; i < row.end; i++)
     {
+        const auto &item = section.items[matches[i]];
         builder
             .emplace<EmoteElement>(
-                value->emote,
+                item.emote,
                 MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                    MessageElementFlag::EmojiAll})
-            ->setLink(
-                Link(Link::Type::InsertText, ":" + value->shortCodes[0] + ":"));
+                                    section.flag})
+            ->setLink(Link(Link::InsertText, item.insertText));
     }
 
     return builder.release();
 }
 
-void addEmotes(Channel &channel, auto &&emotes, const QString &title,
-               const MessageElementFlag &emoteFlag)
+/// The width an emote of `model` takes up in `view`, including the space
+/// after it.
+///
+/// Emotes have different widths. The median is used, so a few wide emotes
+/// don't make all rows narrower - their row wraps instead.
+int emoteCellWidth(const ChannelView &view, const EmoteGridModel &model)
+{
+    auto scale = view.scale();
+    auto metrics =
+        getApp()->getFonts()->getFontMetrics(FontStyle::ChatMedium, scale);
+    auto spaceWidth = metrics.horizontalAdvance(' ');
+
+    std::vector<int> widths;
+    for (size_t i = 0; i < model.sections().size(); i++)
+    {
+        const auto &items = model.sections()[i].items;
+        for (auto index : model.matches(i))
+        {
+            const auto &image = items[index].emote->images.getImage1();
+            if (image && !image->isEmpty())
+            {
+                widths.push_back(image->width());
+            }
+        }
+    }
+    if (widths.empty())
+    {
+        return metrics.height() + spaceWidth;
+    }
+
+    auto median = widths.begin() + static_cast<ptrdiff_t>(widths.size() / 2);
+    std::nth_element(widths.begin(), median, widths.end());
+    auto emoteScale = getSettings()->emoteScale.getValue();
+    return static_cast<int>(static_cast<float>(*median) * scale *
+                            emoteScale) +
+           spaceWidth;
+}
+
+size_t columnsForView(const ChannelView &view, int cellWidth)
 {
-    channel.addMessage(makeTitleMessage(title), MessageContext::Original);
-    channel.addMessage(
-        makeEmoteMessage(std::forward<decltype(emotes)>(emotes), emoteFlag),
-        MessageContext::Original);
+    // Views in the popup almost always scroll, so the width with the
+    // scrollbar is used to not make rows wrap once it's shown
+    return EmoteGridModel::columnsForWidth(
+        view.getScrolledLayoutWidth() -
+            MessageLayoutContainer::horizontalMargin(view.scale()),
+        cellWidth);
 }
 
 void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
                         const std::shared_ptr<const TwitchEmoteSetMap> &sets,
-                        Channel &globalChannel, Channel &subChannel,
+                        EmoteGridModel &globalModel, EmoteGridModel &subModel,
                         const QString &currentChannelID,
                         const QString &channelName)
 {
     if (!local->empty())
     {
-        addEmotes(subChannel, *local, channelName % u" (Follower)",
-                  MessageElementFlag::TwitchEmote);
+        subModel.addSection(channelName % u" (Follower)", *local,
+                            MessageElementFlag::TwitchEmote);
     }
 
     std::vector<
@@ -146,8 +161,8 @@ void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
         if (set.owner->id == currentChannelID)
         {
             // Put current channel emotes at the top
-            addEmotes(subChannel, set.emotes, set.title(),
-                      MessageElementFlag::TwitchEmote);
+            subModel.addSection(set.title(), set.emotes,
+                                MessageElementFlag::TwitchEmote);
         }
         else
         {
@@ -161,60 +176,12 @@ void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
 
     for (const auto &[title, set] : sortedSets)
     {
-        addEmotes(set.get().isSubLike ? subChannel : globalChannel,
-                  set.get().emotes, title, MessageElementFlag::TwitchEmote);
+        (set.get().isSubLike ? subModel : globalModel)
+            .addSection(title, set.get().emotes,
+                        MessageElementFlag::TwitchEmote);
     }
 }
 
-void loadEmojis(ChannelView &view, const std::vector<EmojiPtr> &emojiMap)
-{
-    ChannelPtr emojiChannel(new Channel("", Channel::Type::None));
-    emojiChannel->addMessage(makeEmojiMessage(emojiMap),
-                             MessageContext::Original);
-
-    view.setChannel(emojiChannel);
-}
-
-void loadEmojis(Channel &channel, const std::vector<EmojiPtr> &emojiMap,
-                const QString &title)
-{
-    channel.addMessage(makeTitleMessage(title), MessageContext::Original);
-    channel.addMessage(makeEmojiMessage(emojiMap), MessageContext::Original);
-}
-
-// Create an emote
-EmoteMap filterEmoteMap(const QString &text,
-                        const std::shared_ptr<const EmoteMap> &emotes)
-{
-    EmoteMap filteredMap;
-
-    for (const auto &emote : *emotes)
-    {
-        if (emote.first.string.contains(text, Qt::CaseInsensitive))
-        {
-            filteredMap.insert(emote);
-        }
-    }
-
-    return filteredMap;
-}
-
-std::vector<EmotePtr> filterEmoteVec(const QString &text,
-                                     const std::vector<EmotePtr> &emotes)
-{
-    std::vector<EmotePtr> filtered;
-
-    for (const auto &emote : emotes)
-    {
-        if (emote->name.string.contains(text, Qt::CaseInsensitive))
-        {
-            filtered.emplace_back(emote);
-        }
-    }
-
-    return filtered;
-}
-
 }  // namespace
 
 namespace chatterino {
@@ -282,20 +249,47 @@ EmotePopup::EmotePopup(QWidget *parent)
         return view;
     };
 
-    this->searchView_ = makeView("", false);
-    this->searchView_->hide();
-    layout->addWidget(this->searchView_);
+    auto initGrid = [this](GridView &grid, ChannelView *view,
+                           const EmoteGridModel &model,
+                           QString emptyText = {}) {
+        grid.view = view;
+        grid.model = &model;
+        grid.emptyText = std::move(emptyText);
+
+        // The views are resized when they're shown for the first time
+        view->installEventFilter(this);
+        // We can safely ignore this signal connection since the scrollbar is
+        // destroyed with the view
+        std::ignore = view->getScrollBar().getCurrentValueChanged().connect(
+            [this, &grid] {
+                // The scrollbar can't be changed while it emits this
+                if (!grid.buildQueued)
+                {
+                    grid.buildQueued = true;
+                    QTimer::singleShot(0, this, [this, &grid] {
+                        grid.buildQueued = false;
+                        this->buildVisibleRows(grid);
+                    });
+                }
+            });
+    };
+
+    initGrid(this->searchGrid_, makeView("", false), this->searchModel_);
+    this->searchGrid_.view->hide();
+    layout->addWidget(this->searchGrid_.view);
 
     layout->addWidget(this->notebook_);
     layout->setContentsMargins(0, 0, 0, 0);
 
-    this->subEmotesView_ = makeView("Subs");
-    this->channelEmotesView_ = makeView("Channel");
-    this->globalEmotesView_ = makeView("Global");
-    this->viewEmojis_ = makeView("Emojis");
+    initGrid(this->subGrid_, makeView("Subs"), this->subModel_,
+             "no subscription emotes available");
+    initGrid(this->channelGrid_, makeView("Channel"), this->channelModel_);
+    initGrid(this->globalGrid_, makeView("Global"), this->globalModel_);
+    initGrid(this->emojiGrid_, makeView("Emojis"), this->emojiModel_);
 
-    loadEmojis(*this->viewEmojis_,
-               getApp()->getEmotes()->getEmojis()->getEmojis());
+    this->emojiModel_.addEmojiSection(
+        "Emojis", getApp()->getEmotes()->getEmojis()->getEmojis());
+    this->showGrid(this->emojiGrid_);
     this->addShortcuts();
     this->signalHolder_.managedConnect(getApp()->getHotkeys()->onItemsUpdated,
                                        [this]() {
@@ -416,6 +410,7 @@ void EmotePopup::loadChannel(ChannelPtr channel)
 
     this->channel_ = std::move(channel);
     this->twitchChannel_ = dynamic_cast<TwitchChannel *>(this->channel_.get());
+    this->searchModelDirty_ = true;
 
     this->setWindowTitle("Emotes in #" + this->channel_->getName());
 
@@ -424,13 +419,6 @@ void EmotePopup::loadChannel(ChannelPtr channel)
         return;
     }
 
-    this->globalEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-    this->subEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-    this->channelEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-
     this->reloadEmotes();
 }
 
@@ -441,53 +429,56 @@ void EmotePopup::reloadEmotes()
         return;
     }
 
-    auto subChannel = this->subEmotesView_->underlyingChannel();
-    auto globalChannel = this->globalEmotesView_->underlyingChannel();
-    auto channelChannel = this->channelEmotesView_->underlyingChannel();
-
-    subChannel->clearMessages();
-    globalChannel->clearMessages();
-    channelChannel->clearMessages();
+    this->subModel_.clear();
+    this->globalModel_.clear();
+    this->channelModel_.clear();
+    this->searchModelDirty_ = true;
 
     // twitch
     addTwitchEmoteSets(
         twitchChannel_->localTwitchEmotes(),
         *getApp()->getAccounts()->twitch.getCurrent()->accessEmoteSets(),
-        *globalChannel, *subChannel, twitchChannel_->roomId(),
+        this->globalModel_, this->subModel_, twitchChannel_->roomId(),
         twitchChannel_->getName());
 
     // global
     if (Settings::instance().enableBTTVGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getBttvEmotes()->emotes(),
-                  "BetterTTV", MessageElementFlag::BttvEmote);
+        this->globalModel_.addSection("BetterTTV",
+                                      *getApp()->getBttvEmotes()->emotes(),
+                                      MessageElementFlag::BttvEmote);
     }
     if (Settings::instance().enableFFZGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getFfzEmotes()->emotes(),
-                  "FrankerFaceZ", MessageElementFlag::FfzEmote);
+        this->globalModel_.addSection("FrankerFaceZ",
+                                      *getApp()->getFfzEmotes()->emotes(),
+                                      MessageElementFlag::FfzEmote);
     }
     if (Settings::instance().enableSevenTVGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getSeventvEmotes()->globalEmotes(),
-                  "7TV", MessageElementFlag::SevenTVEmote);
+        this->globalModel_.addSection(
+            "7TV", *getApp()->getSeventvEmotes()->globalEmotes(),
+            MessageElementFlag::SevenTVEmote);
     }
 
     // channel
     if (Settings::instance().enableBTTVChannelEmotes)
     {
-        addEmotes(*channelChannel, *this->twitchChannel_->bttvEmotes(),
-                  "BetterTTV", MessageElementFlag::BttvEmote);
+        this->channelModel_.addSection("BetterTTV",
+                                       *this->twitchChannel_->bttvEmotes(),
+                                       MessageElementFlag::BttvEmote);
     }
     if (Settings::instance().enableFFZChannelEmotes)
     {
-        addEmotes(*channelChannel, *this->twitchChannel_->ffzEmotes(),
-                  "FrankerFaceZ", MessageElementFlag::FfzEmote);
+        this->channelModel_.addSection("FrankerFaceZ",
+                                       *this->twitchChannel_->ffzEmotes(),
+                                       MessageElementFlag::FfzEmote);
     }
     if (Settings::instance().enableSevenTVChannelEmotes)
     {
-        addEmotes(*channelChannel, *this->twitchChannel_->seventvEmotes(),
-                  "7TV", MessageElementFlag::SevenTVEmote);
+        this->channelModel_.addSection("7TV",
+                                       *this->twitchChannel_->seventvEmotes(),
+                                       MessageElementFlag::SevenTVEmote);
     }
 
     // personal
@@ -495,124 +486,190 @@ void EmotePopup::reloadEmotes()
          getApp()->getSeventvPersonalEmotes()->getEmoteSetsForUser(
              getApp()->getAccounts()->twitch.getCurrent()->getUserId()))
     {
-        addEmotes(*subChannel, *map, "7TV", MessageElementFlag::SevenTVEmote);
+        this->subModel_.addSection("7TV", *map,
+                                   MessageElementFlag::SevenTVEmote);
     }
 
-    if (subChannel->getMessageSnapshot().size() == 0)
+    this->showEmoteModels();
+
+    if (!this->search_->text().isEmpty())
     {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no subscription emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        subChannel->addMessage(builder.release(), MessageContext::Original);
+        this->filterEmotes(this->search_->text());
     }
 }
 
-bool EmotePopup::eventFilter(QObject *object, QEvent *event)
+void EmotePopup::showEmoteModels()
 {
-    if (object == this->search_ && event->type() == QEvent::KeyPress)
-    {
-        auto *keyEvent = dynamic_cast<QKeyEvent *>(event);
-        if (keyEvent == QKeySequence::DeleteStartOfWord &&
-            this->search_->selectionLength() > 0)
-        {
-            this->search_->backspace();
-            return true;
-        }
-    }
-    return false;
+    this->showGrid(this->subGrid_);
+    this->showGrid(this->channelGrid_);
+    this->showGrid(this->globalGrid_);
 }
 
-void EmotePopup::filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                                    const QString &searchText)
+void EmotePopup::showGrid(GridView &grid)
 {
-    if (this->twitchChannel_)
+    grid.cellWidth = emoteCellWidth(*grid.view, *grid.model);
+    grid.columns = columnsForView(*grid.view, grid.cellWidth);
+
+    grid.rows = grid.model->rows(grid.columns);
+    // The channel only keeps scrollbackSplitLimit messages. If there are more
+    // rows, multiple rows are put into one message.
+    auto limit = static_cast<size_t>(
+        std::max(getSettings()->scrollbackSplitLimit.getValue(), 1));
+    for (size_t rowsPerMessage = 2; grid.rows.size() > limit;
+         rowsPerMessage++)
     {
-        auto local = filterEmoteMap(searchText,
-                                    this->twitchChannel_->localTwitchEmotes());
-        if (!local.empty())
-        {
-            addEmotes(*searchChannel, local,
-                      this->twitchChannel_->getName() % u" (Follower)",
-                      MessageElementFlag::TwitchEmote);
-        }
+        grid.rows = grid.model->rows(grid.columns * rowsPerMessage);
+    }
 
-        for (const auto &[_id, set] :
-             **getApp()->getAccounts()->twitch.getCurrent()->accessEmoteSets())
-        {
-            auto filtered = filterEmoteVec(searchText, set.emotes);
-            if (!filtered.empty())
-            {
-                addEmotes(*searchChannel, std::move(filtered), set.title(),
-                          MessageElementFlag::TwitchEmote);
-            }
-        }
+    grid.channel = std::make_shared<Channel>("", Channel::Type::None);
+    grid.builtRows = 0;
+    if (grid.rows.empty() && !grid.emptyText.isEmpty())
+    {
+        grid.channel->addMessage(makeSystemTextMessage(grid.emptyText),
+                                 MessageContext::Repost);
     }
+    grid.view->setChannel(grid.channel);
 
-    auto bttvGlobalEmotes =
-        filterEmoteMap(searchText, getApp()->getBttvEmotes()->emotes());
-    auto ffzGlobalEmotes =
-        filterEmoteMap(searchText, getApp()->getFfzEmotes()->emotes());
-    auto seventvGlobalEmotes = filterEmoteMap(
-        searchText, getApp()->getSeventvEmotes()->globalEmotes());
+    this->buildVisibleRows(grid);
+}
 
-    // global
-    if (!bttvGlobalEmotes.empty())
+void EmotePopup::buildVisibleRows(GridView &grid)
+{
+    if (!grid.channel || grid.builtRows >= grid.rows.size())
     {
-        addEmotes(*searchChannel, bttvGlobalEmotes, "BetterTTV (Global)",
-                  MessageElementFlag::BttvEmote);
+        return;
     }
-    if (!ffzGlobalEmotes.empty())
+
+    // The page size is only known once the view was laid out. Until then,
+    // assume rows are about as high as an emote is wide.
+    auto &scrollbar = grid.view->getScrollBar();
+    auto pageSize =
+        std::max(scrollbar.getPageSize(),
+                 qreal(grid.view->height()) / std::max(grid.cellWidth, 1));
+    // Build one page ahead so scrolling doesn't reach the end right away
+    auto target = std::min(
+        static_cast<size_t>(scrollbar.getCurrentValue() + 2 * pageSize) + 1,
+        grid.rows.size());
+
+    for (; grid.builtRows < target; grid.builtRows++)
     {
-        addEmotes(*searchChannel, ffzGlobalEmotes, "FrankerFaceZ (Global)",
-                  MessageElementFlag::FfzEmote);
+        grid.channel->addMessage(
+            makeRowMessage(*grid.model, grid.rows[grid.builtRows]),
+            MessageContext::Repost);
     }
-    if (!seventvGlobalEmotes.empty())
+}
+
+void EmotePopup::updateColumns(GridView &grid)
+{
+    if (!grid.channel)
     {
-        addEmotes(*searchChannel, seventvGlobalEmotes, "7TV (Global)",
-                  MessageElementFlag::SevenTVEmote);
+        return;
     }
 
-    if (this->twitchChannel_ == nullptr)
+    if (columnsForView(*grid.view, grid.cellWidth) != grid.columns)
     {
+        this->showGrid(grid);
         return;
     }
 
-    auto bttvChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->bttvEmotes());
-    auto ffzChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->ffzEmotes());
-    auto seventvChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->seventvEmotes());
+    // The view might show more rows than before
+    this->buildVisibleRows(grid);
+}
 
-    // channel
-    if (!bttvChannelEmotes.empty())
+bool EmotePopup::eventFilter(QObject *object, QEvent *event)
+{
+    if (event->type() == QEvent::Resize)
     {
-        addEmotes(*searchChannel, bttvChannelEmotes, "BetterTTV (Channel)",
-                  MessageElementFlag::BttvEmote);
+        for (auto *grid : {&this->subGrid_, &this->channelGrid_,
+                           &this->globalGrid_, &this->emojiGrid_,
+                           &this->searchGrid_})
+        {
+            if (object == grid->view)
+            {
+                this->updateColumns(*grid);
+            }
+        }
+        return false;
     }
-    if (!ffzChannelEmotes.empty())
+
+    if (object == this->search_ && event->type() == QEvent::KeyPress)
     {
-        addEmotes(*searchChannel, ffzChannelEmotes, "FrankerFaceZ (Channel)",
-                  MessageElementFlag::FfzEmote);
+        auto *keyEvent = dynamic_cast<QKeyEvent *>(event);
+        if (keyEvent == QKeySequence::DeleteStartOfWord &&
+            this->search_->selectionLength() > 0)
+        {
+            this->search_->backspace();
+            return true;
+        }
     }
-    if (!seventvChannelEmotes.empty())
+    return false;
+}
+
+void EmotePopup::buildSearchModel()
+{
+    this->searchModel_.clear();
+    this->searchModelDirty_ = false;
+
+    // true in special channels like /mentions
+    if (this->channel_->isTwitchChannel())
     {
-        addEmotes(*searchChannel, seventvChannelEmotes, "7TV (Channel)",
-                  MessageElementFlag::SevenTVEmote);
+        this->addTwitchSearchSections();
     }
 
-    for (const auto &map :
-         getApp()->getSeventvPersonalEmotes()->getEmoteSetsForUser(
-             getApp()->getAccounts()->twitch.getCurrent()->getUserId()))
+    this->searchModel_.addEmojiSection(
+        "Emojis", getApp()->getEmotes()->getEmojis()->getEmojis());
+}
+
+void EmotePopup::addTwitchSearchSections()
+{
+    if (this->twitchChannel_ != nullptr)
     {
-        auto seventvPersonalEmotes = filterEmoteMap(searchText, map);
-        if (!seventvPersonalEmotes.empty())
+        const auto &local = *this->twitchChannel_->localTwitchEmotes();
+        if (!local.empty())
         {
-            addEmotes(*searchChannel, seventvPersonalEmotes,
-                      "SevenTV (Personal)", MessageElementFlag::SevenTVEmote);
+            this->searchModel_.addSection(
+                this->twitchChannel_->getName() % u" (Follower)", local,
+                MessageElementFlag::TwitchEmote);
+        }
+
+        for (const auto &[_id, set] :
+             **getApp()->getAccounts()->twitch.getCurrent()->accessEmoteSets())
+        {
+            this->searchModel_.addSection(set.title(), set.emotes,
+                                          MessageElementFlag::TwitchEmote);
+        }
+    }
+
+    // global
+    this->searchModel_.addSection("BetterTTV (Global)",
+                                  *getApp()->getBttvEmotes()->emotes(),
+                                  MessageElementFlag::BttvEmote);
+    this->searchModel_.addSection("FrankerFaceZ (Global)",
+                                  *getApp()->getFfzEmotes()->emotes(),
+                                  MessageElementFlag::FfzEmote);
+    this->searchModel_.addSection(
+        "7TV (Global)", *getApp()->getSeventvEmotes()->globalEmotes(),
+        MessageElementFlag::SevenTVEmote);
+
+    if (this->twitchChannel_ != nullptr)
+    {
+        // channel
+        this->searchModel_.addSection("BetterTTV (Channel)",
+                                      *this->twitchChannel_->bttvEmotes(),
+                                      MessageElementFlag::BttvEmote);
+        this->searchModel_.addSection("FrankerFaceZ (Channel)",
+                                      *this->twitchChannel_->ffzEmotes(),
+                                      MessageElementFlag::FfzEmote);
+        this->searchModel_.addSection("7TV (Channel)",
+                                      *this->twitchChannel_->seventvEmotes(),
+                                      MessageElementFlag::SevenTVEmote);
+
+        for (const auto &map :
+             getApp()->getSeventvPersonalEmotes()->getEmoteSetsForUser(
+                 getApp()->getAccounts()->twitch.getCurrent()->getUserId()))
+        {
+            this->searchModel_.addSection("SevenTV (Personal)", *map,
+                                          MessageElementFlag::SevenTVEmote);
         }
     }
 }
@@ -622,40 +679,23 @@ void EmotePopup::filterEmotes(const QString &searchText)
     if (searchText.length() == 0)
     {
         this->notebook_->show();
-        this->searchView_->hide();
+        this->searchGrid_.view->hide();
 
         return;
     }
-    auto searchChannel = std::make_shared<Channel>("", Channel::Type::None);
 
-    // true in special channels like /mentions
-    if (this->channel_->isTwitchChannel())
-    {
-        this->filterTwitchEmotes(searchChannel, searchText);
-    }
-
-    std::vector<EmojiPtr> filteredEmojis{};
-    int emojiCount = 0;
-
-    const auto &emojis = getApp()->getEmotes()->getEmojis()->getEmojis();
-    for (const auto &emoji : emojis)
-    {
-        if (emoji->shortCodes[0].contains(searchText, Qt::CaseInsensitive))
-        {
-            filteredEmojis.push_back(emoji);
-            emojiCount++;
-        }
-    }
-    // emojis
-    if (emojiCount > 0)
+    // The index is only built once per reload, every keystroke after that
+    // just filters it
+    if (this->searchModelDirty_)
     {
-        loadEmojis(*searchChannel, filteredEmojis, "Emojis");
+        this->buildSearchModel();
     }
+    this->searchModel_.setFilter(searchText);
 
-    this->searchView_->setChannel(searchChannel);
+    this->showGrid(this->searchGrid_);
 
     this->notebook_->hide();
-    this->searchView_->show();
+    this->searchGrid_.view->show();
 }
 
 void EmotePopup::saveBounds() const
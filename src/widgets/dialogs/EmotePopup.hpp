@@ -1,10 +1,14 @@
 #pragma once
 
 #include "widgets/BasePopup.hpp"
+#include "widgets/helper/EmoteGridModel.hpp"
 
 #include <pajlada/signals/signal.hpp>
 #include <QLineEdit>
 
+#include <memory>
+#include <vector>
+
 namespace chatterino {
 
 struct Link;
@@ -30,15 +34,36 @@ protected:
     void moveEvent(QMoveEvent *event) override;
 
 private:
-    ChannelView *globalEmotesView_{};
-    ChannelView *channelEmotesView_{};
-    ChannelView *subEmotesView_{};
-    ChannelView *viewEmojis_{};
+    /// A view showing the rows of a model.
+    ///
+    /// Rows are only turned into messages once they're scrolled close to the
+    /// visible range.
+    struct GridView {
+        ChannelView *view{};
+        const EmoteGridModel *model{};
+        /// Shown if the model has no rows
+        QString emptyText;
+
+        ChannelPtr channel;
+        std::vector<EmoteGridModel::Row> rows;
+        /// Number of `rows` that were added to `channel`
+        size_t builtRows = 0;
+        /// Number of emotes per row
+        size_t columns = 1;
+        /// Width of an emote in the view including its spacing
+        int cellWidth = 1;
+        bool buildQueued = false;
+    };
+
+    GridView globalGrid_;
+    GridView channelGrid_;
+    GridView subGrid_;
+    GridView emojiGrid_;
     /**
      * @brief Visible only when the user has specified a search query into the `search_` input.
      * Otherwise the `notebook_` and all other views are visible.
      */
-    ChannelView *searchView_{};
+    GridView searchGrid_;
 
     ChannelPtr channel_;
     TwitchChannel *twitchChannel_{};
@@ -46,9 +71,28 @@ private:
     QLineEdit *search_;
     Notebook *notebook_;
 
-    void filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                            const QString &searchText);
+    EmoteGridModel subModel_;
+    EmoteGridModel channelModel_;
+    EmoteGridModel globalModel_;
+    EmoteGridModel emojiModel_;
+    /// Contains all emotes, built on the first search after a reload
+    EmoteGridModel searchModel_;
+    bool searchModelDirty_ = true;
+
+    void buildSearchModel();
+    /// Adds the Twitch, BTTV, FFZ and 7TV emotes to the search model
+    void addTwitchSearchSections();
     void filterEmotes(const QString &text);
+    /// Shows the subscriber, channel and global models in their views
+    void showEmoteModels();
+
+    /// Splits the model of `grid` into rows for the width of its view and
+    /// shows the first rows
+    void showGrid(GridView &grid);
+    /// Adds the rows close to the visible range of `grid` to its channel
+    void buildVisibleRows(GridView &grid);
+    /// Re-splits the rows of `grid` if the number of columns changed
+    void updateColumns(GridView &grid);
     void addShortcuts() override;
     bool eventFilter(QObject *object, QEvent *event) override;
 
@@ -7,7 +7,8 @@
 #include "controllers/commands/Command.hpp"
 #include "controllers/commands/CommandController.hpp"
 #include "controllers/filters/FilterSet.hpp"
-#include "debug/Benchmark.hpp"
+#include "debug/StartupTimeline.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/layouts/MessageLayout.hpp"
@@ -15,6 +16,7 @@
 #include "messages/layouts/MessageLayoutElement.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageArchive.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/MessageThread.hpp"
@@ -24,12 +26,15 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/Emotes.hpp"
+#include "singletons/helper/GifTimer.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
+#include "util/DebugCount.hpp"
 #include "util/DistanceBetweenPoints.hpp"
 #include "util/Helpers.hpp"
 #include "util/IncognitoBrowser.hpp"
@@ -67,6 +72,7 @@
 #include <chrono>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
 
 namespace {
@@ -77,6 +83,11 @@ using namespace chatterino;
 
 constexpr int SCROLLBAR_PADDING = 8;
 
+/// Number of archived messages loaded when scrolling to the top
+constexpr size_t ARCHIVE_PAGE_SIZE = 100;
+/// Maximum number of archived messages a view shows at once
+constexpr size_t MAX_ARCHIVED_MESSAGES = 5000;
+
 void addEmoteContextMenuItems(QMenu *menu, const Emote &emote,
                               MessageElementFlags creatorFlags)
 {
@@ -303,6 +314,7 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
     , scrollBar_(new Scrollbar(messagesLimit, this))
     , highlightAnimation_(this)
     , context_(context)
+    , messagesLimit_(messagesLimit)
     , messages_(messagesLimit)
     , tooltipWidget_(new TooltipWidget(this))
 {
@@ -399,6 +411,16 @@ void ChannelView::initializeScrollbar()
         {
             this->layoutQueued_ = true;
         }
+
+        // The scrollbar can't be changed while it emits this
+        if (!this->archiveUpdateQueued_)
+        {
+            this->archiveUpdateQueued_ = true;
+            QTimer::singleShot(0, this, [this] {
+                this->archiveUpdateQueued_ = false;
+                this->updateArchivedMessages();
+            });
+        }
     });
 }
 
@@ -407,7 +429,7 @@ void ChannelView::initializeSignals()
     this->signalHolder_.managedConnect(getApp()->getWindows()->wordFlagsChanged,
                                        [this] {
                                            this->queueLayout();
-                                           this->update();
+                                           this->queueUpdate();
                                        });
 
     getSettings()->showLastMessageIndicator.connect(
@@ -418,10 +440,7 @@ void ChannelView::initializeSignals()
 
     this->signalHolder_.managedConnect(
         getApp()->getWindows()->gifRepaintRequested, [&] {
-            if (!this->animationArea_.isEmpty())
-            {
-                this->queueUpdate(this->animationArea_);
-            }
+            this->repaintAnimatedAreas();
         });
 
     this->signalHolder_.managedConnect(
@@ -622,12 +641,106 @@ void ChannelView::scaleChangedEvent(float scale)
 
 void ChannelView::queueUpdate()
 {
-    this->update();
+    this->queueUpdate(this->rect());
 }
 
 void ChannelView::queueUpdate(const QRect &area)
 {
-    this->update(area);
+    if (this->isHiddenFromUser())
+    {
+        // The view is repainted once it's shown
+        return;
+    }
+
+    this->queuedUpdate_ += area;
+    this->scheduleFrame();
+}
+
+void ChannelView::runScheduledFrame()
+{
+    this->frameScheduled_ = false;
+
+    if (this->isHiddenFromUser())
+    {
+        // showEvent performs the layout if one is queued
+        this->queuedUpdate_ = {};
+        return;
+    }
+
+    if (this->layoutQueued_)
+    {
+        this->performLayout();
+    }
+
+    if (!this->queuedUpdate_.isEmpty())
+    {
+        this->update(this->queuedUpdate_);
+        this->queuedUpdate_ = {};
+    }
+}
+
+bool ChannelView::isHiddenFromUser() const
+{
+    return !this->isVisible() || this->window()->isMinimized();
+}
+
+void ChannelView::scheduleFrame()
+{
+    if (this->frameScheduled_)
+    {
+        DebugCount::increase("coalesced view updates");
+        return;
+    }
+
+    this->frameScheduled_ = true;
+    getApp()->getWindows()->scheduleViewFrame(this);
+}
+
+void ChannelView::repaintAnimatedAreas()
+{
+    if (this->animatedAreas_.empty())
+    {
+        return;
+    }
+
+    // Hidden views repaint everything once they're shown again
+    if (!this->isVisible() || this->window()->isMinimized())
+    {
+        this->animatedAreas_.clear();
+        return;
+    }
+
+    auto position = getApp()->getEmotes()->getGIFTimer().position();
+
+    bool anyDue = false;
+    for (const auto &area : this->animatedAreas_)
+    {
+        if (area.nextFrame <= position)
+        {
+            // The paint updates the deadline of the area
+            this->queueUpdate(area.rect);
+            anyDue = true;
+        }
+    }
+
+    if (!anyDue)
+    {
+        this->requestNextAnimationFrame();
+    }
+}
+
+void ChannelView::requestNextAnimationFrame()
+{
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (const auto &area : this->animatedAreas_)
+    {
+        next = std::min(next, area.nextFrame);
+    }
+
+    if (next != std::numeric_limits<uint64_t>::max())
+    {
+        getApp()->getEmotes()->getGIFTimer().requestFrame(next);
+    }
 }
 
 void ChannelView::invalidateBuffers()
@@ -638,13 +751,11 @@ void ChannelView::invalidateBuffers()
 
 void ChannelView::queueLayout()
 {
-    if (this->isVisible())
-    {
-        this->performLayout();
-    }
-    else
+    this->layoutQueued_ = true;
+
+    if (!this->isHiddenFromUser())
     {
-        this->layoutQueued_ = true;
+        this->scheduleFrame();
     }
 }
 
@@ -658,7 +769,7 @@ void ChannelView::showEvent(QShowEvent * /*event*/)
 
 void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
 {
-    // BenchmarkGuard benchmark("layout");
+    trace::Span span(trace::category::LAYOUT, "ChannelView::performLayout");
 
     this->layoutQueued_ = false;
 
@@ -788,7 +899,10 @@ void ChannelView::clearMessages()
 {
     // Clear all stored messages in this chat widget
     this->messages_.clear();
+    this->messages_.setLimit(this->messagesLimit_);
+    this->archivedMessages_ = 0;
     this->scrollBar_->clearHighlights();
+    this->scrollBar_->setHighlightLimit(this->messagesLimit_);
     this->scrollBar_->resetBounds();
     this->scrollBar_->setMaximum(0);
     this->scrollBar_->setMinimum(0);
@@ -1163,21 +1277,7 @@ void ChannelView::messageAppended(MessagePtr &message,
 
     if (this->messages_.pushBack(messageRef))
     {
-        if (this->paused())
-        {
-            this->pauseScrollMinimumOffset_++;
-            this->pauseSelectionOffset_++;
-        }
-        else
-        {
-            this->scrollBar_->offsetMinimum(1);
-            if (this->showingLatestMessages_ && !this->isVisible())
-            {
-                this->scrollBar_->scrollToBottom(false);
-            }
-            this->selection_.shiftMessageIndex(1);
-            this->doubleClickSelection_.shiftMessageIndex(1);
-        }
+        this->messagesRemovedFromStart(1);
     }
 
     if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
@@ -1207,6 +1307,17 @@ void ChannelView::messageAppended(MessagePtr &message,
 }
 
 void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
+{
+    // The messages go before the archived ones
+    if (this->archivedMessages_ > 0)
+    {
+        this->releaseArchivedMessages();
+    }
+
+    this->insertMessagesAtStart(messages);
+}
+
+void ChannelView::insertMessagesAtStart(const std::vector<MessagePtr> &messages)
 {
     std::vector<MessageLayoutPtr> messageRefs;
     messageRefs.resize(messages.size());
@@ -1260,6 +1371,9 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
 
 void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
 {
+    // The index is one of channel_
+    index += this->archivedMessages_;
+
     auto oMessage = this->messages_.get(index);
     if (!oMessage)
     {
@@ -1287,7 +1401,10 @@ void ChannelView::messagesUpdated()
     auto snapshot = this->channel_->getMessageSnapshot();
 
     this->messages_.clear();
+    this->messages_.setLimit(this->messagesLimit_);
+    this->archivedMessages_ = 0;
     this->scrollBar_->clearHighlights();
+    this->scrollBar_->setHighlightLimit(this->messagesLimit_);
     this->scrollBar_->resetBounds();
     this->scrollBar_->setMaximum(qreal(snapshot.size()));
     this->scrollBar_->setMinimum(0);
@@ -1320,6 +1437,101 @@ void ChannelView::messagesUpdated()
     this->queueLayout();
 }
 
+void ChannelView::messagesRemovedFromStart(size_t count)
+{
+    if (this->paused())
+    {
+        this->pauseScrollMinimumOffset_ += static_cast<int>(count);
+        this->pauseSelectionOffset_ += static_cast<uint32_t>(count);
+    }
+    else
+    {
+        this->scrollBar_->offsetMinimum(qreal(count));
+        if (this->showingLatestMessages_ && !this->isVisible())
+        {
+            this->scrollBar_->scrollToBottom(false);
+        }
+        this->selection_.shiftMessageIndex(count);
+        this->doubleClickSelection_.shiftMessageIndex(count);
+    }
+}
+
+void ChannelView::updateArchivedMessages()
+{
+    if (this->scrollBar_->isAtBottom())
+    {
+        if (this->archivedMessages_ > 0)
+        {
+            this->releaseArchivedMessages();
+        }
+        return;
+    }
+
+    if (this->scrollBar_->getRelativeCurrentValue() < 1)
+    {
+        this->loadArchivedMessages();
+    }
+}
+
+void ChannelView::loadArchivedMessages()
+{
+    // Only splits show all messages of the underlying channel with its
+    // scrollback limit, so only they continue where the channel stopped
+    if (this->split_ == nullptr || !this->underlyingChannel_ ||
+        !this->getFilterIds().empty())
+    {
+        return;
+    }
+
+    auto *archive = this->underlyingChannel_->getArchive();
+    if (archive == nullptr ||
+        this->archivedMessages_ >= MAX_ARCHIVED_MESSAGES ||
+        this->messages_.getSnapshot().size() <
+            this->messagesLimit_ + this->archivedMessages_)
+    {
+        return;
+    }
+
+    // The first archivedMessages_ messages of this view are the newest
+    // messages of the archive
+    auto end = archive->endSeq();
+    if (end <= this->archivedMessages_)
+    {
+        return;
+    }
+    end -= this->archivedMessages_;
+    auto count = std::min<uint64_t>({
+        static_cast<uint64_t>(ARCHIVE_PAGE_SIZE),
+        static_cast<uint64_t>(MAX_ARCHIVED_MESSAGES - this->archivedMessages_),
+        end,
+    });
+
+    auto messages = archive->materialize(end - count, end);
+    if (messages.empty())
+    {
+        return;
+    }
+
+    this->archivedMessages_ += messages.size();
+    this->messages_.setLimit(this->messagesLimit_ + this->archivedMessages_);
+    this->scrollBar_->setHighlightLimit(this->messagesLimit_ +
+                                        this->archivedMessages_);
+    this->insertMessagesAtStart(messages);
+}
+
+void ChannelView::releaseArchivedMessages()
+{
+    this->archivedMessages_ = 0;
+    this->scrollBar_->setHighlightLimit(this->messagesLimit_);
+
+    auto removed = this->messages_.setLimit(this->messagesLimit_);
+    if (removed > 0)
+    {
+        this->messagesRemovedFromStart(removed);
+        this->queueLayout();
+    }
+}
+
 void ChannelView::updateLastReadMessage()
 {
     if (auto lastMessage = this->messages_.last())
@@ -1342,7 +1554,7 @@ void ChannelView::resizeEvent(QResizeEvent * /*event*/)
 
     this->queueLayout();
 
-    this->update();
+    this->queueUpdate();
 }
 
 void ChannelView::setSelection(const Selection &newSelection)
@@ -1512,7 +1724,22 @@ void ChannelView::scrollToMessageLayout(MessageLayout *layout,
 
 void ChannelView::paintEvent(QPaintEvent *event)
 {
-    //    BenchmarkGuard benchmark("paint");
+    trace::Span span(trace::category::PAINT, "ChannelView::paintEvent");
+
+    // Qt can paint before the next frame (e.g. when the window is resized)
+    if (this->layoutQueued_)
+    {
+        this->performLayout();
+    }
+
+    if (this->underlyingChannel_)
+    {
+        if (auto *archive = this->underlyingChannel_->getArchive())
+        {
+            // Archives of channels that aren't looked at are dropped first
+            archive->markViewed();
+        }
+    }
 
     QPainter painter(this);
 
@@ -1544,6 +1771,7 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         return;
     }
 
+    std::vector<AnimatedImageArea> animatedAreas;
     MessageLayout *end = nullptr;
 
     MessagePaintContext ctx = {
@@ -1563,10 +1791,9 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         .messageIndex = start,
         .isLastReadMessage = false,
 
+        .animatedAreas = &animatedAreas,
     };
     bool showLastMessageIndicator = getSettings()->showLastMessageIndicator;
-
-    QRect animationArea;
     auto areaContainsY = [&area](auto y) {
         return y >= area.y() && y < area.y() + area.height();
     };
@@ -1588,21 +1815,8 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
             areaContainsY(ctx.y + layout->getHeight()) ||
             (ctx.y < area.y() && layout->getHeight() > area.height()))
         {
-            auto paintResult = layout->paint(ctx);
-            if (paintResult.hasAnimatedElements)
-            {
-                if (animationArea.isNull())
-                {
-                    animationArea = QRect{0, ctx.y, layout->getWidth(),
-                                          layout->getHeight()};
-                }
-                else
-                {
-                    animationArea.setBottom(ctx.y + layout->getHeight());
-                    animationArea.setWidth(
-                        std::max(layout->getWidth(), animationArea.width()));
-                }
-            }
+            layout->paint(ctx);
+            startup::markFirstPaint();
 
             if (this->highlightedMessage_ == layout)
             {
@@ -1631,17 +1845,33 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
     // This happens for example when hovering over the go-to-bottom button.
     if (this->height() <= area.height())
     {
-        this->animationArea_ = animationArea;
+        this->animatedAreas_ = std::move(animatedAreas);
     }
-#ifdef FOURTF
     else
     {
+        // The repainted images show a new frame now
+        for (const auto &painted : animatedAreas)
+        {
+            if (!area.intersects(painted.rect))
+            {
+                continue;
+            }
+            for (auto &shown : this->animatedAreas_)
+            {
+                if (shown.image == painted.image && shown.rect == painted.rect)
+                {
+                    shown.nextFrame = painted.nextFrame;
+                }
+            }
+        }
+#ifdef FOURTF
         // shows the updated area on partial repaints
         painter.setPen(Qt::red);
         painter.drawRect(area.x(), area.y(), area.width() - 1,
                          area.height() - 1);
-    }
 #endif
+    }
+    this->requestNextAnimationFrame();
 
     if (end == nullptr)
     {
@@ -3021,12 +3251,17 @@ int ChannelView::getLayoutWidth() const
 {
     if (this->scrollBar_->isVisible())
     {
-        return int(this->width() - SCROLLBAR_PADDING * this->scale());
+        return this->getScrolledLayoutWidth();
     }
 
     return this->width();
 }
 
+int ChannelView::getScrolledLayoutWidth() const
+{
+    return int(this->width() - SCROLLBAR_PADDING * this->scale());
+}
+
 void ChannelView::selectWholeMessage(MessageLayout *layout, int &messageIndex)
 {
     SelectionItem msgStart(messageIndex,
@@ -15,6 +15,7 @@
 #include <QMenu>
 #include <QPaintEvent>
 #include <QPointer>
+#include <QRegion>
 #include <QScroller>
 #include <QTimer>
 #include <QVariantAnimation>
@@ -97,9 +98,15 @@ public:
                          Context context = Context::None,
                          size_t messagesLimit = 1000);
 
+    /// Repaints the view (or `area`) with the next display frame
     void queueUpdate();
     void queueUpdate(const QRect &area);
+    /// Runs the layout and repaint queued for this frame.
+    /// This is called by the WindowManager.
+    void runScheduledFrame();
     Scrollbar &getScrollBar();
+    /// The width messages are laid out with while the scrollbar is shown
+    int getScrolledLayoutWidth() const;
 
     QString getSelectedText();
     bool hasSelection();
@@ -267,10 +274,24 @@ private:
     void messageAppended(MessagePtr &message,
                          std::optional<MessageFlags> overridingFlags);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
+    void insertMessagesAtStart(const std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
+    /// Keeps the scroll position and selections on the same messages after
+    /// `count` messages were removed from the start
+    void messagesRemovedFromStart(size_t count);
     void messageReplaced(size_t index, MessagePtr &replacement);
     void messagesUpdated();
 
+    /// Loads archived messages of the channel (see MessageArchive) when
+    /// scrolled to the top and drops them again when scrolled to the bottom
+    void updateArchivedMessages();
+    void loadArchivedMessages();
+    void releaseArchivedMessages();
+
+    /// Whether layouts and repaints of this view can be skipped until it's
+    /// shown again
+    bool isHiddenFromUser() const;
+    void scheduleFrame();
     void performLayout(bool causedByScrollbar = false,
                        bool causedByShow = false);
     void layoutVisibleMessages(
@@ -279,6 +300,11 @@ private:
                          bool causedByScrollbar, bool causedByShow);
 
     void drawMessages(QPainter &painter, const QRect &area);
+    /// Repaints the animated images whose frame changed
+    void repaintAnimatedAreas();
+    /// Asks the GIFTimer to repaint once the next frame of an animated image
+    /// is due
+    void requestNextAnimationFrame();
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     void setSelection(const Selection &newSelection);
     void selectWholeMessage(MessageLayout *layout, int &messageIndex);
@@ -316,13 +342,17 @@ private:
 
     bool layoutQueued_ = false;
     bool bufferInvalidationQueued_ = false;
+    /// Set while this view waits for a frame of the WindowManager
+    bool frameScheduled_ = false;
+    /// The area to repaint in the next frame
+    QRegion queuedUpdate_;
 
     bool lastMessageHasAlternateBackground_ = false;
     bool lastMessageHasAlternateBackgroundReverse_ = true;
 
-    /// Tracks the area of animated elements in the last full repaint.
-    /// If this is empty (QRect::isEmpty()), no animated element is shown.
-    QRect animationArea_;
+    /// The animated images of the last full repaint and when they show their
+    /// next frame. If this is empty, no animated image is shown.
+    std::vector<AnimatedImageArea> animatedAreas_;
 
     bool pausable_ = false;
     QTimer pauseTimer_;
@@ -420,7 +450,14 @@ private:
 
     const Context context_;
 
+    /// The number of messages shown without archived messages
+    const size_t messagesLimit_;
     LimitedQueue<MessageLayoutPtr> messages_;
+    /// Number of messages before the first message of channel_. These are
+    /// the newest archived messages of the underlying channel: the ones
+    /// loaded by loadArchivedMessages and the ones evicted since then.
+    size_t archivedMessages_ = 0;
+    bool archiveUpdateQueued_ = false;
 
     pajlada::Signals::SignalHolder signalHolder_;
 
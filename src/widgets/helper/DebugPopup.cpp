@@ -1,15 +1,73 @@
 #include "widgets/helper/DebugPopup.hpp"
 
+#include "Application.hpp"
 #include "common/Literals.hpp"
+#include "debug/Trace.hpp"
+#include "providers/bttv/BttvLiveUpdates.hpp"
+#include "providers/seventv/SeventvEventAPI.hpp"
 #include "util/Clipboard.hpp"
 #include "util/DebugCount.hpp"
 
+#include <QCheckBox>
+#include <QFileDialog>
 #include <QFontDatabase>
+#include <QHBoxLayout>
 #include <QLabel>
+#include <QMessageBox>
 #include <QPushButton>
 #include <QTimer>
 #include <QVBoxLayout>
 
+#include <chrono>
+
+namespace {
+
+using namespace chatterino;
+using namespace literals;
+
+/// Lists the open connections of a live-update manager
+template <typename Manager>
+void appendConnectionStats(QString &text, QStringView name,
+                           const Manager *manager)
+{
+    if (manager == nullptr)
+    {
+        return;
+    }
+
+    auto stats = manager->connectionStats();
+    text += u"\n%1 connections: %2 (opened: %3, closed: %4, failed: %5)"_s
+                .arg(name)
+                .arg(stats.size())
+                .arg(manager->diag.connectionsOpened.load())
+                .arg(manager->diag.connectionsClosed.load())
+                .arg(manager->diag.connectionsFailed.load());
+    for (const auto &connection : stats)
+    {
+        auto uptime = std::chrono::duration_cast<std::chrono::seconds>(
+            connection.uptime);
+        text += u"\n  %1/%2 subscriptions, %3 messages, up %4s"_s
+                    .arg(connection.subscriptions)
+                    .arg(connection.maxSubscriptions)
+                    .arg(connection.messagesReceived)
+                    .arg(uptime.count());
+    }
+}
+
+QString debugText()
+{
+    auto text = DebugCount::getDebugText();
+    if (auto *app = tryGetApp())
+    {
+        appendConnectionStats(text, u"7TV EventAPI", app->getSeventvEventAPI());
+        appendConnectionStats(text, u"BTTV live updates",
+                              app->getBttvLiveUpdates());
+    }
+    return text;
+}
+
+}  // namespace
+
 namespace chatterino {
 
 using namespace literals;
@@ -20,21 +78,45 @@ DebugPopup::DebugPopup()
     auto *text = new QLabel(this);
     auto *timer = new QTimer(this);
     auto *copyButton = new QPushButton(u"&Copy"_s);
+    auto *traceCheckbox = new QCheckBox(u"Record &trace"_s);
+    auto *exportTraceButton = new QPushButton(u"&Export trace..."_s);
 
     QObject::connect(timer, &QTimer::timeout, [text] {
-        text->setText(DebugCount::getDebugText());
+        text->setText(debugText());
     });
     timer->start(300);
-    text->setText(DebugCount::getDebugText());
+    text->setText(debugText());
 
     text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
 
     layout->addWidget(text);
     layout->addWidget(copyButton, 1);
 
+    auto *traceLayout = new QHBoxLayout;
+    traceLayout->addWidget(traceCheckbox);
+    traceLayout->addWidget(exportTraceButton);
+    layout->addLayout(traceLayout);
+
     QObject::connect(copyButton, &QPushButton::clicked, this, [text] {
         crossPlatformCopy(text->text());
     });
+
+    traceCheckbox->setChecked(trace::isEnabled());
+    QObject::connect(traceCheckbox, &QCheckBox::toggled, this,
+                     [](bool checked) {
+                         trace::setEnabled(checked);
+                     });
+    QObject::connect(exportTraceButton, &QPushButton::clicked, this, [this] {
+        auto filePath = QFileDialog::getSaveFileName(
+            this, u"Export trace"_s, u"chatterino-trace.json"_s,
+            u"Chrome trace (*.json)"_s);
+        if (!filePath.isEmpty() && !trace::exportChromeTrace(filePath))
+        {
+            QMessageBox::warning(
+                this, u"Export trace"_s,
+                u"The trace couldn't be written to %1."_s.arg(filePath));
+        }
+    });
 }
 
 }  // namespace chatterino
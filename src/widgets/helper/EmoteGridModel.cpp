@@ -0,0 +1,218 @@
+#include "widgets/helper/EmoteGridModel.hpp"
+
+#include "messages/Emote.hpp"
+#include "messages/MessageElement.hpp"
+#include "providers/emoji/Emojis.hpp"
+#include "util/Helpers.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace chatterino {
+
+void EmoteGridModel::clear()
+{
+    this->sections_.clear();
+    this->matches_.clear();
+    this->filter_.clear();
+}
+
+void EmoteGridModel::addSection(const QString &title,
+                                std::vector<EmotePtr> emotes,
+                                MessageElementFlag flag)
+{
+    std::sort(emotes.begin(), emotes.end(), [](const auto &l, const auto &r) {
+        return compareEmoteStrings(l->name.string, r->name.string);
+    });
+
+    std::vector<Item> items;
+    items.reserve(emotes.size());
+    for (auto &emote : emotes)
+    {
+        auto name = emote->name.string;
+        items.push_back({
+            .emote = std::move(emote),
+            .insertText = name,
+            .searchKey = name.toLower(),
+        });
+    }
+
+    this->addItems(title, std::move(items), flag);
+}
+
+void EmoteGridModel::addSection(const QString &title, const EmoteMap &emotes,
+                                MessageElementFlag flag)
+{
+    std::vector<EmotePtr> vec;
+    vec.reserve(emotes.size());
+    for (const auto &[_name, ptr] : emotes)
+    {
+        vec.emplace_back(ptr);
+    }
+    this->addSection(title, std::move(vec), flag);
+}
+
+void EmoteGridModel::addEmojiSection(const QString &title,
+                                     const std::vector<EmojiPtr> &emojis)
+{
+    std::vector<Item> items;
+    items.reserve(emojis.size());
+    for (const auto &emoji : emojis)
+    {
+        const auto &shortCode = emoji->shortCodes[0];
+        items.push_back({
+            .emote = emoji->emote,
+            .insertText = ":" + shortCode + ":",
+            .searchKey = shortCode.toLower(),
+        });
+    }
+
+    this->addItems(title, std::move(items), MessageElementFlag::EmojiAll);
+}
+
+void EmoteGridModel::addItems(const QString &title, std::vector<Item> items,
+                              MessageElementFlag flag)
+{
+    auto needle = this->filter_.toLower();
+    std::vector<uint32_t> matches;
+    matches.reserve(items.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); i++)
+    {
+        if (needle.isEmpty() || items[i].searchKey.contains(needle))
+        {
+            matches.push_back(i);
+        }
+    }
+
+    this->sections_.push_back({
+        .title = title,
+        .flag = flag,
+        .items = std::move(items),
+    });
+    this->matches_.emplace_back(std::move(matches));
+}
+
+const std::vector<EmoteGridModel::Section> &EmoteGridModel::sections() const
+{
+    return this->sections_;
+}
+
+size_t EmoteGridModel::itemCount() const
+{
+    size_t count = 0;
+    for (const auto &section : this->sections_)
+    {
+        count += section.items.size();
+    }
+    return count;
+}
+
+void EmoteGridModel::setFilter(const QString &text)
+{
+    auto needle = text.toLower();
+    if (needle == this->filter_.toLower())
+    {
+        this->filter_ = text;
+        return;
+    }
+
+    // Typing narrows the previous query, so only the previous matches can
+    // still match.
+    bool narrowing = !this->filter_.isEmpty() &&
+                     needle.contains(this->filter_.toLower());
+    this->filter_ = text;
+
+    for (size_t i = 0; i < this->sections_.size(); i++)
+    {
+        const auto &items = this->sections_[i].items;
+        auto &matches = this->matches_[i];
+
+        if (needle.isEmpty())
+        {
+            matches.resize(items.size());
+            std::iota(matches.begin(), matches.end(), 0U);
+            continue;
+        }
+
+        if (narrowing)
+        {
+            std::erase_if(matches, [&](uint32_t index) {
+                return !items[index].searchKey.contains(needle);
+            });
+            continue;
+        }
+
+        matches.clear();
+        for (uint32_t j = 0; j < static_cast<uint32_t>(items.size()); j++)
+        {
+            if (items[j].searchKey.contains(needle))
+            {
+                matches.push_back(j);
+            }
+        }
+    }
+}
+
+const QString &EmoteGridModel::filter() const
+{
+    return this->filter_;
+}
+
+const std::vector<uint32_t> &EmoteGridModel::matches(size_t section) const
+{
+    return this->matches_[section];
+}
+
+size_t EmoteGridModel::matchCount() const
+{
+    size_t count = 0;
+    for (const auto &matches : this->matches_)
+    {
+        count += matches.size();
+    }
+    return count;
+}
+
+std::vector<EmoteGridModel::Row> EmoteGridModel::rows(size_t columns) const
+{
+    columns = std::max<size_t>(columns, 1);
+
+    std::vector<Row> rows;
+    for (size_t i = 0; i < this->sections_.size(); i++)
+    {
+        auto count = this->matches_[i].size();
+        if (count == 0 && !this->filter_.isEmpty())
+        {
+            continue;
+        }
+
+        rows.push_back({.section = i, .isTitle = true});
+        if (count == 0)
+        {
+            rows.push_back({.section = i});
+            continue;
+        }
+
+        for (size_t begin = 0; begin < count; begin += columns)
+        {
+            rows.push_back({
+                .section = i,
+                .begin = begin,
+                .end = std::min(begin + columns, count),
+            });
+        }
+    }
+
+    return rows;
+}
+
+size_t EmoteGridModel::columnsForWidth(int availableWidth, int cellWidth)
+{
+    if (availableWidth <= 0 || cellWidth <= 0)
+    {
+        return 1;
+    }
+    return static_cast<size_t>(std::max(availableWidth / cellWidth, 1));
+}
+
+}  // namespace chatterino
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+struct EmojiData;
+using EmojiPtr = std::shared_ptr<EmojiData>;
+class EmoteMap;
+enum class MessageElementFlag : int64_t;
+
+/// The emotes of the emote popup, grouped into titled sections.
+///
+/// The popup used to put all emotes of a section into a single message, so
+/// the whole section was laid out as soon as it was shown. The model splits
+/// sections into rows of a fixed number of columns instead. Rows only become
+/// messages once they're scrolled close to the view, and ChannelView only lays
+/// out the rows that are visible.
+///
+/// The lowercase names are built once when a section is added. Filtering only
+/// does substring checks on them and, if the new query extends the previous
+/// one, only looks at the previous matches.
+class EmoteGridModel
+{
+public:
+    struct Item {
+        EmotePtr emote;
+        /// Inserted into the input when the emote is clicked
+        QString insertText;
+        /// Lowercase name that's matched against the filter
+        QString searchKey;
+    };
+
+    struct Section {
+        QString title;
+        MessageElementFlag flag;
+        std::vector<Item> items;
+    };
+
+    /// A row of the grid: either the title of a section or up to `columns`
+    /// items of it.
+    struct Row {
+        size_t section = 0;
+        bool isTitle = false;
+        /// Indices into `matches(section)`
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    /// Removes all sections and resets the filter
+    void clear();
+
+    /// Adds a section with the emotes sorted by name
+    void addSection(const QString &title, std::vector<EmotePtr> emotes,
+                    MessageElementFlag flag);
+    void addSection(const QString &title, const EmoteMap &emotes,
+                    MessageElementFlag flag);
+    /// Adds a section with the emojis in their original order
+    void addEmojiSection(const QString &title,
+                         const std::vector<EmojiPtr> &emojis);
+
+    const std::vector<Section> &sections() const;
+    /// Number of items in all sections
+    size_t itemCount() const;
+
+    /// Only keeps items whose name contains `text` (case-insensitive).
+    /// An empty `text` shows all items.
+    void setFilter(const QString &text);
+    const QString &filter() const;
+
+    /// Indices of the items in `section` matching the current filter
+    const std::vector<uint32_t> &matches(size_t section) const;
+    /// Number of items matching the current filter
+    size_t matchCount() const;
+
+    /// Splits the matching items into rows of `columns` items.
+    ///
+    /// Sections without items get a title and an empty row if no filter is
+    /// set. With a filter, they're skipped.
+    std::vector<Row> rows(size_t columns) const;
+
+    /// The number of cells of `cellWidth` that fit into `availableWidth`.
+    /// This is at least one.
+    static size_t columnsForWidth(int availableWidth, int cellWidth);
+
+private:
+    void addItems(const QString &title, std::vector<Item> items,
+                  MessageElementFlag flag);
+
+    std::vector<Section> sections_;
+    std::vector<std::vector<uint32_t>> matches_;
+    QString filter_;
+};
+
+}  // namespace chatterino
@@ -4,6 +4,7 @@
 #include "common/Channel.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
+#include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/search/AuthorPredicate.hpp"
 #include "messages/search/BadgePredicate.hpp"
@@ -22,10 +23,43 @@
 #include <QLineEdit>
 #include <QPushButton>
 
+#include <optional>
+
+namespace {
+
+using namespace chatterino;
+
+/// Returns the messages that can match a "from:" predicate in `predicates`
+/// or std::nullopt if there is none
+std::optional<std::vector<MessagePtr>> findAuthorCandidates(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+    const LimitedQueue<MessagePtr> &messages)
+{
+    for (const auto &pred : predicates)
+    {
+        const auto *author = dynamic_cast<const AuthorPredicate *>(pred.get());
+        if (author == nullptr || author->isNegated())
+        {
+            continue;
+        }
+
+        std::vector<QString> keys;
+        for (const auto &name : author->authors())
+        {
+            keys.emplace_back(name.toLower());
+        }
+        return messages.findByKeys(keys);
+    }
+
+    return std::nullopt;
+}
+
+}  // namespace
+
 namespace chatterino {
 
 ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot)
+                               const LimitedQueue<MessagePtr> &messages)
 {
     ChannelPtr channel(new Channel(channelName, Channel::Type::None));
 
@@ -34,28 +68,37 @@ ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
 
     // Check for every message whether it fulfills all predicates that have
     // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
-    {
-        MessagePtr message = snapshot[i];
-
-        bool accept = true;
+    auto addIfAccepted = [&](const MessagePtr &message) {
         for (const auto &pred : predicates)
         {
             // Discard the message as soon as one predicate fails
             if (!pred->appliesTo(*message))
             {
-                accept = false;
-                break;
+                return;
             }
         }
 
         // If all predicates match, add the message to the channel
-        if (accept)
-        {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+        auto overrideFlags = std::optional<MessageFlags>(message->flags);
+        overrideFlags->set(MessageFlag::DoNotLog);
+
+        channel->addMessage(message, MessageContext::Repost, overrideFlags);
+    };
 
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
+    // Messages from specific users can be looked up in the index, all other
+    // searches have to check every message
+    if (auto candidates = findAuthorCandidates(predicates, messages))
+    {
+        for (const auto &message : *candidates)
+        {
+            addIfAccepted(message);
+        }
+    }
+    else
+    {
+        for (const auto &message : messages.getSnapshot())
+        {
+            addIfAccepted(message);
         }
     }
 
@@ -214,22 +257,33 @@ bool SearchPopup::eventFilter(QObject *object, QEvent *event)
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
+    if (!this->messages_ || this->messages_->empty())
     {
-        this->snapshot_ = this->buildSnapshot();
+        this->messages_ = this->buildMessages();
     }
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+    this->channelView_->setChannel(filter(
+        this->searchInput_->text(), this->channelName_, *this->messages_));
 }
 
-LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
+std::unique_ptr<LimitedQueue<MessagePtr>> SearchPopup::buildMessages()
 {
+    auto makeQueue = [](const std::vector<MessagePtr> &messages) {
+        auto queue = std::make_unique<LimitedQueue<MessagePtr>>(
+            std::max<size_t>(messages.size(), 1));
+        queue->pushFront(messages);
+        queue->setIndexKeys([](const MessagePtr &message) {
+            return message->userKeys();
+        });
+        return queue;
+    };
+
     // no point in filtering/sorting if it's a single channel search
     if (this->searchChannels_.length() == 1)
     {
         const auto channelPtr = this->searchChannels_.at(0);
-        return channelPtr.get().channel()->getMessageSnapshot();
+        auto snapshot = channelPtr.get().channel()->getMessageSnapshot();
+        return makeQueue({snapshot.begin(), snapshot.end()});
     }
 
     auto combinedSnapshot = std::vector<std::shared_ptr<const Message>>{};
@@ -241,10 +295,8 @@ LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
         const LimitedQueueSnapshot<MessagePtr> &snapshot =
             sharedView.channel()->getMessageSnapshot();
 
-        // TODO: implement iterator on LimitedQueueSnapshot?
-        for (auto i = 0; i < snapshot.size(); ++i)
+        for (const auto &message : snapshot)
         {
-            const MessagePtr &message = snapshot[i];
             if (filterSet && !filterSet->filter(message, sharedView.channel()))
             {
                 continue;
@@ -275,10 +327,7 @@ LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
                   return a->serverReceivedTime < b->serverReceivedTime;
               });
 
-    auto queue = LimitedQueue<MessagePtr>(combinedSnapshot.size());
-    queue.pushFront(combinedSnapshot);
-
-    return queue.getSnapshot();
+    return makeQueue(combinedSnapshot);
 }
 
 void SearchPopup::initLayout()
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ForwardDecl.hpp"
-#include "messages/LimitedQueueSnapshot.hpp"
+#include "messages/LimitedQueue.hpp"
 #include "widgets/BasePopup.hpp"
 
 #include <memory>
@@ -37,7 +37,9 @@ private:
     void initLayout();
     void search();
     void addShortcuts() override;
-    LimitedQueueSnapshot<MessagePtr> buildSnapshot();
+    /// Collects the messages to search, indexed by the users they're from
+    /// or about (see Message::userKeys)
+    std::unique_ptr<LimitedQueue<MessagePtr>> buildMessages();
 
     /**
      * @brief Only retains those message from a list of messages that satisfy a
@@ -45,14 +47,13 @@ private:
      *
      * @param text          the search query -- will be parsed for MessagePredicates
      * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * @param messages      list of messages to filter
      *
      * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     *         "messages"
      */
     static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot);
+                             const LimitedQueue<MessagePtr> &messages);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -64,7 +65,7 @@ private:
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
         const QString &input);
 
-    LimitedQueueSnapshot<MessagePtr> snapshot_;
+    std::unique_ptr<LimitedQueue<MessagePtr>> messages_;
     QLineEdit *searchInput_{};
     ChannelView *channelView_{};
     QString channelName_{};
@@ -1180,6 +1180,10 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                        s.scrollbackSplitLimit, 100, 100000, 100);
     layout.addIntInput("Usercard scrollback limit (requires restart)",
                        s.scrollbackUsercardLimit, 100, 100000, 100);
+    layout.addIntInput(
+        "Total memory for messages beyond the scrollback limit in MiB, "
+        "shared by all channels (requires restart)",
+        s.scrollbackArchiveMemoryLimit, 0, 1024, 8);
 
     layout.addDropdown<int>(
         "Stack timeouts", {"Stack", "Stack until timeout", "Don't stack"},
@@ -3,6 +3,7 @@
 
 #    include "Application.hpp"
 #    include "common/Args.hpp"
+#    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/PluginController.hpp"
 #    include "singletons/Paths.hpp"
 #    include "singletons/Settings.hpp"
@@ -18,6 +19,8 @@
 #    include <QPushButton>
 #    include <QWidget>
 
+#    include <chrono>
+
 namespace chatterino {
 
 PluginsPage::PluginsPage()
@@ -176,6 +179,26 @@ void PluginsPage::rebuildContent()
         }
         pluginEntry->addRow("Commands",
                             new QLabel(commandsTxt, this->dataFrame_));
+
+        const auto &usage = plugin->usage();
+        auto usageTxt =
+            QString("%1 ms in %2 calls")
+                .arg(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         usage.time)
+                         .count())
+                .arg(usage.calls);
+        if (usage.overBudget > 0)
+        {
+            usageTxt += QString(", %1 over budget").arg(usage.overBudget);
+        }
+        pluginEntry->addRow("Time spent",
+                            new QLabel(usageTxt, this->dataFrame_));
+        if (plugin->meta.worker)
+        {
+            pluginEntry->addRow(
+                "Thread",
+                new QLabel("Runs on its own thread", this->dataFrame_));
+        }
         if (!plugin->meta.permissions.empty())
         {
             QString perms = "<ul>";
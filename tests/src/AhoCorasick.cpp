@@ -0,0 +1,35 @@
+#include "util/AhoCorasick.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(AhoCorasick, findAny)
+{
+    AhoCorasick matcher({"he", "she", "his", "hers", ""});
+
+    EXPECT_EQ(matcher.findAny(u"ushers"), 1U);
+    EXPECT_EQ(matcher.findAny(u"this"), 2U);
+    EXPECT_EQ(matcher.findAny(u"ahem"), 0U);
+    EXPECT_EQ(matcher.findAny(u"hi"), std::nullopt);
+    EXPECT_EQ(matcher.findAny(u""), std::nullopt);
+}
+
+TEST(AhoCorasick, Suffixes)
+{
+    // "abcd" doesn't match, but its suffix "bc" does
+    AhoCorasick matcher({"abcd", "bc"});
+
+    EXPECT_EQ(matcher.findAny(u"xabcx"), 1U);
+    EXPECT_EQ(matcher.findAny(u"abcd"), 1U);
+    EXPECT_EQ(matcher.findAny(u"abd"), std::nullopt);
+}
+
+TEST(AhoCorasick, Empty)
+{
+    AhoCorasick matcher({"", ""});
+
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_EQ(matcher.findAny(u"anything"), std::nullopt);
+    EXPECT_TRUE(AhoCorasick().empty());
+}
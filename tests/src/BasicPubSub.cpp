@@ -67,11 +67,18 @@ struct hash<DummySubscription> {
 class MyManager : public BasicPubSubManager<DummySubscription>
 {
 public:
-    MyManager(QString host)
-        : BasicPubSubManager(std::move(host), "Test")
+    MyManager(QString host, size_t maxSubscriptions = 100,
+              std::chrono::milliseconds rebalanceDelay = 30s)
+        : BasicPubSubManager(std::move(host), "Test", rebalanceDelay)
+        , maxSubscriptions_(maxSubscriptions)
     {
     }
 
+    ~MyManager() override
+    {
+        this->stop();
+    }
+
     std::atomic<int32_t> messagesReceived{0};
 
     std::optional<QString> popMessage()
@@ -98,6 +105,14 @@ public:
     }
 
 protected:
+    std::shared_ptr<BasicPubSubClient<DummySubscription>> createClient(
+        liveupdates::WebsocketClient &client,
+        websocketpp::connection_hdl hdl) override
+    {
+        return std::make_shared<BasicPubSubClient<DummySubscription>>(
+            client, hdl, this->maxSubscriptions_);
+    }
+
     void onMessage(
         websocketpp::connection_hdl /*hdl*/,
         BasicPubSubManager<DummySubscription>::WebsocketMessagePtr msg) override
@@ -109,6 +124,7 @@ protected:
     }
 
 private:
+    size_t maxSubscriptions_;
     std::mutex messageMtx_;
     std::deque<QString> messageQueue_;
 };
@@ -146,3 +162,48 @@ TEST(BasicPubSub, SubscriptionCycle)
     ASSERT_EQ(manager.diag.connectionsFailed, 0);
     ASSERT_EQ(manager.messagesReceived, 2);
 }
+
+TEST(BasicPubSub, Rebalance)
+{
+    const QString host("wss://127.0.0.1:9050/liveupdates/sub-unsub");
+    MyManager manager(host, 2, 100ms);
+    manager.start();
+
+    std::this_thread::sleep_for(50ms);
+    manager.sub({1, "a"});
+    manager.sub({1, "b"});
+    manager.sub({1, "c"});
+    manager.sub({1, "d"});
+    std::this_thread::sleep_for(500ms);
+
+    ASSERT_EQ(manager.diag.connectionsOpened, 2);
+    ASSERT_EQ(manager.diag.connectionsFailed, 0);
+    ASSERT_EQ(manager.messagesReceived, 4);
+    auto stats = manager.connectionStats();
+    ASSERT_EQ(stats.size(), 2U);
+    ASSERT_EQ(stats[0].subscriptions, 2U);
+    ASSERT_EQ(stats[0].maxSubscriptions, 2U);
+    ASSERT_EQ(stats[1].subscriptions, 2U);
+
+    // Leaves one subscription on each connection
+    manager.unsub({1, "a"});
+    manager.unsub({1, "d"});
+    std::this_thread::sleep_for(50ms);
+
+    ASSERT_EQ(manager.diag.connectionsClosed, 0);
+    ASSERT_EQ(manager.messagesReceived, 6);
+
+    std::this_thread::sleep_for(500ms);
+
+    // Both subscriptions fit on one connection
+    ASSERT_EQ(manager.diag.connectionsOpened, 2);
+    ASSERT_EQ(manager.diag.connectionsClosed, 1);
+    ASSERT_EQ(manager.diag.subscriptionsMigrated, 1);
+    stats = manager.connectionStats();
+    ASSERT_EQ(stats.size(), 1U);
+    ASSERT_EQ(stats[0].subscriptions, 2U);
+
+    manager.stop();
+
+    ASSERT_EQ(manager.diag.connectionsClosed, 2);
+}
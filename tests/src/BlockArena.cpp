@@ -0,0 +1,82 @@
+#include "util/BlockArena.hpp"
+
+#include "Test.hpp"
+
+#include <cstdint>
+
+using namespace chatterino;
+
+namespace {
+
+struct alignas(32) OverAligned {
+    char value = 0;
+};
+
+}  // namespace
+
+TEST(BlockArena, Allocate)
+{
+    BlockArena arena(256);
+
+    auto *a = arena.create<int>(1);
+    auto *b = arena.create<double>(2.0);
+    auto *c = arena.create<OverAligned>();
+    EXPECT_EQ(*a, 1);
+    EXPECT_EQ(*b, 2.0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(double), 0U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % alignof(OverAligned), 0U);
+    EXPECT_EQ(arena.blockCount(), 1U);
+
+    // Allocations larger than a block get their own block
+    auto *large = arena.allocate(1000, 8);
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(arena.blockCount(), 2U);
+    EXPECT_GE(arena.capacity(), 1256U);
+}
+
+TEST(BlockArena, Reset)
+{
+    BlockArena arena(128);
+
+    auto fill = [&] {
+        for (int i = 0; i < 100; i++)
+        {
+            arena.create<uint64_t>(i);
+        }
+    };
+
+    fill();
+    auto blockCount = arena.blockCount();
+    auto capacity = arena.capacity();
+    auto used = arena.used();
+    EXPECT_GT(blockCount, 1U);
+    EXPECT_GE(used, 100U * sizeof(uint64_t));
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0U);
+
+    // The blocks are reused
+    fill();
+    EXPECT_EQ(arena.blockCount(), blockCount);
+    EXPECT_EQ(arena.capacity(), capacity);
+    EXPECT_EQ(arena.used(), used);
+}
+
+TEST(BlockArena, Growth)
+{
+    BlockArena arena(64, 256);
+
+    // A few small objects only need the first block
+    arena.create<uint64_t>(1);
+    arena.create<uint64_t>(2);
+    EXPECT_EQ(arena.blockCount(), 1U);
+    EXPECT_EQ(arena.capacity(), 64U);
+
+    // Blocks double in size until they reach the maximum
+    for (int i = 0; i < 100; i++)
+    {
+        arena.create<uint64_t>(i);
+    }
+    EXPECT_EQ(arena.blockCount(), 5U);
+    EXPECT_EQ(arena.capacity(), 64U + 128U + 256U + 256U + 256U);
+}
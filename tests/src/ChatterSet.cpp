@@ -85,3 +85,65 @@ TEST(ChatterSet, MaxSizeLastUsed)
     EXPECT_TRUE(set.contains("pajlada"));
     EXPECT_TRUE(set.contains("Pajlada"));
 }
+
+TEST(ChatterSet, filterByPrefix)
+{
+    ChatterSet set;
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Pajbot");
+    set.addRecentChatter("forsen");
+
+    // most recent chatters first
+    EXPECT_EQ(set.filterByPrefix("PAJ"),
+              (std::vector<QString>{"Pajbot", "pajlada"}));
+
+    set.addRecentChatter("Pajlada");
+    EXPECT_EQ(set.filterByPrefix("paj"),
+              (std::vector<QString>{"Pajlada", "Pajbot"}));
+    EXPECT_TRUE(set.filterByPrefix("jbot").empty());
+}
+
+TEST(ChatterSet, filterBySubstring)
+{
+    ChatterSet set;
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Pajbot");
+    set.addRecentChatter("forsen");
+
+    using Items = std::vector<std::pair<QString, QString>>;
+    EXPECT_EQ(set.filterBySubstring(u"JBO"), (Items{{"pajbot", "Pajbot"}}));
+    EXPECT_EQ(set.filterBySubstring(u"a"),
+              (Items{{"pajbot", "Pajbot"}, {"pajlada", "pajlada"}}));
+    EXPECT_EQ(set.filterBySubstring(u"").size(), 3U);
+}
+
+TEST(ChatterSet, IndexFollowsEviction)
+{
+    ChatterSet set;
+    set.addRecentChatter("pajlada");
+
+    for (auto i = 0; i < ChatterSet::CHATTER_LIMIT; ++i)
+    {
+        set.addRecentChatter(QString("chatter%1").arg(i));
+    }
+
+    EXPECT_FALSE(set.contains("pajlada"));
+    EXPECT_TRUE(set.filterBySubstring(u"jlad").empty());
+    EXPECT_EQ(set.filterBySubstring(u"chatter").size(),
+              ChatterSet::CHATTER_LIMIT);
+    EXPECT_EQ(set.topMatches(u"chatter1999", 5),
+              (std::vector<QString>{"chatter1999"}));
+}
+
+TEST(ChatterSet, IndexFollowsOnlineChatters)
+{
+    ChatterSet set;
+    set.addRecentChatter("pajlada");
+    set.addRecentChatter("Forsen");
+
+    set.updateOnlineChatters({"forsen", "nymn"});
+
+    EXPECT_TRUE(set.filterByPrefix("paj").empty());
+    EXPECT_EQ(set.filterByPrefix("for"), (std::vector<QString>{"Forsen"}));
+    EXPECT_EQ(set.filterByPrefix("nym"), (std::vector<QString>{"nymn"}));
+}
@@ -0,0 +1,70 @@
+#include "util/ConsistentHashRing.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+TEST(ConsistentHashRing, SingleNode)
+{
+    ConsistentHashRing ring(1);
+    EXPECT_EQ(ring.nodeCount(), 1U);
+    EXPECT_EQ(ring.nodeFor("pajlada"), 0U);
+    EXPECT_EQ(ring.nodeFor("forsen"), 0U);
+}
+
+TEST(ConsistentHashRing, Stable)
+{
+    ConsistentHashRing a(4);
+    ConsistentHashRing b(4);
+
+    for (int i = 0; i < 100; i++)
+    {
+        auto key = QString("channel%1").arg(i);
+        EXPECT_EQ(a.nodeFor(key), b.nodeFor(key));
+        EXPECT_LT(a.nodeFor(key), 4U);
+    }
+}
+
+TEST(ConsistentHashRing, Distribution)
+{
+    ConsistentHashRing ring(4);
+    std::vector<int> counts(4);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        counts[ring.nodeFor(QString("channel%1").arg(i))]++;
+    }
+
+    // every node should get a reasonable share of the keys
+    for (auto count : counts)
+    {
+        EXPECT_GT(count, 100);
+    }
+}
+
+TEST(ConsistentHashRing, AddingNodeMovesFewKeys)
+{
+    ConsistentHashRing before(4);
+    ConsistentHashRing after(5);
+
+    int moved = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        auto key = QString("channel%1").arg(i);
+        auto oldNode = before.nodeFor(key);
+        auto newNode = after.nodeFor(key);
+        if (oldNode != newNode)
+        {
+            // keys only move to the new node
+            EXPECT_EQ(newNode, 4U);
+            moved++;
+        }
+    }
+
+    // ~1/5 of the keys should move
+    EXPECT_LT(moved, 350);
+}
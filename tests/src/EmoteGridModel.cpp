@@ -0,0 +1,132 @@
+#include "widgets/helper/EmoteGridModel.hpp"
+
+#include "messages/Emote.hpp"
+#include "messages/MessageElement.hpp"
+#include "Test.hpp"
+
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+EmotePtr namedEmote(const QString &name)
+{
+    return std::shared_ptr<Emote>(new Emote{
+        .name{.string{name}},
+        .images{},
+        .tooltip{},
+        .zeroWidth{},
+        .id{},
+        .author{},
+    });
+}
+
+std::vector<EmotePtr> namedEmotes(const std::vector<QString> &names)
+{
+    std::vector<EmotePtr> emotes;
+    for (const auto &name : names)
+    {
+        emotes.emplace_back(namedEmote(name));
+    }
+    return emotes;
+}
+
+std::vector<QString> matchingNames(const EmoteGridModel &model,
+                                   size_t section)
+{
+    std::vector<QString> names;
+    for (auto index : model.matches(section))
+    {
+        names.emplace_back(
+            model.sections()[section].items[index].emote->name.string);
+    }
+    return names;
+}
+
+}  // namespace
+
+TEST(EmoteGridModel, SortsSections)
+{
+    EmoteGridModel model;
+    model.addSection("BetterTTV", namedEmotes({"b", "C", "a"}),
+                     MessageElementFlag::BttvEmote);
+
+    ASSERT_EQ(model.sections().size(), 1U);
+    ASSERT_EQ(model.itemCount(), 3U);
+    EXPECT_EQ(matchingNames(model, 0), (std::vector<QString>{"a", "b", "C"}));
+    EXPECT_EQ(model.sections()[0].items[2].searchKey, "c");
+    EXPECT_EQ(model.sections()[0].items[2].insertText, "C");
+}
+
+TEST(EmoteGridModel, Filter)
+{
+    EmoteGridModel model;
+    model.addSection("Global", namedEmotes({"Kappa", "KappaPride", "Keepo"}),
+                     MessageElementFlag::TwitchEmote);
+    model.addSection("7TV", namedEmotes({"forsenE", "Okayge"}),
+                     MessageElementFlag::SevenTVEmote);
+
+    model.setFilter("k");
+    EXPECT_EQ(model.matchCount(), 4U);
+    EXPECT_EQ(matchingNames(model, 1), (std::vector<QString>{"Okayge"}));
+
+    // narrowing the query
+    model.setFilter("kAp");
+    EXPECT_EQ(matchingNames(model, 0),
+              (std::vector<QString>{"Kappa", "KappaPride"}));
+    EXPECT_EQ(model.matches(1).size(), 0U);
+
+    model.setFilter("kappap");
+    EXPECT_EQ(matchingNames(model, 0), (std::vector<QString>{"KappaPride"}));
+
+    // widening the query again
+    model.setFilter("e");
+    EXPECT_EQ(matchingNames(model, 0),
+              (std::vector<QString>{"KappaPride", "Keepo"}));
+    EXPECT_EQ(matchingNames(model, 1),
+              (std::vector<QString>{"forsenE", "Okayge"}));
+
+    model.setFilter("");
+    EXPECT_EQ(model.matchCount(), 5U);
+}
+
+TEST(EmoteGridModel, Rows)
+{
+    EmoteGridModel model;
+    model.addSection("A", namedEmotes({"1", "2", "3", "4", "5"}),
+                     MessageElementFlag::BttvEmote);
+    model.addSection("Empty", std::vector<EmotePtr>{},
+                     MessageElementFlag::FfzEmote);
+
+    auto rows = model.rows(2);
+    ASSERT_EQ(rows.size(), 6U);
+    EXPECT_TRUE(rows[0].isTitle);
+    EXPECT_EQ(rows[1].begin, 0U);
+    EXPECT_EQ(rows[1].end, 2U);
+    EXPECT_EQ(rows[3].begin, 4U);
+    EXPECT_EQ(rows[3].end, 5U);
+    // empty sections get a title and a placeholder row
+    EXPECT_TRUE(rows[4].isTitle);
+    EXPECT_EQ(rows[4].section, 1U);
+    EXPECT_FALSE(rows[5].isTitle);
+    EXPECT_EQ(rows[5].begin, rows[5].end);
+
+    // sections without matches are hidden while filtering
+    model.setFilter("3");
+    rows = model.rows(2);
+    ASSERT_EQ(rows.size(), 2U);
+    EXPECT_EQ(rows[1].begin, 0U);
+    EXPECT_EQ(rows[1].end, 1U);
+}
+
+TEST(EmoteGridModel, ColumnsForWidth)
+{
+    EXPECT_EQ(EmoteGridModel::columnsForWidth(0, 32), 1U);
+    EXPECT_EQ(EmoteGridModel::columnsForWidth(300, 0), 1U);
+    EXPECT_EQ(EmoteGridModel::columnsForWidth(20, 32), 1U);
+    EXPECT_EQ(EmoteGridModel::columnsForWidth(300, 32), 9U);
+    EXPECT_EQ(EmoteGridModel::columnsForWidth(320, 32), 10U);
+}
@@ -0,0 +1,69 @@
+#include "util/GuiThreadBatch.hpp"
+
+#include "Test.hpp"
+
+#include <QCoreApplication>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(GuiThreadBatch, RunsInOrderInOneFlush)
+{
+    GuiThreadBatch batch;
+    std::vector<int> ran;
+
+    std::thread poster([&] {
+        for (int i = 0; i < 100; i++)
+        {
+            batch.post([&ran, i] {
+                ran.push_back(i);
+            });
+        }
+    });
+    poster.join();
+
+    ASSERT_TRUE(ran.empty());
+    QCoreApplication::sendPostedEvents();
+
+    ASSERT_EQ(ran.size(), 100U);
+    for (size_t i = 0; i < ran.size(); i++)
+    {
+        ASSERT_EQ(ran[i], static_cast<int>(i));
+    }
+    ASSERT_EQ(batch.flushCount(), 1U);
+}
+
+TEST(GuiThreadBatch, PostWhileFlushing)
+{
+    GuiThreadBatch batch;
+    int ran = 0;
+
+    batch.post([&] {
+        ran++;
+        // Posted during a flush, so it's scheduled in a new batch
+        batch.post([&] {
+            ran++;
+        });
+    });
+
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::sendPostedEvents();
+    ASSERT_EQ(ran, 2);
+    ASSERT_EQ(batch.flushCount(), 2U);
+}
+
+TEST(GuiThreadBatch, OutlivesOwner)
+{
+    int ran = 0;
+    {
+        GuiThreadBatch batch;
+        batch.post([&] {
+            ran++;
+        });
+    }
+
+    QCoreApplication::sendPostedEvents();
+    ASSERT_EQ(ran, 1);
+}
@@ -1,6 +1,8 @@
 #include "controllers/ignores/IgnoreController.hpp"
 
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnoreRules.hpp"
 #include "mocks/BaseApplication.hpp"
 #include "mocks/Emotes.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
@@ -184,3 +186,34 @@ TEST_F(TestIgnoreController, processIgnorePhrases)
             << "' and output '" << message << "'";
     }
 }
+
+TEST(IgnoreRules, findBlock)
+{
+    auto block = [](const QString &pattern, bool isRegex,
+                    bool isCaseSensitive) {
+        return IgnorePhrase(pattern, isRegex, true, {}, isCaseSensitive);
+    };
+
+    IgnoreRules rules({
+        block("forsen", false, false),
+        block("Kappa", false, true),
+        block("^!\\w+$", true, false),
+        block("(invalid", true, false),
+        block("", false, false),
+        IgnorePhrase("replaced", false, false, "***", false),
+    });
+
+    ASSERT_NE(rules.findBlock("I like FORSEN a lot"), nullptr);
+    ASSERT_EQ(rules.findBlock("I like FORSEN a lot")->getPattern(), "forsen");
+    ASSERT_NE(rules.findBlock("Kappa 123"), nullptr);
+    ASSERT_EQ(rules.findBlock("kappa 123"), nullptr);
+    ASSERT_NE(rules.findBlock("!command"), nullptr);
+    ASSERT_EQ(rules.findBlock("!command with arguments"), nullptr);
+    ASSERT_EQ(rules.findBlock("(invalid"), nullptr);
+    ASSERT_EQ(rules.findBlock("this gets replaced"), nullptr);
+    ASSERT_EQ(rules.findBlock("hello"), nullptr);
+    ASSERT_EQ(rules.findBlock(""), nullptr);
+
+    ASSERT_EQ(rules.replacePhrases().size(), 1U);
+    ASSERT_EQ(rules.replacePhrases()[0].getPattern(), "replaced");
+}
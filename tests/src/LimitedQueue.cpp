@@ -131,3 +131,182 @@ TEST(LimitedQueue, ReplaceItem)
 
     SNAPSHOT_EQUALS(queue.getSnapshot(), {9, 10, 3}, "first snapshot");
 }
+
+TEST(LimitedQueue, InsertWhenFull)
+{
+    LimitedQueue<int> queue(3);
+    queue.pushBack(1);
+    queue.pushBack(2);
+    queue.pushBack(3);
+
+    // like boost::circular_buffer, the first item makes room
+    EXPECT_TRUE(queue.insertBefore(3, 4));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {2, 4, 3}, "insert before");
+    EXPECT_TRUE(queue.insertAfter(2, 5));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {5, 4, 3}, "insert after");
+
+    // nothing can be inserted in front of the first item
+    EXPECT_TRUE(queue.insertBefore(5, 6));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {5, 4, 3}, "insert at front");
+}
+
+TEST(LimitedQueue, SnapshotIsStable)
+{
+    constexpr int limit = LimitedQueue<int>::MAX_CHUNK_SIZE * 2 + 10;
+    LimitedQueue<int> queue(limit);
+
+    std::vector<int> expected;
+    for (int i = 0; i < limit; ++i)
+    {
+        queue.pushBack(i);
+        expected.push_back(i);
+    }
+
+    auto snapshot = queue.getSnapshot();
+
+    // push enough items to drop the first chunks
+    int deleted = -1;
+    for (int i = limit; i < limit * 2; ++i)
+    {
+        EXPECT_TRUE(queue.pushBack(i, deleted));
+        EXPECT_EQ(deleted, i - limit);
+    }
+    queue.replaceItem(std::size_t(0), -1);
+    queue.replaceItem(limit * 2 - 1, -2);
+    queue.insertAfter(limit + 5, -3);
+
+    SNAPSHOT_EQUALS(snapshot, expected, "old snapshot");
+
+    auto current = queue.getSnapshot();
+    ASSERT_EQ(current.size(), static_cast<size_t>(limit));
+    EXPECT_EQ(current[0], limit + 1);
+    EXPECT_EQ(current[4], limit + 5);
+    EXPECT_EQ(current[5], -3);
+    EXPECT_EQ(current[limit - 1], -2);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    SNAPSHOT_EQUALS(snapshot, expected, "old snapshot after clear");
+    EXPECT_EQ(current[limit - 1], -2);
+}
+
+TEST(LimitedQueue, SnapshotIterators)
+{
+    LimitedQueue<int> queue(3);
+    queue.pushBack(1);
+    queue.pushBack(2);
+    queue.pushBack(3);
+    queue.pushBack(4);
+
+    auto snapshot = queue.getSnapshot();
+    EXPECT_EQ(std::vector<int>(snapshot.begin(), snapshot.end()),
+              (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(std::vector<int>(snapshot.rbegin(), snapshot.rend()),
+              (std::vector<int>{4, 3, 2}));
+    EXPECT_EQ(snapshot.end() - snapshot.begin(), 3);
+
+    LimitedQueueSnapshot<int> empty;
+    EXPECT_EQ(empty.size(), 0U);
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(LimitedQueue, Index)
+{
+    LimitedQueue<int> queue(5);
+    queue.pushBack(1);
+    queue.pushBack(2);
+    queue.pushBack(3);
+
+    // index by parity, odd numbers are also indexed as "odd"
+    queue.setIndexKeys([](const int &item) {
+        std::vector<QString> keys{QString::number(item % 2)};
+        if (item % 2 == 1)
+        {
+            keys.emplace_back("odd");
+        }
+        return keys;
+    });
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{1, 3}));
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{2}));
+    EXPECT_EQ(queue.findByKey("2"), (std::vector<int>{}));
+
+    queue.pushBack(4);
+    queue.pushBack(5);
+    queue.pushBack(7);  // evicts 1
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{3, 5, 7}));
+    EXPECT_EQ(queue.findByKeys({"1", "odd"}), (std::vector<int>{3, 5, 7}));
+    EXPECT_EQ(queue.findByKeys({"0", "odd"}),
+              (std::vector<int>{2, 3, 4, 5, 7}));
+
+    queue.replaceItem(5, 6);
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{3, 7}));
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{2, 4, 6}));
+
+    // renumbers the items
+    queue.insertBefore(4, 9);  // evicts 2
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{3, 9, 7}));
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{4, 6}));
+
+    queue.clear();
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{}));
+    queue.pushFront({10, 11});
+    EXPECT_EQ(queue.findByKey("odd"), (std::vector<int>{11}));
+}
+
+TEST(LimitedQueue, IndexKeysComputedOnce)
+{
+    size_t calls = 0;
+    LimitedQueue<int> queue(10);
+    queue.setIndexKeys([&](const int &item) {
+        calls++;
+        return std::vector<QString>{QString::number(item % 3)};
+    });
+
+    for (int i = 0; i < 1000; i++)
+    {
+        queue.pushBack(i);
+    }
+    // evicting items doesn't compute their keys again
+    EXPECT_EQ(calls, 1000U);
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{990, 993, 996, 999}));
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{991, 994, 997}));
+
+    // renumbering only computes the keys of the new item (evicts 990)
+    queue.insertBefore(995, 1000);
+    EXPECT_EQ(calls, 1001U);
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{991, 994, 1000, 997}));
+
+    EXPECT_EQ(queue.setLimit(4), 6U);
+    EXPECT_EQ(calls, 1001U);
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{996, 999}));
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{997}));
+}
+
+TEST(LimitedQueue, SetLimit)
+{
+    LimitedQueue<int> queue(3);
+    queue.pushBack(1);
+    queue.pushBack(2);
+    queue.pushBack(3);
+    queue.setIndexKeys([](const int &item) {
+        return std::vector<QString>{QString::number(item % 2)};
+    });
+
+    // Growing the queue keeps all items and makes room at the front
+    EXPECT_EQ(queue.setLimit(5), 0U);
+    EXPECT_EQ(queue.limit(), 5U);
+    EXPECT_EQ(queue.pushFront({-1, 0}), (std::vector<int>{-1, 0}));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {-1, 0, 1, 2, 3}, "after grow");
+
+    auto snapshot = queue.getSnapshot();
+
+    // Shrinking the queue removes items from the front
+    EXPECT_EQ(queue.setLimit(3), 2U);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {1, 2, 3}, "after shrink");
+    SNAPSHOT_EQUALS(snapshot, {-1, 0, 1, 2, 3}, "old snapshot");
+    EXPECT_EQ(queue.findByKey("1"), (std::vector<int>{1, 3}));
+    EXPECT_EQ(queue.findByKey("0"), (std::vector<int>{2}));
+
+    queue.pushBack(4);  // evicts 1
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {2, 3, 4}, "after push");
+}
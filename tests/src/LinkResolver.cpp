@@ -0,0 +1,95 @@
+#include "providers/links/LinkResolver.hpp"
+
+#include "common/Literals.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "NetworkHelpers.hpp"
+#include "providers/links/LinkInfo.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+using namespace chatterino;
+using namespace literals;
+
+using State = LinkInfo::State;
+
+namespace {
+
+QString resolverUrl()
+{
+    return QString("%1/status/200?url=%2").arg(HTTPBIN_BASE_URL, "%1");
+}
+
+void waitUntilLoaded(const LinkInfo &info)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!info.isLoaded() && timer.elapsed() < 10000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    ASSERT_TRUE(info.isLoaded());
+}
+
+}  // namespace
+
+TEST(LinkResolver, NormalizeUrl)
+{
+    EXPECT_EQ(LinkResolver::normalizeUrl(u"HTTPS://Chatterino.COM"_s),
+              u"https://chatterino.com/"_s);
+    EXPECT_EQ(LinkResolver::normalizeUrl(u"https://chatterino.com/a/../b"_s),
+              u"https://chatterino.com/b"_s);
+    EXPECT_EQ(LinkResolver::normalizeUrl(u" https://chatterino.com/Path "_s),
+              u"https://chatterino.com/Path"_s);
+    EXPECT_EQ(LinkResolver::normalizeUrl(u"chatterino.com"_s),
+              u"chatterino.com"_s);
+}
+
+TEST(LinkResolver, SharesRequests)
+{
+    mock::BaseApplication app;
+    app.settings.linkInfoTooltip = true;
+    LinkResolver resolver(resolverUrl());
+
+    LinkInfo first(u"https://chatterino.com/"_s);
+    LinkInfo second(u"https://CHATTERINO.com"_s);
+    LinkInfo third(u"https://chatterino.com/"_s);
+
+    resolver.resolve(&first);
+    resolver.resolve(&second);
+    resolver.resolve(&third);
+    ASSERT_TRUE(first.isLoading());
+    ASSERT_TRUE(second.isLoading());
+    ASSERT_TRUE(third.isLoading());
+
+    waitUntilLoaded(first);
+
+    // The other infos waited for the same request
+    ASSERT_TRUE(first.isResolved());
+    ASSERT_TRUE(second.isResolved());
+    ASSERT_TRUE(third.isResolved());
+
+    // Later infos are resolved from the cache
+    LinkInfo cached(u"https://chatterino.com"_s);
+    resolver.resolve(&cached);
+    ASSERT_TRUE(cached.isResolved());
+    ASSERT_EQ(cached.tooltip(), first.tooltip());
+}
+
+TEST(LinkResolver, WaitingInfoDestroyed)
+{
+    mock::BaseApplication app;
+    app.settings.linkInfoTooltip = true;
+    LinkResolver resolver(resolverUrl());
+
+    LinkInfo first(u"https://chatterino.com/destroyed"_s);
+    {
+        LinkInfo second(u"https://chatterino.com/destroyed"_s);
+        resolver.resolve(&first);
+        resolver.resolve(&second);
+    }
+
+    waitUntilLoaded(first);
+    ASSERT_TRUE(first.isResolved());
+}
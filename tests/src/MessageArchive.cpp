@@ -0,0 +1,142 @@
+#include "messages/MessageArchive.hpp"
+
+#include "common/Literals.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+MessagePtr userMessage(const QString &name, const QString &text,
+                       qint64 receivedAt)
+{
+    MessageBuilder builder;
+    builder->loginName = name;
+    builder->displayName = name.toUpper();
+    builder->usernameColor = QColor(255, 0, 0);
+    builder->messageText = text;
+    builder->serverReceivedTime = QDateTime::fromMSecsSinceEpoch(receivedAt);
+    builder->flags.set(MessageFlag::Highlighted, MessageFlag::FirstMessage);
+    return builder.release();
+}
+
+}  // namespace
+
+TEST(MessageArchive, Materialize)
+{
+    mock::BaseApplication app;
+    MessageArchive archive(std::make_shared<MessageArchiveBudget>(1024 * 1024));
+
+    archive.add(*userMessage("foo", "hello", 1000));
+    archive.add(*userMessage("bar", u"héllo wörld"_s, 2000));
+    archive.add(*makeSystemMessage("Something happened"));
+    ASSERT_EQ(archive.size(), 3U);
+    ASSERT_EQ(archive.firstSeq(), 0U);
+    ASSERT_EQ(archive.endSeq(), 3U);
+
+    auto messages = archive.materialize(0, 10);
+    ASSERT_EQ(messages.size(), 3U);
+
+    EXPECT_EQ(messages[0]->loginName, "foo");
+    EXPECT_EQ(messages[0]->displayName, "FOO");
+    EXPECT_EQ(messages[0]->messageText, "hello");
+    EXPECT_EQ(messages[0]->usernameColor, QColor(255, 0, 0));
+    EXPECT_EQ(messages[0]->serverReceivedTime.toMSecsSinceEpoch(), 1000);
+    EXPECT_TRUE(messages[0]->flags.has(MessageFlag::Archived));
+    EXPECT_TRUE(messages[0]->flags.has(MessageFlag::FirstMessage));
+    // Highlights need their color, which isn't archived
+    EXPECT_FALSE(messages[0]->flags.has(MessageFlag::Highlighted));
+
+    EXPECT_EQ(messages[1]->messageText, u"héllo wörld"_s);
+    EXPECT_EQ(messages[1]->loginName, "bar");
+
+    EXPECT_EQ(messages[2]->messageText, "Something happened");
+    EXPECT_TRUE(messages[2]->flags.has(MessageFlag::System));
+
+    auto last = archive.materialize(1, 2);
+    ASSERT_EQ(last.size(), 1U);
+    EXPECT_EQ(last[0]->loginName, "bar");
+}
+
+TEST(MessageArchive, Budget)
+{
+    mock::BaseApplication app;
+    // Enough for one arena and a few hundred messages
+    auto budget = std::make_shared<MessageArchiveBudget>(80 * 1024);
+    MessageArchive archive(budget);
+
+    QString text(200, 'a');
+    for (int i = 0; i < 2000; i++)
+    {
+        archive.add(*userMessage("user", text + QString::number(i), i));
+    }
+
+    EXPECT_LE(archive.memoryUsage(), 80U * 1024);
+    EXPECT_EQ(budget->usage(), archive.memoryUsage());
+    EXPECT_LT(archive.size(), 2000U);
+    EXPECT_GT(archive.size(), 0U);
+    EXPECT_EQ(archive.endSeq(), 2000U);
+    EXPECT_EQ(archive.firstSeq(), 2000U - archive.size());
+
+    // Dropped messages are skipped
+    auto messages = archive.materialize(0, archive.firstSeq() + 1);
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_EQ(messages[0]->messageText,
+              text + QString::number(archive.firstSeq()));
+
+    archive.clear();
+    EXPECT_EQ(archive.size(), 0U);
+    EXPECT_EQ(archive.memoryUsage(), 0U);
+    EXPECT_EQ(budget->usage(), 0U);
+    EXPECT_EQ(archive.endSeq(), 2000U);
+}
+
+TEST(MessageArchive, SharedBudget)
+{
+    mock::BaseApplication app;
+    auto budget = std::make_shared<MessageArchiveBudget>(200 * 1024);
+
+    QString text(200, 'a');
+    auto fill = [&](MessageArchive &archive, int count) {
+        for (int i = 0; i < count; i++)
+        {
+            archive.add(*userMessage("user", text + QString::number(i), i));
+        }
+    };
+
+    MessageArchive viewed(budget);
+    MessageArchive notViewed(budget);
+    fill(viewed, 200);
+    fill(notViewed, 200);
+    ASSERT_EQ(viewed.size(), 200U);
+    ASSERT_EQ(notViewed.size(), 200U);
+    EXPECT_EQ(budget->usage(),
+              viewed.memoryUsage() + notViewed.memoryUsage());
+
+    // The limit applies to both archives together. The archive that wasn't
+    // viewed recently loses its messages first.
+    viewed.markViewed();
+    fill(viewed, 400);
+    EXPECT_LE(budget->usage(), 200U * 1024);
+    EXPECT_EQ(budget->usage(),
+              viewed.memoryUsage() + notViewed.memoryUsage());
+    EXPECT_EQ(viewed.size(), 600U);
+    EXPECT_LT(notViewed.size(), 200U);
+
+    {
+        MessageArchive other(budget);
+        fill(other, 10);
+        EXPECT_EQ(budget->usage(), viewed.memoryUsage() +
+                                       notViewed.memoryUsage() +
+                                       other.memoryUsage());
+    }
+    // Destroyed archives give their memory back
+    EXPECT_EQ(budget->usage(),
+              viewed.memoryUsage() + notViewed.memoryUsage());
+}
@@ -90,3 +90,49 @@ TEST(TextElement, BasicCase)
     EXPECT_EQ(wordStart, 0);
     EXPECT_EQ(wordEnd, 3);
 }
+
+TEST(MessageLayout, SharedBetweenViews)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(std::make_unique<TextElement>("aaaaaaaa bbbbbbbb",
+                                                 MessageElementFlag::Text));
+    auto message = builder.release();
+
+    MessageColors colors;
+    auto layoutWithWidth = [&](MessageLayout &layout, int width) {
+        return layout.layout(
+            {
+                .messageColors = colors,
+                .flags = MessageElementFlag::Text,
+                .width = width,
+                .scale = 1,
+                .imageScale = 1,
+            },
+            false);
+    };
+
+    MessageLayout first(message);
+    MessageLayout second(message);
+    EXPECT_TRUE(layoutWithWidth(first, WIDTH));
+    EXPECT_TRUE(layoutWithWidth(second, WIDTH));
+    EXPECT_FALSE(layoutWithWidth(second, WIDTH));
+
+    // Both views use the same elements
+    auto point = QPoint(WIDTH / 20, first.getHeight() / 2);
+    ASSERT_NE(first.getElementAt(point), nullptr);
+    EXPECT_EQ(first.getElementAt(point), second.getElementAt(point));
+
+    // A view with a different width gets its own layout
+    EXPECT_TRUE(layoutWithWidth(second, WIDTH / 2));
+    EXPECT_NE(first.getElementAt(point), second.getElementAt(point));
+    EXPECT_FALSE(layoutWithWidth(first, WIDTH));
+
+    // A message that's laid out again is laid out for all views
+    message->invalidateLayouts();
+    EXPECT_TRUE(layoutWithWidth(first, WIDTH));
+    EXPECT_TRUE(layoutWithWidth(second, WIDTH));
+    EXPECT_FALSE(layoutWithWidth(first, WIDTH));
+    EXPECT_EQ(first.getElementAt(point), second.getElementAt(point));
+}
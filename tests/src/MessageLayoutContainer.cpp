@@ -146,7 +146,7 @@ TEST_P(MessageLayoutContainerTest, RtlReordering)
             got.append(' ');
         }
 
-        if (dynamic_cast<ImageLayoutElement *>(el.get()))
+        if (dynamic_cast<ImageLayoutElement *>(el))
         {
             el->addCopyTextToString(got);
             if (el->hasTrailingSpace())
@@ -164,6 +164,51 @@ TEST_P(MessageLayoutContainerTest, RtlReordering)
     ASSERT_EQ(container.textDirection_, expectedDirection) << got;
 }
 
+TEST(MessageLayoutContainer, ReusesArena)
+{
+    MockApplication mockApplication;
+    MessageLayoutContainer container;
+    MessageLayoutContext ctx{
+        .messageColors = {},
+        .flags =
+            {
+                MessageElementFlag::Text,
+                MessageElementFlag::Username,
+                MessageElementFlag::TwitchEmote,
+            },
+        .width = 300,
+        .scale = 1.0F,
+        .imageScale = 1.0F,
+    };
+
+    auto elements =
+        makeElements(u"@aliens foo bar baz @foo qox !emote1 !emote2 foo bar"_s);
+    auto layout = [&] {
+        container.beginLayout(ctx.width, ctx.scale, ctx.imageScale, {});
+        for (const auto &element : elements)
+        {
+            element->addToContainer(container, ctx);
+        }
+        container.endLayout();
+    };
+
+    layout();
+    auto elementCount = container.elements_.size();
+    auto blockCount = container.arena_.blockCount();
+    auto used = container.arena_.used();
+    ASSERT_EQ(elementCount, elements.size());
+    ASSERT_GT(used, 0U);
+
+    // Laying out the same message again reuses the memory of the arena
+    for (int i = 0; i < 10; i++)
+    {
+        layout();
+        ASSERT_EQ(container.elements_.size(), elementCount);
+        ASSERT_EQ(container.arena_.blockCount(), blockCount);
+        ASSERT_EQ(container.arena_.used(), used);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     MessageLayoutContainer, MessageLayoutContainerTest,
     testing::Values(
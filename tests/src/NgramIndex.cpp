@@ -0,0 +1,128 @@
+#include "util/NgramIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+std::vector<QString> texts(const NgramIndex &index,
+                           std::vector<NgramIndex::Id> ids, bool sort = true)
+{
+    std::vector<QString> result;
+    for (auto id : ids)
+    {
+        result.push_back(index.text(id));
+    }
+    if (sort)
+    {
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(NgramIndex, Prefix)
+{
+    NgramIndex index;
+    index.insert("forsen");
+    index.insert("Forsenlol");
+    index.insert("pajlada");
+    index.insert("fo");
+
+    EXPECT_EQ(texts(index, index.findPrefix(u"FORS")),
+              (std::vector<QString>{"Forsenlol", "forsen"}));
+    EXPECT_EQ(texts(index, index.findPrefix(u"f")),
+              (std::vector<QString>{"Forsenlol", "fo", "forsen"}));
+    EXPECT_TRUE(index.findPrefix(u"orsen").empty());
+    EXPECT_EQ(index.findPrefix(u"").size(), 4U);
+}
+
+TEST(NgramIndex, Substring)
+{
+    NgramIndex index;
+    index.insert("forsen");
+    index.insert("Forsenlol");
+    index.insert("pajlada");
+    index.insert("NymN");
+
+    // trigram lookups
+    EXPECT_EQ(texts(index, index.findSubstring(u"RSEN")),
+              (std::vector<QString>{"Forsenlol", "forsen"}));
+    EXPECT_EQ(texts(index, index.findSubstring(u"enlo")),
+              (std::vector<QString>{"Forsenlol"}));
+    EXPECT_TRUE(index.findSubstring(u"forsenx").empty());
+    // all trigrams exist, but not in this order
+    EXPECT_TRUE(index.findSubstring(u"ladajl").empty());
+
+    // short queries
+    EXPECT_EQ(texts(index, index.findSubstring(u"n")),
+              (std::vector<QString>{"Forsenlol", "NymN", "forsen"}));
+    EXPECT_EQ(texts(index, index.findSubstring(u"ym")),
+              (std::vector<QString>{"NymN"}));
+}
+
+TEST(NgramIndex, Remove)
+{
+    NgramIndex index;
+    auto forsen = index.insert("forsen");
+    auto forsenlol = index.insert("forsenlol");
+    EXPECT_EQ(index.size(), 2U);
+
+    index.remove(forsen);
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_FALSE(index.contains(forsen));
+    EXPECT_EQ(texts(index, index.findSubstring(u"forsen")),
+              (std::vector<QString>{"forsenlol"}));
+    EXPECT_EQ(texts(index, index.findPrefix(u"forsen")),
+              (std::vector<QString>{"forsenlol"}));
+
+    // removing twice is fine
+    index.remove(forsen);
+    EXPECT_EQ(index.size(), 1U);
+
+    // ids are reused
+    auto nymn = index.insert("nymn");
+    EXPECT_EQ(nymn, forsen);
+    EXPECT_EQ(texts(index, index.findSubstring(u"ymn")),
+              (std::vector<QString>{"nymn"}));
+
+    index.remove(forsenlol);
+    EXPECT_TRUE(index.findSubstring(u"sen").empty());
+    EXPECT_TRUE(index.findPrefix(u"f").empty());
+}
+
+TEST(NgramIndex, SetText)
+{
+    NgramIndex index;
+    auto id = index.insert("pajlada");
+    index.setText(id, "Pajlada");
+    EXPECT_EQ(index.text(id), "Pajlada");
+    EXPECT_EQ(index.key(id), "pajlada");
+    EXPECT_EQ(texts(index, index.findSubstring(u"JLA")),
+              (std::vector<QString>{"Pajlada"}));
+}
+
+TEST(NgramIndex, TopK)
+{
+    NgramIndex index;
+    index.insert("xkappa");
+    index.insert("KappaPride");
+    index.insert("Kappa");
+    index.insert("KappaHD");
+    index.insert("MiniK");
+
+    // exact match, then prefix matches by length, then substring matches
+    EXPECT_EQ(texts(index, index.topK(u"kappa", 10), false),
+              (std::vector<QString>{"Kappa", "KappaHD", "KappaPride",
+                                    "xkappa"}));
+    EXPECT_EQ(texts(index, index.topK(u"kappa", 2), false),
+              (std::vector<QString>{"Kappa", "KappaHD"}));
+    EXPECT_TRUE(index.topK(u"kappa", 0).empty());
+}
@@ -0,0 +1,38 @@
+#include "controllers/nicknames/NicknameRules.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(NicknameRules, match)
+{
+    NicknameRules rules({
+        Nickname("forsen", "xd", false, false),
+        Nickname("^pajl(.*)$", "pajbot\\1", true, true),
+        Nickname("pajlada", "never", false, true),
+        Nickname("Zneix", "cs", false, true),
+        Nickname("FORSEN", "shadowed", false, false),
+        Nickname("(invalid", "", true, false),
+    });
+
+    EXPECT_EQ(rules.match("Forsen"), "xd");
+    EXPECT_EQ(rules.match("forsen"), "xd");
+    // The regex comes before the exact name
+    EXPECT_EQ(rules.match("pajlada"), "pajbotada");
+    EXPECT_EQ(rules.match("Zneix"), "cs");
+    EXPECT_EQ(rules.match("zneix"), std::nullopt);
+    EXPECT_EQ(rules.match("(invalid"), std::nullopt);
+    EXPECT_EQ(rules.match("someone"), std::nullopt);
+}
+
+TEST(NicknameRules, ExactBeforeRegex)
+{
+    NicknameRules rules({
+        Nickname("pajlada", "exact", false, false),
+        Nickname("^pajl(.*)$", "regex", true, true),
+    });
+
+    EXPECT_EQ(rules.match("PAJLADA"), "exact");
+    EXPECT_EQ(rules.match("pajlada"), "exact");
+    EXPECT_EQ(rules.match("pajlaGod"), "regex");
+}
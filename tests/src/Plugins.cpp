@@ -2,6 +2,7 @@
 #    include "Application.hpp"
 #    include "common/Channel.hpp"
 #    include "common/network/NetworkCommon.hpp"
+#    include "controllers/accounts/AccountController.hpp"
 #    include "controllers/commands/Command.hpp"  // IWYU pragma: keep
 #    include "controllers/commands/CommandController.hpp"
 #    include "controllers/plugins/api/ChannelRef.hpp"
@@ -9,16 +10,20 @@
 #    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/PluginPermission.hpp"
 #    include "controllers/plugins/SolTypes.hpp"  // IWYU pragma: keep
+#    include "messages/Message.hpp"
+#    include "messages/MessageBuilder.hpp"
 #    include "mocks/BaseApplication.hpp"
 #    include "mocks/Channel.hpp"
 #    include "mocks/Emotes.hpp"
 #    include "mocks/Logging.hpp"
 #    include "mocks/TwitchIrcServer.hpp"
 #    include "NetworkHelpers.hpp"
+#    include "providers/twitch/TwitchChannel.hpp"
 #    include "singletons/Logging.hpp"
 #    include "Test.hpp"
 
 #    include <lauxlib.h>
+#    include <QThread>
 #    include <sol/state_view.hpp>
 #    include <sol/table.hpp>
 
@@ -46,6 +51,8 @@ class MockTwitch : public mock::MockTwitchIrcServer
 {
 public:
     ChannelPtr mm2pl = std::make_shared<MockChannel>("mm2pl");
+    // Set by tests that need a real Twitch channel
+    ChannelPtr forsen;
 
     ChannelPtr getChannelOrEmpty(const QString &dirtyChannelName) override
     {
@@ -53,6 +60,10 @@ public:
         {
             return this->mm2pl;
         }
+        if (dirtyChannelName == "forsen" && this->forsen)
+        {
+            return this->forsen;
+        }
         return Channel::getEmpty();
     }
 
@@ -102,8 +113,14 @@ public:
         return &this->logging;
     }
 
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
     PluginController plugins;
     mock::EmptyLogging logging;
+    AccountController accounts;
     CommandController commands;
     mock::Emotes emotes;
     MockTwitch twitch;
@@ -135,6 +152,21 @@ public:
     {
         return pl->state_;
     }
+
+    static void flushObservedMessages()
+    {
+        getApp()->getPlugins()->flushObservedMessages();
+    }
+
+    static void startWorker(Plugin *pl)
+    {
+        pl->startWorker();
+    }
+
+    static QThread *workerThread(Plugin *pl)
+    {
+        return pl->workerThread_.get();
+    }
 };
 
 }  // namespace chatterino
@@ -638,4 +670,191 @@ TEST_F(PluginTest, tryCallTest)
     }
 }
 
+TEST_F(PluginTest, instructionBudget)
+{
+    configure();
+
+    lua->script(R"lua(
+        _G.finished = 0
+        c2.register_command("/fine", function(ctx)
+            _G.finished = _G.finished + 1
+        end)
+        c2.register_command("/spin", function(ctx)
+            -- catching the error mustn't allow the plugin to keep running
+            while true do
+                pcall(function()
+                    while true do end
+                end)
+            end
+        end)
+    )lua");
+
+    app->commands.execCommand("/fine", channel, false);
+    EXPECT_EQ(rawpl->usage().calls, 1U);
+    EXPECT_EQ(rawpl->usage().overBudget, 0U);
+
+    for (size_t i = 1; i <= Plugin::MAX_BUDGET_VIOLATIONS; i++)
+    {
+        EXPECT_TRUE(rawpl->isRunnable());
+        app->commands.execCommand("/spin", channel, false);
+        EXPECT_EQ(rawpl->usage().overBudget, i);
+    }
+    EXPECT_FALSE(rawpl->isRunnable());
+
+    // disabled plugins don't run commands
+    EXPECT_EQ(lua->get<int>("finished"), 1);
+    app->commands.execCommand("/fine", channel, false);
+    EXPECT_EQ(lua->get<int>("finished"), 1);
+    EXPECT_EQ(rawpl->usage().calls, 1U + Plugin::MAX_BUDGET_VIOLATIONS);
+}
+
+TEST_F(PluginTest, messagesAdded)
+{
+    configure();
+
+    lua->script(R"lua(
+        _G.batches = {}
+        c2.register_callback(c2.EventType.MessagesAdded, function(ev)
+            local batch = {}
+            for _, msg in ipairs(ev.messages) do
+                table.insert(
+                    batch,
+                    msg:get_channel_name() .. ":" .. msg:get_text()
+                )
+            end
+            table.insert(_G.batches, batch)
+        end, { channels = { "mm2pl" }, authors = { "forsen" } })
+    )lua");
+
+    auto makeMessage = [](const QString &author, const QString &text) {
+        MessageBuilder builder;
+        builder->loginName = author;
+        builder->messageText = text;
+        return builder.release();
+    };
+    auto other = std::make_shared<MockChannel>("other");
+
+    channel->addMessage(makeMessage("forsen", "a"), MessageContext::Original);
+    channel->addMessage(makeMessage("pajlada", "b"),
+                        MessageContext::Original);
+    other->addMessage(makeMessage("forsen", "c"), MessageContext::Original);
+    channel->addMessage(makeMessage("forsen", "d"), MessageContext::Original);
+    PluginControllerAccess::flushObservedMessages();
+
+    sol::table batches = (*lua)["batches"];
+    ASSERT_EQ(batches.size(), 1U);
+    sol::table batch = batches[1];
+    ASSERT_EQ(batch.size(), 2U);
+    EXPECT_EQ(batch.get<QString>(1), "mm2pl:a");
+    EXPECT_EQ(batch.get<QString>(2), "mm2pl:d");
+
+    // the callback isn't invoked without matching messages
+    channel->addMessage(makeMessage("pajlada", "e"),
+                        MessageContext::Original);
+    PluginControllerAccess::flushObservedMessages();
+    EXPECT_EQ(batches.size(), 1U);
+
+    // only MessagesAdded callbacks take a filter
+    EXPECT_ANY_THROW(lua->script(R"lua(
+        c2.register_callback(
+            c2.EventType.CompletionRequested, function() end, {}
+        )
+    )lua"));
+}
+
+TEST_F(PluginTest, workerThread)
+{
+    configure();
+    PluginControllerAccess::startWorker(rawpl);
+    ASSERT_TRUE(rawpl->isWorker());
+
+    QThread *commandThread = nullptr;
+    RequestWaiter commandWaiter;
+    lua->set("done", [&] {
+        commandThread = QThread::currentThread();
+        commandWaiter.requestDone();
+    });
+
+    RequestWaiter setupWaiter;
+    rawpl->invoke([&] {
+        lua->script(R"lua(
+            c2.register_command("/work", function(ctx)
+                done()
+            end)
+        )lua");
+        setupWaiter.requestDone();
+    });
+    setupWaiter.waitForRequest();
+    // the command is registered on the GUI thread
+    QCoreApplication::processEvents();
+    EXPECT_EQ(app->commands.pluginCommands(), QStringList{"/work"});
+
+    app->commands.execCommand("/work", channel, false);
+    commandWaiter.waitForRequest();
+    EXPECT_EQ(commandThread, PluginControllerAccess::workerThread(rawpl));
+    EXPECT_NE(commandThread, QThread::currentThread());
+
+    // completions are requested synchronously
+    EXPECT_FALSE(rawpl->getCompletionCallback().has_value());
+}
+
+TEST_F(PluginTest, workerThreadCommandCollision)
+{
+    configure();
+    // another plugin owns the command
+    ASSERT_TRUE(app->commands.registerPluginCommand("/taken"));
+    PluginControllerAccess::startWorker(rawpl);
+
+    RequestWaiter setupWaiter;
+    rawpl->invoke([&] {
+        lua->script(R"lua(
+            registered = c2.register_command("/taken", function(ctx) end)
+        )lua");
+        setupWaiter.requestDone();
+    });
+    setupWaiter.waitForRequest();
+    // the worker can't know that the name is taken yet
+    EXPECT_TRUE(lua->get<bool>("registered"));
+
+    // the command is registered on the GUI thread, which fails
+    QCoreApplication::processEvents();
+
+    // the command is released on the worker thread
+    RequestWaiter releaseWaiter;
+    rawpl->invoke([&] {
+        releaseWaiter.requestDone();
+    });
+    releaseWaiter.waitForRequest();
+
+    EXPECT_FALSE(rawpl->hasCommand("/taken"));
+    EXPECT_TRUE(rawpl->listRegisteredCommands().empty());
+    EXPECT_EQ(app->commands.pluginCommands(), QStringList{"/taken"});
+}
+
+TEST_F(PluginTest, workerThreadChannel)
+{
+    configure();
+    app->twitch.forsen = std::make_shared<TwitchChannel>("forsen");
+    PluginControllerAccess::startWorker(rawpl);
+    ASSERT_TRUE(rawpl->isWorker());
+
+    RequestWaiter waiter;
+    rawpl->invoke([&] {
+        lua->script(R"lua(
+            local chan = c2.Channel.by_name("forsen")
+            name = chan:get_display_name()
+            mod = chan:is_mod()
+            vip = chan:is_vip()
+            broadcaster = chan:is_broadcaster()
+        )lua");
+        waiter.requestDone();
+    });
+    waiter.waitForRequest();
+
+    EXPECT_EQ(lua->get<QString>("name"), "forsen");
+    EXPECT_EQ(lua->get<bool>("mod"), false);
+    EXPECT_EQ(lua->get<bool>("vip"), false);
+    EXPECT_EQ(lua->get<bool>("broadcaster"), false);
+}
+
 #endif
@@ -0,0 +1,156 @@
+#include "providers/ProviderSnapshot.hpp"
+
+#include "NetworkHelpers.hpp"
+#include "Test.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <atomic>
+
+using namespace chatterino;
+
+namespace {
+
+QString snapshotPath(const QTemporaryDir &dir)
+{
+    return dir.filePath("provider-snapshot.bin");
+}
+
+}  // namespace
+
+TEST(ProviderSnapshot, RoundTrip)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        ProviderSnapshot snapshot;
+        snapshot.initialize(snapshotPath(dir));
+        ASSERT_FALSE(snapshot.get("bttv.global").has_value());
+
+        snapshot.set("bttv.global", {"\"etag\"", R"([{"id":"1"}])"});
+        snapshot.set("seventv.global", {{}, R"({"emotes":[]})"});
+        snapshot.save();
+    }
+
+    ProviderSnapshot snapshot;
+    snapshot.initialize(snapshotPath(dir));
+
+    auto bttv = snapshot.get("bttv.global");
+    ASSERT_TRUE(bttv.has_value());
+    EXPECT_EQ(bttv->etag, "\"etag\"");
+    EXPECT_EQ(bttv->data, R"([{"id":"1"}])");
+    EXPECT_TRUE(snapshot.contains("bttv.global", R"([{"id":"1"}])"));
+    EXPECT_FALSE(snapshot.contains("bttv.global", "[]"));
+
+    auto seventv = snapshot.get("seventv.global");
+    ASSERT_TRUE(seventv.has_value());
+    EXPECT_TRUE(seventv->etag.isEmpty());
+    EXPECT_EQ(seventv->data, R"({"emotes":[]})");
+
+    EXPECT_FALSE(snapshot.get("ffz.global").has_value());
+
+    // Replacing an entry while the file is mapped
+    snapshot.set("bttv.global", {"\"etag2\"", "[]"});
+    snapshot.save();
+    EXPECT_EQ(snapshot.get("seventv.global")->data, R"({"emotes":[]})");
+
+    ProviderSnapshot reloaded;
+    reloaded.initialize(snapshotPath(dir));
+    EXPECT_EQ(reloaded.get("bttv.global")->etag, "\"etag2\"");
+    EXPECT_EQ(reloaded.get("bttv.global")->data, "[]");
+    EXPECT_EQ(reloaded.get("seventv.global")->data, R"({"emotes":[]})");
+}
+
+TEST(ProviderSnapshot, Invalid)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        ProviderSnapshot snapshot;
+        snapshot.initialize(snapshotPath(dir));
+        snapshot.set("ffz.global", {"etag", "data"});
+        snapshot.save();
+    }
+
+    QFile file(snapshotPath(dir));
+    ASSERT_TRUE(file.open(QFile::ReadOnly));
+    auto valid = file.readAll();
+    file.close();
+
+    auto overwrite = [&](const QByteArray &contents) {
+        QFile out(snapshotPath(dir));
+        ASSERT_TRUE(out.open(QFile::WriteOnly | QFile::Truncate));
+        out.write(contents);
+    };
+
+    // Truncated
+    overwrite(valid.left(valid.size() - 1));
+    {
+        ProviderSnapshot snapshot;
+        snapshot.initialize(snapshotPath(dir));
+        EXPECT_FALSE(snapshot.get("ffz.global").has_value());
+    }
+
+    // Other version
+    auto otherVersion = valid;
+    otherVersion[4] = static_cast<char>(ProviderSnapshot::VERSION + 1);
+    overwrite(otherVersion);
+    {
+        ProviderSnapshot snapshot;
+        snapshot.initialize(snapshotPath(dir));
+        EXPECT_FALSE(snapshot.get("ffz.global").has_value());
+    }
+
+    // Unknown format
+    overwrite("not a snapshot");
+    {
+        ProviderSnapshot snapshot;
+        snapshot.initialize(snapshotPath(dir));
+        EXPECT_FALSE(snapshot.get("ffz.global").has_value());
+    }
+
+    // Nothing is recorded without a file
+    ProviderSnapshot uninitialized;
+    uninitialized.set("ffz.global", {"etag", "data"});
+    EXPECT_FALSE(uninitialized.get("ffz.global").has_value());
+}
+
+TEST(ProviderSnapshot, UnusableSnapshotIsDropped)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    ProviderSnapshot snapshot;
+    snapshot.initialize(snapshotPath(dir));
+    snapshot.set("bttv.global", {"\"etag\"", "not json"});
+
+    std::atomic<int> applied = 0;
+    QByteArray response;
+    RequestWaiter waiter;
+    snapshot.load(
+        "bttv.global", QString("%1/headers").arg(HTTPBIN_BASE_URL),
+        [&](const QByteArray &data) {
+            applied++;
+            if (data == "not json")
+            {
+                return false;
+            }
+            response = data;
+            return true;
+        },
+        [&] {
+            waiter.requestDone();
+        });
+    waiter.waitForRequest();
+
+    // The snapshot and then the response were applied
+    EXPECT_EQ(applied, 2);
+    ASSERT_FALSE(response.isEmpty());
+    // The request didn't revalidate the ETag of the dropped snapshot
+    EXPECT_FALSE(response.contains("If-None-Match"));
+    EXPECT_FALSE(response.contains("if-none-match"));
+    EXPECT_TRUE(snapshot.contains("bttv.global", response));
+}
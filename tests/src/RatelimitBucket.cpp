@@ -45,3 +45,58 @@ TEST(RatelimitBucket, BatchTwoParts)
 
     EXPECT_EQ(n, 6);
 }
+
+TEST(RatelimitBucket, Prioritized)
+{
+    const int cooldown = 100;
+    QStringList handled;
+    auto cb = [&handled](QString msg) {
+        handled.append(msg);
+    };
+    auto bucket = std::make_unique<RatelimitBucket>(1, cooldown, cb, nullptr);
+    bucket->send("1");
+    EXPECT_EQ(handled, QStringList{"1"});
+
+    // Rate limit reached, these are all queued
+    bucket->send("2");
+    bucket->send("3");
+    bucket->send("4", true);
+    // 3 is already queued, it's moved to the prioritized queue
+    bucket->send("3", true);
+
+    for (int i = 0; i < 3; i++)
+    {
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds{cooldown});
+        QCoreApplication::processEvents();
+    }
+
+    EXPECT_EQ(handled, (QStringList{"1", "4", "3", "2"}));
+}
+
+TEST(RatelimitBucket, PrioritizedDuplicates)
+{
+    const int cooldown = 100;
+    QStringList handled;
+    auto cb = [&handled](QString msg) {
+        handled.append(msg);
+    };
+    auto bucket = std::make_unique<RatelimitBucket>(1, cooldown, cb, nullptr);
+    bucket->send("1");
+    EXPECT_EQ(handled, QStringList{"1"});
+
+    // Rate limit reached, the duplicates are only queued once
+    bucket->send("2", true);
+    bucket->send("3", true);
+    bucket->send("2", true);
+    bucket->send("3", true);
+
+    for (int i = 0; i < 3; i++)
+    {
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds{cooldown});
+        QCoreApplication::processEvents();
+    }
+
+    EXPECT_EQ(handled, (QStringList{"1", "2", "3"}));
+}
@@ -0,0 +1,146 @@
+#include "providers/recentmessages/MessageCache.hpp"
+
+#include "providers/twitch/TwitchIrcLine.hpp"
+#include "Test.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QTemporaryDir>
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using recentmessages::MessageCache;
+
+namespace {
+
+MessageCache::TimePoint at(std::chrono::milliseconds ms)
+{
+    return MessageCache::TimePoint(ms);
+}
+
+TwitchIrcLine privmsg(const QString &id, const QString &text)
+{
+    return *TwitchIrcLine::parse(
+        QString("@id=%1 :user!user@user.tmi.twitch.tv PRIVMSG #pajlada :%2")
+            .arg(id, text)
+            .toUtf8());
+}
+
+}  // namespace
+
+TEST(RecentMessagesCache, RecordsChannelMessages)
+{
+    MessageCache cache;
+    cache.initialize({}, 10);
+
+    cache.add(privmsg("1", "a"), at(1000ms));
+    cache.add(*TwitchIrcLine::parse(":user!user@user.tmi.twitch.tv JOIN "
+                                    "#pajlada"),
+              at(1500ms));
+    cache.add(*TwitchIrcLine::parse("@id=2 :user!user@user.tmi.twitch.tv "
+                                    "WHISPER pajlada :hi"),
+              at(1600ms));
+    cache.add(privmsg("3", "b"), at(2000ms));
+
+    auto lines = cache.lines("pajlada");
+    ASSERT_EQ(lines.size(), 2U);
+    // The lines are stored like the Recent Messages API returns them
+    EXPECT_EQ(lines[0], "@historical=1;rm-received-ts=1000;id=1 "
+                        ":user!user@user.tmi.twitch.tv PRIVMSG #pajlada :a");
+    EXPECT_TRUE(lines[1].endsWith(":b"));
+}
+
+TEST(RecentMessagesCache, MergesApiMessages)
+{
+    MessageCache cache;
+    cache.initialize({}, 3);
+
+    cache.add(privmsg("2", "live"), at(2000ms));
+    cache.add("pajlada",
+              QJsonArray{
+                  "@historical=1;id=1;rm-received-ts=1000 "
+                  ":user!user@user.tmi.twitch.tv PRIVMSG #pajlada :old",
+                  // received live already
+                  "@historical=1;id=2;rm-received-ts=2001 "
+                  ":user!user@user.tmi.twitch.tv PRIVMSG #pajlada :live",
+                  "@historical=1;id=4;rm-received-ts=4000 "
+                  ":user!user@user.tmi.twitch.tv PRIVMSG #pajlada :new",
+              });
+    cache.add(privmsg("5", "newest"), at(5000ms));
+
+    // Only the newest three are kept
+    auto lines = cache.lines("pajlada");
+    ASSERT_EQ(lines.size(), 3U);
+    EXPECT_TRUE(lines[0].endsWith(":live"));
+    EXPECT_TRUE(lines[1].endsWith(":new"));
+    EXPECT_TRUE(lines[2].endsWith(":newest"));
+
+    // Older than everything that's kept
+    cache.add(privmsg("0", "ancient"), at(10ms));
+    EXPECT_EQ(cache.lines("pajlada").size(), 3U);
+    EXPECT_TRUE(cache.lines("pajlada")[0].endsWith(":live"));
+}
+
+TEST(RecentMessagesCache, Persists)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        MessageCache cache;
+        cache.initialize(dir.path(), 10);
+        cache.add(privmsg("1", "a"), at(1000ms));
+        cache.add(privmsg("2", "b"), at(2000ms));
+        cache.save();
+    }
+
+    MessageCache cache;
+    cache.initialize(dir.path(), 10);
+    EXPECT_EQ(cache.loadPersisted("forsen", at(10000ms)), std::nullopt);
+
+    auto persisted = cache.loadPersisted("pajlada", at(10000ms));
+    ASSERT_TRUE(persisted.has_value());
+    EXPECT_EQ(persisted->newest, at(2000ms));
+    EXPECT_EQ(persisted->root.value("messages").toArray().size(), 2);
+
+    // The persisted lines are kept for the next run
+    EXPECT_EQ(cache.lines("pajlada").size(), 2U);
+}
+
+TEST(RecentMessagesCache, RejoinUsesRecordedLines)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        MessageCache cache;
+        cache.initialize(dir.path(), 10);
+        cache.add(privmsg("1", "a"), at(1000ms));
+        cache.save();
+    }
+
+    MessageCache cache;
+    cache.initialize(dir.path(), 10);
+    ASSERT_TRUE(cache.loadPersisted("pajlada", at(5000ms)).has_value());
+
+    // The file is only read on the first join
+    ASSERT_TRUE(QFile::remove(dir.filePath("pajlada.json")));
+    cache.add(privmsg("2", "b"), at(6000ms));
+    cache.add(privmsg("3", "c"), at(7000ms));
+
+    // Received after the channel was joined again
+    cache.add(privmsg("4", "d"), at(9000ms));
+
+    auto persisted = cache.loadPersisted("pajlada", at(8000ms));
+    ASSERT_TRUE(persisted.has_value());
+    EXPECT_EQ(persisted->newest, at(7000ms));
+    auto lines = persisted->root.value("messages").toArray();
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_TRUE(lines[0].toString().endsWith(":a"));
+    EXPECT_TRUE(lines[2].toString().endsWith(":c"));
+
+    // The persisted lines weren't recorded twice
+    EXPECT_EQ(cache.lines("pajlada").size(), 4U);
+}
@@ -0,0 +1,249 @@
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include "common/Atomic.hpp"
+#include "messages/Emote.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "providers/seventv/eventapi/Dispatch.hpp"
+#include "Test.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <rapidjson/document.h>
+
+#include <memory>
+#include <variant>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::seventv::eventapi;
+
+namespace {
+
+const QString EMOTE_SET_ID = "60b39e943e203cc169dfc106";
+
+QJsonObject makeEmote(const QString &id, const QString &name)
+{
+    return {
+        {"id", id},
+        {"name", name},
+        {"flags", 0},
+        {"data",
+         QJsonObject{
+             {"name", name},
+             {"listed", true},
+             {"flags", 0},
+             {"owner", QJsonObject{{"display_name", "owner"}}},
+             {"host",
+              QJsonObject{
+                  {"url", "//cdn.7tv.app/emote/" + id},
+                  {"files",
+                   QJsonArray{
+                       QJsonObject{
+                           {"name", "1x.webp"},
+                           {"format", "WEBP"},
+                           {"width", 28},
+                           {"height", 28},
+                       },
+                   }},
+              }},
+         }},
+    };
+}
+
+Dispatch makeDispatch()
+{
+    // The dispatch refers to its body, so the document has to outlive it
+    static const auto document = [] {
+        rapidjson::Document doc;
+        doc.Parse(R"({"type":"emote_set.update","body":{)"
+                  R"("id":"60b39e943e203cc169dfc106",)"
+                  R"("actor":{"display_name":"actor"}}})");
+        return doc;
+    }();
+
+    return Dispatch(document);
+}
+
+std::vector<QString> appliedNames(
+    const std::vector<SeventvEmotes::AppliedEmoteChange> &applied)
+{
+    std::vector<QString> names;
+    for (const auto &change : applied)
+    {
+        names.push_back(change.emote->name.string);
+    }
+    return names;
+}
+
+std::vector<size_t> appliedIndices(
+    const std::vector<SeventvEmotes::AppliedEmoteChange> &applied)
+{
+    std::vector<size_t> indices;
+    for (const auto &change : applied)
+    {
+        indices.push_back(change.index);
+    }
+    return indices;
+}
+
+class SeventvEmotesTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        this->app = std::make_unique<mock::BaseApplication>();
+        this->initial = std::make_shared<const EmoteMap>(
+            seventv::detail::parseEmotes(
+                QJsonArray{
+                    makeEmote("a1", "Alpha"),
+                    makeEmote("b1", "Beta"),
+                },
+                SeventvEmoteSetKind::Channel));
+        ASSERT_EQ(this->initial->size(), 2U);
+    }
+
+    void TearDown() override
+    {
+        this->initial.reset();
+        this->app.reset();
+    }
+
+    std::unique_ptr<mock::BaseApplication> app;
+    std::shared_ptr<const EmoteMap> initial;
+};
+
+}  // namespace
+
+TEST_F(SeventvEmotesTest, ApplyMixedChanges)
+{
+    auto dispatch = makeDispatch();
+
+    EmoteSetChanges changes;
+    changes.emoteSetID = EMOTE_SET_ID;
+    changes.changes = {
+        EmoteAddDispatch(dispatch, makeEmote("c1", "Gamma")),
+        // rename
+        EmoteUpdateDispatch(dispatch, makeEmote("b1", "Beta"),
+                            makeEmote("b1", "Bee")),
+        EmoteRemoveDispatch(dispatch, makeEmote("a1", "Alpha")),
+        // remove after add
+        EmoteAddDispatch(dispatch, makeEmote("d1", "Delta")),
+        EmoteRemoveDispatch(dispatch, makeEmote("d1", "Delta")),
+        // not in the map
+        EmoteRemoveDispatch(dispatch, makeEmote("x1", "Unknown")),
+        // rename of an emote added in the same batch
+        EmoteUpdateDispatch(dispatch, makeEmote("c1", "Gamma"),
+                            makeEmote("c1", "Gam")),
+    };
+
+    Atomic<std::shared_ptr<const EmoteMap>> map(
+        std::shared_ptr<const EmoteMap>(this->initial));
+    auto applied = SeventvEmotes::applyEmoteSetChanges(map, changes);
+
+    EXPECT_EQ(appliedIndices(applied),
+              (std::vector<size_t>{0, 1, 2, 3, 4, 6}));
+    EXPECT_EQ(appliedNames(applied),
+              (std::vector<QString>{"Gamma", "Bee", "Alpha", "Delta", "Delta",
+                                    "Gam"}));
+
+    auto updated = map.get();
+    ASSERT_NE(updated, this->initial);
+    EXPECT_EQ(updated->size(), 2U);
+    EXPECT_TRUE(updated->contains(EmoteName{"Bee"}));
+    EXPECT_TRUE(updated->contains(EmoteName{"Gam"}));
+    EXPECT_FALSE(updated->contains(EmoteName{"Alpha"}));
+    EXPECT_FALSE(updated->contains(EmoteName{"Beta"}));
+    EXPECT_FALSE(updated->contains(EmoteName{"Gamma"}));
+    EXPECT_FALSE(updated->contains(EmoteName{"Delta"}));
+
+    auto bee = updated->at(EmoteName{"Bee"});
+    EXPECT_EQ(bee->id.string, "b1");
+    ASSERT_TRUE(bee->baseName.has_value());
+    EXPECT_EQ(bee->baseName->string, "Beta");
+
+    // The previous map is left untouched
+    EXPECT_EQ(this->initial->size(), 2U);
+    EXPECT_TRUE(this->initial->contains(EmoteName{"Alpha"}));
+    EXPECT_TRUE(this->initial->contains(EmoteName{"Beta"}));
+}
+
+TEST_F(SeventvEmotesTest, ApplyNothing)
+{
+    auto dispatch = makeDispatch();
+
+    EmoteSetChanges changes;
+    changes.emoteSetID = EMOTE_SET_ID;
+    changes.changes = {
+        EmoteRemoveDispatch(dispatch, makeEmote("x1", "Unknown")),
+    };
+
+    Atomic<std::shared_ptr<const EmoteMap>> map(
+        std::shared_ptr<const EmoteMap>(this->initial));
+    auto applied = SeventvEmotes::applyEmoteSetChanges(map, changes);
+
+    EXPECT_TRUE(applied.empty());
+    // The map isn't replaced if nothing changed
+    EXPECT_EQ(map.get(), this->initial);
+}
+
+TEST_F(SeventvEmotesTest, ApplyMergedChanges)
+{
+    auto dispatch = makeDispatch();
+
+    // Two dispatches for the same emote set, merged before they're applied
+    EmoteSetChanges first;
+    first.emoteSetID = EMOTE_SET_ID;
+    first.changes = {
+        EmoteAddDispatch(dispatch, makeEmote("c1", "Gamma")),
+        EmoteRemoveDispatch(dispatch, makeEmote("a1", "Alpha")),
+    };
+
+    EmoteSetChanges second;
+    second.emoteSetID = EMOTE_SET_ID;
+    second.changes = {
+        EmoteRemoveDispatch(dispatch, makeEmote("c1", "Gamma")),
+        EmoteAddDispatch(dispatch, makeEmote("a1", "Alpha")),
+        EmoteUpdateDispatch(dispatch, makeEmote("b1", "Beta"),
+                            makeEmote("b1", "Bee")),
+    };
+
+    first.append(std::move(second));
+    ASSERT_EQ(first.changes.size(), 5U);
+    EXPECT_TRUE(std::holds_alternative<EmoteAddDispatch>(first.changes[0]));
+    EXPECT_TRUE(std::holds_alternative<EmoteRemoveDispatch>(first.changes[1]));
+    EXPECT_TRUE(std::holds_alternative<EmoteRemoveDispatch>(first.changes[2]));
+    EXPECT_TRUE(std::holds_alternative<EmoteAddDispatch>(first.changes[3]));
+    EXPECT_TRUE(std::holds_alternative<EmoteUpdateDispatch>(first.changes[4]));
+
+    Atomic<std::shared_ptr<const EmoteMap>> map(
+        std::shared_ptr<const EmoteMap>(this->initial));
+    auto applied = SeventvEmotes::applyEmoteSetChanges(map, first);
+
+    // Indices refer to the merged changes
+    EXPECT_EQ(appliedIndices(applied), (std::vector<size_t>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(appliedNames(applied),
+              (std::vector<QString>{"Gamma", "Alpha", "Gamma", "Alpha",
+                                    "Bee"}));
+
+    auto updated = map.get();
+    EXPECT_EQ(updated->size(), 2U);
+    EXPECT_TRUE(updated->contains(EmoteName{"Alpha"}));
+    EXPECT_TRUE(updated->contains(EmoteName{"Bee"}));
+    EXPECT_FALSE(updated->contains(EmoteName{"Gamma"}));
+
+    // Applying the dispatches one by one ends up with the same emotes
+    Atomic<std::shared_ptr<const EmoteMap>> oneByOne(
+        std::shared_ptr<const EmoteMap>(this->initial));
+    for (const auto &change : first.changes)
+    {
+        SeventvEmotes::applyEmoteSetChanges(
+            oneByOne, EmoteSetChanges{EMOTE_SET_ID, {change}});
+    }
+    auto expected = oneByOne.get();
+    EXPECT_EQ(expected->size(), updated->size());
+    for (const auto &[name, emote] : *expected)
+    {
+        EXPECT_TRUE(updated->contains(name)) << name.string;
+    }
+}
@@ -3,9 +3,12 @@
 #include "providers/seventv/eventapi/Client.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/eventapi/Message.hpp"
+#include "providers/seventv/SeventvCosmetics.hpp"
 #include "Test.hpp"
+#include "util/Variant.hpp"
 
 #include <QString>
+#include <rapidjson/document.h>
 
 #include <optional>
 
@@ -28,15 +31,24 @@ TEST(SeventvEventAPI, AllEvents)
     std::optional<EmoteRemoveDispatch> removeDispatch;
     std::optional<UserConnectionUpdateDispatch> userDispatch;
 
-    std::ignore = eventAPI.signals_.emoteAdded.connect([&](const auto &d) {
-        addDispatch = d;
-    });
-    std::ignore = eventAPI.signals_.emoteUpdated.connect([&](const auto &d) {
-        updateDispatch = d;
-    });
-    std::ignore = eventAPI.signals_.emoteRemoved.connect([&](const auto &d) {
-        removeDispatch = d;
-    });
+    std::ignore =
+        eventAPI.signals_.emoteSetChanged.connect([&](const auto &changes) {
+            for (const auto &change : changes.changes)
+            {
+                std::visit(variant::Overloaded{
+                               [&](const EmoteAddDispatch &d) {
+                                   addDispatch = d;
+                               },
+                               [&](const EmoteUpdateDispatch &d) {
+                                   updateDispatch = d;
+                               },
+                               [&](const EmoteRemoveDispatch &d) {
+                                   removeDispatch = d;
+                               },
+                           },
+                           change);
+            }
+        });
     std::ignore = eventAPI.signals_.userUpdated.connect([&](const auto &d) {
         userDispatch = d;
     });
@@ -107,3 +119,81 @@ TEST(SeventvEventAPI, NoHeartbeat)
 
     eventApi.stop();
 }
+
+TEST(SeventvEventAPI, DecodeEnvelope)
+{
+    auto hello = parseBaseMessage(std::string_view(
+        R"({"op":1,"d":{"heartbeat_interval":45000,"session_id":"x"}})"));
+    ASSERT_TRUE(hello);
+    ASSERT_EQ(hello->op, Opcode::Hello);
+    ASSERT_EQ(hello->heartbeatInterval, 45000);
+    // Only dispatches keep their document
+    ASSERT_TRUE(hello->document.IsNull());
+
+    auto dispatch = parseBaseMessage(std::string_view(
+        R"({"op":0,"d":{"type":"emote_set.update","body":{"id":"set",)"
+        R"("actor":{"display_name":"nerixyz"},"pushed":[]}}})"));
+    ASSERT_TRUE(dispatch);
+    ASSERT_EQ(dispatch->op, Opcode::Dispatch);
+    auto inner = dispatch->toInner<Dispatch>();
+    ASSERT_TRUE(inner);
+    ASSERT_EQ(inner->type, SubscriptionType::UpdateEmoteSet);
+    ASSERT_EQ(inner->id, "set");
+    ASSERT_EQ(inner->actorName, "nerixyz");
+    ASSERT_TRUE(inner->body["pushed"].IsArray());
+
+    ASSERT_FALSE(parseBaseMessage(std::string_view("not json")));
+}
+
+TEST(SeventvEventAPI, DecodeDispatch)
+{
+    auto entitlement = parseBaseMessage(std::string_view(
+        R"({"op":0,"d":{"type":"entitlement.create","body":{"id":"e",)"
+        R"("object":{"kind":"BADGE","ref_id":"badge","user":{"connections":[)"
+        R"({"platform":"YOUTUBE","id":"yt","username":"yt"},)"
+        R"({"platform":"TWITCH","id":"123","username":"forsen"}]}}}}})"));
+    ASSERT_TRUE(entitlement);
+    auto entitlementDispatch = entitlement->toInner<Dispatch>();
+    ASSERT_TRUE(entitlementDispatch);
+    ASSERT_EQ(entitlementDispatch->type, SubscriptionType::CreateEntitlement);
+
+    EntitlementCreateDeleteDispatch created(*entitlementDispatch);
+    ASSERT_TRUE(created.validate());
+    ASSERT_EQ(created.kind, seventv::CosmeticKind::Badge);
+    ASSERT_EQ(created.refID, "badge");
+    ASSERT_EQ(created.userID, "123");
+    ASSERT_EQ(created.userName, "forsen");
+
+    auto update = parseBaseMessage(std::string_view(
+        R"({"op":0,"d":{"type":"emote_set.update","body":{"id":"set",)"
+        R"("updated":[{"key":"emotes","old_value":{"id":"e1","name":"a"},)"
+        R"("value":{"id":"e1","name":"b"}}],)"
+        R"("pulled":[{"key":"emotes","old_value":{"id":"e2","name":"c"}}]}}})"));
+    ASSERT_TRUE(update);
+    auto updateDispatch = update->toInner<Dispatch>();
+    ASSERT_TRUE(updateDispatch);
+
+    const auto &updated = updateDispatch->body["updated"][0U];
+    EmoteUpdateDispatch renamed(*updateDispatch, updated["old_value"],
+                                updated["value"]);
+    ASSERT_TRUE(renamed.validate());
+    ASSERT_EQ(renamed.emoteSetID, "set");
+    ASSERT_EQ(renamed.emoteID, "e1");
+    ASSERT_EQ(renamed.oldEmoteName, "a");
+    ASSERT_EQ(renamed.emoteName, "b");
+
+    const auto &pulled = updateDispatch->body["pulled"][0U];
+    EmoteRemoveDispatch removed(*updateDispatch, pulled["old_value"]);
+    ASSERT_TRUE(removed.validate());
+    ASSERT_EQ(removed.emoteID, "e2");
+    ASSERT_EQ(removed.emoteName, "c");
+
+    // Missing members decode to empty values
+    auto empty = parseBaseMessage(std::string_view(R"({"op":0,"d":{}})"));
+    ASSERT_TRUE(empty);
+    auto emptyDispatch = empty->toInner<Dispatch>();
+    ASSERT_TRUE(emptyDispatch);
+    ASSERT_EQ(emptyDispatch->type, SubscriptionType::INVALID);
+    ASSERT_TRUE(emptyDispatch->id.isEmpty());
+    ASSERT_FALSE(EntitlementCreateDeleteDispatch(*emptyDispatch).validate());
+}
@@ -0,0 +1,44 @@
+#include "debug/StartupTimeline.hpp"
+
+#include "debug/Trace.hpp"
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(StartupTimeline, Stages)
+{
+    startup::clear();
+
+    auto backgroundStart = trace::now();
+    startup::mark("first");
+    startup::mark("second");
+    startup::markBackground("background", backgroundStart);
+    ASSERT_FALSE(startup::isFinished());
+
+    startup::markFirstPaint();
+    ASSERT_TRUE(startup::isFinished());
+
+    // Stages after the first paint are ignored
+    startup::mark("late");
+    startup::markFirstPaint();
+
+    auto stages = startup::stages();
+    ASSERT_EQ(stages.size(), 4U);
+    EXPECT_STREQ(stages[0].name, "first");
+    EXPECT_STREQ(stages[1].name, "second");
+    EXPECT_STREQ(stages[2].name, "background");
+    EXPECT_STREQ(stages[3].name, "first painted message");
+
+    // Sequential stages start where the previous one ended
+    EXPECT_EQ(stages[1].startNs, stages[0].endNs);
+    EXPECT_EQ(stages[3].startNs, stages[1].endNs);
+    EXPECT_EQ(stages[2].startNs, backgroundStart);
+    for (const auto &stage : stages)
+    {
+        EXPECT_LE(stage.startNs, stage.endNs);
+    }
+
+    startup::clear();
+    EXPECT_FALSE(startup::isFinished());
+    EXPECT_TRUE(startup::stages().empty());
+}
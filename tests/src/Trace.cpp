@@ -0,0 +1,136 @@
+#include "debug/Trace.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+/// Exports the trace and returns the spans recorded by these tests
+QJsonArray exportTestSpans(const QTemporaryDir &dir)
+{
+    auto filePath = dir.filePath("trace.json");
+    EXPECT_TRUE(trace::exportChromeTrace(filePath));
+
+    QFile file(filePath);
+    EXPECT_TRUE(file.open(QFile::ReadOnly));
+    auto root = QJsonDocument::fromJson(file.readAll()).object();
+    EXPECT_EQ(root.value("displayTimeUnit").toString(), "ms");
+
+    // Other threads might record spans while tracing is enabled
+    QJsonArray spans;
+    for (const auto &value : root.value("traceEvents").toArray())
+    {
+        auto event = value.toObject();
+        if (event.value("ph").toString() == "X" &&
+            event.value("name").toString().startsWith("test-"))
+        {
+            spans.append(event);
+        }
+    }
+    return spans;
+}
+
+/// Records spans while alive
+class RecordingGuard
+{
+public:
+    RecordingGuard()
+    {
+        trace::clear();
+        trace::setEnabled(true);
+    }
+
+    ~RecordingGuard()
+    {
+        trace::setEnabled(false);
+        trace::clear();
+    }
+
+    RecordingGuard(const RecordingGuard &) = delete;
+    RecordingGuard &operator=(const RecordingGuard &) = delete;
+    RecordingGuard(RecordingGuard &&) = delete;
+    RecordingGuard &operator=(RecordingGuard &&) = delete;
+};
+
+}  // namespace
+
+TEST(Trace, ExportsSpans)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    // Nothing is recorded while tracing is disabled
+    trace::setEnabled(false);
+    trace::recordSpan(trace::category::BENCHMARK, "test-disabled", 0, 1);
+
+    RecordingGuard guard;
+    trace::recordSpan(trace::category::BENCHMARK, "test-static", 1000, 3500);
+    trace::recordSpan(trace::category::LAYOUT, QString("test-dynamic"), 4000,
+                      5000);
+
+    auto spans = exportTestSpans(dir);
+    ASSERT_EQ(spans.size(), 2);
+
+    auto first = spans.at(0).toObject();
+    EXPECT_EQ(first.value("name").toString(), "test-static");
+    EXPECT_EQ(first.value("cat").toString(), "benchmark");
+    // Timestamps are in microseconds
+    EXPECT_EQ(first.value("ts").toDouble(), 1.0);
+    EXPECT_EQ(first.value("dur").toDouble(), 2.5);
+
+    auto second = spans.at(1).toObject();
+    EXPECT_EQ(second.value("name").toString(), "test-dynamic");
+    EXPECT_EQ(second.value("cat").toString(), "layout");
+    EXPECT_EQ(second.value("tid"), first.value("tid"));
+
+    // Clearing discards the recorded spans
+    trace::clear();
+    EXPECT_TRUE(exportTestSpans(dir).isEmpty());
+}
+
+TEST(Trace, RingBufferWrapsAround)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    RecordingGuard guard;
+
+    // Overwrites the oldest 10 spans
+    constexpr size_t overflow = 10;
+    for (size_t i = 0; i < trace::RING_BUFFER_SIZE + overflow; i++)
+    {
+        auto ns = static_cast<int64_t>(i) * 1000;
+        trace::recordSpan(trace::category::BENCHMARK, "test-span", ns, ns + 1);
+    }
+
+    auto spans = exportTestSpans(dir);
+    ASSERT_EQ(static_cast<size_t>(spans.size()), trace::RING_BUFFER_SIZE);
+
+    // The spans are exported from oldest to newest
+    EXPECT_EQ(spans.first().toObject().value("ts").toDouble(),
+              static_cast<double>(overflow));
+    EXPECT_EQ(spans.last().toObject().value("ts").toDouble(),
+              static_cast<double>(trace::RING_BUFFER_SIZE + overflow - 1));
+    for (qsizetype i = 1; i < spans.size(); i++)
+    {
+        ASSERT_LT(spans.at(i - 1).toObject().value("ts").toDouble(),
+                  spans.at(i).toObject().value("ts").toDouble());
+    }
+}
+
+TEST(Trace, ExportFailure)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    // The parent directory doesn't exist
+    EXPECT_FALSE(
+        trace::exportChromeTrace(dir.filePath("missing/trace.json")));
+}
@@ -0,0 +1,95 @@
+#include "providers/twitch/TwitchIrcLine.hpp"
+
+#include "Test.hpp"
+#include "util/IrcHelpers.hpp"
+
+#include <QString>
+
+using namespace chatterino;
+
+TEST(TwitchIrcLine, ClearChat)
+{
+    auto line = TwitchIrcLine::parse(
+        "@ban-duration=600;room-id=11148817;target-user-id=1;tmi-sent-ts="
+        "1700000000000 :tmi.twitch.tv CLEARCHAT #pajlada :forsen\r\n");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->command(), "CLEARCHAT");
+    EXPECT_TRUE(line->isCommand("CLEARCHAT"));
+    EXPECT_EQ(line->prefix(), "tmi.twitch.tv");
+    EXPECT_EQ(line->tagCount(), 4U);
+    EXPECT_EQ(line->tag("ban-duration"), "600");
+    EXPECT_EQ(line->tag("room-id"), "11148817");
+    EXPECT_FALSE(line->hasTag("target-msg-id"));
+    EXPECT_EQ(line->findTag("target-msg-id"), std::nullopt);
+
+    ASSERT_EQ(line->parameterCount(), 2U);
+    EXPECT_EQ(line->parameter(0), "#pajlada");
+    EXPECT_EQ(line->parameter(1), "forsen");
+    EXPECT_EQ(line->parameter(2), QString());
+
+    EXPECT_EQ(line->raw().right(6), "forsen");
+}
+
+TEST(TwitchIrcLine, Prefix)
+{
+    auto line =
+        TwitchIrcLine::parse(":ronni!ronni@ronni.tmi.twitch.tv JOIN #dallas");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->tagCount(), 0U);
+    EXPECT_EQ(line->nick(), "ronni");
+    EXPECT_EQ(line->prefix(), "ronni!ronni@ronni.tmi.twitch.tv");
+    ASSERT_EQ(line->parameterCount(), 1U);
+    EXPECT_EQ(line->parameter(0), "#dallas");
+
+    auto ping = TwitchIrcLine::parse("PING :tmi.twitch.tv");
+    ASSERT_TRUE(ping.has_value());
+    EXPECT_EQ(ping->nick(), QString());
+    EXPECT_EQ(ping->parameter(0), "tmi.twitch.tv");
+}
+
+TEST(TwitchIrcLine, Trailing)
+{
+    auto line = TwitchIrcLine::parse(
+        "@emotes=;empty-value;;flags= :a!a@a.tmi.twitch.tv PRIVMSG #c "
+        ":hello  world :) \xc3\xbc");
+    ASSERT_TRUE(line.has_value());
+
+    EXPECT_EQ(line->tagCount(), 3U);
+    EXPECT_TRUE(line->hasTag("empty-value"));
+    EXPECT_EQ(line->tag("empty-value"), QString());
+    EXPECT_EQ(line->findTag("flags"), QString());
+
+    ASSERT_EQ(line->parameterCount(), 2U);
+    EXPECT_EQ(line->parameter(1),
+              QString::fromUtf8("hello  world :) \xc3\xbc"));
+}
+
+TEST(TwitchIrcLine, Invalid)
+{
+    EXPECT_FALSE(TwitchIrcLine::parse("").has_value());
+    EXPECT_FALSE(TwitchIrcLine::parse("@a=b").has_value());
+    EXPECT_FALSE(TwitchIrcLine::parse("@a=b :prefix").has_value());
+}
+
+TEST(TwitchIrcLine, UnescapeTagValue)
+{
+    std::vector<std::string_view> inputs{
+        R"(DefectiveCloak gifted a Tier 1 sub to aliiscrying!)",
+        R"(DefectiveCloak\s\sgifted\sa\sTier\s1\ssub\sto\s)",
+        R"(foo\:bar)",
+        R"(foo\\bar)",
+        R"(foo\nbar\r)",
+        R"(unknown\xescape)",
+        R"(trailing\)",
+    };
+
+    // unescapeTagValue must behave exactly like parseTagString
+    for (const auto &input : inputs)
+    {
+        auto expected = parseTagString(
+            QString::fromUtf8(input.data(), static_cast<int>(input.size())));
+        EXPECT_EQ(unescapeTagValue(input), expected);
+    }
+}
@@ -2,11 +2,16 @@
 #include "providers/twitch/PubSubClient.hpp"
 #include "providers/twitch/PubSubManager.hpp"
 #include "providers/twitch/pubsubmessages/AutoMod.hpp"
+#include "providers/twitch/pubsubmessages/Base.hpp"
+#include "providers/twitch/pubsubmessages/ChatModeratorAction.hpp"
+#include "providers/twitch/pubsubmessages/Message.hpp"
 #include "providers/twitch/pubsubmessages/Whisper.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "Test.hpp"
 
+#include <QColor>
 #include <QString>
+#include <QStringList>
 
 #include <chrono>
 #include <mutex>
@@ -452,6 +457,91 @@ TEST(TwitchPubSubClient, AutoModMessageHeld)
     ASSERT_EQ(pubSub.diag.connectionsFailed, 0);
 }
 
+TEST(TwitchPubSubClient, DecodeEnvelope)
+{
+    std::string_view pong = R"({"type":"PONG"})";
+    auto oPong = parsePubSubBaseMessage(pong);
+    ASSERT_TRUE(oPong);
+    ASSERT_EQ(oPong->type, PubSubMessage::Type::Pong);
+    ASSERT_FALSE(oPong->toInner<PubSubMessageMessage>());
+
+    std::string_view response =
+        R"({"type":"RESPONSE","nonce":"abc","error":"ERR_BADAUTH"})";
+    auto oResponse = parsePubSubBaseMessage(response);
+    ASSERT_TRUE(oResponse);
+    ASSERT_EQ(oResponse->type, PubSubMessage::Type::Response);
+    ASSERT_EQ(oResponse->nonce, "abc");
+    ASSERT_EQ(oResponse->error, "ERR_BADAUTH");
+
+    std::string_view message =
+        R"({"type":"MESSAGE","data":{"topic":"chat_moderator_actions.1.2",)"
+        R"("message":"{\"type\":\"moderation_action\",\"data\":)"
+        R"({\"moderation_action\":\"clear\"}}"}})";
+    auto oMessage = parsePubSubBaseMessage(message);
+    ASSERT_TRUE(oMessage);
+    ASSERT_EQ(oMessage->type, PubSubMessage::Type::Message);
+    ASSERT_EQ(oMessage->topic, "chat_moderator_actions.1.2");
+
+    auto oMessageMessage = oMessage->toInner<PubSubMessageMessage>();
+    ASSERT_TRUE(oMessageMessage);
+    auto oAction =
+        oMessageMessage->toInner<PubSubChatModeratorActionMessage>();
+    ASSERT_TRUE(oAction);
+    ASSERT_EQ(oAction->type,
+              PubSubChatModeratorActionMessage::Type::ModerationAction);
+    ASSERT_EQ(oAction->data.moderationAction, "clear");
+
+    ASSERT_FALSE(parsePubSubBaseMessage(std::string_view("{")));
+    ASSERT_FALSE(parsePubSubBaseMessage(std::string_view("[]")));
+}
+
+TEST(TwitchPubSubClient, DecodeInnerMessage)
+{
+    PubSubMessageMessage timeout(
+        "", "chat_moderator_actions.1.2",
+        R"({"type":"moderation_action","data":{"type":"chat_login_moderation",)"
+        R"("moderation_action":"timeout","args":["forsen","600"],)"
+        R"("created_by":"pajlada","created_by_user_id":"11148817",)"
+        R"("target_user_id":"22484632"}})");
+    auto oTimeout = timeout.toInner<PubSubChatModeratorActionMessage>();
+    ASSERT_TRUE(oTimeout);
+    ASSERT_EQ(oTimeout->type,
+              PubSubChatModeratorActionMessage::Type::ModerationAction);
+    ASSERT_EQ(oTimeout->data.moderationAction, "timeout");
+    ASSERT_EQ(oTimeout->data.type, "chat_login_moderation");
+    ASSERT_EQ(oTimeout->data.args, QStringList({"forsen", "600"}));
+    // The reason is omitted
+    ASSERT_EQ(oTimeout->data.arg(2), "");
+    ASSERT_EQ(oTimeout->data.createdBy, "pajlada");
+    ASSERT_EQ(oTimeout->data.createdByUserID, "11148817");
+    ASSERT_EQ(oTimeout->data.targetUserID, "22484632");
+
+    PubSubMessageMessage automod(
+        "", "automod-queue.1.2",
+        R"({"type":"automod_caught_message","data":{"status":"PENDING",)"
+        R"("content_classification":{"category":"swearing","level":4},)"
+        R"("message":{"id":"abc","content":{"text":"kurwa"},)"
+        R"("sender":{"user_id":"1","login":"forsen",)"
+        R"("display_name":"Forsen","chat_color":"#FF0000"}}}})");
+    auto oAutomod = automod.toInner<PubSubAutoModQueueMessage>();
+    ASSERT_TRUE(oAutomod);
+    ASSERT_EQ(oAutomod->type,
+              PubSubAutoModQueueMessage::Type::AutoModCaughtMessage);
+    ASSERT_EQ(oAutomod->status, "PENDING");
+    ASSERT_EQ(oAutomod->contentCategory, "swearing");
+    ASSERT_EQ(oAutomod->contentLevel, 4);
+    ASSERT_EQ(oAutomod->messageID, "abc");
+    ASSERT_EQ(oAutomod->messageText, "kurwa");
+    ASSERT_EQ(oAutomod->senderUserLogin, "forsen");
+    ASSERT_EQ(oAutomod->senderUserDisplayName, "Forsen");
+    ASSERT_EQ(oAutomod->senderUserChatColor, QColor("#FF0000"));
+
+    PubSubMessageMessage empty("", "automod-queue.1.2", "{}");
+    ASSERT_FALSE(empty.toInner<PubSubAutoModQueueMessage>());
+    PubSubMessageMessage invalid("", "automod-queue.1.2", "[");
+    ASSERT_FALSE(invalid.toInner<PubSubAutoModQueueMessage>());
+}
+
 }  // namespace chatterino
 
 #endif